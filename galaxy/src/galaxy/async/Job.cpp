@@ -0,0 +1,117 @@
+///
+/// Job.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "Job.hpp"
+
+namespace galaxy
+{
+	namespace async
+	{
+		Job::Job(std::function<void(void)>&& func, Job* parent) noexcept
+		    : m_func {std::move(func)}, m_parent {parent}, m_unfinished {1}, m_refs {1}, m_done {false}
+		{
+			m_lock.clear();
+		}
+
+		Job::~Job() noexcept
+		{
+			m_continuations.clear();
+		}
+
+		void Job::retain() noexcept
+		{
+			m_refs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void Job::release() noexcept
+		{
+			if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete this;
+			}
+		}
+
+		JobHandle::JobHandle() noexcept
+		    : m_job {nullptr}
+		{
+		}
+
+		JobHandle::JobHandle(Job* job) noexcept
+		    : m_job {job}
+		{
+			if (m_job)
+			{
+				m_job->retain();
+			}
+		}
+
+		JobHandle::JobHandle(const JobHandle& handle) noexcept
+		    : JobHandle {handle.m_job}
+		{
+		}
+
+		JobHandle::JobHandle(JobHandle&& handle) noexcept
+		    : m_job {handle.m_job}
+		{
+			handle.m_job = nullptr;
+		}
+
+		JobHandle& JobHandle::operator=(const JobHandle& handle) noexcept
+		{
+			if (this != &handle)
+			{
+				if (handle.m_job)
+				{
+					handle.m_job->retain();
+				}
+
+				if (m_job)
+				{
+					m_job->release();
+				}
+
+				m_job = handle.m_job;
+			}
+
+			return *this;
+		}
+
+		JobHandle& JobHandle::operator=(JobHandle&& handle) noexcept
+		{
+			if (this != &handle)
+			{
+				if (m_job)
+				{
+					m_job->release();
+				}
+
+				m_job        = handle.m_job;
+				handle.m_job = nullptr;
+			}
+
+			return *this;
+		}
+
+		JobHandle::~JobHandle() noexcept
+		{
+			if (m_job)
+			{
+				m_job->release();
+			}
+		}
+
+		const bool JobHandle::is_done() const noexcept
+		{
+			return m_job == nullptr || m_job->m_done.load(std::memory_order_acquire);
+		}
+
+		const bool JobHandle::valid() const noexcept
+		{
+			return m_job != nullptr;
+		}
+	} // namespace async
+} // namespace galaxy
\ No newline at end of file
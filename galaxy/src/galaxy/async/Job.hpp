@@ -0,0 +1,183 @@
+///
+/// Job.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_ASYNC_JOB_HPP_
+#define GALAXY_ASYNC_JOB_HPP_
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace galaxy
+{
+	namespace async
+	{
+		class ThreadPool;
+
+		///
+		/// \brief A unit of work scheduled on a ThreadPool.
+		///
+		/// Jobs are reference counted and owned by the pool. A job is complete once its function has run and
+		/// all of its children have completed. Continuations are scheduled when a job completes.
+		///
+		class Job final
+		{
+			friend class ThreadPool;
+			friend class JobHandle;
+
+		public:
+			///
+			/// Destructor.
+			///
+			~Job() noexcept;
+
+		private:
+			///
+			/// Constructor.
+			///
+			/// \param func Function to execute.
+			/// \param parent Optional parent job. Parent will not complete until this job has.
+			///
+			Job(std::function<void(void)>&& func, Job* parent) noexcept;
+
+			///
+			/// Copy constructor.
+			///
+			Job(const Job&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			Job(Job&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			Job& operator=(const Job&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			Job& operator=(Job&&) = delete;
+
+			///
+			/// Increment reference count.
+			///
+			void retain() noexcept;
+
+			///
+			/// Decrement reference count, deleting job if it reaches zero.
+			///
+			void release() noexcept;
+
+		private:
+			///
+			/// Work to be done.
+			///
+			std::function<void(void)> m_func;
+
+			///
+			/// Parent job.
+			///
+			Job* m_parent;
+
+			///
+			/// Number of unfinished jobs, including this one and its children.
+			///
+			std::atomic<int> m_unfinished;
+
+			///
+			/// Reference count.
+			///
+			std::atomic<int> m_refs;
+
+			///
+			/// Has job and all children completed.
+			///
+			std::atomic<bool> m_done;
+
+			///
+			/// Protects continuation list.
+			///
+			std::atomic_flag m_lock;
+
+			///
+			/// Jobs to schedule once this one completes.
+			///
+			std::vector<Job*> m_continuations;
+		};
+
+		///
+		/// Reference to a submitted job, used to wait on it or chain work after it.
+		///
+		class JobHandle final
+		{
+			friend class ThreadPool;
+
+		public:
+			///
+			/// Constructor. Creates an empty handle.
+			///
+			JobHandle() noexcept;
+
+			///
+			/// Copy constructor.
+			///
+			JobHandle(const JobHandle& handle) noexcept;
+
+			///
+			/// Move constructor.
+			///
+			JobHandle(JobHandle&& handle) noexcept;
+
+			///
+			/// Copy assignment operator.
+			///
+			JobHandle& operator=(const JobHandle& handle) noexcept;
+
+			///
+			/// Move assignment operator.
+			///
+			JobHandle& operator=(JobHandle&& handle) noexcept;
+
+			///
+			/// Destructor.
+			///
+			~JobHandle() noexcept;
+
+			///
+			/// Check if the job and all its children have completed.
+			///
+			/// \return True if finished. An empty handle is always finished.
+			///
+			[[nodiscard]] const bool is_done() const noexcept;
+
+			///
+			/// Check if this handle refers to a job.
+			///
+			/// \return True if not empty.
+			///
+			[[nodiscard]] const bool valid() const noexcept;
+
+		private:
+			///
+			/// Argument constructor.
+			///
+			/// \param job Job to reference.
+			///
+			JobHandle(Job* job) noexcept;
+
+		private:
+			///
+			/// Referenced job.
+			///
+			Job* m_job;
+		};
+	} // namespace async
+} // namespace galaxy
+
+#endif
\ No newline at end of file
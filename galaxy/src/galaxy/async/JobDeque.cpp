@@ -0,0 +1,97 @@
+///
+/// JobDeque.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "JobDeque.hpp"
+
+namespace galaxy
+{
+	namespace async
+	{
+		JobDeque::JobDeque() noexcept
+		    : m_top {0}, m_bottom {0}
+		{
+			for (auto& slot : m_buffer)
+			{
+				slot.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		JobDeque::~JobDeque() noexcept
+		{
+		}
+
+		const bool JobDeque::push(Job* job) noexcept
+		{
+			const auto bottom = m_bottom.load(std::memory_order_relaxed);
+			const auto top    = m_top.load(std::memory_order_acquire);
+
+			if (bottom - top >= CAPACITY)
+			{
+				return false;
+			}
+
+			// Release publishes the job to thieves that acquire bottom.
+			m_buffer[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		Job* JobDeque::pop() noexcept
+		{
+			const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = m_top.load(std::memory_order_relaxed);
+
+			Job* job = nullptr;
+			if (top <= bottom)
+			{
+				job = m_buffer[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+				if (top == bottom)
+				{
+					// Last job, race against thieves.
+					if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					{
+						job = nullptr;
+					}
+
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return job;
+		}
+
+		Job* JobDeque::steal() noexcept
+		{
+			auto top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top < bottom)
+			{
+				Job* job = m_buffer[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+				if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					return job;
+				}
+			}
+
+			return nullptr;
+		}
+
+		const bool JobDeque::empty() const noexcept
+		{
+			return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+		}
+	} // namespace async
+} // namespace galaxy
\ No newline at end of file
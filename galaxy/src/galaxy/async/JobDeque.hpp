@@ -0,0 +1,114 @@
+///
+/// JobDeque.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_ASYNC_JOBDEQUE_HPP_
+#define GALAXY_ASYNC_JOBDEQUE_HPP_
+
+#include <array>
+#include <cstdint>
+
+#include "galaxy/async/Job.hpp"
+
+namespace galaxy
+{
+	namespace async
+	{
+		///
+		/// \brief Fixed capacity Chase-Lev work stealing deque.
+		///
+		/// Only the owning thread may push() and pop(), which work on the bottom of the deque.
+		/// Any thread may steal() from the top.
+		///
+		class JobDeque final
+		{
+		public:
+			///
+			/// Maximum number of jobs in deque. Must be a power of two.
+			///
+			inline static constexpr const std::int64_t CAPACITY = 4096;
+
+			///
+			/// Constructor.
+			///
+			JobDeque() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~JobDeque() noexcept;
+
+			///
+			/// Push a job onto the bottom. Owner thread only.
+			///
+			/// \param job Job to push.
+			///
+			/// \return False if deque is full.
+			///
+			[[nodiscard]] const bool push(Job* job) noexcept;
+
+			///
+			/// Pop a job from the bottom. Owner thread only.
+			///
+			/// \return Pointer to job, or nullptr if empty.
+			///
+			[[nodiscard]] Job* pop() noexcept;
+
+			///
+			/// Steal a job from the top. Any thread.
+			///
+			/// \return Pointer to job, or nullptr if empty or another thread won the race.
+			///
+			[[nodiscard]] Job* steal() noexcept;
+
+			///
+			/// Check if deque appears empty.
+			///
+			/// \return True if empty at the time of calling.
+			///
+			[[nodiscard]] const bool empty() const noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			JobDeque(const JobDeque&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			JobDeque(JobDeque&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			JobDeque& operator=(const JobDeque&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			JobDeque& operator=(JobDeque&&) = delete;
+
+		private:
+			///
+			/// Index thieves steal from.
+			///
+			alignas(64) std::atomic<std::int64_t> m_top;
+
+			///
+			/// Index the owner pushes and pops from.
+			///
+			alignas(64) std::atomic<std::int64_t> m_bottom;
+
+			///
+			/// Ring buffer of jobs.
+			///
+			alignas(64) std::array<std::atomic<Job*>, CAPACITY> m_buffer;
+		};
+	} // namespace async
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+///
+/// JobQueue.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <cstdint>
+
+#include "JobQueue.hpp"
+
+namespace galaxy
+{
+	namespace async
+	{
+		JobQueue::JobQueue() noexcept
+		    : m_enqueue {0}, m_dequeue {0}
+		{
+			for (std::size_t i = 0; i < CAPACITY; i++)
+			{
+				m_buffer[i].m_sequence.store(i, std::memory_order_relaxed);
+				m_buffer[i].m_job = nullptr;
+			}
+		}
+
+		JobQueue::~JobQueue() noexcept
+		{
+		}
+
+		const bool JobQueue::push(Job* job) noexcept
+		{
+			Cell* cell = nullptr;
+			auto pos   = m_enqueue.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				cell            = &m_buffer[pos & (CAPACITY - 1)];
+				const auto seq  = cell->m_sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+				if (diff == 0)
+				{
+					if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = m_enqueue.load(std::memory_order_relaxed);
+				}
+			}
+
+			cell->m_job = job;
+			cell->m_sequence.store(pos + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		Job* JobQueue::pop() noexcept
+		{
+			Cell* cell = nullptr;
+			auto pos   = m_dequeue.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				cell            = &m_buffer[pos & (CAPACITY - 1)];
+				const auto seq  = cell->m_sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					return nullptr;
+				}
+				else
+				{
+					pos = m_dequeue.load(std::memory_order_relaxed);
+				}
+			}
+
+			auto* job = cell->m_job;
+			cell->m_sequence.store(pos + CAPACITY, std::memory_order_release);
+
+			return job;
+		}
+	} // namespace async
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,114 @@
+///
+/// JobQueue.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_ASYNC_JOBQUEUE_HPP_
+#define GALAXY_ASYNC_JOBQUEUE_HPP_
+
+#include <array>
+
+#include "galaxy/async/Job.hpp"
+
+namespace galaxy
+{
+	namespace async
+	{
+		///
+		/// \brief Bounded lock-free multi-producer multi-consumer queue.
+		///
+		/// Used by threads that are not part of a ThreadPool to submit jobs.
+		///
+		class JobQueue final
+		{
+		public:
+			///
+			/// Maximum number of jobs in queue. Must be a power of two.
+			///
+			inline static constexpr const std::size_t CAPACITY = 4096;
+
+			///
+			/// Constructor.
+			///
+			JobQueue() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~JobQueue() noexcept;
+
+			///
+			/// Add a job to the queue.
+			///
+			/// \param job Job to add.
+			///
+			/// \return False if queue is full.
+			///
+			[[nodiscard]] const bool push(Job* job) noexcept;
+
+			///
+			/// Take a job from the queue.
+			///
+			/// \return Pointer to job, or nullptr if empty.
+			///
+			[[nodiscard]] Job* pop() noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			JobQueue(const JobQueue&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			JobQueue(JobQueue&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			JobQueue& operator=(const JobQueue&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			JobQueue& operator=(JobQueue&&) = delete;
+
+		private:
+			///
+			/// Queue slot. Sequence number tells producers and consumers whose turn it is.
+			///
+			struct Cell final
+			{
+				///
+				/// Slot sequence number.
+				///
+				std::atomic<std::size_t> m_sequence;
+
+				///
+				/// Stored job.
+				///
+				Job* m_job;
+			};
+
+			///
+			/// Ring buffer of cells.
+			///
+			std::array<Cell, CAPACITY> m_buffer;
+
+			///
+			/// Next position to push to.
+			///
+			alignas(64) std::atomic<std::size_t> m_enqueue;
+
+			///
+			/// Next position to pop from.
+			///
+			alignas(64) std::atomic<std::size_t> m_dequeue;
+		};
+	} // namespace async
+} // namespace galaxy
+
+#endif
\ No newline at end of file
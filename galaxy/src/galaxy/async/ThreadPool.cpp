@@ -13,44 +13,44 @@ namespace galaxy
 {
 	namespace async
 	{
+		namespace
+		{
+			///
+			/// Pool the calling worker thread belongs to.
+			///
+			thread_local const ThreadPool* t_pool = nullptr;
+
+			///
+			/// Deque index of the calling thread in t_pool.
+			///
+			thread_local int t_index = -1;
+
+			///
+			/// Number of empty searches before a worker goes to sleep.
+			///
+			constexpr const int SPIN_COUNT = 64;
+		} // namespace
+
 		ThreadPool::ThreadPool()
-		    : m_is_destroyed {true}, m_sync {0}
+		    : ThreadPool {std::max(std::thread::hardware_concurrency(), 2u) - 1}
+		{
+		}
+
+		ThreadPool::ThreadPool(const unsigned int workers)
+		    : m_is_destroyed {false}, m_owner {std::this_thread::get_id()}, m_running {true}, m_epoch {0}, m_sleeping {0}
 		{
-			m_running = true;
+			m_max_threads = std::max(workers, 1u);
+			m_injected    = std::make_unique<JobQueue>();
 
-			m_max_threads = std::thread::hardware_concurrency();
-			if (m_max_threads > MAX_THREADS_ALLOWED_TOTAL)
+			for (unsigned int i = 0; i < m_max_threads + 1; i++)
 			{
-				m_max_threads = MAX_THREADS_ALLOWED_TOTAL;
+				m_deques.emplace_back(std::make_unique<JobDeque>());
 			}
 
-			for (std::size_t i = 0; i < m_max_threads; i++)
+			for (unsigned int i = 1; i < m_max_threads + 1; i++)
 			{
-				// This is just storing the thread.
-				m_workers.emplace_back([&]() {
-					Task* task = nullptr;
-
-					while (m_running)
-					{
-						task = nullptr;
-
-						// Wait until notification.
-						m_sync.acquire();
-
-						m_mutex.lock();
-						if (!m_tasks.empty())
-						{
-							task = m_tasks.front();
-							m_tasks.pop();
-						}
-						m_mutex.unlock();
-
-						// Make sure a task was assigned.
-						if (task != nullptr)
-						{
-							task->exec();
-						}
-					}
+				m_workers.emplace_back([this, i]() {
+					worker(static_cast<int>(i));
 				});
 			}
 		}
@@ -65,29 +65,39 @@ namespace galaxy
 
 		void ThreadPool::queue(Task* task) noexcept
 		{
-			m_mutex.lock();
-			m_tasks.emplace(task);
-			m_mutex.unlock();
+			submit([task]() {
+				task->exec();
+			});
+		}
 
-			m_sync.release();
+		void ThreadPool::wait(const JobHandle& job) noexcept
+		{
+			const auto index = local_index();
+			while (!job.is_done())
+			{
+				auto* next = find_job(index);
+				if (next != nullptr)
+				{
+					execute(next);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
 		}
 
 		void ThreadPool::finish()
 		{
-			m_running = false;
-
-			// Make sure tasks is not in use, then empty queue.
-			// In case any tasks are left over.
-			m_mutex.lock();
-			while (!m_tasks.empty())
+			if (m_is_destroyed)
 			{
-				m_tasks.pop();
+				return;
 			}
-			m_mutex.unlock();
 
-			m_sync.release(m_max_threads);
+			m_running = false;
+			m_epoch.fetch_add(1, std::memory_order_release);
+			m_epoch.notify_all();
 
-			// Destroy all threads.
 			for (auto& worker : m_workers)
 			{
 				worker.request_stop();
@@ -95,7 +105,190 @@ namespace galaxy
 			}
 
 			m_workers.clear();
+
+			// Run anything left over so no one waits forever.
+			const auto index = local_index();
+			auto* job        = find_job(index);
+			while (job != nullptr)
+			{
+				execute(job);
+				job = find_job(index);
+			}
+
 			m_is_destroyed = true;
 		}
+
+		const unsigned int ThreadPool::get_thread_count() const noexcept
+		{
+			return m_max_threads;
+		}
+
+		Job* ThreadPool::make_job(std::function<void(void)>&& func, Job* parent)
+		{
+			if (parent != nullptr)
+			{
+				parent->m_unfinished.fetch_add(1, std::memory_order_relaxed);
+				parent->retain();
+			}
+
+			return new Job {std::move(func), parent};
+		}
+
+		void ThreadPool::schedule(Job* job) noexcept
+		{
+			const auto index = local_index();
+
+			bool queued = false;
+			if (index >= 0)
+			{
+				queued = m_deques[index]->push(job);
+			}
+
+			if (!queued)
+			{
+				queued = m_injected->push(job);
+			}
+
+			if (!queued)
+			{
+				// Queues are full, so do the work now.
+				execute(job);
+			}
+			else
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (m_sleeping.load(std::memory_order_relaxed) > 0)
+				{
+					m_epoch.fetch_add(1, std::memory_order_release);
+					m_epoch.notify_one();
+				}
+			}
+		}
+
+		void ThreadPool::execute(Job* job) noexcept
+		{
+			job->m_func();
+			finish_job(job);
+			job->release();
+		}
+
+		void ThreadPool::finish_job(Job* job) noexcept
+		{
+			if (job->m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				while (job->m_lock.test_and_set(std::memory_order_acquire))
+				{
+				}
+
+				job->m_done.store(true, std::memory_order_release);
+				auto continuations = std::move(job->m_continuations);
+				job->m_lock.clear(std::memory_order_release);
+
+				for (auto* next : continuations)
+				{
+					schedule(next);
+				}
+
+				if (job->m_parent != nullptr)
+				{
+					finish_job(job->m_parent);
+					job->m_parent->release();
+				}
+			}
+		}
+
+		Job* ThreadPool::find_job(const int index) noexcept
+		{
+			if (index >= 0)
+			{
+				auto* job = m_deques[index]->pop();
+				if (job != nullptr)
+				{
+					return job;
+				}
+			}
+
+			auto* job = m_injected->pop();
+			if (job != nullptr)
+			{
+				return job;
+			}
+
+			// Start at a different victim per thread to spread contention.
+			const auto count = m_deques.size();
+			const auto start = static_cast<std::size_t>(index < 0 ? 0 : index);
+			for (std::size_t i = 1; i <= count; i++)
+			{
+				const auto victim = (start + i) % count;
+				if (static_cast<int>(victim) != index)
+				{
+					job = m_deques[victim]->steal();
+					if (job != nullptr)
+					{
+						return job;
+					}
+				}
+			}
+
+			return nullptr;
+		}
+
+		const int ThreadPool::local_index() const noexcept
+		{
+			// Creating thread is not tracked with t_pool, so a second pool made on it does not take over deque 0.
+			if (t_pool == this)
+			{
+				return t_index;
+			}
+
+			return std::this_thread::get_id() == m_owner ? 0 : -1;
+		}
+
+		void ThreadPool::worker(const int index)
+		{
+			t_pool  = this;
+			t_index = index;
+
+			int spins = 0;
+			while (m_running.load(std::memory_order_acquire))
+			{
+				auto* job = find_job(index);
+				if (job != nullptr)
+				{
+					execute(job);
+					spins = 0;
+				}
+				else if (spins < SPIN_COUNT)
+				{
+					spins++;
+					std::this_thread::yield();
+				}
+				else
+				{
+					m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+					const auto epoch = m_epoch.load(std::memory_order_acquire);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+
+					// Recheck after announcing sleep so a concurrent submit is not missed.
+					job = find_job(index);
+					if (job != nullptr)
+					{
+						m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+						execute(job);
+					}
+					else if (m_running.load(std::memory_order_acquire))
+					{
+						m_epoch.wait(epoch, std::memory_order_acquire);
+						m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+					}
+					else
+					{
+						m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+					}
+
+					spins = 0;
+				}
+			}
+		}
 	} // namespace async
 } // namespace galaxy
\ No newline at end of file
@@ -8,31 +8,40 @@
 #ifndef GALAXY_ASYNC_THREADPOOL_HPP_
 #define GALAXY_ASYNC_THREADPOOL_HPP_
 
-#include <mutex>
-#include <queue>
-#include <semaphore>
+#include <algorithm>
+#include <memory>
 #include <thread>
-#include <vector>
 
+#include "galaxy/async/JobDeque.hpp"
+#include "galaxy/async/JobQueue.hpp"
 #include "galaxy/async/Task.hpp"
 
-#define MAX_THREADS_ALLOWED_TOTAL 16
-
 namespace galaxy
 {
 	namespace async
 	{
 		///
-		/// Creates a system defined count of threads to reuse for task based work.
+		/// \brief Work stealing job scheduler.
+		///
+		/// Each worker owns a deque it pushes and pops jobs from, and steals from the other workers when empty.
+		/// The thread that created the pool also owns a deque so it can submit without contention and help
+		/// execute jobs while waiting. Other threads submit through a shared lock-free queue.
 		///
 		class ThreadPool final
 		{
 		public:
 			///
-			/// Constructor.
+			/// Constructor. Creates one worker less than the number of hardware threads.
 			///
 			ThreadPool();
 
+			///
+			/// Argument constructor.
+			///
+			/// \param workers Number of worker threads to create, not including the calling thread. Minimum of 1.
+			///
+			ThreadPool(const unsigned int workers);
+
 			///
 			/// Destructor.
 			///
@@ -41,15 +50,77 @@ namespace galaxy
 			///
 			/// Queue a task for the thread pool to execute.
 			///
-			/// \param task Pointer to task to queue.
+			/// \param task Pointer to task to queue. Caller manages lifetime.
 			///
 			void queue(Task* task) noexcept;
 
 			///
-			/// Finish all threads.
+			/// Submit a job.
+			///
+			/// \param func Function to execute.
+			///
+			/// \return Handle to job.
+			///
+			template<typename Lambda>
+			[[maybe_unused]] JobHandle submit(Lambda&& func);
+
+			///
+			/// \brief Submit a child job.
+			///
+			/// The parent will not be done until the child is. Must be called while the parent is not yet done,
+			/// usually from inside the parent's function.
+			///
+			/// \param parent Parent job.
+			/// \param func Function to execute.
+			///
+			/// \return Handle to child job.
+			///
+			template<typename Lambda>
+			[[maybe_unused]] JobHandle submit(const JobHandle& parent, Lambda&& func);
+
+			///
+			/// Submit a job to be executed once another job is done.
+			///
+			/// \param job Job to wait on.
+			/// \param func Function to execute.
+			///
+			/// \return Handle to continuation job.
+			///
+			template<typename Lambda>
+			[[maybe_unused]] JobHandle then(const JobHandle& job, Lambda&& func);
+
+			///
+			/// \brief Split a range into chunks and process them in parallel.
+			///
+			/// Blocks until the whole range is processed. The calling thread executes jobs while it waits.
+			///
+			/// \param begin First index.
+			/// \param end One past last index.
+			/// \param grain Largest chunk a single job will process. Minimum of 1.
+			/// \param func Called with (chunk_begin, chunk_end).
+			///
+			template<typename Lambda>
+			void parallel_for(const std::size_t begin, const std::size_t end, const std::size_t grain, Lambda&& func);
+
+			///
+			/// Wait for a job to complete. The calling thread executes other jobs while it waits.
+			///
+			/// \param job Job to wait on.
+			///
+			void wait(const JobHandle& job) noexcept;
+
+			///
+			/// Finish all threads. Jobs still queued are executed on the calling thread.
 			///
 			void finish();
 
+			///
+			/// Get number of worker threads.
+			///
+			/// \return Const unsigned int.
+			///
+			[[nodiscard]] const unsigned int get_thread_count() const noexcept;
+
 		private:
 			///
 			/// Copy constructor.
@@ -61,6 +132,60 @@ namespace galaxy
 			///
 			ThreadPool& operator=(const ThreadPool&) = delete;
 
+			///
+			/// Allocate a job.
+			///
+			/// \param func Function to execute.
+			/// \param parent Optional parent.
+			///
+			/// \return Job with one reference owned by the pool.
+			///
+			[[nodiscard]] Job* make_job(std::function<void(void)>&& func, Job* parent);
+
+			///
+			/// Push job to a queue and wake a worker.
+			///
+			/// \param job Job to schedule.
+			///
+			void schedule(Job* job) noexcept;
+
+			///
+			/// Run a job and release the pool's reference to it.
+			///
+			/// \param job Job to execute.
+			///
+			void execute(Job* job) noexcept;
+
+			///
+			/// Mark one unit of work as finished on a job, completing it if nothing is left.
+			///
+			/// \param job Job to update.
+			///
+			void finish_job(Job* job) noexcept;
+
+			///
+			/// Find a job to execute.
+			///
+			/// \param index Deque index of calling thread, or -1.
+			///
+			/// \return Pointer to job or nullptr.
+			///
+			[[nodiscard]] Job* find_job(const int index) noexcept;
+
+			///
+			/// Get the deque index of the calling thread.
+			///
+			/// \return Index, or -1 if the calling thread does not own a deque in this pool.
+			///
+			[[nodiscard]] const int local_index() const noexcept;
+
+			///
+			/// Worker thread loop.
+			///
+			/// \param index Deque index of worker.
+			///
+			void worker(const int index);
+
 		private:
 			///
 			/// Keeps track if threadpool has been destroyed.
@@ -68,24 +193,24 @@ namespace galaxy
 			bool m_is_destroyed;
 
 			///
-			/// Worker threads to do a task on.
+			/// Thread that created the pool, which owns deque 0.
 			///
-			std::vector<std::jthread> m_workers;
+			std::thread::id m_owner;
 
 			///
-			/// Task queue.
+			/// Worker threads.
 			///
-			std::queue<Task*> m_tasks;
+			std::vector<std::jthread> m_workers;
 
 			///
-			/// Controls thread synchronization.
+			/// Per-thread deques. Index 0 belongs to the thread that created the pool.
 			///
-			std::counting_semaphore<MAX_THREADS_ALLOWED_TOTAL> m_sync;
+			std::vector<std::unique_ptr<JobDeque>> m_deques;
 
 			///
-			/// Mutex to protect queue.
+			/// Jobs submitted from threads without a deque.
 			///
-			std::mutex m_mutex;
+			std::unique_ptr<JobQueue> m_injected;
 
 			///
 			/// Control thread activity.
@@ -93,10 +218,112 @@ namespace galaxy
 			std::atomic<bool> m_running;
 
 			///
-			/// Max threads allocated.
+			/// Incremented to wake sleeping workers.
+			///
+			std::atomic<std::uint32_t> m_epoch;
+
+			///
+			/// Number of workers sleeping or about to sleep.
+			///
+			std::atomic<int> m_sleeping;
+
+			///
+			/// Number of worker threads.
 			///
 			unsigned int m_max_threads;
 		};
+
+		template<typename Lambda>
+		inline JobHandle ThreadPool::submit(Lambda&& func)
+		{
+			auto* job = make_job(std::forward<Lambda>(func), nullptr);
+
+			JobHandle handle {job};
+			schedule(job);
+
+			return handle;
+		}
+
+		template<typename Lambda>
+		inline JobHandle ThreadPool::submit(const JobHandle& parent, Lambda&& func)
+		{
+			auto* job = make_job(std::forward<Lambda>(func), parent.m_job);
+
+			JobHandle handle {job};
+			schedule(job);
+
+			return handle;
+		}
+
+		template<typename Lambda>
+		inline JobHandle ThreadPool::then(const JobHandle& job, Lambda&& func)
+		{
+			auto* next = make_job(std::forward<Lambda>(func), nullptr);
+			JobHandle handle {next};
+
+			auto* prev = job.m_job;
+			if (prev == nullptr)
+			{
+				schedule(next);
+			}
+			else
+			{
+				while (prev->m_lock.test_and_set(std::memory_order_acquire))
+				{
+				}
+
+				if (prev->m_done.load(std::memory_order_acquire))
+				{
+					prev->m_lock.clear(std::memory_order_release);
+					schedule(next);
+				}
+				else
+				{
+					prev->m_continuations.push_back(next);
+					prev->m_lock.clear(std::memory_order_release);
+				}
+			}
+
+			return handle;
+		}
+
+		template<typename Lambda>
+		inline void ThreadPool::parallel_for(const std::size_t begin, const std::size_t end, const std::size_t grain, Lambda&& func)
+		{
+			if (begin >= end)
+			{
+				return;
+			}
+
+			const auto chunk = std::max<std::size_t>(grain, 1);
+
+			// Recursively halve the range, handing the upper half to other threads.
+			// Capturing by reference is safe because this function does not return until every chunk is done.
+			JobHandle root;
+			std::function<void(std::size_t, std::size_t)> split = [&](std::size_t first, std::size_t last) {
+				while (last - first > chunk)
+				{
+					const auto mid = first + ((last - first) / 2);
+					submit(root, [&split, mid, last]() {
+						split(mid, last);
+					});
+
+					last = mid;
+				}
+
+				func(first, last);
+			};
+
+			auto* job = make_job(
+				[&]() {
+					split(begin, end);
+				},
+				nullptr);
+
+			root = JobHandle {job};
+			execute(job);
+			wait(root);
+		}
 	} // namespace async
 } // namespace galaxy
 
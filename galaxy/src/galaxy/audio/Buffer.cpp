@@ -5,8 +5,6 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
-#include <stb/stb_vorbis.h>
-
 #include "galaxy/core/ServiceLocator.hpp"
 #include "galaxy/error/ALError.hpp"
 #include "galaxy/error/Log.hpp"
@@ -86,63 +84,59 @@ namespace galaxy
 
 		const bool Buffer::internal_load(std::string_view file)
 		{
-			bool result     = true;
-			const auto path = SL_HANDLE.vfs()->absolute(file);
+			if (std::filesystem::path(file).extension() != ".ogg")
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Sound must be ogg vorbis and have extension of .ogg!");
+				return false;
+			}
+
+			std::optional<Samples> samples;
 
-			if (path == std::nullopt)
+			// Archived sounds are decoded straight from the mapping.
+			if (const auto packed = SL_HANDLE.vfs()->view(file))
 			{
-				GALAXY_LOG(GALAXY_ERROR, "Failed to find file to load into audio buffer: {0}.", file);
-				result = false;
+				samples = decode_vorbis(packed.value());
 			}
-			else
+			else if (const auto path = SL_HANDLE.vfs()->absolute(file))
 			{
-				const auto path_str = path.value();
-				if (std::filesystem::path(path_str).extension() != ".ogg")
-				{
-					GALAXY_LOG(GALAXY_ERROR, "Sound must be ogg vorbis and have extension of .ogg!");
-					result = false;
-				}
-				else
+				if (const auto data = SL_HANDLE.vfs()->open_binary(path.value()))
 				{
-					int channels = 0;
-					int samples  = 0;
-					short* data  = nullptr;
-
-					const auto length = stb_vorbis_decode_filename(path_str.c_str(), &channels, &samples, &data);
-					if (length < 1)
-					{
-						result = false;
-
-						// Make sure data is freed.
-						if (data != nullptr)
-						{
-							std::free(data);
-						}
-
-						if (length == -1)
-						{
-							GALAXY_LOG(GALAXY_ERROR, "Failed to open file with stb_vorbis.");
-						}
-						else if (length == -2)
-						{
-							GALAXY_LOG(GALAXY_ERROR, "Failed to parse with stb_vorbis.");
-						}
-						else
-						{
-							GALAXY_LOG(GALAXY_ERROR, "Failed due to unknown error. Error code returned: {0}.", length);
-						}
-					}
-					else
-					{
-						const auto format = (channels > 1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
-						alBufferData(m_buffer, format, data, channels * length * sizeof(short), samples);
-
-						std::free(data);
-					}
+					samples = decode_vorbis(data.value());
 				}
 			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to find file to load into audio buffer: {0}.", file);
+				return false;
+			}
+
+			if (samples == std::nullopt)
+			{
+				return false;
+			}
+
+			return internal_load(samples.value());
+		}
+
+		const bool Buffer::internal_load(const Samples& samples)
+		{
+			if (samples.m_data.empty())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Attempted to load empty samples into audio buffer.");
+				return false;
+			}
+
+			const auto format = (samples.m_channels > 1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+			alBufferData(m_buffer, format, samples.m_data.data(), static_cast<ALsizei>(samples.m_data.size() * sizeof(short)), samples.m_sample_rate);
+
+			const auto error = alGetError();
+			if (error != AL_NO_ERROR)
+			{
+				GALAXY_LOG(GALAXY_ERROR, error::al_parse_error("Unable to upload audio buffer.", error));
+				return false;
+			}
 
-			return result;
+			return true;
 		}
 	} // namespace audio
 } // namespace galaxy
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include "galaxy/audio/Samples.hpp"
+
 namespace galaxy
 {
 	namespace audio
@@ -82,6 +84,15 @@ namespace galaxy
 			///
 			[[maybe_unused]] const bool internal_load(std::string_view file);
 
+			///
+			/// Upload already decoded samples. Must be called on the thread with the OpenAL context.
+			///
+			/// \param samples Decoded samples, i.e. from res::Loader.
+			///
+			/// \return False if load failed.
+			///
+			[[maybe_unused]] const bool internal_load(const Samples& samples);
+
 		protected:
 			///
 			/// Handle to Buffer.
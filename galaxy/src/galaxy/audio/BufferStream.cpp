@@ -63,8 +63,9 @@ namespace galaxy
 
 		const bool BufferStream::internal_load(std::string_view file)
 		{
-			bool result     = true;
-			const auto path = SL_HANDLE.vfs()->absolute(file);
+			bool result       = true;
+			const auto packed = SL_HANDLE.vfs()->view(file);
+			const auto path   = packed ? std::make_optional(static_cast<std::string>(file)) : SL_HANDLE.vfs()->absolute(file);
 
 			if (path == std::nullopt)
 			{
@@ -81,7 +82,9 @@ namespace galaxy
 				}
 				else
 				{
-					m_stream = stb_vorbis_open_filename(path_str.c_str(), nullptr, nullptr);
+					// Archived music streams from the mapping, which outlives the stream.
+					m_stream = packed ? stb_vorbis_open_memory(reinterpret_cast<const unsigned char*>(packed->data()), static_cast<int>(packed->size()), nullptr, nullptr)
+									  : stb_vorbis_open_filename(path_str.c_str(), nullptr, nullptr);
 					if (!m_stream)
 					{
 						GALAXY_LOG(GALAXY_ERROR, "STB failed to load: {0}.", file);
@@ -0,0 +1,56 @@
+///
+/// Samples.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <cstdlib>
+
+#include <stb/stb_vorbis.h>
+
+#include "galaxy/error/Log.hpp"
+
+#include "Samples.hpp"
+
+namespace galaxy
+{
+	namespace audio
+	{
+		std::optional<Samples> decode_vorbis(std::span<const char> data)
+		{
+			Samples samples;
+			short* output = nullptr;
+
+			const auto length = stb_vorbis_decode_memory(reinterpret_cast<const unsigned char*>(data.data()), static_cast<int>(data.size()), &samples.m_channels, &samples.m_sample_rate, &output);
+			if (length < 1)
+			{
+				// Make sure data is freed.
+				if (output != nullptr)
+				{
+					std::free(output);
+				}
+
+				if (length == -1)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to open file with stb_vorbis.");
+				}
+				else if (length == -2)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to parse with stb_vorbis.");
+				}
+				else
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed due to unknown error. Error code returned: {0}.", length);
+				}
+
+				return std::nullopt;
+			}
+
+			samples.m_data.assign(output, output + static_cast<std::size_t>(length) * samples.m_channels);
+			std::free(output);
+
+			return std::make_optional(std::move(samples));
+		}
+	} // namespace audio
+} // namespace galaxy
\ No newline at end of file
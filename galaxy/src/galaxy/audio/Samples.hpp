@@ -0,0 +1,53 @@
+///
+/// Samples.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_AUDIO_SAMPLES_HPP_
+#define GALAXY_AUDIO_SAMPLES_HPP_
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace galaxy
+{
+	namespace audio
+	{
+		///
+		/// Decoded 16 bit PCM, ready to upload to a buffer.
+		///
+		struct Samples final
+		{
+			///
+			/// Interleaved samples.
+			///
+			std::vector<short> m_data;
+
+			///
+			/// Number of channels.
+			///
+			int m_channels = 0;
+
+			///
+			/// Samples per second.
+			///
+			int m_sample_rate = 0;
+		};
+
+		///
+		/// \brief Decode an ogg vorbis file.
+		///
+		/// Does not touch OpenAL, so it can run on any thread.
+		///
+		/// \param data Encoded ogg vorbis.
+		///
+		/// \return Decoded samples, or std::nullopt if stb_vorbis could not decode it.
+		///
+		[[nodiscard]] std::optional<Samples> decode_vorbis(std::span<const char> data);
+	} // namespace audio
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -61,6 +61,20 @@ namespace galaxy
 			return res;
 		}
 
+		const bool Sound::load(std::string_view file, const Samples& samples)
+		{
+			const auto res = internal_load(samples);
+			if (res)
+			{
+				m_filename = static_cast<std::string>(file);
+
+				set_max_distance(100.0f);
+				m_source.queue(this);
+			}
+
+			return res;
+		}
+
 		void Sound::set_looping(const bool looping)
 		{
 			alSourcei(m_source.handle(), AL_LOOPING, looping);
@@ -131,37 +145,57 @@ namespace galaxy
 			m_filename = json.at("file");
 			if (load(m_filename))
 			{
-				set_looping(json.at("looping"));
-				set_pitch(json.at("pitch"));
-				set_gain(json.at("gain"));
-				set_rolloff_factor(json.at("rolloff-factor"));
-				set_max_distance(json.at("max-distance"));
-
-				const auto& cone_json = json.at("cone");
-				set_cone(cone_json.at("outer-gain"), cone_json.at("inner-gain"), cone_json.at("inner-angle"));
-
-				const auto& pos_json = json.at("pos");
-				glm::vec3 pos        = {pos_json.at("x"), pos_json.at("y"), pos_json.at("z")};
-				set_position(pos);
-
-				const auto& vel_json = json.at("vel");
-				glm::vec3 vel        = {vel_json.at("x"), vel_json.at("y"), vel_json.at("z")};
-				set_velocity(vel);
-
-				const auto& dir_json = json.at("dir");
-				glm::vec3 dir        = {dir_json.at("x"), dir_json.at("y"), dir_json.at("z")};
-				set_direction(dir);
-
-				const bool is_playing = json.at("is-playing");
-				if (is_playing)
-				{
-					play();
-				}
+				configure(json);
 			}
 			else
 			{
 				GALAXY_LOG(GALAXY_ERROR, "Unable to load sound effect: {0}.", std::string {json.at("file")});
 			}
 		}
+
+		const bool Sound::deserialize(const nlohmann::json& json, const Samples& samples)
+		{
+			const std::string file = json.at("file");
+			if (load(file, samples))
+			{
+				configure(json);
+				return true;
+			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Unable to load sound effect: {0}.", file);
+				return false;
+			}
+		}
+
+		void Sound::configure(const nlohmann::json& json)
+		{
+			set_looping(json.at("looping"));
+			set_pitch(json.at("pitch"));
+			set_gain(json.at("gain"));
+			set_rolloff_factor(json.at("rolloff-factor"));
+			set_max_distance(json.at("max-distance"));
+
+			const auto& cone_json = json.at("cone");
+			set_cone(cone_json.at("outer-gain"), cone_json.at("inner-gain"), cone_json.at("inner-angle"));
+
+			const auto& pos_json = json.at("pos");
+			glm::vec3 pos        = {pos_json.at("x"), pos_json.at("y"), pos_json.at("z")};
+			set_position(pos);
+
+			const auto& vel_json = json.at("vel");
+			glm::vec3 vel        = {vel_json.at("x"), vel_json.at("y"), vel_json.at("z")};
+			set_velocity(vel);
+
+			const auto& dir_json = json.at("dir");
+			glm::vec3 dir        = {dir_json.at("x"), dir_json.at("y"), dir_json.at("z")};
+			set_direction(dir);
+
+			const bool is_playing = json.at("is-playing");
+			if (is_playing)
+			{
+				play();
+			}
+		}
 	} // namespace audio
 } // namespace galaxy
\ No newline at end of file
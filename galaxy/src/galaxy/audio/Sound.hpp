@@ -68,6 +68,16 @@ namespace galaxy
 			///
 			[[maybe_unused]] const bool load(std::string_view file);
 
+			///
+			/// Load already decoded samples.
+			///
+			/// \param file File the samples were decoded from.
+			/// \param samples Decoded samples, i.e. from res::Loader.
+			///
+			/// \return False if load failed.
+			///
+			[[maybe_unused]] const bool load(std::string_view file, const Samples& samples);
+
 			///
 			/// \brief Should the sound repeat upon reaching the end.
 			///
@@ -96,7 +106,24 @@ namespace galaxy
 			///
 			void deserialize(const nlohmann::json& json) override;
 
+			///
+			/// Deserializes from object, using already decoded samples instead of loading "file".
+			///
+			/// \param json Json object to retrieve data from.
+			/// \param samples Decoded samples, i.e. from res::Loader.
+			///
+			/// \return False if the samples could not be loaded.
+			///
+			[[maybe_unused]] const bool deserialize(const nlohmann::json& json, const Samples& samples);
+
 		private:
+			///
+			/// Set source properties from json.
+			///
+			/// \param json Json object to retrieve data from.
+			///
+			void configure(const nlohmann::json& json);
+
 			///
 			/// Move constructor.
 			///
@@ -81,7 +81,10 @@ namespace galaxy
 
 		public:
 			///
-			/// Script to be called when a collision occurs with this entity.
+			/// \brief Script to be called when a collision occurs with this entity.
+			///
+			/// Runs once per tick after the physics step, if any entity using it has a contact event. The global table
+			/// galaxy_collisions holds each event as {entity, other, phase}, with phase a gContactPhase.
 			///
 			std::string m_script;
 		};
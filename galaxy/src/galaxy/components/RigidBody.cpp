@@ -15,12 +15,12 @@ namespace galaxy
 	namespace components
 	{
 		RigidBody::RigidBody() noexcept
-		    : Serializable {this}, m_type {physics::BodyType::STATIC}
+		    : Serializable {this}, m_type {physics::BodyType::STATIC}, m_ccd {false}, m_velocity {0.0f, 0.0f}, m_mass {1.0f}, m_restitution {0.0f}
 		{
 		}
 
 		RigidBody::RigidBody(const nlohmann::json& json)
-		    : Serializable {this}, m_type {physics::BodyType::STATIC}
+		    : Serializable {this}, m_type {physics::BodyType::STATIC}, m_ccd {false}, m_velocity {0.0f, 0.0f}, m_mass {1.0f}, m_restitution {0.0f}
 		{
 			deserialize(json);
 		}
@@ -28,14 +28,22 @@ namespace galaxy
 		RigidBody::RigidBody(RigidBody&& rb) noexcept
 		    : Serializable {this}
 		{
-			this->m_type = rb.m_type;
+			this->m_type        = rb.m_type;
+			this->m_ccd         = rb.m_ccd;
+			this->m_velocity    = rb.m_velocity;
+			this->m_mass        = rb.m_mass;
+			this->m_restitution = rb.m_restitution;
 		}
 
 		RigidBody& RigidBody::operator=(RigidBody&& rb) noexcept
 		{
 			if (this != &rb)
 			{
-				this->m_type = rb.m_type;
+				this->m_type        = rb.m_type;
+				this->m_ccd         = rb.m_ccd;
+				this->m_velocity    = rb.m_velocity;
+				this->m_mass        = rb.m_mass;
+				this->m_restitution = rb.m_restitution;
 			}
 
 			return *this;
@@ -45,7 +53,12 @@ namespace galaxy
 		{
 			// clang-format off
 			nlohmann::json json = "{}"_json;
-			json["type"] = magic_enum::enum_name(m_type);
+			json["type"]        = magic_enum::enum_name(m_type);
+			json["ccd"]         = m_ccd;
+			json["velocity_x"]  = m_velocity.x;
+			json["velocity_y"]  = m_velocity.y;
+			json["mass"]        = m_mass;
+			json["restitution"] = m_restitution;
 			// clang-format on
 
 			return json;
@@ -53,7 +66,12 @@ namespace galaxy
 
 		void RigidBody::deserialize(const nlohmann::json& json)
 		{
-			m_type = magic_enum::enum_cast<physics::BodyType>(json.at("type").get<std::string>()).value();
+			m_type        = magic_enum::enum_cast<physics::BodyType>(json.at("type").get<std::string>()).value();
+			m_ccd         = json.value("ccd", false);
+			m_velocity.x  = json.value("velocity_x", 0.0f);
+			m_velocity.y  = json.value("velocity_y", 0.0f);
+			m_mass        = json.value("mass", 1.0f);
+			m_restitution = json.value("restitution", 0.0f);
 		}
 	} // namespace components
 } // namespace galaxy
\ No newline at end of file
@@ -8,6 +8,8 @@
 #ifndef GALAXY_COMPONENTS_RIGIDBODY_HPP_
 #define GALAXY_COMPONENTS_RIGIDBODY_HPP_
 
+#include <glm/vec2.hpp>
+
 #include "galaxy/fs/Serializable.hpp"
 #include "galaxy/physics/BodyType.hpp"
 
@@ -78,6 +80,29 @@ namespace galaxy
 			/// Body type.
 			///
 			physics::BodyType m_type;
+
+			///
+			/// \brief Continuous collision detection.
+			///
+			/// Dynamic bodies that move further than their own size in one tick are swept against static bodies,
+			/// so they stop at the first one they hit instead of passing through it.
+			///
+			bool m_ccd;
+
+			///
+			/// Velocity in pixels per second. Integrated and changed by collisions for dynamic bodies.
+			///
+			glm::vec2 m_velocity;
+
+			///
+			/// Mass. Heavier bodies are pushed less in collisions with other dynamic bodies.
+			///
+			float m_mass;
+
+			///
+			/// Bounciness, from 0 to 1.
+			///
+			float m_restitution;
 		};
 	} // namespace components
 } // namespace galaxy
@@ -119,8 +119,6 @@ namespace galaxy
 
 				m_width  = font_ptr->get_width(text);
 				m_height = font_ptr->get_height();
-
-				m_batch.buffer_data();
 			}
 			else
 			{
@@ -184,6 +182,11 @@ namespace galaxy
 			return m_batch.count();
 		}
 
+		const int Text::base_vertex() const noexcept
+		{
+			return m_batch.base_vertex();
+		}
+
 		const unsigned int Text::vao() const noexcept
 		{
 			return m_batch.vao();
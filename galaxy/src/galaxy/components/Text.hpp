@@ -154,6 +154,13 @@ namespace galaxy
 			///
 			[[nodiscard]] const int count() const noexcept;
 
+			///
+			/// Gets the base vertex to draw with.
+			///
+			/// \return Const int.
+			///
+			[[nodiscard]] const int base_vertex() const noexcept;
+
 			///
 			/// Get the GL VAO.
 			///
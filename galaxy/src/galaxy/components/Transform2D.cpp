@@ -7,8 +7,6 @@
 
 #include <algorithm>
 
-#include <glm/gtc/type_ptr.hpp>
-
 #include "Transform2D.hpp"
 
 namespace galaxy
@@ -16,12 +14,12 @@ namespace galaxy
 	namespace components
 	{
 		Transform2D::Transform2D() noexcept
-		    : Serializable {this}, m_dirty {true}, m_origin {0.0f, 0.0f}, m_translation {1.0f}, m_rotation {1.0f}, m_scale {1.0f}, m_pos {0.0f, 0.0f}, m_rotate {0.0f}, m_scale_factor {1.0f}, m_model {1.0f}
+		    : Serializable {this}, m_dirty {true}, m_origin {0.0f, 0.0f}, m_pos {0.0f, 0.0f}, m_rotate {0.0f}, m_scale_factor {1.0f}, m_affine {1.0f}
 		{
 		}
 
 		Transform2D::Transform2D(const nlohmann::json& json)
-		    : Serializable {this}, m_dirty {true}, m_origin {0.0f, 0.0f}, m_translation {1.0f}, m_rotation {1.0f}, m_scale {1.0f}, m_pos {0.0f, 0.0f}, m_rotate {0.0f}, m_scale_factor {1.0f}, m_model {1.0f}
+		    : Serializable {this}, m_dirty {true}, m_origin {0.0f, 0.0f}, m_pos {0.0f, 0.0f}, m_rotate {0.0f}, m_scale_factor {1.0f}, m_affine {1.0f}
 		{
 			deserialize(json);
 		}
@@ -30,14 +28,11 @@ namespace galaxy
 		    : Serializable {this}
 		{
 			this->m_dirty        = t.m_dirty;
-			this->m_model        = std::move(t.m_model);
+			this->m_affine       = std::move(t.m_affine);
 			this->m_origin       = std::move(t.m_origin);
 			this->m_pos          = std::move(t.m_pos);
 			this->m_rotate       = t.m_rotate;
-			this->m_rotation     = std::move(t.m_rotation);
-			this->m_scale        = std::move(t.m_scale);
 			this->m_scale_factor = t.m_scale_factor;
-			this->m_translation  = std::move(t.m_translation);
 		}
 
 		Transform2D& Transform2D::operator=(Transform2D&& t) noexcept
@@ -45,14 +40,11 @@ namespace galaxy
 			if (this != &t)
 			{
 				this->m_dirty        = t.m_dirty;
-				this->m_model        = std::move(t.m_model);
+				this->m_affine       = std::move(t.m_affine);
 				this->m_origin       = std::move(t.m_origin);
 				this->m_pos          = std::move(t.m_pos);
 				this->m_rotate       = t.m_rotate;
-				this->m_rotation     = std::move(t.m_rotation);
-				this->m_scale        = std::move(t.m_scale);
 				this->m_scale_factor = t.m_scale_factor;
-				this->m_translation  = std::move(t.m_translation);
 			}
 
 			return *this;
@@ -98,26 +90,11 @@ namespace galaxy
 			m_dirty = true;
 		}
 
-		void Transform2D::recalculate()
+		void Transform2D::recalculate_batch(std::span<Transform2D> transforms) noexcept
 		{
-			constexpr const auto identity_matrix = glm::mat4 {1.0f};
-
-			if (m_dirty)
+			for (auto& transform : transforms)
 			{
-				m_translation = glm::translate(identity_matrix, {m_pos.x, m_pos.y, 0.0f});
-
-				m_rotation = identity_matrix;
-				m_rotation = glm::translate(m_rotation, glm::vec3(m_origin, 0.0f));
-				m_rotation = glm::rotate(m_rotation, glm::radians(m_rotate), {0.0f, 0.0f, 1.0f});
-				m_rotation = glm::translate(m_rotation, -glm::vec3(m_origin, 0.0f));
-
-				m_scale = identity_matrix;
-				m_scale = glm::translate(m_scale, glm::vec3(m_origin, 0.0f));
-				m_scale = glm::scale(m_scale, {m_scale_factor, m_scale_factor, 1.0f});
-				m_scale = glm::translate(m_scale, -glm::vec3(m_origin, 0.0f));
-
-				m_model = m_translation * m_rotation * m_scale;
-				m_dirty = false;
+				transform.recalculate();
 			}
 		}
 
@@ -126,10 +103,22 @@ namespace galaxy
 			return m_dirty;
 		}
 
-		const glm::mat4& Transform2D::get_transform()
+		glm::mat4 Transform2D::get_transform() noexcept
+		{
+			recalculate();
+
+			glm::mat4 model {1.0f};
+			model[0] = {m_affine[0], 0.0f, 0.0f};
+			model[1] = {m_affine[1], 0.0f, 0.0f};
+			model[3] = {m_affine[2], 0.0f, 1.0f};
+
+			return model;
+		}
+
+		const glm::mat3x2& Transform2D::get_affine() noexcept
 		{
 			recalculate();
-			return m_model;
+			return m_affine;
 		}
 
 		const glm::vec2& Transform2D::get_pos() const noexcept
@@ -156,13 +145,10 @@ namespace galaxy
 		{
 			m_dirty        = true;
 			m_origin       = {0.0f, 0.0f};
-			m_translation  = glm::mat4 {1.0f};
-			m_rotation     = glm::mat4 {1.0f};
-			m_scale        = glm::mat4 {1.0f};
 			m_pos          = {0.0f, 0.0f};
 			m_rotate       = 0.0f;
 			m_scale_factor = 1.0f;
-			m_model        = glm::mat4 {1.0f};
+			m_affine       = glm::mat3x2 {1.0f};
 		}
 
 		nlohmann::json Transform2D::serialize()
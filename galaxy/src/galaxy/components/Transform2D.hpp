@@ -8,7 +8,11 @@
 #ifndef GALAXY_COMPONENTS_TRANSFORM2D_HPP_
 #define GALAXY_COMPONENTS_TRANSFORM2D_HPP_
 
+#include <cmath>
+#include <span>
+
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat3x2.hpp>
 
 #include "galaxy/fs/Serializable.hpp"
 #include "galaxy/meta/Concepts.hpp"
@@ -92,9 +96,19 @@ namespace galaxy
 			void set_origin(const float x, const float y) noexcept;
 
 			///
-			/// Recalculates the model view matrix.
+			/// Recalculates the cached affine transform, if dirty.
 			///
-			void recalculate();
+			void recalculate() noexcept;
+
+			///
+			/// \brief Recalculate every dirty transform in one pass.
+			///
+			/// Intended to be run over a contiguous component array once per frame, so later users
+			/// of the transform only read the cached affine.
+			///
+			/// \param transforms Transforms to update.
+			///
+			static void recalculate_batch(std::span<Transform2D> transforms) noexcept;
 
 			///
 			/// Get flag indicating if Transform2D needs to be applied before rendering.
@@ -104,11 +118,28 @@ namespace galaxy
 			[[nodiscard]] const bool is_dirty() const noexcept;
 
 			///
-			/// Retrieve internal transformation matrix.
+			/// Build a 4x4 transformation matrix, i.e. for a shader uniform.
+			///
+			/// \return Model matrix as glm::mat4.
+			///
+			[[nodiscard]] glm::mat4 get_transform() noexcept;
+
+			///
+			/// Retrieve cached 2D affine transform. Columns are x axis, y axis and translation.
 			///
-			/// \return Reference to internal glm::mat4.
+			/// \return Const reference to internal glm::mat3x2.
 			///
-			[[nodiscard]] const glm::mat4& get_transform();
+			[[nodiscard]] const glm::mat3x2& get_affine() noexcept;
+
+			///
+			/// Transform a point from local space to world space.
+			///
+			/// \param x Local x coord.
+			/// \param y Local y coord.
+			///
+			/// \return Transformed point.
+			///
+			[[nodiscard]] glm::vec2 transform_point(const float x, const float y) noexcept;
 
 			///
 			/// Get stored pos cache.
@@ -168,21 +199,6 @@ namespace galaxy
 			///
 			glm::vec2 m_origin;
 
-			///
-			/// Translation matrix.
-			///
-			glm::mat4 m_translation;
-
-			///
-			/// Rotational matrix.
-			///
-			glm::mat4 m_rotation;
-
-			///
-			/// Scale matrix.
-			///
-			glm::mat4 m_scale;
-
 			///
 			/// Cached for easy retrieval.
 			/// Pos.
@@ -202,9 +218,9 @@ namespace galaxy
 			float m_scale_factor;
 
 			///
-			/// Combined transformation matrix.
+			/// Combined 2D affine transformation.
 			///
-			glm::mat4 m_model;
+			glm::mat3x2 m_affine;
 
 		private:
 			///
@@ -217,6 +233,29 @@ namespace galaxy
 			///
 			Transform2D(const Transform2D&) = delete;
 		};
+
+		inline void Transform2D::recalculate() noexcept
+		{
+			if (m_dirty)
+			{
+				// Equivalent to translate(pos) * translate(origin) * rotate * scale * translate(-origin).
+				const auto radians = m_rotate * 0.017453292519943295f;
+				const auto cos     = std::cos(radians) * m_scale_factor;
+				const auto sin     = std::sin(radians) * m_scale_factor;
+
+				m_affine[0] = {cos, sin};
+				m_affine[1] = {-sin, cos};
+				m_affine[2] = {m_pos.x + m_origin.x - (cos * m_origin.x - sin * m_origin.y), m_pos.y + m_origin.y - (sin * m_origin.x + cos * m_origin.y)};
+
+				m_dirty = false;
+			}
+		}
+
+		inline glm::vec2 Transform2D::transform_point(const float x, const float y) noexcept
+		{
+			recalculate();
+			return {m_affine[0].x * x + m_affine[1].x * y + m_affine[2].x, m_affine[0].y * x + m_affine[1].y * y + m_affine[2].y};
+		}
 	} // namespace components
 } // namespace galaxy
 
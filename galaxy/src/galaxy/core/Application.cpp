@@ -173,6 +173,25 @@ namespace galaxy
 				m_langs->set_language("en_au");
 				SL_HANDLE.m_language = m_langs.get();
 
+				// Asset loader. Fonts, textures and sounds are decoded on the pool while the rest is set up.
+				m_loader           = std::make_unique<res::Loader>(m_pool.get(), m_vfs.get());
+				SL_HANDLE.m_loader = m_loader.get();
+
+				// FontBook.
+				m_fontbook = std::make_unique<res::FontBook>();
+				m_fontbook->create_from_json(m_config->get<std::string>("fontbook-json"), *m_loader);
+				SL_HANDLE.m_fontbook = m_fontbook.get();
+
+				// Texture Atlas.
+				m_texturebook = std::make_unique<res::TextureBook>();
+				m_texturebook->add_json(m_config->get<std::string>("texturebook-json"), *m_loader);
+				SL_HANDLE.m_texturebook = m_texturebook.get();
+
+				// SoundBook.
+				m_soundbook = std::make_unique<res::SoundBook>();
+				m_soundbook->create_from_json(m_config->get<std::string>("soundbook-json"), *m_loader);
+				SL_HANDLE.m_soundbook = m_soundbook.get();
+
 				// ShaderBook.
 				m_shaderbook           = std::make_unique<res::ShaderBook>(m_config->get<std::string>("shaderbook-json"));
 				SL_HANDLE.m_shaderbook = m_shaderbook.get();
@@ -181,25 +200,16 @@ namespace galaxy
 				m_scriptbook           = std::make_unique<res::ScriptBook>(m_config->get<std::string>("scriptbook-json"));
 				SL_HANDLE.m_scriptbook = m_scriptbook.get();
 
-				// FontBook.
-				m_fontbook           = std::make_unique<res::FontBook>(m_config->get<std::string>("fontbook-json"));
-				SL_HANDLE.m_fontbook = m_fontbook.get();
-
-				// Texture Atlas.
-				m_texturebook           = std::make_unique<res::TextureBook>(m_config->get<std::string>("texturebook-json"));
-				SL_HANDLE.m_texturebook = m_texturebook.get();
-
 				// Set up renderer.
 				RENDERER_2D().init(m_config->get<std::string>("renderlayers-json"));
 
-				// SoundBook.
-				m_soundbook           = std::make_unique<res::SoundBook>(m_config->get<std::string>("soundbook-json"));
-				SL_HANDLE.m_soundbook = m_soundbook.get();
-
 				// MusicBook.
 				m_musicbook           = std::make_unique<res::MusicBook>(m_config->get<std::string>("musicbook-json"));
 				SL_HANDLE.m_musicbook = m_musicbook.get();
 
+				// Layers expect every resource to be resident, so upload whatever is left.
+				m_loader->wait_all();
+
 				// Set up custom lua functions and types.
 				lua::register_functions();
 				lua::register_audio();
@@ -247,6 +257,7 @@ namespace galaxy
 
 			m_layers.clear();
 
+			m_loader.reset();
 			m_pool->finish();
 			m_window->destroy();
 
@@ -320,6 +331,9 @@ namespace galaxy
 					}
 				}
 
+				// Upload assets decoded since the last frame.
+				m_loader->poll();
+
 				m_layer_stack.top()->pre_render();
 
 				m_window->begin();
@@ -358,6 +372,9 @@ namespace galaxy
 			{
 				GALAXY_LOG(GALAXY_INFO, "Missing asset folder, creating at: {0}.", merged);
 				std::filesystem::create_directories(merged);
+
+				// No-op before the root is mounted, since mounting indexes everything.
+				m_vfs->index(merged);
 			}
 		}
 
@@ -451,6 +468,26 @@ namespace galaxy
 
 		void Application::reload_assets(efsw::WatchID watch_id, const std::string& dir, const std::string& filename, efsw::Action action, std::string old_filename)
 		{
+			const auto path = std::filesystem::path(dir) / filename;
+			switch (action)
+			{
+				case efsw::Actions::Add:
+					m_vfs->index(path);
+					break;
+
+				case efsw::Actions::Delete:
+					m_vfs->unindex(path);
+					break;
+
+				case efsw::Actions::Moved:
+					m_vfs->unindex(std::filesystem::path(dir) / old_filename);
+					m_vfs->index(path);
+					break;
+
+				default:
+					break;
+			}
+
 			m_window->request_attention();
 
 			if (dir.find("music") != std::string::npos)
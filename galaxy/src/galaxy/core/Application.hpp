@@ -21,6 +21,7 @@
 #include "galaxy/fs/FileSystem.hpp"
 #include "galaxy/resource/FontBook.hpp"
 #include "galaxy/resource/Language.hpp"
+#include "galaxy/resource/Loader.hpp"
 #include "galaxy/resource/MusicBook.hpp"
 #include "galaxy/resource/ScriptBook.hpp"
 #include "galaxy/resource/ShaderBook.hpp"
@@ -209,6 +210,11 @@ namespace galaxy
 			///
 			std::unique_ptr<async::ThreadPool> m_pool;
 
+			///
+			/// Background asset loader.
+			///
+			std::unique_ptr<res::Loader> m_loader;
+
 		private:
 			///
 			/// Filesystem watcher.
@@ -5,6 +5,8 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <magic_enum.hpp>
+
 #include "galaxy/core/ServiceLocator.hpp"
 #include "galaxy/core/Window.hpp"
 #include "galaxy/graphics/Renderer2D.hpp"
@@ -21,7 +23,7 @@ namespace galaxy
 	namespace core
 	{
 		Scene2D::Scene2D(std::string_view name) noexcept
-		    : Serializable {this}, m_name {""}, m_active_map {""}, m_maps_path {""}
+		    : Serializable {this}, m_name {""}, m_broadphase {physics::Broadphase::DYNAMIC_TREE}, m_active_map {""}, m_maps_path {""}
 		{
 			m_camera.create(0.0f, static_cast<float>(SL_HANDLE.window()->get_width()), static_cast<float>(SL_HANDLE.window()->get_height()), 0.0f);
 			m_camera.set_speed(100.0f);
@@ -31,6 +33,7 @@ namespace galaxy
 			m_dispatcher.subscribe<events::MouseWheel>(m_camera);
 			m_dispatcher.subscribe<events::WindowResized>(m_camera);
 
+			m_world.set_thread_pool(SL_HANDLE.pool());
 			m_world.create_system<systems::ParticleSystem>();
 			m_world.create_system<systems::AnimationSystem>();
 			m_world.create_system<systems::TransformSystem>();
@@ -130,6 +133,7 @@ namespace galaxy
 			json["world"]      = m_world.serialize();
 			json["active-map"] = m_active_map;
 			json["maps-path"]  = m_maps_path;
+			json["broadphase"] = magic_enum::enum_name(m_broadphase);
 			//json["theme"]  = m_gui_theme.serialize();
 			//json["gui"]    = m_gui.serialize();
 
@@ -145,6 +149,7 @@ namespace galaxy
 
 			m_active_map = json.at("active-map");
 			m_maps_path  = json.at("maps-path");
+			m_broadphase = magic_enum::enum_cast<physics::Broadphase>(json.value("broadphase", "DYNAMIC_TREE")).value_or(physics::Broadphase::DYNAMIC_TREE);
 
 			//m_gui_theme.deserialize(json.at("theme"));
 			//m_gui.set_theme(&m_gui_theme);
@@ -13,6 +13,7 @@
 #include "galaxy/fs/Serializable.hpp"
 #include "galaxy/graphics/Camera2D.hpp"
 #include "galaxy/map/TiledWorld.hpp"
+#include "galaxy/physics/Broadphase.hpp"
 
 namespace galaxy
 {
@@ -144,6 +145,11 @@ namespace galaxy
 			///
 			events::Dispatcher m_dispatcher;
 
+			///
+			/// Collision broadphase. Spatial hash cells are sized to the tiles of the active map.
+			///
+			physics::Broadphase m_broadphase;
+
 		private:
 			///
 			/// Tiled map world.
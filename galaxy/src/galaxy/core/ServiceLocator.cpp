@@ -82,8 +82,13 @@ namespace galaxy
 			return m_pool;
 		}
 
+		res::Loader* ServiceLocator::loader() const noexcept
+		{
+			return m_loader;
+		}
+
 		ServiceLocator::ServiceLocator() noexcept
-		    : m_restart {false}, m_config {nullptr}, m_window {nullptr}, m_lua {nullptr}, m_fontbook {nullptr}, m_shaderbook {nullptr}, m_soundbook {nullptr}, m_musicbook {nullptr}, m_texturebook {nullptr}, m_vfs {nullptr}, m_openal {nullptr}, m_scriptbook {nullptr}, m_language {nullptr}, m_pool {nullptr}
+		    : m_restart {false}, m_config {nullptr}, m_window {nullptr}, m_lua {nullptr}, m_fontbook {nullptr}, m_shaderbook {nullptr}, m_soundbook {nullptr}, m_musicbook {nullptr}, m_texturebook {nullptr}, m_vfs {nullptr}, m_openal {nullptr}, m_scriptbook {nullptr}, m_language {nullptr}, m_pool {nullptr}, m_loader {nullptr}
 		{
 		}
 	} // namespace core
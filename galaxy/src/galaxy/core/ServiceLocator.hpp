@@ -47,6 +47,7 @@ namespace galaxy
 		class MusicBook;
 		class ScriptBook;
 		class Language;
+		class Loader;
 	} // namespace res
 
 	namespace core
@@ -163,6 +164,13 @@ namespace galaxy
 			///
 			[[maybe_unused]] async::ThreadPool* pool() const noexcept;
 
+			///
+			/// Get asset Loader service.
+			///
+			/// \return Return pointer to Loader service.
+			///
+			[[maybe_unused]] res::Loader* loader() const noexcept;
+
 		public:
 			///
 			/// Restart flag.
@@ -260,6 +268,11 @@ namespace galaxy
 			/// ThreadPool service.
 			///
 			async::ThreadPool* m_pool;
+
+			///
+			/// Loader service.
+			///
+			res::Loader* m_loader;
 		};
 	} // namespace core
 } // namespace galaxy
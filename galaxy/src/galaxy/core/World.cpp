@@ -36,7 +36,7 @@ namespace galaxy
 	namespace core
 	{
 		World::World()
-		    : Serializable {this}, m_next_id {0}
+		    : Serializable {this}
 		{
 			register_component<components::Animated>("Animated");
 			register_component<components::BatchSprite>("BatchSprite");
@@ -58,29 +58,29 @@ namespace galaxy
 
 		void World::update(core::Scene2D* scene, const double dt)
 		{
-			for (const auto& pair : m_systems)
-			{
-				pair.second->update(scene, dt);
-			}
+			m_scheduler.execute(scene, dt);
 		}
 
 		const ecs::Entity World::create()
 		{
-			ecs::Entity entity = 0;
-			if (!m_invalid_entities.empty())
+			ecs::EntityIndex index = 0;
+			if (!m_free_slots.empty())
 			{
-				entity = m_invalid_entities[m_invalid_entities.size() - 1];
-				m_invalid_entities.pop_back();
+				index = m_free_slots.back();
+				m_free_slots.pop_back();
 			}
 			else
 			{
-				entity = m_next_id++;
+				index = static_cast<ecs::EntityIndex>(m_slots.size());
+				m_slots.emplace_back();
 			}
 
-			m_flags[entity] = {};
-			m_entities.emplace_back(entity);
-			m_flags[entity].set(flags::AllowSerialize::value);
+			auto& slot   = m_slots[index];
+			slot.m_alive = true;
+			slot.m_flags.reset();
+			slot.m_flags.set(flags::AllowSerialize::value);
 
+			const auto entity = ecs::make_entity(index, slot.m_version);
 			return entity;
 		}
 
@@ -138,33 +138,52 @@ namespace galaxy
 
 		void World::destroy(const ecs::Entity entity)
 		{
-			m_entities.erase(std::remove(m_entities.begin(), m_entities.end(), entity), m_entities.end());
-
-			for (const auto& ptr : m_data)
+			if (!has(entity))
 			{
-				ptr->remove(entity);
+				GALAXY_LOG(GALAXY_ERROR, "Failed to destroy entity: {0}. Entity does not exist.", entity);
+				return;
 			}
 
-			m_invalid_entities.push_back(entity);
-
-			for (auto it = m_debug_names.begin(); it != m_debug_names.end();)
 			{
-				if (it->second == entity)
+				std::lock_guard<std::mutex> lock {m_groups_mutex};
+				for (const auto& group : m_groups)
 				{
-					m_debug_names.erase(it++);
+					if (group)
+					{
+						group->remove(entity);
+					}
 				}
-				else
+			}
+
+			for (const auto& ptr : m_data)
+			{
+				if (ptr && ptr->has(entity))
 				{
-					it++;
+					ptr->remove(entity);
 				}
 			}
 
-			m_flags.erase(entity);
+			// Bump the version so handles to the destroyed entity stay invalid.
+			const auto index = ecs::entity_index(entity);
+			auto& slot       = m_slots[index];
+			slot.m_alive     = false;
+			slot.m_version++;
+			slot.m_flags.reset();
+
+			m_free_slots.push_back(index);
+			m_debug_names.erase(entity);
 		}
 
 		const bool World::has(const ecs::Entity entity) noexcept
 		{
-			return (std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end());
+			const auto index = ecs::entity_index(entity);
+			if (index < m_slots.size())
+			{
+				const auto& slot = m_slots[index];
+				return slot.m_alive && slot.m_version == ecs::entity_version(entity);
+			}
+
+			return false;
 		}
 
 		const bool World::is_enabled(const ecs::Entity entity)
@@ -182,13 +201,25 @@ namespace galaxy
 			unset_flag<flags::Enabled>(entity);
 		}
 
-		void World::clear()
+		void World::set_execution_mode(const ecs::ExecutionMode mode) noexcept
+		{
+			m_scheduler.set_mode(mode);
+		}
+
+		void World::set_thread_pool(async::ThreadPool* pool) noexcept
+		{
+			m_scheduler.set_pool(pool);
+		}
+
+		const ecs::SystemScheduler& World::get_scheduler() const noexcept
 		{
-			m_next_id = 0;
+			return m_scheduler;
+		}
 
-			m_entities.clear();
-			m_invalid_entities.clear();
-			m_flags.clear();
+		void World::clear()
+		{
+			m_slots.clear();
+			m_free_slots.clear();
 			m_debug_names.clear();
 
 			for (auto& ptr : m_data)
@@ -196,6 +227,54 @@ namespace galaxy
 				ptr.reset();
 			}
 			m_data.clear();
+
+			std::lock_guard<std::mutex> lock {m_groups_mutex};
+			for (auto& group : m_groups)
+			{
+				group.reset();
+			}
+			m_groups.clear();
+		}
+
+		void World::refresh_groups(const ecs::Entity entity)
+		{
+			const auto enabled = is_enabled(entity);
+
+			std::lock_guard<std::mutex> lock {m_groups_mutex};
+			for (const auto& group : m_groups)
+			{
+				if (group)
+				{
+					group->refresh(entity, enabled, m_data);
+				}
+			}
+		}
+
+		void World::refresh_groups(const ecs::Entity entity, const std::size_t type)
+		{
+			const auto enabled = is_enabled(entity);
+
+			std::lock_guard<std::mutex> lock {m_groups_mutex};
+			for (const auto& group : m_groups)
+			{
+				if (group && group->includes(type))
+				{
+					group->refresh(entity, enabled, m_data);
+				}
+			}
+		}
+
+		void World::rebuild_schedule()
+		{
+			std::vector<ecs::System*> systems;
+			systems.reserve(m_systems.size());
+
+			for (const auto& pair : m_systems)
+			{
+				systems.push_back(pair.second.get());
+			}
+
+			m_scheduler.build(std::move(systems));
 		}
 
 		nlohmann::json World::serialize()
@@ -203,8 +282,14 @@ namespace galaxy
 			nlohmann::json json = "{}"_json;
 
 			json["entities"] = nlohmann::json::array();
-			for (const auto& entity : m_entities)
+			for (std::size_t index = 0; index < m_slots.size(); index++)
 			{
+				if (!m_slots[index].m_alive)
+				{
+					continue;
+				}
+
+				const auto entity          = ecs::make_entity(static_cast<ecs::EntityIndex>(index), m_slots[index].m_version);
 				const auto allow_serialize = is_flag_set<flags::AllowSerialize>(entity);
 				if (allow_serialize)
 				{
@@ -10,10 +10,16 @@
 
 #include <bitset>
 #include <execution>
+#include <mutex>
 #include <optional>
 
+#include <robin_hood.h>
+
 #include "galaxy/ecs/ComponentSet.hpp"
+#include "galaxy/ecs/Group.hpp"
 #include "galaxy/ecs/System.hpp"
+#include "galaxy/ecs/SystemScheduler.hpp"
+#include "galaxy/flags/Enabled.hpp"
 #include "galaxy/fs/Serializable.hpp"
 #include "galaxy/graphics/Renderables.hpp"
 #include "galaxy/meta/UniqueID.hpp"
@@ -35,9 +41,9 @@ namespace galaxy
 		using SUniqueID = meta::UniqueID<struct SystemUniqueID>;
 
 		///
-		/// Container for retrieval of entities in operate() function.
+		/// Predefinition of unique id structure for component groups.
 		///
-		using EntitysWithCounters = robin_hood::unordered_map<ecs::Entity, int>;
+		using GUniqueID = meta::UniqueID<struct GroupUniqueID>;
 
 		///
 		/// Shorthand for component factory map.
@@ -57,6 +63,12 @@ namespace galaxy
 		class World final : public fs::Serializable
 		{
 		public:
+			///
+			/// Number of entities processed by each parallel operate() job.
+			/// Large enough that writes from neighbouring jobs rarely land in the same cache line.
+			///
+			inline static constexpr const std::size_t OPERATE_CHUNK_SIZE = 1024;
+
 			///
 			/// Constructor.
 			///
@@ -159,6 +171,16 @@ namespace galaxy
 			template<meta::is_class Component>
 			[[nodiscard]] Component* get(const ecs::Entity entity);
 
+			///
+			/// \brief Retrieve every component of a type, packed contiguously.
+			///
+			/// Includes components of disabled entities. Use for batch updates over a whole component type.
+			///
+			/// \return View of components. Invalidated when components of this type are created or removed.
+			///
+			template<meta::is_class Component>
+			[[nodiscard]] std::span<Component> get_components();
+
 			///
 			/// Remove a component assosiated with an entity.
 			/// Template type is type of component to remove.
@@ -247,6 +269,9 @@ namespace galaxy
 			/// \brief Iterate over a set of components of a set of types and manipulate their data.
 			///
 			/// The components to manipulate are specified in the template parameter.
+			/// If a thread pool has been set and the policy is not sequenced, entities are split into
+			/// chunks of OPERATE_CHUNK_SIZE that are processed on the pool. Do not create or destroy
+			/// entities or components from the callback when running in parallel.
 			///
 			/// \param policy STL exection policy. Beware that this may run on another thread.
 			/// \param func A lambda function that manipulates the components.
@@ -261,6 +286,26 @@ namespace galaxy
 			template<meta::is_class... Components, typename Policy, typename Lambda>
 			void operate(Policy&& policy, Lambda&& func);
 
+			///
+			/// \brief Iterate over a set of components in parallel chunks, giving each chunk its own result.
+			///
+			/// Avoids sharing state between threads. Runs on the calling thread if no thread pool is set.
+			/// Do not create or destroy entities or components from the callback.
+			///
+			/// \param func A lambda function that manipulates the components.
+			///		          For example:
+			/*
+								auto sums = manager.operate_chunked<int, a, b>([](int& sum, const ecs::Entity entity, a* ca, b* cb)
+								{
+									sum += ca->val;
+								});
+								*/
+			///
+			/// \return One default constructed then accumulated result per chunk.
+			///
+			template<typename Result, meta::is_class... Components, typename Lambda>
+			[[nodiscard]] std::vector<Result> operate_chunked(Lambda&& func);
+
 			///
 			/// Apply a function to each entity.
 			///
@@ -273,7 +318,8 @@ namespace galaxy
 			/// \brief Add a system to the manager.
 			///
 			/// Template parameter to speficy type of system to create.
-			/// Systems will be updated in the order in which they are created.
+			/// Systems that depend on each other are updated in the order in which they are created.
+			/// Independent systems may be updated concurrently, see set_execution_mode().
 			///
 			/// \param args Constructor arguments for the system.
 			///
@@ -288,6 +334,27 @@ namespace galaxy
 			template<is_system System>
 			[[nodiscard]] System* get_system();
 
+			///
+			/// Set how systems are updated. Use ExecutionMode::SINGLE_THREADED for deterministic debugging.
+			///
+			/// \param mode Execution mode.
+			///
+			void set_execution_mode(const ecs::ExecutionMode mode) noexcept;
+
+			///
+			/// Set the thread pool used to update systems in parallel.
+			///
+			/// \param pool Non-owning pointer to a thread pool. If null, systems are updated on the calling thread.
+			///
+			void set_thread_pool(async::ThreadPool* pool) noexcept;
+
+			///
+			/// Get the system scheduler.
+			///
+			/// \return Const reference to the scheduler.
+			///
+			[[nodiscard]] const ecs::SystemScheduler& get_scheduler() const noexcept;
+
 			///
 			/// Clear all entity data from world.
 			///
@@ -329,59 +396,149 @@ namespace galaxy
 			World& operator=(World&&) = delete;
 
 			///
-			/// Called by operate().
+			/// \brief Retrieve the group for a set of components, creating and populating it on first use.
+			///
+			/// Locked, since systems in the same stage can both reach here for the first time on different threads.
+			///
+			/// \return Reference to the group.
+			///
+			template<meta::is_class... Components>
+			[[nodiscard]] ecs::Group& get_group();
+
+			///
+			/// Retrieve a component that is known to exist. Used when iterating groups.
+			///
+			/// \param entity Entity component is assosiated with.
+			///
+			/// \return Pointer to component of type Component.
 			///
 			template<meta::is_class Component>
-			void internal_operate(EntitysWithCounters& entities, bool& terminate);
+			[[nodiscard]] Component* internal_get(const ecs::Entity entity);
 
-		private:
 			///
-			/// Counter for free entity ids.
+			/// Update group membership for an entity after its components or enabled state have changed.
+			///
+			/// \param entity Entity to refresh.
+			///
+			void refresh_groups(const ecs::Entity entity);
+
+			///
+			/// Update group membership for an entity after a component of a type has been added or removed.
+			///
+			/// \param entity Entity to refresh.
+			/// \param type Component type id that was changed.
+			///
+			void refresh_groups(const ecs::Entity entity, const std::size_t type);
+
+			///
+			/// Retrieve the flags of a live entity.
+			///
+			/// \param entity Entity to look up. Must be valid.
+			///
+			/// \return Reference to entity flag bitset.
+			///
+			[[nodiscard]] std::bitset<8>& internal_flags(const ecs::Entity entity) noexcept;
+
+			///
+			/// Call a function for a range of entities in a group.
+			///
+			/// \param entities Group entities.
+			/// \param begin First index.
+			/// \param end One past last index.
+			/// \param func Function to call with entity and components.
 			///
-			std::uint64_t m_next_id;
+			template<meta::is_class... Components, typename Lambda>
+			void operate_range(const std::vector<ecs::Entity>& entities, const std::size_t begin, const std::size_t end, Lambda&& func);
 
 			///
-			/// Stores entitys.
+			/// Rebuild system dependency graph after a system has been added.
+			///
+			void rebuild_schedule();
+
+		private:
+			///
+			/// Per-entity state, indexed by entity index.
 			///
-			std::vector<ecs::Entity> m_entities;
+			struct EntitySlot final
+			{
+				///
+				/// Current version of the entity occupying this slot.
+				///
+				ecs::EntityVersion m_version = 0;
+
+				///
+				/// Is the slot currently occupied.
+				///
+				bool m_alive = false;
+
+				///
+				/// Entity flags.
+				///
+				std::bitset<8> m_flags;
+			};
 
 			///
-			/// Stores invalid entities.
+			/// Entity slot table.
 			///
-			std::vector<ecs::Entity> m_invalid_entities;
+			std::vector<EntitySlot> m_slots;
 
 			///
-			/// Stores entity flags.
+			/// Free slot indexes to be recycled.
 			///
-			robin_hood::unordered_flat_map<ecs::Entity, std::bitset<8>> m_flags;
+			std::vector<ecs::EntityIndex> m_free_slots;
 
 			///
 			/// Debug entity names.
 			///
-			robin_hood::unordered_flat_map<std::string, ecs::Entity> m_debug_names;
+			robin_hood::unordered_flat_map<ecs::Entity, std::string> m_debug_names;
 
 			///
 			/// Stores polymorphic ComponentSets.
 			///
 			std::vector<std::unique_ptr<ecs::Set>> m_data;
 
+			///
+			/// Persistent component groups used by operate().
+			///
+			std::vector<std::unique_ptr<ecs::Group>> m_groups;
+
+			///
+			/// Guards m_groups, which operate() can grow from any thread of a parallel stage.
+			///
+			std::mutex m_groups_mutex;
+
 			///
 			/// Stores systems.
 			///
 			std::vector<std::pair<std::size_t, std::unique_ptr<ecs::System>>> m_systems;
 
+			///
+			/// Decides which systems can be updated concurrently.
+			///
+			ecs::SystemScheduler m_scheduler;
+
 			///
 			/// Used to allow for component creation without having to know the compile time type.
 			///
 			ComponentFactory m_component_factory;
 		};
 
+		inline std::bitset<8>& World::internal_flags(const ecs::Entity entity) noexcept
+		{
+			return m_slots[ecs::entity_index(entity)].m_flags;
+		}
+
 		template<meta::is_bitset_flag Flag>
 		inline void World::set_flag(const ecs::Entity entity)
 		{
 			if (has(entity))
 			{
-				m_flags[entity].set(Flag::value);
+				internal_flags(entity).set(Flag::value);
+
+				if constexpr (Flag::value == flags::Enabled::value)
+				{
+					refresh_groups(entity);
+				}
 			}
 			else
 			{
@@ -394,7 +551,7 @@ namespace galaxy
 		{
 			if (has(entity))
 			{
-				return m_flags[entity].test(Flag::value);
+				return internal_flags(entity).test(Flag::value);
 			}
 			else
 			{
@@ -408,7 +565,12 @@ namespace galaxy
 		{
 			if (has(entity))
 			{
-				m_flags[entity].reset(Flag::value);
+				internal_flags(entity).reset(Flag::value);
+
+				if constexpr (Flag::value == flags::Enabled::value)
+				{
+					refresh_groups(entity);
+				}
 			}
 			else
 			{
@@ -459,7 +621,10 @@ namespace galaxy
 					{
 						if (!derived->has(entity))
 						{
-							return derived->create(entity, std::forward<Args>(args)...);
+							auto* component = derived->create(entity, std::forward<Args>(args)...);
+							refresh_groups(entity, type);
+
+							return component;
 						}
 						else
 						{
@@ -510,6 +675,18 @@ namespace galaxy
 			return res;
 		}
 
+		template<meta::is_class Component>
+		inline std::span<Component> World::get_components()
+		{
+			const auto type = CUniqueID::get<Component>();
+			if (type < m_data.size() && m_data[type] != nullptr)
+			{
+				return static_cast<ecs::ComponentSet<Component>*>(m_data[type].get())->get_components();
+			}
+
+			return {};
+		}
+
 		template<meta::is_class Component>
 		inline void World::remove(const ecs::Entity entity)
 		{
@@ -531,6 +708,8 @@ namespace galaxy
 					{
 						auto* derived = static_cast<ecs::ComponentSet<Component>*>(m_data[type].get());
 						derived->remove(entity);
+
+						refresh_groups(entity, type);
 					}
 				}
 			}
@@ -563,24 +742,15 @@ namespace galaxy
 		{
 			if (!m_data.empty())
 			{
-				constexpr const auto length = sizeof...(Components);
-				EntitysWithCounters entities;
+				const auto& entities = get_group<Components...>().get_entities();
 
-				bool error = false;
-				(internal_operate<Components>(entities, error), ...);
-
-				if (!error)
+				// Walk backwards so the callback can safely remove the current entity from the group.
+				for (auto index = entities.size(); index > 0; index--)
 				{
-					for (const auto& [entity, count] : entities)
+					if (index <= entities.size())
 					{
-						// Ensures that only entities that have all components are used.
-						if (!(count < length))
-						{
-							if (is_enabled(entity))
-							{
-								func(entity, get<Components>(entity)...);
-							}
-						}
+						const auto entity = entities[index - 1];
+						func(entity, internal_get<Components>(entity)...);
 					}
 				}
 			}
@@ -591,36 +761,99 @@ namespace galaxy
 		{
 			if (!m_data.empty())
 			{
-				constexpr const auto length = sizeof...(Components);
-				EntitysWithCounters entities;
-
-				bool error = false;
-				(internal_operate<Components>(entities, error), ...);
+				const auto& entities = get_group<Components...>().get_entities();
+				auto* pool           = m_scheduler.get_pool();
 
-				if (!error)
+				if constexpr (std::is_same_v<std::remove_cvref_t<Policy>, std::execution::sequenced_policy>)
 				{
-					// pair.first = entity
-					// pair.second = count
-					std::for_each(policy, entities.begin(), entities.end(), [&](const auto& pair) {
-						// Ensures that only entities that have all components are used.
-						if (!(pair.second < length))
+					operate_range<Components...>(entities, 0, entities.size(), func);
+				}
+				else if (pool != nullptr)
+				{
+					const auto chunks = (entities.size() + OPERATE_CHUNK_SIZE - 1) / OPERATE_CHUNK_SIZE;
+					pool->parallel_for(0, chunks, 1, [&](const std::size_t first, const std::size_t last) {
+						for (auto chunk = first; chunk < last; chunk++)
 						{
-							if (is_enabled(pair.first))
-							{
-								func(pair.first, get<Components>(pair.first)...);
-							}
+							const auto begin = chunk * OPERATE_CHUNK_SIZE;
+							operate_range<Components...>(entities, begin, std::min(begin + OPERATE_CHUNK_SIZE, entities.size()), func);
 						}
 					});
 				}
+				else
+				{
+					std::for_each(policy, entities.begin(), entities.end(), [&](const ecs::Entity entity) {
+						func(entity, internal_get<Components>(entity)...);
+					});
+				}
+			}
+		}
+
+		template<typename Result, meta::is_class... Components, typename Lambda>
+		inline std::vector<Result> World::operate_chunked(Lambda&& func)
+		{
+			std::vector<Result> results;
+
+			if (!m_data.empty())
+			{
+				const auto& entities = get_group<Components...>().get_entities();
+				const auto chunks    = (entities.size() + OPERATE_CHUNK_SIZE - 1) / OPERATE_CHUNK_SIZE;
+				results.resize(chunks);
+
+				const auto process = [&](const std::size_t first, const std::size_t last) {
+					for (auto chunk = first; chunk < last; chunk++)
+					{
+						const auto begin = chunk * OPERATE_CHUNK_SIZE;
+						auto& result     = results[chunk];
+
+						operate_range<Components...>(entities, begin, std::min(begin + OPERATE_CHUNK_SIZE, entities.size()), [&](const ecs::Entity entity, Components*... components) {
+							func(result, entity, components...);
+						});
+					}
+				};
+
+				auto* pool = m_scheduler.get_pool();
+				if (pool != nullptr)
+				{
+					pool->parallel_for(0, chunks, 1, process);
+				}
+				else
+				{
+					process(0, chunks);
+				}
+			}
+
+			return results;
+		}
+
+		template<meta::is_class... Components, typename Lambda>
+		inline void World::operate_range(const std::vector<ecs::Entity>& entities, const std::size_t begin, const std::size_t end, Lambda&& func)
+		{
+			// Sets may not exist yet for types that have never been added, in which case the group is empty anyway.
+			if (begin >= end)
+			{
+				return;
+			}
+
+			// Look up each set once per range rather than once per entity.
+			const auto sets = std::make_tuple(static_cast<ecs::ComponentSet<Components>*>(m_data[CUniqueID::get<Components>()].get())...);
+
+			for (auto index = begin; index < end; index++)
+			{
+				const auto entity = entities[index];
+				func(entity, std::get<ecs::ComponentSet<Components>*>(sets)->get(entity)...);
 			}
 		}
 
 		template<typename Lambda>
 		inline void World::each(Lambda&& func) const
 		{
-			for (const auto& entity : m_entities)
+			for (std::size_t index = 0; index < m_slots.size(); index++)
 			{
-				func(entity);
+				const auto& slot = m_slots[index];
+				if (slot.m_alive)
+				{
+					func(ecs::make_entity(static_cast<ecs::EntityIndex>(index), slot.m_version));
+				}
 			}
 		}
 
@@ -629,6 +862,8 @@ namespace galaxy
 		{
 			const auto type = SUniqueID::get<System>();
 			m_systems.emplace_back(std::make_pair(type, std::make_unique<System>(std::forward<Args>(args)...)));
+
+			rebuild_schedule();
 		}
 
 		template<is_system System>
@@ -651,28 +886,40 @@ namespace galaxy
 			}
 		}
 
-		template<meta::is_class Component>
-		inline void World::internal_operate(EntitysWithCounters& entities, bool& terminate)
+		template<meta::is_class... Components>
+		inline ecs::Group& World::get_group()
 		{
-			if (!terminate)
+			const auto type = GUniqueID::get<std::tuple<Components...>>();
+
+			std::lock_guard<std::mutex> lock {m_groups_mutex};
+			if (type >= m_groups.size())
 			{
-				const auto type = CUniqueID::get<Component>();
-				if (type >= m_data.size())
-				{
-					terminate = true;
-				}
-				else
+				m_groups.resize(type + 1);
+			}
+
+			if (!m_groups[type])
+			{
+				m_groups[type] = std::make_unique<ecs::Group>(std::vector<std::size_t> {CUniqueID::get<Components>()...});
+
+				// Populate from existing entities, only done once per group.
+				for (std::size_t index = 0; index < m_slots.size(); index++)
 				{
-					auto ptr = m_data[type].get();
-					if (ptr != nullptr)
+					const auto& slot = m_slots[index];
+					if (slot.m_alive)
 					{
-						for (const auto& entity : ptr->m_entities)
-						{
-							entities[entity]++;
-						}
+						const auto entity = ecs::make_entity(static_cast<ecs::EntityIndex>(index), slot.m_version);
+						m_groups[type]->refresh(entity, slot.m_flags.test(flags::Enabled::value), m_data);
 					}
 				}
 			}
+
+			return *m_groups[type];
+		}
+
+		template<meta::is_class Component>
+		inline Component* World::internal_get(const ecs::Entity entity)
+		{
+			return static_cast<ecs::ComponentSet<Component>*>(m_data[CUniqueID::get<Component>()].get())->get(entity);
 		}
 	} // namespace core
 } // namespace galaxy
@@ -8,6 +8,8 @@
 #ifndef GALAXY_ECS_COMPONENTSET_HPP_
 #define GALAXY_ECS_COMPONENTSET_HPP_
 
+#include <span>
+
 #include "galaxy/error/Log.hpp"
 #include "galaxy/ecs/Set.hpp"
 #include "galaxy/meta/Concepts.hpp"
@@ -82,9 +84,9 @@ namespace galaxy
 			///
 			/// Retrieve internal component array.
 			///
-			/// \return Const reference to a std::vector.
+			/// \return View of packed components. Invalidated when components are created or removed.
 			///
-			[[nodiscard]] const std::vector<Component>& get_components() noexcept;
+			[[nodiscard]] std::span<Component> get_components() noexcept;
 
 		private:
 			///
@@ -130,20 +132,21 @@ namespace galaxy
 		template<typename... Args>
 		inline Component* ComponentSet<Component>::create(const Entity entity, Args&&... args)
 		{
+			m_sparse.set(entity, m_entities.size());
+
 			m_entities.push_back(entity);
 			m_components.emplace_back(std::forward<Args>(args)...);
 
-			m_keymap[entity] = m_count++;
-
 			return &m_components.back();
 		}
 
 		template<meta::is_class Component>
 		inline Component* ComponentSet<Component>::get(const Entity entity)
 		{
-			if (m_keymap.contains(entity))
+			const auto pos = find(entity);
+			if (pos != SparseArray::null)
 			{
-				return &m_components[m_keymap[entity]];
+				return &m_components[pos];
 			}
 			else
 			{
@@ -155,24 +158,22 @@ namespace galaxy
 		template<meta::is_class Component>
 		inline void ComponentSet<Component>::remove(const Entity entity)
 		{
-			if (m_keymap.contains(entity))
+			const auto pos = find(entity);
+			if (pos != SparseArray::null)
 			{
-				const auto end = m_components.size() - 1;
+				// Swap the last element into the removed slot to keep the arrays packed.
+				const auto end = m_entities.size() - 1;
+				if (pos != end)
+				{
+					m_components[pos] = std::move(m_components[end]);
+					m_entities[pos]   = m_entities[end];
 
-				auto temp_comp = std::move(m_components[end]);
-				auto temp_ent  = m_entities[end];
-
-				m_components[end] = std::move(m_components[m_keymap[entity]]);
-				m_entities[end]   = m_entities[m_keymap[entity]];
-
-				m_components[m_keymap[entity]] = std::move(temp_comp);
-				m_entities[m_keymap[entity]]   = temp_ent;
-				m_keymap[temp_ent]             = m_keymap[entity];
+					m_sparse.set(m_entities[pos], pos);
+				}
 
 				m_components.pop_back();
 				m_entities.pop_back();
-				m_keymap.erase(entity);
-				m_count--;
+				m_sparse.erase(entity);
 			}
 			else
 			{
@@ -185,9 +186,7 @@ namespace galaxy
 		{
 			m_components.clear();
 			m_entities.clear();
-			m_keymap.clear();
-
-			m_count = 0;
+			m_sparse.clear();
 		}
 
 		template<meta::is_class Component>
@@ -197,7 +196,7 @@ namespace galaxy
 		}
 
 		template<meta::is_class Component>
-		inline const std::vector<Component>& ComponentSet<Component>::get_components() noexcept
+		inline std::span<Component> ComponentSet<Component>::get_components() noexcept
 		{
 			return m_components;
 		}
@@ -15,9 +15,59 @@ namespace galaxy
 	namespace ecs
 	{
 		///
-		/// Entity typedef.
+		/// \brief Entity typedef.
+		///
+		/// Lower 32 bits are the index of the entity, upper 32 bits are the version.
+		/// The version is incremented every time an index is recycled, so stale handles never alias a new entity.
 		///
 		using Entity = std::uint64_t;
+
+		///
+		/// Entity index typedef.
+		///
+		using EntityIndex = std::uint32_t;
+
+		///
+		/// Entity version typedef.
+		///
+		using EntityVersion = std::uint32_t;
+
+		///
+		/// Construct an entity handle.
+		///
+		/// \param index Index part of the entity.
+		/// \param version Version part of the entity.
+		///
+		/// \return Combined entity handle.
+		///
+		[[nodiscard]] inline constexpr Entity make_entity(const EntityIndex index, const EntityVersion version) noexcept
+		{
+			return (static_cast<Entity>(version) << 32) | static_cast<Entity>(index);
+		}
+
+		///
+		/// Get the index part of an entity.
+		///
+		/// \param entity Entity handle.
+		///
+		/// \return Index of entity.
+		///
+		[[nodiscard]] inline constexpr EntityIndex entity_index(const Entity entity) noexcept
+		{
+			return static_cast<EntityIndex>(entity & 0xFFFFFFFF);
+		}
+
+		///
+		/// Get the version part of an entity.
+		///
+		/// \param entity Entity handle.
+		///
+		/// \return Version of entity.
+		///
+		[[nodiscard]] inline constexpr EntityVersion entity_version(const Entity entity) noexcept
+		{
+			return static_cast<EntityVersion>(entity >> 32);
+		}
 	} // namespace ecs
 } // namespace galaxy
 
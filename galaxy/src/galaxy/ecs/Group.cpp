@@ -0,0 +1,97 @@
+///
+/// Group.cpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#include <algorithm>
+
+#include "Group.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		Group::Group(std::vector<std::size_t>&& types) noexcept
+		    : m_types {std::move(types)}
+		{
+		}
+
+		Group::~Group() noexcept
+		{
+			clear();
+		}
+
+		void Group::refresh(const Entity entity, const bool enabled, const std::vector<std::unique_ptr<Set>>& sets)
+		{
+			bool matches = enabled;
+			if (matches)
+			{
+				for (const auto type : m_types)
+				{
+					if (type >= sets.size() || sets[type] == nullptr || !sets[type]->has(entity))
+					{
+						matches = false;
+						break;
+					}
+				}
+			}
+
+			if (matches)
+			{
+				if (!has(entity))
+				{
+					m_sparse.set(entity, m_entities.size());
+					m_entities.push_back(entity);
+				}
+			}
+			else
+			{
+				remove(entity);
+			}
+		}
+
+		void Group::remove(const Entity entity)
+		{
+			if (has(entity))
+			{
+				const auto index = m_sparse.get(entity);
+				const auto last  = m_entities.back();
+
+				m_entities[index] = last;
+				m_sparse.set(last, index);
+
+				m_entities.pop_back();
+				m_sparse.erase(entity);
+			}
+		}
+
+		void Group::clear()
+		{
+			m_entities.clear();
+			m_sparse.clear();
+		}
+
+		const bool Group::includes(const std::size_t type) const noexcept
+		{
+			return std::find(m_types.begin(), m_types.end(), type) != m_types.end();
+		}
+
+		const bool Group::has(const Entity entity) const noexcept
+		{
+			const auto pos = m_sparse.get(entity);
+			return pos != SparseArray::null && m_entities[pos] == entity;
+		}
+
+		const unsigned int Group::get_size() const noexcept
+		{
+			return static_cast<unsigned int>(m_entities.size());
+		}
+
+		const std::vector<Entity>& Group::get_entities() const noexcept
+		{
+			return m_entities;
+		}
+	} // namespace ecs
+} // namespace galaxy
\ No newline at end of file
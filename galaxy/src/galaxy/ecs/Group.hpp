@@ -0,0 +1,147 @@
+///
+/// Group.hpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#ifndef GALAXY_ECS_GROUP_HPP_
+#define GALAXY_ECS_GROUP_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "galaxy/ecs/Set.hpp"
+
+namespace galaxy
+{
+	namespace core
+	{
+		class World;
+	} // namespace core
+
+	namespace ecs
+	{
+		///
+		/// \brief Persistent, non-owning view of every enabled entity that has a specific set of components.
+		///
+		/// Membership is updated incrementally by the world when components are created or removed,
+		/// or when an entity is enabled, disabled or destroyed. Iterating a group is a linear walk
+		/// over a packed array of entities.
+		///
+		class Group final
+		{
+			friend class core::World;
+
+		public:
+			///
+			/// Argument constructor.
+			///
+			/// \param types Component type ids an entity must have to be part of this group.
+			///
+			Group(std::vector<std::size_t>&& types) noexcept;
+
+			///
+			/// Destructor.
+			///
+			~Group() noexcept;
+
+			///
+			/// Update the membership of an entity.
+			///
+			/// \param entity Entity to check.
+			/// \param enabled Is the entity currently enabled.
+			/// \param sets Component sets to check against, indexed by component type id.
+			///
+			void refresh(const Entity entity, const bool enabled, const std::vector<std::unique_ptr<Set>>& sets);
+
+			///
+			/// Remove an entity from the group, if present.
+			///
+			/// \param entity Entity to remove.
+			///
+			void remove(const Entity entity);
+
+			///
+			/// Erase all entities in group.
+			///
+			void clear();
+
+			///
+			/// Check if group depends on a component type.
+			///
+			/// \param type Component type id.
+			///
+			/// \return True if the component is part of the group.
+			///
+			[[nodiscard]] const bool includes(const std::size_t type) const noexcept;
+
+			///
+			/// Check if an entity is part of this group.
+			///
+			/// \param entity Entity to check.
+			///
+			/// \return True if the entity is part of the group.
+			///
+			[[nodiscard]] const bool has(const Entity entity) const noexcept;
+
+			///
+			/// Get size of group.
+			///
+			/// \return Const unsigned int.
+			///
+			[[nodiscard]] const unsigned int get_size() const noexcept;
+
+			///
+			/// Retrieve packed entity array.
+			///
+			/// \return Const reference to a std::vector.
+			///
+			[[nodiscard]] const std::vector<Entity>& get_entities() const noexcept;
+
+		private:
+			///
+			/// Constructor.
+			///
+			Group() = delete;
+
+			///
+			/// Copy constructor.
+			///
+			Group(const Group&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			Group(Group&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			Group& operator=(const Group&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			Group& operator=(Group&&) = delete;
+
+		private:
+			///
+			/// Component type ids that make up this group.
+			///
+			std::vector<std::size_t> m_types;
+
+			///
+			/// Packed array of entities in this group.
+			///
+			std::vector<Entity> m_entities;
+
+			///
+			/// Keeps track of entity position using entity index as key.
+			///
+			SparseArray m_sparse;
+		};
+	} // namespace ecs
+} // namespace galaxy
+
+#endif
\ No newline at end of file
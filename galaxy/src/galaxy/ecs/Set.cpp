@@ -11,13 +11,12 @@ namespace galaxy
 {
 	namespace ecs
 	{
-		const bool Set::has(const Entity entity) noexcept
+		const bool Set::has(const Entity entity) const noexcept
 		{
-			return (std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end());
+			return find(entity) != SparseArray::null;
 		}
 
 		Set::Set() noexcept
-		    : m_count {0}
 		{
 		}
 	} // namespace ecs
@@ -10,9 +10,8 @@
 
 #include <vector>
 
-#include <robin_hood.h>
-
 #include "galaxy/ecs/Entity.hpp"
+#include "galaxy/ecs/SparseArray.hpp"
 
 namespace galaxy
 {
@@ -43,7 +42,7 @@ namespace galaxy
 			///
 			/// \return Const boolean. True if entity is found.
 			///
-			[[nodiscard]] const bool has(const Entity entity) noexcept;
+			[[nodiscard]] const bool has(const Entity entity) const noexcept;
 
 			///
 			/// Remove the entity and its assossiated component.
@@ -70,21 +69,25 @@ namespace galaxy
 			///
 			Set() noexcept;
 
-		protected:
 			///
-			/// Keeps track of entity positions in vector.
+			/// Find the position of an entity in the packed arrays.
+			///
+			/// \param entity Entity to find.
+			///
+			/// \return Position of entity, or SparseArray::null if the entity (or that version of it) is not in the set.
 			///
-			std::size_t m_count;
+			[[nodiscard]] const std::uint32_t find(const Entity entity) const noexcept;
 
+		protected:
 			///
 			/// Entitys that have this component.
 			///
 			std::vector<Entity> m_entities;
 
 			///
-			/// Keeps track of entity position using entity as key.
+			/// Keeps track of entity position using entity index as key.
 			///
-			robin_hood::unordered_flat_map<Entity, std::size_t> m_keymap;
+			SparseArray m_sparse;
 
 		private:
 			///
@@ -107,6 +110,17 @@ namespace galaxy
 			///
 			Set& operator=(Set&&) = delete;
 		};
+
+		inline const std::uint32_t Set::find(const Entity entity) const noexcept
+		{
+			const auto pos = m_sparse.get(entity);
+			if (pos != SparseArray::null && m_entities[pos] == entity)
+			{
+				return pos;
+			}
+
+			return SparseArray::null;
+		}
 	} // namespace ecs
 } // namespace galaxy
 
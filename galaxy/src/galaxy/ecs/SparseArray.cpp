@@ -0,0 +1,49 @@
+///
+/// SparseArray.cpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#include "SparseArray.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		void SparseArray::set(const Entity entity, const std::size_t position)
+		{
+			const auto index = entity_index(entity);
+			const auto page  = index / PAGE_SIZE;
+
+			if (page >= m_pages.size())
+			{
+				m_pages.resize(page + 1);
+			}
+
+			if (m_pages[page] == nullptr)
+			{
+				m_pages[page] = std::make_unique<Page>();
+				m_pages[page]->fill(null);
+			}
+
+			(*m_pages[page])[index % PAGE_SIZE] = static_cast<std::uint32_t>(position);
+		}
+
+		void SparseArray::erase(const Entity entity) noexcept
+		{
+			const auto index = entity_index(entity);
+			const auto page  = index / PAGE_SIZE;
+
+			if (page < m_pages.size() && m_pages[page] != nullptr)
+			{
+				(*m_pages[page])[index % PAGE_SIZE] = null;
+			}
+		}
+
+		void SparseArray::clear() noexcept
+		{
+			m_pages.clear();
+		}
+	} // namespace ecs
+} // namespace galaxy
\ No newline at end of file
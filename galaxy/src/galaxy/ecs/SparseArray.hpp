@@ -0,0 +1,128 @@
+///
+/// SparseArray.hpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#ifndef GALAXY_ECS_SPARSEARRAY_HPP_
+#define GALAXY_ECS_SPARSEARRAY_HPP_
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "galaxy/ecs/Entity.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		///
+		/// \brief Paged array mapping an entity index to a position in a packed array.
+		///
+		/// Pages are only allocated when an entity index inside them is used,
+		/// so memory is proportional to the range of live indices rather than the highest index.
+		///
+		class SparseArray final
+		{
+		public:
+			///
+			/// Number of entries in a page.
+			///
+			inline static constexpr const std::size_t PAGE_SIZE = 4096;
+
+			///
+			/// Value returned when an entity has no position.
+			///
+			inline static constexpr const std::uint32_t null = std::numeric_limits<std::uint32_t>::max();
+
+			///
+			/// Constructor.
+			///
+			SparseArray() noexcept = default;
+
+			///
+			/// Destructor.
+			///
+			~SparseArray() noexcept = default;
+
+			///
+			/// Assign a position to an entity.
+			///
+			/// \param entity Entity to use as key. Only the index is used.
+			/// \param position Position in packed array.
+			///
+			void set(const Entity entity, const std::size_t position);
+
+			///
+			/// Remove the position of an entity.
+			///
+			/// \param entity Entity to remove.
+			///
+			void erase(const Entity entity) noexcept;
+
+			///
+			/// Get the position of an entity.
+			///
+			/// \param entity Entity to look up.
+			///
+			/// \return Position in packed array, or SparseArray::null.
+			///
+			[[nodiscard]] const std::uint32_t get(const Entity entity) const noexcept;
+
+			///
+			/// Erase all entries and free all pages.
+			///
+			void clear() noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			SparseArray(const SparseArray&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			SparseArray(SparseArray&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			SparseArray& operator=(const SparseArray&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			SparseArray& operator=(SparseArray&&) = delete;
+
+		private:
+			///
+			/// Page typedef.
+			///
+			using Page = std::array<std::uint32_t, PAGE_SIZE>;
+
+			///
+			/// Lazily allocated pages.
+			///
+			std::vector<std::unique_ptr<Page>> m_pages;
+		};
+
+		inline const std::uint32_t SparseArray::get(const Entity entity) const noexcept
+		{
+			const auto index = entity_index(entity);
+			const auto page  = index / PAGE_SIZE;
+
+			if (page < m_pages.size() && m_pages[page] != nullptr)
+			{
+				return (*m_pages[page])[index % PAGE_SIZE];
+			}
+
+			return null;
+		}
+	} // namespace ecs
+} // namespace galaxy
+
+#endif
\ No newline at end of file
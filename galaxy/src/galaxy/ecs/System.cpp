@@ -5,4 +5,40 @@
 /// See LICENSE.txt.
 ///
 
-#include "System.hpp"
\ No newline at end of file
+#include "System.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		System::System() noexcept
+		    : m_declared {false}, m_main_thread {false}
+		{
+		}
+
+		const std::vector<std::size_t>& System::get_reads() const noexcept
+		{
+			return m_reads;
+		}
+
+		const std::vector<std::size_t>& System::get_writes() const noexcept
+		{
+			return m_writes;
+		}
+
+		const bool System::has_declared_access() const noexcept
+		{
+			return m_declared;
+		}
+
+		const bool System::is_main_thread_only() const noexcept
+		{
+			return m_main_thread;
+		}
+
+		void System::main_thread_only() noexcept
+		{
+			m_main_thread = true;
+		}
+	} // namespace ecs
+} // namespace galaxy
\ No newline at end of file
@@ -8,11 +8,20 @@
 #ifndef GALAXY_ECS_SYSTEM_HPP_
 #define GALAXY_ECS_SYSTEM_HPP_
 
+#include <vector>
+
+#include "galaxy/meta/UniqueID.hpp"
+
 namespace galaxy
 {
 	namespace core
 	{
 		class Scene2D;
+
+		///
+		/// Tag type used to generate component type ids. See core::CUniqueID.
+		///
+		struct ComponentUniqueID;
 	} // namespace core
 
 	namespace ecs
@@ -36,12 +45,94 @@ namespace galaxy
 			///
 			virtual void update(core::Scene2D* scene, const double dt) = 0;
 
+			///
+			/// Get component type ids this system reads.
+			///
+			/// \return Const reference to a std::vector.
+			///
+			[[nodiscard]] const std::vector<std::size_t>& get_reads() const noexcept;
+
+			///
+			/// Get component type ids this system writes.
+			///
+			/// \return Const reference to a std::vector.
+			///
+			[[nodiscard]] const std::vector<std::size_t>& get_writes() const noexcept;
+
+			///
+			/// \brief Has this system declared which components it accesses.
+			///
+			/// Systems that have not are treated as reading and writing everything.
+			///
+			/// \return True if reads() or writes() has been called.
+			///
+			[[nodiscard]] const bool has_declared_access() const noexcept;
+
+			///
+			/// Does this system have to be updated on the main thread.
+			///
+			/// \return True if system cannot run on a worker thread.
+			///
+			[[nodiscard]] const bool is_main_thread_only() const noexcept;
+
 		protected:
 			///
 			/// Default constructor.
 			///
-			System() noexcept = default;
+			System() noexcept;
+
+			///
+			/// Declare components this system only reads. Call from the constructor.
+			///
+			template<meta::is_class... Components>
+			void reads();
+
+			///
+			/// Declare components this system writes to. Call from the constructor.
+			///
+			template<meta::is_class... Components>
+			void writes();
+
+			///
+			/// Mark system as needing the main thread, i.e. it touches OpenGL or Lua. Call from the constructor.
+			///
+			void main_thread_only() noexcept;
+
+		private:
+			///
+			/// Component type ids read.
+			///
+			std::vector<std::size_t> m_reads;
+
+			///
+			/// Component type ids written.
+			///
+			std::vector<std::size_t> m_writes;
+
+			///
+			/// Has access been declared.
+			///
+			bool m_declared;
+
+			///
+			/// Must run on main thread.
+			///
+			bool m_main_thread;
 		};
+
+		template<meta::is_class... Components>
+		inline void System::reads()
+		{
+			(m_reads.push_back(meta::UniqueID<core::ComponentUniqueID>::get<Components>()), ...);
+			m_declared = true;
+		}
+
+		template<meta::is_class... Components>
+		inline void System::writes()
+		{
+			(m_writes.push_back(meta::UniqueID<core::ComponentUniqueID>::get<Components>()), ...);
+			m_declared = true;
+		}
 	} // namespace ecs
 } // namespace galaxy
 
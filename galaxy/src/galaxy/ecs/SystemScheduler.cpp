@@ -0,0 +1,149 @@
+///
+/// SystemScheduler.cpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#include <algorithm>
+
+#include "SystemScheduler.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		SystemScheduler::SystemScheduler() noexcept
+		    : m_mode {ExecutionMode::PARALLEL}, m_pool {nullptr}
+		{
+		}
+
+		SystemScheduler::~SystemScheduler() noexcept
+		{
+			m_systems.clear();
+			m_stages.clear();
+			m_jobs.clear();
+		}
+
+		void SystemScheduler::build(std::vector<System*>&& systems)
+		{
+			m_systems = std::move(systems);
+			m_stages.clear();
+			m_jobs.clear();
+
+			// Each system goes in the stage after the latest system it depends on.
+			std::vector<std::size_t> levels(m_systems.size(), 0);
+			for (std::size_t i = 0; i < m_systems.size(); i++)
+			{
+				for (std::size_t j = 0; j < i; j++)
+				{
+					if (conflicts(m_systems[j], m_systems[i]))
+					{
+						levels[i] = std::max(levels[i], levels[j] + 1);
+					}
+				}
+
+				if (levels[i] >= m_stages.size())
+				{
+					m_stages.resize(levels[i] + 1);
+				}
+
+				m_stages[levels[i]].push_back(i);
+			}
+		}
+
+		void SystemScheduler::execute(core::Scene2D* scene, const double dt)
+		{
+			if (m_mode == ExecutionMode::SINGLE_THREADED || m_pool == nullptr)
+			{
+				for (auto* system : m_systems)
+				{
+					system->update(scene, dt);
+				}
+			}
+			else
+			{
+				for (const auto& stage : m_stages)
+				{
+					if (stage.size() == 1)
+					{
+						m_systems[stage.front()]->update(scene, dt);
+					}
+					else
+					{
+						for (const auto index : stage)
+						{
+							auto* system = m_systems[index];
+							if (!system->is_main_thread_only())
+							{
+								m_jobs.emplace_back(m_pool->submit([system, scene, dt]() {
+									system->update(scene, dt);
+								}));
+							}
+						}
+
+						for (const auto index : stage)
+						{
+							if (m_systems[index]->is_main_thread_only())
+							{
+								m_systems[index]->update(scene, dt);
+							}
+						}
+
+						for (const auto& job : m_jobs)
+						{
+							m_pool->wait(job);
+						}
+
+						m_jobs.clear();
+					}
+				}
+			}
+		}
+
+		void SystemScheduler::set_mode(const ExecutionMode mode) noexcept
+		{
+			m_mode = mode;
+		}
+
+		void SystemScheduler::set_pool(async::ThreadPool* pool) noexcept
+		{
+			m_pool = pool;
+		}
+
+		const ExecutionMode SystemScheduler::get_mode() const noexcept
+		{
+			return m_mode;
+		}
+
+		async::ThreadPool* SystemScheduler::get_pool() const noexcept
+		{
+			return m_pool;
+		}
+
+		const std::vector<std::vector<std::size_t>>& SystemScheduler::get_stages() const noexcept
+		{
+			return m_stages;
+		}
+
+		const bool SystemScheduler::conflicts(const System* a, const System* b) const noexcept
+		{
+			if (!a->has_declared_access() || !b->has_declared_access())
+			{
+				return true;
+			}
+
+			// Keeps main thread systems in creation order.
+			if (a->is_main_thread_only() && b->is_main_thread_only())
+			{
+				return true;
+			}
+
+			const auto overlaps = [](const std::vector<std::size_t>& lhs, const std::vector<std::size_t>& rhs) {
+				return std::find_first_of(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) != lhs.end();
+			};
+
+			return overlaps(a->get_writes(), b->get_writes()) || overlaps(a->get_writes(), b->get_reads()) || overlaps(b->get_writes(), a->get_reads());
+		}
+	} // namespace ecs
+} // namespace galaxy
\ No newline at end of file
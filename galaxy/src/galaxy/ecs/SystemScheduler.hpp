@@ -0,0 +1,165 @@
+///
+/// SystemScheduler.hpp
+/// galaxy
+///
+/// See LICENSE.txt.
+///
+
+#ifndef GALAXY_ECS_SYSTEMSCHEDULER_HPP_
+#define GALAXY_ECS_SYSTEMSCHEDULER_HPP_
+
+#include "galaxy/async/ThreadPool.hpp"
+#include "galaxy/ecs/System.hpp"
+
+namespace galaxy
+{
+	namespace ecs
+	{
+		///
+		/// How systems are executed each update.
+		///
+		enum class ExecutionMode : int
+		{
+			///
+			/// Systems are run one after another, in creation order, on the calling thread.
+			///
+			SINGLE_THREADED,
+
+			///
+			/// Independent systems are run concurrently on the thread pool.
+			///
+			PARALLEL
+		};
+
+		///
+		/// \brief Builds a dependency graph between systems from their declared component access and runs them.
+		///
+		/// Two systems depend on each other if one writes a component the other reads or writes, if either has
+		/// not declared its access, or if both must run on the main thread. A dependency always points from the
+		/// system created first to the one created later, so the result matches creation order when run serially.
+		/// Systems are grouped into stages, where every system in a stage is independent of the others.
+		///
+		class SystemScheduler final
+		{
+		public:
+			///
+			/// Constructor.
+			///
+			SystemScheduler() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~SystemScheduler() noexcept;
+
+			///
+			/// Rebuild dependency graph and stages.
+			///
+			/// \param systems Systems in creation order. Non-owning.
+			///
+			void build(std::vector<System*>&& systems);
+
+			///
+			/// Update all systems.
+			///
+			/// \param scene Pointer to scene.
+			/// \param dt "Lag" time to pass to systems.
+			///
+			void execute(core::Scene2D* scene, const double dt);
+
+			///
+			/// Set how systems are executed.
+			///
+			/// \param mode Execution mode.
+			///
+			void set_mode(const ExecutionMode mode) noexcept;
+
+			///
+			/// Set thread pool used in parallel mode. If null, systems are run single threaded.
+			///
+			/// \param pool Non-owning pointer to a thread pool.
+			///
+			void set_pool(async::ThreadPool* pool) noexcept;
+
+			///
+			/// Get execution mode.
+			///
+			/// \return Const ExecutionMode.
+			///
+			[[nodiscard]] const ExecutionMode get_mode() const noexcept;
+
+			///
+			/// Get thread pool.
+			///
+			/// \return Pointer to thread pool, may be null.
+			///
+			[[nodiscard]] async::ThreadPool* get_pool() const noexcept;
+
+			///
+			/// Get computed stages.
+			///
+			/// \return Const reference to system indexes for each stage, in creation order.
+			///
+			[[nodiscard]] const std::vector<std::vector<std::size_t>>& get_stages() const noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			SystemScheduler(const SystemScheduler&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			SystemScheduler(SystemScheduler&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+			///
+			/// Check if two systems cannot run at the same time.
+			///
+			/// \param a First system.
+			/// \param b Second system.
+			///
+			/// \return True if there is a dependency between the two.
+			///
+			[[nodiscard]] const bool conflicts(const System* a, const System* b) const noexcept;
+
+		private:
+			///
+			/// Systems in creation order.
+			///
+			std::vector<System*> m_systems;
+
+			///
+			/// Indexes of systems that can run together, per stage.
+			///
+			std::vector<std::vector<std::size_t>> m_stages;
+
+			///
+			/// Jobs for systems running on the thread pool in the current stage.
+			///
+			std::vector<async::JobHandle> m_jobs;
+
+			///
+			/// Execution mode.
+			///
+			ExecutionMode m_mode;
+
+			///
+			/// Thread pool to run systems on.
+			///
+			async::ThreadPool* m_pool;
+		};
+	} // namespace ecs
+} // namespace galaxy
+
+#endif
\ No newline at end of file
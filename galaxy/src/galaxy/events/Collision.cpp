@@ -0,0 +1,19 @@
+///
+/// Collision.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "Collision.hpp"
+
+namespace galaxy
+{
+	namespace events
+	{
+		Collision::Collision(const ecs::Entity a, const ecs::Entity b, const physics::ContactPhase phase, const glm::vec2& normal) noexcept
+		    : m_a {a}, m_b {b}, m_phase {phase}, m_normal {normal}
+		{
+		}
+	} // namespace events
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,68 @@
+///
+/// Collision.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_EVENTS_COLLISION_HPP_
+#define GALAXY_EVENTS_COLLISION_HPP_
+
+#include <glm/vec2.hpp>
+
+#include "galaxy/ecs/Entity.hpp"
+#include "galaxy/physics/ContactPhase.hpp"
+
+namespace galaxy
+{
+	namespace events
+	{
+		///
+		/// Contact between two entities, dispatched after the physics step.
+		///
+		struct Collision final
+		{
+			///
+			/// Default constructor.
+			///
+			Collision() noexcept = default;
+
+			///
+			/// Constructor.
+			///
+			/// \param a First entity.
+			/// \param b Second entity.
+			/// \param phase Stage of the contact.
+			/// \param normal Direction that moves a out of b. Zero when contact ends.
+			///
+			Collision(const ecs::Entity a, const ecs::Entity b, const physics::ContactPhase phase, const glm::vec2& normal) noexcept;
+
+			///
+			/// Default destructor.
+			///
+			~Collision() noexcept = default;
+
+			///
+			/// First entity.
+			///
+			ecs::Entity m_a;
+
+			///
+			/// Second entity.
+			///
+			ecs::Entity m_b;
+
+			///
+			/// Stage of the contact.
+			///
+			physics::ContactPhase m_phase;
+
+			///
+			/// Direction that moves a out of b.
+			///
+			glm::vec2 m_normal;
+		};
+	} // namespace events
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,273 @@
+///
+/// Archive.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <zlib.h>
+
+#include "galaxy/error/Log.hpp"
+
+#include "Archive.hpp"
+
+namespace galaxy
+{
+	namespace fs
+	{
+		namespace
+		{
+			///
+			/// Read a little endian integer. Bounds must already be checked.
+			///
+			template<typename Type>
+			[[nodiscard]] Type read_int(std::span<const char> data, const std::uint64_t offset) noexcept
+			{
+				Type value;
+				std::memcpy(&value, data.data() + offset, sizeof(Type));
+
+				return value;
+			}
+		} // namespace
+
+		Archive::Archive() noexcept
+		    : m_mapping {nullptr}
+		{
+		}
+
+		Archive::~Archive() noexcept
+		{
+			close();
+		}
+
+		const bool Archive::load(const std::filesystem::path& path)
+		{
+			close();
+
+#if defined(_WIN32) || defined(_WIN64)
+			auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to open archive {0}.", path.string());
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				CloseHandle(file);
+
+				GALAXY_LOG(GALAXY_ERROR, "Empty archive {0}.", path.string());
+				return false;
+			}
+
+			m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+
+			if (m_mapping == nullptr)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to map archive {0}.", path.string());
+				return false;
+			}
+
+			const auto* data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+			if (data == nullptr)
+			{
+				CloseHandle(m_mapping);
+				m_mapping = nullptr;
+
+				GALAXY_LOG(GALAXY_ERROR, "Failed to map archive {0}.", path.string());
+				return false;
+			}
+
+			m_data = {static_cast<const char*>(data), static_cast<std::size_t>(size.QuadPart)};
+#else
+			const auto fd = ::open(path.c_str(), O_RDONLY);
+			if (fd == -1)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to open archive {0}.", path.string());
+				return false;
+			}
+
+			struct stat info;
+			if (fstat(fd, &info) == -1 || info.st_size == 0)
+			{
+				::close(fd);
+
+				GALAXY_LOG(GALAXY_ERROR, "Empty archive {0}.", path.string());
+				return false;
+			}
+
+			// Mapping stays valid after the descriptor is closed.
+			auto* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+
+			if (data == MAP_FAILED)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to map archive {0}.", path.string());
+				return false;
+			}
+
+			m_data = {static_cast<const char*>(data), static_cast<std::size_t>(info.st_size)};
+#endif
+
+			if (!parse())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Malformed archive {0}.", path.string());
+
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void Archive::close() noexcept
+		{
+			std::lock_guard<std::mutex> lock {m_mutex};
+
+			m_entries.clear();
+			m_inflated.clear();
+
+			if (!m_data.empty())
+			{
+#if defined(_WIN32) || defined(_WIN64)
+				UnmapViewOfFile(m_data.data());
+				CloseHandle(m_mapping);
+				m_mapping = nullptr;
+#else
+				munmap(const_cast<char*>(m_data.data()), m_data.size());
+#endif
+				m_data = {};
+			}
+		}
+
+		std::optional<std::span<const char>> Archive::view(std::string_view name)
+		{
+			const auto it = m_entries.find(static_cast<std::string>(name));
+			if (it == m_entries.end())
+			{
+				return std::nullopt;
+			}
+
+			const auto& entry = it->second;
+			const auto stored = m_data.subspan(entry.m_offset, entry.m_stored_size);
+
+			if (!(entry.m_flags & FLAG_COMPRESSED))
+			{
+				return std::make_optional(stored);
+			}
+
+			std::lock_guard<std::mutex> lock {m_mutex};
+
+			auto& inflated = m_inflated[it->first];
+			if (inflated.size() != entry.m_size)
+			{
+				inflated.resize(entry.m_size);
+
+				auto length = static_cast<uLongf>(entry.m_size);
+				if (uncompress(reinterpret_cast<Bytef*>(inflated.data()), &length, reinterpret_cast<const Bytef*>(stored.data()), static_cast<uLong>(stored.size())) != Z_OK ||
+					length != entry.m_size)
+				{
+					m_inflated.erase(it->first);
+
+					GALAXY_LOG(GALAXY_ERROR, "Failed to inflate {0} from archive.", name);
+					return std::nullopt;
+				}
+			}
+
+			return std::make_optional(std::span<const char> {inflated.data(), inflated.size()});
+		}
+
+		const bool Archive::contains(std::string_view name) const
+		{
+			return m_entries.contains(static_cast<std::string>(name));
+		}
+
+		std::vector<std::string> Archive::names() const
+		{
+			std::vector<std::string> names;
+			names.reserve(m_entries.size());
+
+			for (const auto& [name, entry] : m_entries)
+			{
+				names.push_back(name);
+			}
+
+			return names;
+		}
+
+		const std::size_t Archive::size() const noexcept
+		{
+			return m_entries.size();
+		}
+
+		const bool Archive::is_open() const noexcept
+		{
+			return !m_data.empty();
+		}
+
+		const bool Archive::parse()
+		{
+			if (m_data.size() < HEADER_SIZE || read_int<std::uint32_t>(m_data, 0) != MAGIC || read_int<std::uint32_t>(m_data, 4) != VERSION)
+			{
+				return false;
+			}
+
+			const auto count      = read_int<std::uint32_t>(m_data, 8);
+			const auto toc_offset = read_int<std::uint64_t>(m_data, 16);
+			const auto toc_size   = read_int<std::uint64_t>(m_data, 24);
+
+			if (toc_offset > m_data.size() || toc_size > m_data.size() - toc_offset)
+			{
+				return false;
+			}
+
+			// Offset, size, stored size, flags, name length, then the name.
+			constexpr const std::uint64_t fixed = 8 + 8 + 8 + 4 + 4;
+
+			auto cursor    = toc_offset;
+			const auto end = toc_offset + toc_size;
+
+			m_entries.reserve(count);
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				if (end - cursor < fixed)
+				{
+					return false;
+				}
+
+				Entry entry;
+				entry.m_offset      = read_int<std::uint64_t>(m_data, cursor);
+				entry.m_size        = read_int<std::uint64_t>(m_data, cursor + 8);
+				entry.m_stored_size = read_int<std::uint64_t>(m_data, cursor + 16);
+				entry.m_flags       = read_int<std::uint32_t>(m_data, cursor + 24);
+
+				const auto length = read_int<std::uint32_t>(m_data, cursor + 28);
+				cursor += fixed;
+
+				if (end - cursor < length || entry.m_offset > toc_offset || entry.m_stored_size > toc_offset - entry.m_offset)
+				{
+					return false;
+				}
+
+				m_entries.emplace(std::string {m_data.data() + cursor, length}, entry);
+				cursor += length;
+			}
+
+			return true;
+		}
+	} // namespace fs
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,211 @@
+///
+/// Archive.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_FS_ARCHIVE_HPP_
+#define GALAXY_FS_ARCHIVE_HPP_
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <robin_hood.h>
+
+namespace galaxy
+{
+	namespace fs
+	{
+		///
+		/// \brief Read only view of a packed asset archive.
+		///
+		/// Layout is a fixed header, then every file as a blob aligned to ALIGNMENT, then a table of contents.
+		/// All integers are little endian. The file is memory mapped, so stored blobs are handed out as spans
+		/// into the mapping without a copy. Compressed blobs are inflated once on first access and kept.
+		///
+		class Archive final
+		{
+		public:
+			///
+			/// "GPAK".
+			///
+			inline static constexpr const std::uint32_t MAGIC = 0x4B415047;
+
+			///
+			/// Format version.
+			///
+			inline static constexpr const std::uint32_t VERSION = 1;
+
+			///
+			/// Alignment of every blob.
+			///
+			inline static constexpr const std::uint64_t ALIGNMENT = 16;
+
+			///
+			/// Size of header in bytes: magic, version, entry count, reserved, toc offset, toc size.
+			///
+			inline static constexpr const std::uint64_t HEADER_SIZE = 32;
+
+			///
+			/// Entry flag for a zlib compressed blob.
+			///
+			inline static constexpr const std::uint32_t FLAG_COMPRESSED = 1;
+
+			///
+			/// File extension of archives.
+			///
+			inline static constexpr const std::string_view EXTENSION = ".gpak";
+
+			///
+			/// Table of contents entry.
+			///
+			struct Entry final
+			{
+				///
+				/// Offset of blob from start of archive.
+				///
+				std::uint64_t m_offset;
+
+				///
+				/// Size of file.
+				///
+				std::uint64_t m_size;
+
+				///
+				/// Size of blob in archive. Same as m_size unless compressed.
+				///
+				std::uint64_t m_stored_size;
+
+				///
+				/// Entry flags.
+				///
+				std::uint32_t m_flags;
+			};
+
+			///
+			/// Constructor.
+			///
+			Archive() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~Archive() noexcept;
+
+			///
+			/// Map an archive and read its table of contents.
+			///
+			/// \param path Path to archive.
+			///
+			/// \return True if successful.
+			///
+			[[maybe_unused]] const bool load(const std::filesystem::path& path);
+
+			///
+			/// Unmap archive. Invalidates all views.
+			///
+			void close() noexcept;
+
+			///
+			/// Get file data.
+			///
+			/// \param name Path of file relative to the packed directory, using '/'.
+			///
+			/// \return Span valid until the archive is closed, or std::nullopt if not in the archive.
+			///
+			[[nodiscard]] std::optional<std::span<const char>> view(std::string_view name);
+
+			///
+			/// Check if a file is in the archive.
+			///
+			/// \param name Path of file relative to the packed directory, using '/'.
+			///
+			/// \return True if found.
+			///
+			[[nodiscard]] const bool contains(std::string_view name) const;
+
+			///
+			/// Get path of every file in the archive.
+			///
+			/// \return Names relative to the packed directory.
+			///
+			[[nodiscard]] std::vector<std::string> names() const;
+
+			///
+			/// Get number of files.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t size() const noexcept;
+
+			///
+			/// Is an archive mapped.
+			///
+			/// \return True if loaded.
+			///
+			[[nodiscard]] const bool is_open() const noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			Archive(const Archive&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			Archive(Archive&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			Archive& operator=(const Archive&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			Archive& operator=(Archive&&) = delete;
+
+			///
+			/// Read table of contents from mapping.
+			///
+			/// \return False if the header or table is malformed.
+			///
+			[[nodiscard]] const bool parse();
+
+		private:
+			///
+			/// Mapped archive.
+			///
+			std::span<const char> m_data;
+
+			///
+			/// Platform mapping handle. Only used on Windows.
+			///
+			void* m_mapping;
+
+			///
+			/// Table of contents.
+			///
+			robin_hood::unordered_node_map<std::string, Entry> m_entries;
+
+			///
+			/// Compressed files that have been read.
+			///
+			robin_hood::unordered_node_map<std::string, std::vector<char>> m_inflated;
+
+			///
+			/// Guards inflated files, since views may be requested from loader threads.
+			///
+			std::mutex m_mutex;
+		};
+	} // namespace fs
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -5,7 +5,9 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 
 #include <nlohmann/json.hpp>
@@ -20,9 +22,29 @@ namespace galaxy
 {
 	namespace fs
 	{
+		namespace
+		{
+			///
+			/// Absolute path without dot segments or a trailing separator, so paths can be compared.
+			///
+			[[nodiscard]] std::filesystem::path normalise(const std::filesystem::path& path)
+			{
+				auto result = std::filesystem::absolute(path).lexically_normal();
+				if (!result.has_filename() && result.has_parent_path())
+				{
+					result = result.parent_path();
+				}
+
+				return result;
+			}
+		} // namespace
+
 		Virtual::~Virtual() noexcept
 		{
 			m_dirs.clear();
+			m_index.clear();
+			m_packed.clear();
+			m_archives.clear();
 		}
 
 		void Virtual::create_file(std::string_view filepath)
@@ -31,10 +53,37 @@ namespace galaxy
 
 			std::ofstream ofs {abs_fp, std::ofstream::trunc};
 			ofs.close();
+
+			index(abs_fp);
+		}
+
+		std::optional<std::span<const char>> Virtual::view(std::string_view file)
+		{
+			const auto filename = std::filesystem::path(file).filename().string();
+
+			std::shared_lock lock {m_mutex};
+			if (m_packed.empty() || m_index.contains(filename))
+			{
+				return std::nullopt;
+			}
+
+			const auto it = m_packed.find(filename);
+			if (it == m_packed.end())
+			{
+				return std::nullopt;
+			}
+
+			m_archived++;
+			return it->second.m_archive->view(it->second.m_name);
 		}
 
 		std::optional<std::string> Virtual::open(std::string_view file)
 		{
+			if (const auto data = view(file))
+			{
+				return std::make_optional<std::string>(data->begin(), data->end());
+			}
+
 			const auto path = absolute(file);
 			if (path == std::nullopt)
 			{
@@ -61,6 +110,11 @@ namespace galaxy
 
 		std::optional<std::vector<char>> Virtual::open_binary(std::string_view file)
 		{
+			if (const auto data = view(file))
+			{
+				return std::make_optional<std::vector<char>>(data->begin(), data->end());
+			}
+
 			const auto path = absolute(file);
 			if (path == std::nullopt)
 			{
@@ -111,6 +165,8 @@ namespace galaxy
 			{
 				ofs << data;
 				ofs.close();
+
+				index(path_str);
 				return true;
 			}
 			else
@@ -140,6 +196,8 @@ namespace galaxy
 			{
 				ofs.write(data.data(), data.size());
 				ofs.close();
+
+				index(path_str);
 				return true;
 			}
 			else
@@ -158,18 +216,35 @@ namespace galaxy
 			}
 			else
 			{
+				m_lookups++;
+
+				const auto filename = std::filesystem::path(file).filename().string();
+				{
+					std::shared_lock lock {m_mutex};
+
+					if (const auto it = m_index.find(filename); it != m_index.end())
+					{
+						m_hits++;
+						return std::make_optional(it->second.front().m_path);
+					}
+				}
+
+				// Written to disk before the watcher reported it.
+				std::unique_lock lock {m_mutex};
 				for (const auto& mounted_dir : m_dirs)
 				{
-					for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(mounted_dir, std::filesystem::directory_options::skip_permission_denied))
+					const auto path = mounted_dir / file;
+					if (std::filesystem::exists(path))
 					{
-						const auto& path = dir_entry.path();
-						if (path.filename() == std::filesystem::path(file).filename())
-						{
-							return std::make_optional(std::filesystem::absolute(path).string());
-						}
+						const auto abs = normalise(path);
+						add_path(abs);
+
+						m_fallbacks++;
+						return std::make_optional(abs.string());
 					}
 				}
 
+				m_misses++;
 				return std::nullopt;
 			}
 		}
@@ -276,14 +351,154 @@ namespace galaxy
 		{
 			if (std::filesystem::is_directory(dir))
 			{
-				m_dirs.emplace_back(dir);
+				std::unique_lock lock {m_mutex};
+
+				const auto& mounted = m_dirs.emplace_back(normalise(dir));
+				for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(mounted, std::filesystem::directory_options::skip_permission_denied))
+				{
+					add_path(dir_entry.path());
+				}
 
 				return true;
 			}
+			else if (std::filesystem::is_regular_file(dir) && std::filesystem::path(dir).extension() == Archive::EXTENSION)
+			{
+				auto archive = std::make_unique<Archive>();
+				if (!archive->load(dir))
+				{
+					return false;
+				}
+
+				std::unique_lock lock {m_mutex};
+				for (auto& name : archive->names())
+				{
+					auto filename = std::filesystem::path(name).filename().string();
+					m_packed.try_emplace(std::move(filename), Packed {.m_archive = archive.get(), .m_name = std::move(name)});
+				}
+
+				m_archives.push_back(std::move(archive));
+				return true;
+			}
 			else
 			{
 				return false;
 			}
 		}
+
+		void Virtual::index(const std::filesystem::path& path)
+		{
+			const auto abs = normalise(path);
+
+			std::unique_lock lock {m_mutex};
+			if (!is_mounted(abs))
+			{
+				return;
+			}
+
+			add_path(abs);
+
+			std::error_code ec;
+			if (std::filesystem::is_directory(abs, ec))
+			{
+				for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(abs, std::filesystem::directory_options::skip_permission_denied, ec))
+				{
+					add_path(dir_entry.path());
+				}
+			}
+		}
+
+		void Virtual::unindex(const std::filesystem::path& path)
+		{
+			const auto abs      = normalise(path);
+			const auto abs_str  = abs.string();
+			const auto filename = abs.filename().string();
+
+			std::unique_lock lock {m_mutex};
+
+			const auto it = m_index.find(filename);
+			if (it == m_index.end())
+			{
+				return;
+			}
+
+			auto& entries    = it->second;
+			const auto entry = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) {
+				return e.m_path == abs_str;
+			});
+			if (entry == entries.end())
+			{
+				return;
+			}
+
+			const bool directory = entry->m_directory;
+
+			entries.erase(entry);
+			m_indexed--;
+
+			if (entries.empty())
+			{
+				m_index.erase(it);
+			}
+
+			// A deleted directory can't be walked, so everything under it is found by prefix.
+			if (directory)
+			{
+				for (auto index_it = m_index.begin(); index_it != m_index.end();)
+				{
+					auto& paths = index_it->second;
+					m_indexed -= std::erase_if(paths, [&](const Entry& e) {
+						const std::filesystem::path indexed {e.m_path};
+						return std::mismatch(abs.begin(), abs.end(), indexed.begin(), indexed.end()).first == abs.end();
+					});
+
+					if (paths.empty())
+					{
+						index_it = m_index.erase(index_it);
+					}
+					else
+					{
+						++index_it;
+					}
+				}
+			}
+		}
+
+		const Virtual::Stats Virtual::get_stats() const noexcept
+		{
+			std::shared_lock lock {m_mutex};
+
+			return {.m_lookups = m_lookups, .m_hits = m_hits, .m_fallbacks = m_fallbacks, .m_misses = m_misses, .m_indexed = m_indexed, .m_archived = m_archived};
+		}
+
+		void Virtual::reset_stats() noexcept
+		{
+			m_lookups   = 0;
+			m_hits      = 0;
+			m_fallbacks = 0;
+			m_misses    = 0;
+			m_archived  = 0;
+		}
+
+		void Virtual::add_path(const std::filesystem::path& path)
+		{
+			auto& entries  = m_index[path.filename().string()];
+			const auto str = path.string();
+
+			if (std::none_of(entries.begin(), entries.end(), [&](const Entry& e) {
+					return e.m_path == str;
+				}))
+			{
+				std::error_code ec;
+				entries.push_back({.m_path = str, .m_directory = std::filesystem::is_directory(path, ec)});
+				m_indexed++;
+			}
+		}
+
+		const bool Virtual::is_mounted(const std::filesystem::path& path) const
+		{
+			return std::any_of(m_dirs.begin(), m_dirs.end(), [&](const std::filesystem::path& dir) {
+				return std::mismatch(dir.begin(), dir.end(), path.begin(), path.end()).first == dir.end();
+			});
+		}
 	} // namespace fs
 } // namespace galaxy
\ No newline at end of file
@@ -8,31 +8,74 @@
 #ifndef GALAXY_FS_FILESYSTEM_HPP_
 #define GALAXY_FS_FILESYSTEM_HPP_
 
+#include <atomic>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string_view>
+#include <vector>
+
+#include <robin_hood.h>
+
+#include "galaxy/fs/Archive.hpp"
 
 #define CUR_DIR std::filesystem::current_path().string()
 
 namespace galaxy
 {
-	namespace core
-	{
-		class Application;
-	} // namespace core
-
 	namespace fs
 	{
 		///
-		/// Virtual File System to make managing files easier.
+		/// \brief Virtual File System to make managing files easier.
+		///
+		/// Files are found by name anywhere under a mounted directory. Every name is indexed when a directory is
+		/// mounted, and the index is kept current by index() and unindex(), which Application calls from its file
+		/// watcher. Packed archives can be mounted too, and are read through view() without a copy. Loose files
+		/// take priority over archived ones, so edited assets override the archive while developing. Lookups may
+		/// be made from any thread.
 		///
 		class Virtual final
 		{
-			friend class core::Application;
-
 		public:
+			///
+			/// Lookup counters, to check how often the index is missed.
+			///
+			struct Stats final
+			{
+				///
+				/// Relative paths looked up.
+				///
+				std::size_t m_lookups;
+
+				///
+				/// Lookups found in the index.
+				///
+				std::size_t m_hits;
+
+				///
+				/// Lookups found on disk that were not in the index yet, i.e. a file written before its watcher event.
+				///
+				std::size_t m_fallbacks;
+
+				///
+				/// Lookups not found.
+				///
+				std::size_t m_misses;
+
+				///
+				/// Paths in the index.
+				///
+				std::size_t m_indexed;
+
+				///
+				/// Views served from a mounted archive.
+				///
+				std::size_t m_archived;
+			};
+
 			///
 			/// Constructor.
 			///
@@ -52,6 +95,18 @@ namespace galaxy
 			///
 			void create_file(std::string_view filepath);
 
+			///
+			/// \brief Get file data from a mounted archive without a copy.
+			///
+			/// Compressed files are inflated on first access and kept until the VFS is destroyed.
+			///
+			/// \param file File to view.
+			///
+			/// \return Span valid for the life of the VFS, or std::nullopt if the file is not archived or a loose
+			///			file of the same name exists, in which case load it from disk.
+			///
+			[[nodiscard]] std::optional<std::span<const char>> view(std::string_view file);
+
 			///
 			/// Open a file and store contents in std::string.
 			///
@@ -97,12 +152,50 @@ namespace galaxy
 			///
 			/// \brief Retrieve the absolute position of a file to load.
 			///
-			/// Searches recursively over each mount point.
+			/// Looks up the filename in the index of every mount point. If it is not indexed, the path is checked
+			/// relative to each mount point in case the file was created before the index heard about it.
 			///
 			/// \param file Name of file to get path for.
 			///
 			[[nodiscard]] std::optional<std::string> absolute(std::string_view file);
 
+			///
+			/// \brief Mounts a directory or archive to the VFS.
+			///
+			/// Everything in the directory is added to the index. Archives are recognised by Archive::EXTENSION.
+			///
+			/// \param dir Directory or archive to add.
+			///
+			/// \return Returns false if not a directory or a valid archive, and does not mount if so.
+			///
+			[[maybe_unused]] const bool mount(std::string_view dir);
+
+			///
+			/// Add a file, or a directory and everything in it, to the index. Ignored if not inside a mount point.
+			///
+			/// \param path Path that was created or moved into place.
+			///
+			void index(const std::filesystem::path& path);
+
+			///
+			/// Remove a file, or a directory and everything in it, from the index.
+			///
+			/// \param path Path that was deleted or moved away.
+			///
+			void unindex(const std::filesystem::path& path);
+
+			///
+			/// Get lookup counters.
+			///
+			/// \return Copy of counters.
+			///
+			[[nodiscard]] const Stats get_stats() const noexcept;
+
+			///
+			/// Reset lookup counters to zero.
+			///
+			void reset_stats() noexcept;
+
 			///
 			/// Open an open file dialog using pfd.
 			///
@@ -149,19 +242,108 @@ namespace galaxy
 
 		private:
 			///
-			/// Mounts a directory to the VFS.
+			/// Indexed path.
 			///
-			/// \param dir Directory to add.
+			struct Entry final
+			{
+				///
+				/// Absolute path.
+				///
+				std::string m_path;
+
+				///
+				/// Was a directory when indexed, so removing it removes everything under it.
+				///
+				bool m_directory;
+			};
+
 			///
-			/// \return Returns false if not a directory, and does not mount if so.
+			/// File in a mounted archive.
 			///
-			[[maybe_unused]] const bool mount(std::string_view dir);
+			struct Packed final
+			{
+				///
+				/// Archive holding the file.
+				///
+				Archive* m_archive;
+
+				///
+				/// Name of the file in the archive.
+				///
+				std::string m_name;
+			};
+
+			///
+			/// Add a path to the index. Caller must hold the lock.
+			///
+			/// \param path Absolute path.
+			///
+			void add_path(const std::filesystem::path& path);
+
+			///
+			/// Is a path inside a mount point. Caller must hold the lock.
+			///
+			/// \param path Absolute path.
+			///
+			/// \return True if path is inside a mounted directory.
+			///
+			[[nodiscard]] const bool is_mounted(const std::filesystem::path& path) const;
 
 		private:
 			///
 			/// Stores mounted directories.
 			///
 			std::vector<std::filesystem::path> m_dirs;
+
+			///
+			/// Absolute paths of every file and directory, by filename. First mounted, first found.
+			///
+			robin_hood::unordered_node_map<std::string, std::vector<Entry>> m_index;
+
+			///
+			/// Mounted archives.
+			///
+			std::vector<std::unique_ptr<Archive>> m_archives;
+
+			///
+			/// Archived files, by filename. First mounted, first found.
+			///
+			robin_hood::unordered_node_map<std::string, Packed> m_packed;
+
+			///
+			/// Number of paths in the index.
+			///
+			std::size_t m_indexed = 0;
+
+			///
+			/// Guards the index. Written by the file watcher thread.
+			///
+			mutable std::shared_mutex m_mutex;
+
+			///
+			/// Relative paths looked up.
+			///
+			std::atomic<std::size_t> m_lookups = 0;
+
+			///
+			/// Lookups found in the index.
+			///
+			std::atomic<std::size_t> m_hits = 0;
+
+			///
+			/// Lookups found on disk but not in the index.
+			///
+			std::atomic<std::size_t> m_fallbacks = 0;
+
+			///
+			/// Lookups not found.
+			///
+			std::atomic<std::size_t> m_misses = 0;
+
+			///
+			/// Views served from an archive.
+			///
+			std::atomic<std::size_t> m_archived = 0;
 		};
 	} // namespace fs
 } // namespace galaxy
@@ -0,0 +1,164 @@
+///
+/// Packer.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "galaxy/error/Log.hpp"
+#include "galaxy/fs/Archive.hpp"
+
+#include "Packer.hpp"
+
+namespace galaxy
+{
+	namespace fs
+	{
+		namespace
+		{
+			///
+			/// Append a little endian integer.
+			///
+			template<typename Type>
+			void write_int(std::vector<char>& buffer, const Type value)
+			{
+				std::array<char, sizeof(Type)> bytes;
+				std::memcpy(bytes.data(), &value, sizeof(Type));
+
+				buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+			}
+
+			///
+			/// Extensions that don't shrink further.
+			///
+			[[nodiscard]] bool is_compressed_format(const std::filesystem::path& path)
+			{
+				auto ext = path.extension().string();
+				std::transform(ext.begin(), ext.end(), ext.begin(), [](const unsigned char c) {
+					return static_cast<char>(std::tolower(c));
+				});
+
+				return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".ogg" || ext == Archive::EXTENSION;
+			}
+		} // namespace
+
+		const bool pack(const std::filesystem::path& dir, const std::filesystem::path& output, const bool compress)
+		{
+			if (!std::filesystem::is_directory(dir))
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Tried to pack {0}, which is not a directory.", dir.string());
+				return false;
+			}
+
+			const auto abs_output = std::filesystem::absolute(output).lexically_normal();
+
+			std::vector<std::filesystem::path> files;
+			for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(dir, std::filesystem::directory_options::skip_permission_denied))
+			{
+				if (dir_entry.is_regular_file() && std::filesystem::absolute(dir_entry.path()).lexically_normal() != abs_output)
+				{
+					files.push_back(dir_entry.path());
+				}
+			}
+
+			std::sort(files.begin(), files.end());
+
+			std::ofstream ofs {output, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc};
+			if (!ofs.good())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to create archive {0}.", output.string());
+				return false;
+			}
+
+			// Header is written last, once the table of contents offset is known.
+			std::vector<char> padding(Archive::HEADER_SIZE, 0);
+			ofs.write(padding.data(), padding.size());
+
+			std::vector<char> toc;
+			std::vector<char> data;
+			std::vector<char> deflated;
+			std::uint64_t offset = Archive::HEADER_SIZE;
+
+			for (const auto& file : files)
+			{
+				std::ifstream ifs {file, std::ifstream::in | std::ifstream::binary | std::ifstream::ate};
+				if (!ifs.good())
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to read {0} while packing.", file.string());
+					return false;
+				}
+
+				data.resize(static_cast<std::size_t>(ifs.tellg()));
+				ifs.seekg(0, std::ifstream::beg);
+				ifs.read(data.data(), data.size());
+				ifs.close();
+
+				std::uint32_t flags = 0;
+				std::span<const char> blob {data.data(), data.size()};
+
+				if (compress && !data.empty() && data.size() <= std::numeric_limits<uLong>::max() && !is_compressed_format(file))
+				{
+					auto length = compressBound(static_cast<uLong>(data.size()));
+					deflated.resize(length);
+
+					if (compress2(reinterpret_cast<Bytef*>(deflated.data()), &length, reinterpret_cast<const Bytef*>(data.data()), static_cast<uLong>(data.size()), Z_BEST_COMPRESSION) ==
+							Z_OK &&
+						length < data.size() - data.size() / 8)
+					{
+						flags = Archive::FLAG_COMPRESSED;
+						blob  = {deflated.data(), length};
+					}
+				}
+
+				const auto aligned = (offset + Archive::ALIGNMENT - 1) & ~(Archive::ALIGNMENT - 1);
+				padding.assign(aligned - offset, 0);
+				ofs.write(padding.data(), padding.size());
+				ofs.write(blob.data(), blob.size());
+
+				const auto name = std::filesystem::relative(file, dir).generic_string();
+				write_int<std::uint64_t>(toc, aligned);
+				write_int<std::uint64_t>(toc, data.size());
+				write_int<std::uint64_t>(toc, blob.size());
+				write_int<std::uint32_t>(toc, flags);
+				write_int<std::uint32_t>(toc, static_cast<std::uint32_t>(name.size()));
+				toc.insert(toc.end(), name.begin(), name.end());
+
+				offset = aligned + blob.size();
+			}
+
+			ofs.write(toc.data(), toc.size());
+
+			std::vector<char> header;
+			write_int<std::uint32_t>(header, Archive::MAGIC);
+			write_int<std::uint32_t>(header, Archive::VERSION);
+			write_int<std::uint32_t>(header, static_cast<std::uint32_t>(files.size()));
+			write_int<std::uint32_t>(header, 0);
+			write_int<std::uint64_t>(header, offset);
+			write_int<std::uint64_t>(header, toc.size());
+
+			ofs.seekp(0, std::ofstream::beg);
+			ofs.write(header.data(), header.size());
+			ofs.close();
+
+			if (!ofs.good())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to write archive {0}.", output.string());
+				return false;
+			}
+
+			return true;
+		}
+	} // namespace fs
+} // namespace galaxy
\ No newline at end of file
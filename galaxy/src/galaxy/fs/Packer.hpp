@@ -0,0 +1,34 @@
+///
+/// Packer.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_FS_PACKER_HPP_
+#define GALAXY_FS_PACKER_HPP_
+
+#include <filesystem>
+
+namespace galaxy
+{
+	namespace fs
+	{
+		///
+		/// \brief Pack every file in a directory into an archive. See fs::Archive for the layout.
+		///
+		/// Files are stored in name order, so the same directory always gives the same archive. Formats that are
+		/// already compressed (png, jpg, ogg) are stored as is, and other files are only kept compressed when it
+		/// saves at least an eighth of their size. Stored files are read from the mapping without a copy.
+		///
+		/// \param dir Directory to pack. Names in the archive are relative to this, using '/'.
+		/// \param output Archive to write. Overwritten if it exists.
+		/// \param compress Allow zlib compression.
+		///
+		/// \return True if successful.
+		///
+		[[maybe_unused]] const bool pack(const std::filesystem::path& dir, const std::filesystem::path& output, const bool compress = true);
+	} // namespace fs
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,291 @@
+///
+/// AtlasBaker.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+
+#include <nlohmann/json.hpp>
+#include <robin_hood.h>
+#include <stb/stb_image_write.h>
+
+#include "galaxy/error/Log.hpp"
+#include "galaxy/math/RectPack.hpp"
+
+#include "AtlasBaker.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		namespace
+		{
+			///
+			/// Extensions stb_image can decode that are worth putting in an atlas.
+			///
+			[[nodiscard]] bool is_image(const std::filesystem::path& path)
+			{
+				auto ext = path.extension().string();
+				std::transform(ext.begin(), ext.end(), ext.begin(), [](const unsigned char c) {
+					return static_cast<char>(std::tolower(c));
+				});
+
+				return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+			}
+
+			///
+			/// Read and decode, top row first.
+			///
+			[[nodiscard]] std::optional<Image> decode_file(const std::filesystem::path& path)
+			{
+				std::ifstream ifs {path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate};
+				if (!ifs.good())
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to read {0} while baking atlas.", path.string());
+					return std::nullopt;
+				}
+
+				std::vector<char> data(static_cast<std::size_t>(ifs.tellg()));
+				ifs.seekg(0, std::ifstream::beg);
+				ifs.read(data.data(), data.size());
+
+				return decode_image(data, false);
+			}
+
+			///
+			/// Where a texture went.
+			///
+			struct Placement final
+			{
+				///
+				/// Index of file.
+				///
+				std::size_t m_file;
+
+				///
+				/// Index of page.
+				///
+				std::size_t m_page;
+
+				///
+				/// Bounds on page.
+				///
+				math::Rect<int> m_region;
+			};
+		} // namespace
+
+		std::vector<BakedPage> bake_atlas(std::span<const std::filesystem::path> files, const int size, async::ThreadPool& pool)
+		{
+			std::vector<std::optional<Image>> images(files.size());
+			pool.parallel_for(0, files.size(), 1, [&](const std::size_t first, const std::size_t last) {
+				for (auto i = first; i < last; i++)
+				{
+					images[i] = decode_file(files[i]);
+				}
+			});
+
+			// First file with a name wins, same as adding to an atlas at runtime.
+			std::vector<std::size_t> order;
+			robin_hood::unordered_flat_set<std::string> names;
+			for (std::size_t i = 0; i < files.size(); i++)
+			{
+				if (!images[i].has_value())
+				{
+					continue;
+				}
+
+				const auto& image = images[i].value();
+				if (image.m_width > size || image.m_height > size)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "{0} does not fit in a {1}x{1} atlas.", files[i].string(), size);
+				}
+				else if (!names.insert(files[i].stem().string()).second)
+				{
+					GALAXY_LOG(GALAXY_WARNING, "Skipping {0}, a texture with the same name is already in the atlas.", files[i].string());
+				}
+				else
+				{
+					order.push_back(i);
+				}
+			}
+
+			// Largest first leaves small textures to fill the gaps. Ties are broken by name so output is stable.
+			std::sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b) {
+				const auto& lhs = images[a].value();
+				const auto& rhs = images[b].value();
+
+				const auto lhs_area = static_cast<std::int64_t>(lhs.m_width) * lhs.m_height;
+				const auto rhs_area = static_cast<std::int64_t>(rhs.m_width) * rhs.m_height;
+
+				if (lhs_area != rhs_area)
+				{
+					return lhs_area > rhs_area;
+				}
+				else if (std::max(lhs.m_width, lhs.m_height) != std::max(rhs.m_width, rhs.m_height))
+				{
+					return std::max(lhs.m_width, lhs.m_height) > std::max(rhs.m_width, rhs.m_height);
+				}
+
+				return files[a].stem() < files[b].stem();
+			});
+
+			std::vector<Placement> placements;
+			std::vector<math::RectPack<int>> packers;
+			placements.reserve(order.size());
+
+			for (const auto index : order)
+			{
+				const auto& image = images[index].value();
+
+				std::optional<math::Rect<int>> region = std::nullopt;
+				std::size_t page                      = 0;
+
+				for (; page < packers.size(); page++)
+				{
+					region = packers[page].pack(image.m_width, image.m_height);
+					if (region.has_value())
+					{
+						break;
+					}
+				}
+
+				if (!region.has_value())
+				{
+					packers.emplace_back().init(size, size, math::PackMethod::MAXRECTS_BSSF);
+					region = packers.back().pack(image.m_width, image.m_height);
+				}
+
+				placements.push_back({index, page, region.value()});
+			}
+
+			std::vector<BakedPage> pages(packers.size());
+			for (const auto& placement : placements)
+			{
+				auto& page = pages[placement.m_page];
+				page.m_regions.push_back({files[placement.m_file].stem().string(), placement.m_region});
+
+				page.m_image.m_width  = std::max(page.m_image.m_width, placement.m_region.m_x + placement.m_region.m_width);
+				page.m_image.m_height = std::max(page.m_image.m_height, placement.m_region.m_y + placement.m_region.m_height);
+			}
+
+			for (auto& page : pages)
+			{
+				page.m_image.m_pixels.resize(static_cast<std::size_t>(page.m_image.m_width) * page.m_image.m_height * 4, 0);
+				std::sort(page.m_regions.begin(), page.m_regions.end(), [](const BakedRegion& a, const BakedRegion& b) {
+					return a.m_name < b.m_name;
+				});
+			}
+
+			// Regions never overlap, so every texture can be copied at once.
+			pool.parallel_for(0, placements.size(), 8, [&](const std::size_t first, const std::size_t last) {
+				for (auto i = first; i < last; i++)
+				{
+					const auto& placement = placements[i];
+					const auto& src       = images[placement.m_file].value();
+					auto& dst             = pages[placement.m_page].m_image;
+
+					const auto row = static_cast<std::size_t>(src.m_width) * 4;
+					for (int y = 0; y < src.m_height; y++)
+					{
+						const auto dst_offset = (static_cast<std::size_t>(placement.m_region.m_y + y) * dst.m_width + placement.m_region.m_x) * 4;
+						std::memcpy(dst.m_pixels.data() + dst_offset, src.m_pixels.data() + (y * row), row);
+					}
+				}
+			});
+
+			return pages;
+		}
+
+		const bool bake_atlas(const std::filesystem::path& dir, const std::filesystem::path& manifest, const int size, async::ThreadPool& pool)
+		{
+			if (!std::filesystem::is_directory(dir))
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Tried to bake atlas from {0}, which is not a directory.", dir.string());
+				return false;
+			}
+
+			std::vector<std::filesystem::path> files;
+			for (const auto& dir_entry : std::filesystem::recursive_directory_iterator(dir, std::filesystem::directory_options::skip_permission_denied))
+			{
+				if (dir_entry.is_regular_file() && is_image(dir_entry.path()))
+				{
+					files.push_back(dir_entry.path());
+				}
+			}
+
+			// Directory order is unspecified, so sort for stable output.
+			std::sort(files.begin(), files.end());
+
+			// Pages from an earlier bake into the same directory would be baked again.
+			const auto prefix     = manifest.stem().string() + "_";
+			const auto output_dir = std::filesystem::absolute(manifest).lexically_normal().parent_path();
+			std::erase_if(files, [&](const std::filesystem::path& file) {
+				return file.stem().string().starts_with(prefix) && std::filesystem::absolute(file).lexically_normal().parent_path() == output_dir;
+			});
+
+			const auto pages = bake_atlas(files, size, pool);
+
+			nlohmann::json json = "{\"pages\":[]}"_json;
+			json["size"]        = size;
+
+			std::vector<std::filesystem::path> outputs;
+			for (std::size_t i = 0; i < pages.size(); i++)
+			{
+				auto output = manifest.parent_path() / (prefix + std::to_string(i) + ".png");
+
+				nlohmann::json page_json = "{\"textures\":{}}"_json;
+				page_json["image"]       = output.filename().string();
+
+				for (const auto& region : pages[i].m_regions)
+				{
+					auto& texture_json     = page_json["textures"][region.m_name];
+					texture_json["x"]      = region.m_region.m_x;
+					texture_json["y"]      = region.m_region.m_y;
+					texture_json["width"]  = region.m_region.m_width;
+					texture_json["height"] = region.m_region.m_height;
+				}
+
+				json["pages"].push_back(std::move(page_json));
+				outputs.push_back(std::move(output));
+			}
+
+			// Flip is global and may have been left on by RenderTexture::save().
+			stbi_flip_vertically_on_write(false);
+
+			std::vector<char> written(pages.size(), 0);
+			pool.parallel_for(0, pages.size(), 1, [&](const std::size_t first, const std::size_t last) {
+				for (auto i = first; i < last; i++)
+				{
+					const auto& image = pages[i].m_image;
+					written[i]        = stbi_write_png(outputs[i].string().c_str(), image.m_width, image.m_height, 4, image.m_pixels.data(), image.m_width * 4) != 0;
+				}
+			});
+
+			for (std::size_t i = 0; i < outputs.size(); i++)
+			{
+				if (!written[i])
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to write atlas page {0}.", outputs[i].string());
+					return false;
+				}
+			}
+
+			std::ofstream ofs {manifest, std::ofstream::out | std::ofstream::trunc};
+			if (!ofs.good())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to write atlas manifest {0}.", manifest.string());
+				return false;
+			}
+
+			ofs << json.dump(4);
+			return true;
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
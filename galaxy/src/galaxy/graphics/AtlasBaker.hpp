@@ -0,0 +1,89 @@
+///
+/// AtlasBaker.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_ATLASBAKER_HPP_
+#define GALAXY_GRAPHICS_ATLASBAKER_HPP_
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "galaxy/async/ThreadPool.hpp"
+#include "galaxy/graphics/Image.hpp"
+#include "galaxy/math/Rect.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// A texture placed on a baked page.
+		///
+		struct BakedRegion final
+		{
+			///
+			/// Texture key. Filename without extension, same as TextureAtlas.
+			///
+			std::string m_name;
+
+			///
+			/// Pixel bounds on the page, from the top left.
+			///
+			math::Rect<int> m_region;
+		};
+
+		///
+		/// One atlas worth of textures, blitted together on the CPU.
+		///
+		struct BakedPage final
+		{
+			///
+			/// Page pixels, top row first. Trimmed to the area in use.
+			///
+			Image m_image;
+
+			///
+			/// Textures on this page, in name order.
+			///
+			std::vector<BakedRegion> m_regions;
+		};
+
+		///
+		/// \brief Decode, pack and blit textures into atlas pages without touching OpenGL.
+		///
+		/// Decoding and blitting are spread over the pool. Textures are packed largest first with MaxRects, each into the
+		/// first page with room, so later pages soak up what earlier ones could not fit and the same files always give
+		/// the same pages.
+		///
+		/// \param files Image files on disk. Files that fail to decode, are larger than a page, or share a name with
+		///			an earlier file are skipped.
+		/// \param size Width and height of a page. Should match the atlas size at runtime.
+		/// \param pool Pool to decode and blit on.
+		///
+		/// \return Baked pages.
+		///
+		[[nodiscard]] std::vector<BakedPage> bake_atlas(std::span<const std::filesystem::path> files, const int size, async::ThreadPool& pool);
+
+		///
+		/// \brief Bake every image in a directory and write the pages and a manifest to disk.
+		///
+		/// Pages are written as png files next to the manifest, named after it, i.e. atlas_0.png for atlas.json.
+		/// res::TextureBook loads a manifest in place of a texturebook json, and uploads the pages directly.
+		///
+		/// \param dir Directory to search recursively for png, jpg, bmp and tga files.
+		/// \param manifest Json manifest to write. Overwritten if it exists.
+		/// \param size Width and height of a page.
+		/// \param pool Pool to decode, blit and encode on.
+		///
+		/// \return True if successful.
+		///
+		[[maybe_unused]] const bool bake_atlas(const std::filesystem::path& dir, const std::filesystem::path& manifest, const int size, async::ThreadPool& pool);
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+///
+/// GLRenderDevice.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <glad/glad.h>
+
+#include "GLRenderDevice.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		GLRenderDevice::GLRenderDevice() noexcept
+		{
+			m_shaders.fill(nullptr);
+		}
+
+		void GLRenderDevice::set_shader(const RenderShader type, Shader* shader)
+		{
+			const auto index = static_cast<std::size_t>(type);
+
+			m_shaders[index]   = shader;
+			m_locations[index] = {};
+
+			if (shader != nullptr)
+			{
+				auto& locations = m_locations[index];
+
+				locations.m_transform = glGetUniformLocation(shader->id(), "u_transform");
+				locations.m_colour    = glGetUniformLocation(shader->id(), "u_colour");
+				locations.m_width     = glGetUniformLocation(shader->id(), "u_width");
+				locations.m_height    = glGetUniformLocation(shader->id(), "u_height");
+				locations.m_opacity   = glGetUniformLocation(shader->id(), "u_opacity");
+			}
+		}
+
+		void GLRenderDevice::bind_shader(const RenderShader shader)
+		{
+			m_shaders[static_cast<std::size_t>(shader)]->bind();
+		}
+
+		void GLRenderDevice::upload_uniforms(const RenderShader shader, const RenderUniforms& uniforms)
+		{
+			const auto& locations = m_locations[static_cast<std::size_t>(shader)];
+
+			if (locations.m_transform != -1)
+			{
+				glUniformMatrix4fv(locations.m_transform, 1, GL_FALSE, uniforms.m_transform.data());
+			}
+
+			if (locations.m_colour != -1)
+			{
+				glUniform4fv(locations.m_colour, 1, uniforms.m_colour.data());
+			}
+
+			if (locations.m_width != -1)
+			{
+				glUniform1f(locations.m_width, uniforms.m_width);
+			}
+
+			if (locations.m_height != -1)
+			{
+				glUniform1f(locations.m_height, uniforms.m_height);
+			}
+
+			if (locations.m_opacity != -1)
+			{
+				glUniform1i(locations.m_opacity, uniforms.m_opacity);
+			}
+		}
+
+		void GLRenderDevice::bind_texture(const unsigned int texture)
+		{
+			glBindTexture(GL_TEXTURE_2D, texture);
+		}
+
+		void GLRenderDevice::bind_vao(const unsigned int vao)
+		{
+			glBindVertexArray(vao);
+		}
+
+		void GLRenderDevice::draw(const RenderCommand& command)
+		{
+			if (command.m_instance_count > 0)
+			{
+				glDrawElementsInstanced(command.m_type, command.m_index_count, GL_UNSIGNED_INT, nullptr, command.m_instance_count);
+			}
+			else
+			{
+				glDrawElementsBaseVertex(command.m_type, command.m_index_count, GL_UNSIGNED_INT, nullptr, command.m_base_vertex);
+			}
+		}
+
+		void GLRenderDevice::reset()
+		{
+			glBindTexture(GL_TEXTURE_2D, 0);
+			glBindVertexArray(0);
+			glUseProgram(0);
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
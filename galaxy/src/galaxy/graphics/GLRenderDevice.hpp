@@ -0,0 +1,139 @@
+///
+/// GLRenderDevice.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_GLRENDERDEVICE_HPP_
+#define GALAXY_GRAPHICS_GLRENDERDEVICE_HPP_
+
+#include "galaxy/graphics/RenderQueue.hpp"
+#include "galaxy/graphics/Shader.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// OpenGL render device. Uniform locations are looked up once per shader.
+		///
+		class GLRenderDevice final : public RenderDevice
+		{
+		public:
+			///
+			/// Constructor.
+			///
+			GLRenderDevice() noexcept;
+
+			///
+			/// Destructor.
+			///
+			virtual ~GLRenderDevice() noexcept = default;
+
+			///
+			/// Set the shader used for a RenderShader and cache its uniform locations.
+			///
+			/// \param type Shader slot.
+			/// \param shader Loaded shader. Caller manages lifetime.
+			///
+			void set_shader(const RenderShader type, Shader* shader);
+
+			///
+			/// Bind a shader.
+			///
+			/// \param shader Shader to bind.
+			///
+			void bind_shader(const RenderShader shader) override;
+
+			///
+			/// Upload uniforms to the bound shader.
+			///
+			/// \param shader Bound shader.
+			/// \param uniforms Values to upload.
+			///
+			void upload_uniforms(const RenderShader shader, const RenderUniforms& uniforms) override;
+
+			///
+			/// Bind a texture.
+			///
+			/// \param texture Texture id.
+			///
+			void bind_texture(const unsigned int texture) override;
+
+			///
+			/// Bind a vertex array.
+			///
+			/// \param vao Vertex array id.
+			///
+			void bind_vao(const unsigned int vao) override;
+
+			///
+			/// Draw with currently bound state.
+			///
+			/// \param command Command to draw.
+			///
+			void draw(const RenderCommand& command) override;
+
+			///
+			/// Unbind texture, vertex array and shader.
+			///
+			void reset() override;
+
+		private:
+			///
+			/// Uniform locations of a shader. -1 if the shader does not use it.
+			///
+			struct Locations final
+			{
+				///
+				/// u_transform.
+				///
+				int m_transform = -1;
+
+				///
+				/// u_colour.
+				///
+				int m_colour = -1;
+
+				///
+				/// u_width.
+				///
+				int m_width = -1;
+
+				///
+				/// u_height.
+				///
+				int m_height = -1;
+
+				///
+				/// u_opacity.
+				///
+				int m_opacity = -1;
+			};
+
+			///
+			/// Copy constructor.
+			///
+			GLRenderDevice(const GLRenderDevice&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			GLRenderDevice& operator=(const GLRenderDevice&) = delete;
+
+		private:
+			///
+			/// Shader for each RenderShader.
+			///
+			std::array<Shader*, RenderQueue::SHADERS> m_shaders;
+
+			///
+			/// Uniform locations for each RenderShader.
+			///
+			std::array<Locations, RenderQueue::SHADERS> m_locations;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+///
+/// GLStreamBackend.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "galaxy/error/Log.hpp"
+
+#include "GLStreamBackend.hpp"
+
+///
+/// Flags used for both storage and mapping. Readable so a growing stream can carry over data written this frame.
+///
+constexpr const GLbitfield stream_flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+///
+/// Nanoseconds to block per glClientWaitSync call.
+///
+constexpr const GLuint64 wait_timeout = 1'000'000;
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		GLStreamBackend::GLStreamBackend() noexcept
+		    : m_current {0}
+		{
+		}
+
+		GLStreamBackend::~GLStreamBackend() noexcept
+		{
+			while (!m_buffers.empty())
+			{
+				unmap(m_buffers.back().first);
+			}
+		}
+
+		std::byte* GLStreamBackend::map(const std::size_t size)
+		{
+			unsigned int buffer = 0;
+			glCreateBuffers(1, &buffer);
+			glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(size), nullptr, stream_flags);
+
+			auto* ptr = static_cast<std::byte*>(glMapNamedBufferRange(buffer, 0, static_cast<GLsizeiptr>(size), stream_flags));
+			if (ptr == nullptr)
+			{
+				glDeleteBuffers(1, &buffer);
+				return nullptr;
+			}
+
+			m_buffers.emplace_back(ptr, buffer);
+			m_current = buffer;
+
+			return ptr;
+		}
+
+		void GLStreamBackend::unmap(std::byte* mapped) noexcept
+		{
+			const auto it = std::find_if(m_buffers.begin(), m_buffers.end(), [&](const auto& pair) {
+				return pair.first == mapped;
+			});
+
+			if (it != m_buffers.end())
+			{
+				// GL defers deleting the storage until commands reading from it have finished.
+				glUnmapNamedBuffer(it->second);
+				glDeleteBuffers(1, &it->second);
+
+				if (it->second == m_current)
+				{
+					m_current = 0;
+				}
+
+				m_buffers.erase(it);
+			}
+		}
+
+		const unsigned int GLStreamBackend::id() const noexcept
+		{
+			return m_current;
+		}
+
+		void* GLStreamBackend::fence()
+		{
+			return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		const bool GLStreamBackend::wait(void* fence)
+		{
+			auto* sync = static_cast<GLsync>(fence);
+
+			// Poll first so the common case of an already finished frame does not flush.
+			auto result = glClientWaitSync(sync, 0, 0);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+			{
+				return false;
+			}
+
+			do
+			{
+				result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, wait_timeout);
+				if (result == GL_WAIT_FAILED)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to wait on stream buffer fence.");
+					break;
+				}
+			} while (result == GL_TIMEOUT_EXPIRED);
+
+			return true;
+		}
+
+		void GLStreamBackend::destroy_fence(void* fence) noexcept
+		{
+			glDeleteSync(static_cast<GLsync>(fence));
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,108 @@
+///
+/// GLStreamBackend.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_GLSTREAMBACKEND_HPP_
+#define GALAXY_GRAPHICS_GLSTREAMBACKEND_HPP_
+
+#include <utility>
+#include <vector>
+
+#include "galaxy/graphics/StreamBackend.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// OpenGL stream backend. Each mapping is a new buffer object with immutable, persistent and coherent
+		/// storage. Synchronisation uses sync objects.
+		///
+		class GLStreamBackend final : public StreamBackend
+		{
+		public:
+			///
+			/// Constructor.
+			///
+			GLStreamBackend() noexcept;
+
+			///
+			/// Destructor.
+			///
+			virtual ~GLStreamBackend() noexcept;
+
+			///
+			/// Create a buffer object and map it for writing until it is unmapped.
+			///
+			/// \param size Size in bytes.
+			///
+			/// \return Pointer to mapped memory, or nullptr on failure.
+			///
+			[[nodiscard]] std::byte* map(const std::size_t size) override;
+
+			///
+			/// Unmap and delete a buffer object.
+			///
+			/// \param mapped Pointer returned by map().
+			///
+			void unmap(std::byte* mapped) noexcept override;
+
+			///
+			/// Get most recently mapped buffer object.
+			///
+			/// \return Const uint. 0 if nothing is mapped.
+			///
+			[[nodiscard]] const unsigned int id() const noexcept override;
+
+			///
+			/// Insert a fence after all commands issued so far.
+			///
+			/// \return GLsync handle.
+			///
+			[[nodiscard]] void* fence() override;
+
+			///
+			/// Block until a fence has been signaled.
+			///
+			/// \param fence GLsync handle.
+			///
+			/// \return True if the calling thread had to wait.
+			///
+			[[maybe_unused]] const bool wait(void* fence) override;
+
+			///
+			/// Delete a fence.
+			///
+			/// \param fence GLsync handle.
+			///
+			void destroy_fence(void* fence) noexcept override;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			GLStreamBackend(const GLStreamBackend&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			GLStreamBackend& operator=(const GLStreamBackend&) = delete;
+
+		private:
+			///
+			/// Mapped pointer and buffer object of each live mapping.
+			///
+			std::vector<std::pair<std::byte*, unsigned int>> m_buffers;
+
+			///
+			/// Most recently mapped buffer object.
+			///
+			unsigned int m_current;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
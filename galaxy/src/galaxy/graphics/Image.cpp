@@ -0,0 +1,37 @@
+///
+/// Image.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <stb/stb_image.h>
+
+#include "galaxy/error/Log.hpp"
+
+#include "Image.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		std::optional<Image> decode_image(std::span<const char> data, const bool flip)
+		{
+			// The global flag is shared with loads on other threads.
+			stbi_set_flip_vertically_on_load_thread(flip);
+
+			Image image;
+			auto* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()), static_cast<int>(data.size()), &image.m_width, &image.m_height, nullptr, STBI_rgb_alpha);
+			if (pixels == nullptr)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to decode image: {0}.", stbi_failure_reason());
+				return std::nullopt;
+			}
+
+			image.m_pixels.assign(pixels, pixels + static_cast<std::size_t>(image.m_width) * image.m_height * STBI_rgb_alpha);
+			stbi_image_free(pixels);
+
+			return std::make_optional(std::move(image));
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
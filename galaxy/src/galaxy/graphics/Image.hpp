@@ -0,0 +1,54 @@
+///
+/// Image.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_IMAGE_HPP_
+#define GALAXY_GRAPHICS_IMAGE_HPP_
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// Decoded RGBA8 pixels, ready to upload to a texture.
+		///
+		struct Image final
+		{
+			///
+			/// Pixel data, 4 bytes per pixel.
+			///
+			std::vector<unsigned char> m_pixels;
+
+			///
+			/// Width in pixels.
+			///
+			int m_width = 0;
+
+			///
+			/// Height in pixels.
+			///
+			int m_height = 0;
+		};
+
+		///
+		/// \brief Decode an encoded image (png, jpg, etc) to RGBA8.
+		///
+		/// Does not touch OpenGL, so it can run on any thread.
+		///
+		/// \param data Encoded image.
+		/// \param flip Flip vertically, as textures expect.
+		///
+		/// \return Decoded image, or std::nullopt if stb_image could not decode it.
+		///
+		[[nodiscard]] std::optional<Image> decode_image(std::span<const char> data, const bool flip = true);
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -78,5 +78,10 @@ namespace galaxy
 		{
 			return m_count;
 		}
+
+		const unsigned int IndexBuffer::id() const noexcept
+		{
+			return m_ibo;
+		}
 	} // namespace graphics
 } // namespace galaxy
\ No newline at end of file
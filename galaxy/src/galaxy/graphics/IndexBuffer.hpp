@@ -72,6 +72,13 @@ namespace galaxy
 			///
 			[[nodiscard]] const int index_count() const noexcept;
 
+			///
+			/// Get OpenGL id.
+			///
+			/// \return Const unsigned int.
+			///
+			[[nodiscard]] const unsigned int id() const noexcept;
+
 		private:
 			///
 			/// Copy constructor.
@@ -0,0 +1,61 @@
+///
+/// QuadIndexBuffer.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <vector>
+
+#include "QuadIndexBuffer.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		QuadIndexBuffer::QuadIndexBuffer()
+		{
+			std::vector<unsigned int> is;
+			is.reserve(MAX_QUADS * 6);
+
+			unsigned int increment = 0;
+			for (unsigned int counter = 0; counter < MAX_QUADS; counter++)
+			{
+				is.push_back(0 + increment);
+				is.push_back(1 + increment);
+				is.push_back(3 + increment);
+				is.push_back(1 + increment);
+				is.push_back(2 + increment);
+				is.push_back(3 + increment);
+
+				increment += 4;
+			}
+
+			m_ibo.create(is, true);
+		}
+
+		std::shared_ptr<QuadIndexBuffer> QuadIndexBuffer::acquire()
+		{
+			static std::weak_ptr<QuadIndexBuffer> s_shared;
+
+			auto shared = s_shared.lock();
+			if (!shared)
+			{
+				shared   = std::shared_ptr<QuadIndexBuffer>(new QuadIndexBuffer());
+				s_shared = shared;
+			}
+
+			return shared;
+		}
+
+		const unsigned int QuadIndexBuffer::id() const noexcept
+		{
+			return m_ibo.id();
+		}
+
+		const std::size_t QuadIndexBuffer::size_bytes() const noexcept
+		{
+			return static_cast<std::size_t>(m_ibo.index_count()) * sizeof(unsigned int);
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,94 @@
+///
+/// QuadIndexBuffer.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_QUADINDEXBUFFER_HPP_
+#define GALAXY_GRAPHICS_QUADINDEXBUFFER_HPP_
+
+#include <memory>
+
+#include "galaxy/graphics/IndexBuffer.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// \brief Index buffer for drawing quads as two triangles, shared by every batch.
+		///
+		/// Created on first acquire and destroyed when the last holder releases it.
+		/// Never written to after creation.
+		///
+		class QuadIndexBuffer final
+		{
+		public:
+			///
+			/// Most quads a single draw call can use.
+			///
+			inline static constexpr const unsigned int MAX_QUADS = 100000;
+
+			///
+			/// Destructor.
+			///
+			~QuadIndexBuffer() noexcept = default;
+
+			///
+			/// Get the shared instance, creating it if needed. Must be called on the thread owning the GL context.
+			///
+			/// \return Shared pointer to index buffer.
+			///
+			[[nodiscard]] static std::shared_ptr<QuadIndexBuffer> acquire();
+
+			///
+			/// Get OpenGL id.
+			///
+			/// \return Const unsigned int.
+			///
+			[[nodiscard]] const unsigned int id() const noexcept;
+
+			///
+			/// Get size of index data.
+			///
+			/// \return Const std::size_t in bytes.
+			///
+			[[nodiscard]] const std::size_t size_bytes() const noexcept;
+
+		private:
+			///
+			/// Constructor.
+			///
+			QuadIndexBuffer();
+
+			///
+			/// Copy constructor.
+			///
+			QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			QuadIndexBuffer(QuadIndexBuffer&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			QuadIndexBuffer& operator=(QuadIndexBuffer&&) = delete;
+
+		private:
+			///
+			/// Index data.
+			///
+			IndexBuffer m_ibo;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+///
+/// RenderCommand.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <cmath>
+
+#include "RenderCommand.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		const std::uint64_t RenderCommand::make_key(const int layer, const RenderShader shader, const unsigned int texture, const std::uint16_t depth) noexcept
+		{
+			// Bias layer so negative layers sort before positive ones.
+			const auto biased = static_cast<std::uint64_t>(std::clamp(layer, -32768, 32767) + 32768);
+
+			return (biased << 48) | ((static_cast<std::uint64_t>(shader) & 0xFF) << 40) | ((static_cast<std::uint64_t>(texture) & 0xFFFFFF) << 16) | depth;
+		}
+
+		const std::uint16_t RenderCommand::make_depth(const float bottom) noexcept
+		{
+			// Bias so objects above the origin sort first. NaN falls through to 0.
+			const auto clamped = std::clamp(std::round(bottom), -32768.0f, 32767.0f);
+			return std::isnan(clamped) ? 0 : static_cast<std::uint16_t>(static_cast<int>(clamped) + 32768);
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,166 @@
+///
+/// RenderCommand.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_RENDERCOMMAND_HPP_
+#define GALAXY_GRAPHICS_RENDERCOMMAND_HPP_
+
+#include <array>
+#include <cstdint>
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// Shader a render command is drawn with.
+		///
+		enum class RenderShader : int
+		{
+			///
+			/// Points, lines and polygons.
+			///
+			POINT = 0,
+
+			///
+			/// Text.
+			///
+			TEXT = 1,
+
+			///
+			/// Single sprite.
+			///
+			SPRITE = 2,
+
+			///
+			/// Spritebatch.
+			///
+			BATCH = 3,
+
+			///
+			/// Instanced particles.
+			///
+			INSTANCE = 4
+		};
+
+		///
+		/// Plain uniform values for a draw. Each shader only reads the values it declares.
+		///
+		struct RenderUniforms final
+		{
+			///
+			/// Column major model matrix.
+			///
+			std::array<float, 16> m_transform = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+
+			///
+			/// Normalized RGBA colour.
+			///
+			std::array<float, 4> m_colour = {1.0f, 1.0f, 1.0f, 1.0f};
+
+			///
+			/// Texture width.
+			///
+			float m_width = 0.0f;
+
+			///
+			/// Texture height.
+			///
+			float m_height = 0.0f;
+
+			///
+			/// Opacity from 0 to 255.
+			///
+			int m_opacity = 255;
+
+			///
+			/// Equality operator.
+			///
+			[[nodiscard]] bool operator==(const RenderUniforms&) const = default;
+		};
+
+		///
+		/// \brief A single draw, submitted to a RenderQueue.
+		///
+		/// Commands are sorted by m_key, then executed with redundant state changes removed.
+		///
+		struct RenderCommand final
+		{
+			///
+			/// Sort key. See make_key().
+			///
+			std::uint64_t m_key = 0;
+
+			///
+			/// Vertex Array Object to bind.
+			///
+			unsigned int m_vao = 0;
+
+			///
+			/// Texture to bind.
+			///
+			unsigned int m_texture = 0;
+
+			///
+			/// Element buffer index count.
+			///
+			int m_index_count = 0;
+
+			///
+			/// Type to render i.e. GL_LINES, GL_TRIANGLES, etc.
+			///
+			unsigned int m_type = 0;
+
+			///
+			/// Instance count. If greater than 0 object is drawn as an instance.
+			///
+			unsigned int m_instance_count = 0;
+
+			///
+			/// Added to each index before fetching a vertex. Used by objects that stream into a ring buffer.
+			///
+			int m_base_vertex = 0;
+
+			///
+			/// Shader to draw with.
+			///
+			RenderShader m_shader = RenderShader::POINT;
+
+			///
+			/// Uniform values.
+			///
+			RenderUniforms m_uniforms;
+
+			///
+			/// \brief Build a sort key.
+			///
+			/// From most to least significant: 16 bits layer, 8 bits shader, 24 bits texture, 16 bits depth.
+			///
+			/// \param layer Render layer. Clamped to a 16 bit signed range.
+			/// \param shader Shader used to draw.
+			/// \param texture Texture id. Only used for ordering, so ids beyond 24 bits only affect grouping.
+			/// \param depth Order within a layer, shader and texture.
+			///
+			/// \return Const 64 bit key.
+			///
+			[[nodiscard]] static const std::uint64_t make_key(const int layer, const RenderShader shader, const unsigned int texture, const std::uint16_t depth) noexcept;
+
+			///
+			/// \brief Build depth from the bottom edge of an object.
+			///
+			/// Objects lower on screen are drawn over objects above them, same as a "topdown" draw order in Tiled.
+			/// Commands that draw many objects at once, i.e. batches and particles, use a depth of 0.
+			///
+			/// \param bottom Bottom edge in pixels. Clamped to a 16 bit signed range.
+			///
+			/// \return Const depth for make_key().
+			///
+			[[nodiscard]] static const std::uint16_t make_depth(const float bottom) noexcept;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,8 @@
+///
+/// RenderDevice.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "RenderDevice.hpp"
\ No newline at end of file
@@ -0,0 +1,80 @@
+///
+/// RenderDevice.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_RENDERDEVICE_HPP_
+#define GALAXY_GRAPHICS_RENDERDEVICE_HPP_
+
+#include "galaxy/graphics/RenderCommand.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// \brief State changes and draws issued by a RenderQueue.
+		///
+		/// Kept separate from the queue so sorting and state tracking can be driven by a mock in tests.
+		///
+		class RenderDevice
+		{
+		public:
+			///
+			/// Virtual destructor.
+			///
+			virtual ~RenderDevice() noexcept = default;
+
+			///
+			/// Bind a shader.
+			///
+			/// \param shader Shader to bind.
+			///
+			virtual void bind_shader(const RenderShader shader) = 0;
+
+			///
+			/// Upload uniforms to the bound shader.
+			///
+			/// \param shader Bound shader.
+			/// \param uniforms Values to upload.
+			///
+			virtual void upload_uniforms(const RenderShader shader, const RenderUniforms& uniforms) = 0;
+
+			///
+			/// Bind a texture.
+			///
+			/// \param texture Texture id.
+			///
+			virtual void bind_texture(const unsigned int texture) = 0;
+
+			///
+			/// Bind a vertex array.
+			///
+			/// \param vao Vertex array id.
+			///
+			virtual void bind_vao(const unsigned int vao) = 0;
+
+			///
+			/// Draw with currently bound state.
+			///
+			/// \param command Command to draw.
+			///
+			virtual void draw(const RenderCommand& command) = 0;
+
+			///
+			/// Unbind everything once the queue is done.
+			///
+			virtual void reset() = 0;
+
+		protected:
+			///
+			/// Constructor.
+			///
+			RenderDevice() noexcept = default;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -5,9 +5,6 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
-#include <algorithm>
-#include <execution>
-
 #include "RenderLayer.hpp"
 
 namespace galaxy
@@ -17,13 +14,11 @@ namespace galaxy
 		RenderLayer::RenderLayer(const int layer)
 		    : m_layer {layer}
 		{
-			m_data.reserve(50);
 		}
 
 		RenderLayer::RenderLayer(RenderLayer&& rl) noexcept
 		{
 			this->m_batches = std::move(rl.m_batches);
-			this->m_data    = std::move(rl.m_data);
 			this->m_layer   = rl.m_layer;
 		}
 
@@ -32,7 +27,6 @@ namespace galaxy
 			if (this != &rl)
 			{
 				this->m_batches = std::move(rl.m_batches);
-				this->m_data    = std::move(rl.m_data);
 				this->m_layer   = rl.m_layer;
 			}
 
@@ -44,32 +38,27 @@ namespace galaxy
 			clear();
 		}
 
-		void RenderLayer::submit(Renderable& renderable)
-		{
-			m_data.emplace_back(std::move(renderable));
-		}
-
-		void RenderLayer::submit_batched_sprites(Shader& batch_shader)
+		void RenderLayer::submit_batched_sprites(RenderQueue& queue)
 		{
 			for (auto& [index, batch] : m_batches)
 			{
-				// clang-format off
-				Renderable renderable = {
-					.m_vao = batch.vao(),
-					.m_texture = batch.gl_texture(),
-					.m_index_count = batch.count(),
-					.m_type = GL_TRIANGLES,
-					.m_configure_shader = [&]()
-					{
-						batch_shader.bind();
-						batch_shader.set_uniform("u_width", static_cast<float>(batch.get_width()));
-						batch_shader.set_uniform("u_height", static_cast<float>(batch.get_height()));
-					}
-				};
-				// clang-format on
+				if (batch.count() == 0)
+				{
+					continue;
+				}
 
-				submit(renderable);
-				batch.buffer_data();
+				RenderCommand command;
+				command.m_key               = RenderCommand::make_key(m_layer, RenderShader::BATCH, batch.gl_texture(), 0);
+				command.m_vao               = batch.vao();
+				command.m_texture           = batch.gl_texture();
+				command.m_index_count       = batch.count();
+				command.m_type              = GL_TRIANGLES;
+				command.m_base_vertex       = batch.base_vertex();
+				command.m_shader            = RenderShader::BATCH;
+				command.m_uniforms.m_width  = static_cast<float>(batch.get_width());
+				command.m_uniforms.m_height = static_cast<float>(batch.get_height());
+
+				queue.submit(command);
 			}
 		}
 
@@ -79,42 +68,6 @@ namespace galaxy
 			{
 				batch.clear();
 			}
-
-			m_data.clear();
-		}
-
-		void RenderLayer::draw()
-		{
-			std::sort(std::execution::par, m_data.begin(), m_data.end(), [&](const auto& left, const auto& right) {
-				if (left.m_type == right.m_type)
-				{
-					return left.m_texture < right.m_texture;
-				}
-				else
-				{
-					return left.m_type < right.m_type;
-				}
-			});
-
-			for (auto& renderable : m_data)
-			{
-				renderable.m_configure_shader();
-				glBindVertexArray(renderable.m_vao);
-				glBindTexture(GL_TEXTURE_2D, renderable.m_texture);
-
-				if (renderable.m_instance_count > 0)
-				{
-					glDrawElementsInstanced(renderable.m_type, renderable.m_index_count, GL_UNSIGNED_INT, nullptr, renderable.m_instance_count);
-				}
-				else
-				{
-					glDrawElements(renderable.m_type, renderable.m_index_count, GL_UNSIGNED_INT, nullptr);
-				}
-			}
-
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glBindVertexArray(0);
-			glUseProgram(0);
 		}
 
 		const int RenderLayer::get_layer() const noexcept
@@ -8,9 +8,7 @@
 #ifndef GALAXY_GRAPHICS_RENDERLAYER_HPP_
 #define GALAXY_GRAPHICS_RENDERLAYER_HPP_
 
-#include <vector>
-
-#include "galaxy/graphics/Renderable.hpp"
+#include "galaxy/graphics/RenderQueue.hpp"
 #include "galaxy/graphics/SpriteBatch.hpp"
 
 namespace galaxy
@@ -18,7 +16,7 @@ namespace galaxy
 	namespace graphics
 	{
 		///
-		/// A layer of renderables to draw to the screen.
+		/// A layer of spritebatches to draw to the screen.
 		///
 		class RenderLayer final
 		{
@@ -49,29 +47,17 @@ namespace galaxy
 			~RenderLayer();
 
 			///
-			/// Submit a renderable to this layer.
-			///
-			/// \param renderable Usually constructed by Renderer2D::submit().
-			///
-			void submit(Renderable& renderable);
-
-			///
-			/// Submit all batched sprites in this layer to the renderer.
+			/// Submit a command for each non-empty spritebatch in this layer.
 			///
-			/// \param batch_shader Shader used to draw sprite batches.
+			/// \param queue Queue to submit to.
 			///
-			void submit_batched_sprites(Shader& batch_shader);
+			void submit_batched_sprites(RenderQueue& queue);
 
 			///
-			/// Clear all data.
+			/// Clear all spritebatches.
 			///
 			void clear();
 
-			///
-			/// Draw everything to screen.
-			///
-			void draw();
-
 			///
 			/// Get numeric layer (depth).
 			///
@@ -101,11 +87,6 @@ namespace galaxy
 			///
 			int m_layer;
 
-			///
-			/// Layer data.
-			///
-			std::vector<Renderable> m_data;
-
 			///
 			/// Layer spritebatches.
 			///
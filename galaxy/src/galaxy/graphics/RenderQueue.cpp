@@ -0,0 +1,152 @@
+///
+/// RenderQueue.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <limits>
+
+#include "RenderQueue.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		void RenderQueue::submit(const RenderCommand& command)
+		{
+			m_sorted.push_back({command.m_key, static_cast<std::uint32_t>(m_commands.size())});
+			m_commands.push_back(command);
+		}
+
+		void RenderQueue::sort()
+		{
+			const auto count = m_sorted.size();
+			if (count < 2)
+			{
+				return;
+			}
+
+			m_scratch.resize(count);
+
+			// LSD radix sort, one byte per pass. Passes where every key shares the same byte are skipped,
+			// which is common for the layer and shader bytes.
+			for (unsigned int shift = 0; shift < 64; shift += 8)
+			{
+				std::array<std::size_t, 256> offsets = {};
+				for (const auto& entry : m_sorted)
+				{
+					offsets[(entry.m_key >> shift) & 0xFF]++;
+				}
+
+				if (offsets[(m_sorted[0].m_key >> shift) & 0xFF] == count)
+				{
+					continue;
+				}
+
+				std::size_t total = 0;
+				for (auto& offset : offsets)
+				{
+					const auto bucket = offset;
+					offset            = total;
+					total += bucket;
+				}
+
+				for (const auto& entry : m_sorted)
+				{
+					m_scratch[offsets[(entry.m_key >> shift) & 0xFF]++] = entry;
+				}
+
+				m_sorted.swap(m_scratch);
+			}
+		}
+
+		void RenderQueue::execute(RenderDevice& device)
+		{
+			constexpr const auto unbound = std::numeric_limits<unsigned int>::max();
+
+			m_stats = {};
+
+			// Uniforms are per program state, so track what each shader was last given.
+			std::array<RenderUniforms, SHADERS> uploaded;
+			std::array<bool, SHADERS> has_uploaded = {};
+
+			int shader           = -1;
+			unsigned int texture = unbound;
+			unsigned int vao     = unbound;
+
+			for (const auto& entry : m_sorted)
+			{
+				const auto& command = m_commands[entry.m_index];
+				const auto index    = static_cast<std::size_t>(command.m_shader);
+
+				if (shader != static_cast<int>(command.m_shader))
+				{
+					shader = static_cast<int>(command.m_shader);
+					device.bind_shader(command.m_shader);
+					m_stats.m_shader_binds++;
+				}
+
+				if (!has_uploaded[index] || uploaded[index] != command.m_uniforms)
+				{
+					uploaded[index]     = command.m_uniforms;
+					has_uploaded[index] = true;
+
+					device.upload_uniforms(command.m_shader, command.m_uniforms);
+					m_stats.m_uniform_uploads++;
+				}
+
+				if (texture != command.m_texture)
+				{
+					texture = command.m_texture;
+					device.bind_texture(texture);
+					m_stats.m_texture_binds++;
+				}
+
+				if (vao != command.m_vao)
+				{
+					vao = command.m_vao;
+					device.bind_vao(vao);
+					m_stats.m_vao_binds++;
+				}
+
+				device.draw(command);
+				m_stats.m_draws++;
+			}
+
+			if (!m_sorted.empty())
+			{
+				device.reset();
+			}
+		}
+
+		void RenderQueue::clear() noexcept
+		{
+			m_commands.clear();
+			m_sorted.clear();
+		}
+
+		std::span<const RenderCommand> RenderQueue::get_commands() const noexcept
+		{
+			return m_commands;
+		}
+
+		std::vector<std::uint32_t> RenderQueue::get_order() const
+		{
+			std::vector<std::uint32_t> order;
+			order.reserve(m_sorted.size());
+
+			for (const auto& entry : m_sorted)
+			{
+				order.push_back(entry.m_index);
+			}
+
+			return order;
+		}
+
+		const RenderStats& RenderQueue::get_stats() const noexcept
+		{
+			return m_stats;
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
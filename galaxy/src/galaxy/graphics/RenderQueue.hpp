@@ -0,0 +1,181 @@
+///
+/// RenderQueue.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_RENDERQUEUE_HPP_
+#define GALAXY_GRAPHICS_RENDERQUEUE_HPP_
+
+#include <span>
+#include <vector>
+
+#include "galaxy/graphics/RenderDevice.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// Counts from the last RenderQueue::execute().
+		///
+		struct RenderStats final
+		{
+			///
+			/// Draw calls issued.
+			///
+			std::size_t m_draws = 0;
+
+			///
+			/// Shader binds issued.
+			///
+			std::size_t m_shader_binds = 0;
+
+			///
+			/// Uniform uploads issued.
+			///
+			std::size_t m_uniform_uploads = 0;
+
+			///
+			/// Texture binds issued.
+			///
+			std::size_t m_texture_binds = 0;
+
+			///
+			/// Vertex array binds issued.
+			///
+			std::size_t m_vao_binds = 0;
+		};
+
+		///
+		/// \brief Buffer of render commands for a frame.
+		///
+		/// Commands are radix sorted by key, which is stable, so commands with equal keys draw in submission order.
+		/// Execution skips shader, uniform, texture and vertex array changes that would not change state.
+		///
+		class RenderQueue final
+		{
+		public:
+			///
+			/// Number of RenderShader values.
+			///
+			inline static constexpr const std::size_t SHADERS = 5;
+
+			///
+			/// Constructor.
+			///
+			RenderQueue() noexcept = default;
+
+			///
+			/// Destructor.
+			///
+			~RenderQueue() noexcept = default;
+
+			///
+			/// Add a command.
+			///
+			/// \param command Command to copy into the queue.
+			///
+			void submit(const RenderCommand& command);
+
+			///
+			/// Sort commands by key.
+			///
+			void sort();
+
+			///
+			/// Issue sorted commands to a device.
+			///
+			/// \param device Device to draw with.
+			///
+			void execute(RenderDevice& device);
+
+			///
+			/// Remove all commands.
+			///
+			void clear() noexcept;
+
+			///
+			/// Get commands in submission order.
+			///
+			/// \return Span of commands.
+			///
+			[[nodiscard]] std::span<const RenderCommand> get_commands() const noexcept;
+
+			///
+			/// Get command indices in sorted order.
+			///
+			/// \return Copy of indices into get_commands().
+			///
+			[[nodiscard]] std::vector<std::uint32_t> get_order() const;
+
+			///
+			/// Get counts from last execute().
+			///
+			/// \return Const reference to stats.
+			///
+			[[nodiscard]] const RenderStats& get_stats() const noexcept;
+
+		private:
+			///
+			/// Key and index pair sorted in place of whole commands.
+			///
+			struct SortEntry final
+			{
+				///
+				/// Command sort key.
+				///
+				std::uint64_t m_key;
+
+				///
+				/// Index of command.
+				///
+				std::uint32_t m_index;
+			};
+
+			///
+			/// Copy constructor.
+			///
+			RenderQueue(const RenderQueue&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			RenderQueue(RenderQueue&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			RenderQueue& operator=(const RenderQueue&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			RenderQueue& operator=(RenderQueue&&) = delete;
+
+		private:
+			///
+			/// Commands in submission order.
+			///
+			std::vector<RenderCommand> m_commands;
+
+			///
+			/// Sorted keys.
+			///
+			std::vector<SortEntry> m_sorted;
+
+			///
+			/// Scratch space for radix passes.
+			///
+			std::vector<SortEntry> m_scratch;
+
+			///
+			/// Counts from last execute().
+			///
+			RenderStats m_stats;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
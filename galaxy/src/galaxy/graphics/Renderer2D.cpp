@@ -5,7 +5,11 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <cstring>
 #include <execution>
+#include <format>
+
+#include <glm/gtc/type_ptr.hpp>
 
 #include "galaxy/components/ParticleEffect.hpp"
 #include "galaxy/components/Primitive2D.hpp"
@@ -352,6 +356,25 @@ namespace galaxy
 {
 	namespace graphics
 	{
+		namespace
+		{
+			///
+			/// Copy a matrix into a uniform payload.
+			///
+			void copy_transform(RenderUniforms& uniforms, const glm::mat4& transform) noexcept
+			{
+				std::memcpy(uniforms.m_transform.data(), glm::value_ptr(transform), sizeof(float) * 16);
+			}
+
+			///
+			/// Copy a colour into a uniform payload.
+			///
+			void copy_colour(RenderUniforms& uniforms, const glm::vec4& colour) noexcept
+			{
+				std::memcpy(uniforms.m_colour.data(), glm::value_ptr(colour), sizeof(float) * 4);
+			}
+		} // namespace
+
 		Renderer2D::Renderer2D() noexcept
 		{
 			m_point_shader.load_raw(point_vert, point_frag);
@@ -364,6 +387,12 @@ namespace galaxy
 
 			m_camera_ubo.create(CAMERA_UBO_INDEX);
 			m_camera_ubo.reserve(sizeof(Camera2D::Data));
+
+			m_device.set_shader(RenderShader::POINT, &m_point_shader);
+			m_device.set_shader(RenderShader::TEXT, &m_text_shader);
+			m_device.set_shader(RenderShader::SPRITE, &m_sprite_shader);
+			m_device.set_shader(RenderShader::BATCH, &m_spritebatch_shader);
+			m_device.set_shader(RenderShader::INSTANCE, &m_instance_shader);
 		}
 
 		Renderer2D::~Renderer2D() noexcept
@@ -415,6 +444,7 @@ namespace galaxy
 		{
 			m_layer_data.clear();
 			m_layers.clear();
+			m_queue.clear();
 		}
 
 		void Renderer2D::buffer_camera(Camera2D& camera)
@@ -459,19 +489,16 @@ namespace galaxy
 
 		void Renderer2D::submit(components::Primitive2D* data, components::Transform2D* transform)
 		{
-			// clang-format off
-			Renderable renderable = {
-				.m_vao = data->vao(),
-				.m_texture = 0,
-				.m_index_count = data->index_count(),
-				.m_configure_shader = [this, data, transform]()
-				{
-					this->m_point_shader.bind();
-					this->m_point_shader.set_uniform("u_colour", data->get_colour().normalized());
-					this->m_point_shader.set_uniform("u_transform", transform->get_transform());
-			    }
-			};
-			// clang-format on
+			auto& layer = m_layer_data.at(data->get_layer());
+
+			RenderCommand command;
+			command.m_key         = RenderCommand::make_key(layer.get_layer(), RenderShader::POINT, 0, RenderCommand::make_depth(transform->get_pos().y + data->get_height()));
+			command.m_vao         = data->vao();
+			command.m_index_count = data->index_count();
+			command.m_shader      = RenderShader::POINT;
+
+			copy_colour(command.m_uniforms, data->get_colour().normalized());
+			copy_transform(command.m_uniforms, transform->get_transform());
 
 			switch (data->get_type())
 			{
@@ -479,63 +506,60 @@ namespace galaxy
 				case Primitives::ELLIPSE:
 				case Primitives::POLYGON:
 				case Primitives::POLYLINE:
-					renderable.m_type = GL_LINE_LOOP;
+					command.m_type = GL_LINE_LOOP;
 					break;
 
 				case Primitives::LINE:
-					renderable.m_type = GL_LINES;
+					command.m_type = GL_LINES;
 					break;
 
 				case Primitives::POINT:
-					renderable.m_type = GL_POINTS;
+					command.m_type = GL_POINTS;
 					break;
 			}
 
-			m_layer_data.at(data->get_layer()).submit(renderable);
+			m_queue.submit(command);
 		}
 
 		void Renderer2D::submit(components::Text* text, components::Transform2D* transform)
 		{
-			// clang-format off
-			Renderable renderable = {
-				.m_vao = text->vao(),
-				.m_texture = text->gl_texture(),
-				.m_index_count = text->count(),
-				.m_type = GL_TRIANGLES,
-				.m_configure_shader = [this, text, transform]()
-				{
-					this->m_text_shader.bind();
-					this->m_text_shader.set_uniform("u_transform", transform->get_transform());
-					this->m_text_shader.set_uniform("u_colour", text->get_colour().normalized());
-					this->m_text_shader.set_uniform<float>("u_width", text->get_batch_width());
-					this->m_text_shader.set_uniform<float>("u_height", text->get_batch_height());
-				}
-			};
-			// clang-format on
-
-			m_layer_data.at(text->get_layer()).submit(renderable);
+			auto& layer = m_layer_data.at(text->get_layer());
+
+			RenderCommand command;
+			command.m_key               = RenderCommand::make_key(layer.get_layer(), RenderShader::TEXT, text->gl_texture(), RenderCommand::make_depth(transform->get_pos().y + text->get_height()));
+			command.m_vao               = text->vao();
+			command.m_texture           = text->gl_texture();
+			command.m_index_count       = text->count();
+			command.m_type              = GL_TRIANGLES;
+			command.m_base_vertex       = text->base_vertex();
+			command.m_shader            = RenderShader::TEXT;
+			command.m_uniforms.m_width  = static_cast<float>(text->get_batch_width());
+			command.m_uniforms.m_height = static_cast<float>(text->get_batch_height());
+
+			copy_transform(command.m_uniforms, transform->get_transform());
+			copy_colour(command.m_uniforms, text->get_colour().normalized());
+
+			m_queue.submit(command);
 		}
 
 		void Renderer2D::submit(components::Sprite* sprite, components::Transform2D* transform)
 		{
-			// clang-format off
-			Renderable renderable = {
-				.m_vao = sprite->vao(),
-				.m_texture = sprite->gl_texture(),
-				.m_index_count = sprite->index_count(),
-				.m_type =  GL_TRIANGLES,
-				.m_configure_shader = [this, sprite, transform]()
-				{
-					this->m_sprite_shader.bind();
-					this->m_sprite_shader.set_uniform("u_transform", transform->get_transform());
-					this->m_sprite_shader.set_uniform<int>("u_opacity", sprite->get_opacity());
-					this->m_sprite_shader.set_uniform<float>("u_width", sprite->get_width());
-					this->m_sprite_shader.set_uniform<float>("u_height", sprite->get_height());
-				}
-			};
-			// clang-format on
-
-			m_layer_data.at(sprite->get_layer()).submit(renderable);
+			auto& layer = m_layer_data.at(sprite->get_layer());
+
+			RenderCommand command;
+			command.m_key                = RenderCommand::make_key(layer.get_layer(), RenderShader::SPRITE, sprite->gl_texture(), RenderCommand::make_depth(transform->get_pos().y + sprite->get_height()));
+			command.m_vao                = sprite->vao();
+			command.m_texture            = sprite->gl_texture();
+			command.m_index_count        = sprite->index_count();
+			command.m_type               = GL_TRIANGLES;
+			command.m_shader             = RenderShader::SPRITE;
+			command.m_uniforms.m_opacity = static_cast<int>(sprite->get_opacity());
+			command.m_uniforms.m_width   = static_cast<float>(sprite->get_width());
+			command.m_uniforms.m_height  = static_cast<float>(sprite->get_height());
+
+			copy_transform(command.m_uniforms, transform->get_transform());
+
+			m_queue.submit(command);
 		}
 
 		void Renderer2D::submit(components::BatchSprite* batch, components::Transform2D* transform)
@@ -545,25 +569,22 @@ namespace galaxy
 
 		void Renderer2D::submit(components::ParticleEffect* particle_effect)
 		{
-			// clang-format off
-			Renderable renderable = {
-				.m_vao = particle_effect->vao(),
-				.m_texture = particle_effect->gl_texture(),
-				.m_index_count = particle_effect->index_count(),
-				.m_type = GL_TRIANGLES,
-				.m_configure_shader = [this, particle_effect]()
-				{
-					this->m_instance_shader.bind();
-					this->m_instance_shader.set_uniform<int>("u_opacity", particle_effect->get_opacity());
-					this->m_instance_shader.set_uniform<float>("u_width", particle_effect->get_width());
-					this->m_instance_shader.set_uniform<float>("u_height", particle_effect->get_height());
-				},
-				.m_instance_count = particle_effect->instance_count()
-			};
-			// clang-format on
-
-			m_layer_data.at(particle_effect->get_layer()).submit(renderable);
-		} // namespace graphics
+			auto& layer = m_layer_data.at(particle_effect->get_layer());
+
+			RenderCommand command;
+			command.m_key                = RenderCommand::make_key(layer.get_layer(), RenderShader::INSTANCE, particle_effect->gl_texture(), 0);
+			command.m_vao                = particle_effect->vao();
+			command.m_texture            = particle_effect->gl_texture();
+			command.m_index_count        = particle_effect->index_count();
+			command.m_type               = GL_TRIANGLES;
+			command.m_instance_count     = particle_effect->instance_count();
+			command.m_shader             = RenderShader::INSTANCE;
+			command.m_uniforms.m_opacity = static_cast<int>(particle_effect->get_opacity());
+			command.m_uniforms.m_width   = static_cast<float>(particle_effect->get_width());
+			command.m_uniforms.m_height  = static_cast<float>(particle_effect->get_height());
+
+			m_queue.submit(command);
+		}
 
 		void Renderer2D::prepare()
 		{
@@ -571,15 +592,43 @@ namespace galaxy
 			{
 				layer->clear();
 			}
+
+			m_queue.clear();
 		}
 
 		void Renderer2D::draw()
 		{
 			for (auto* layer : m_layers)
 			{
-				layer->submit_batched_sprites(m_spritebatch_shader);
-				layer->draw();
+				layer->submit_batched_sprites(m_queue);
 			}
+
+			m_queue.sort();
+			m_queue.execute(m_device);
+		}
+
+		const RenderStats& Renderer2D::get_stats() const noexcept
+		{
+			return m_queue.get_stats();
+		}
+
+		std::string Renderer2D::memory_report() const
+		{
+			std::string report;
+			std::size_t layers = 0;
+
+			for (const auto& [name, layer] : m_layer_data)
+			{
+				for (const auto& [index, batch] : layer.m_batches)
+				{
+					report += std::format("Layer {0}, atlas {1}: {2} bytes reserved, {3} bytes written this frame.\n", name, index, batch.reserved_bytes(), batch.uploaded_bytes());
+					layers += batch.reserved_bytes();
+				}
+			}
+
+			report += std::format("Layer batches: {0} bytes. All vertex streams, including text: {1} bytes. Shared quad indices: {2} bytes.\n", layers, StreamBuffer::get_total_reserved(), QuadIndexBuffer::MAX_QUADS * 6 * sizeof(unsigned int));
+
+			return report;
 		}
 
 		void Renderer2D::draw_sprite_to_target(components::Sprite* sprite, components::Transform2D* transform, RenderTexture* target)
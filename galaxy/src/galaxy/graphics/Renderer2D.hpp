@@ -9,6 +9,7 @@
 #define GALAXY_GRAPHICS_RENDERER2D_HPP_
 
 #include "galaxy/graphics/Camera2D.hpp"
+#include "galaxy/graphics/GLRenderDevice.hpp"
 #include "galaxy/graphics/UniformBuffer.hpp"
 #include "galaxy/graphics/RenderLayer.hpp"
 
@@ -152,7 +153,7 @@ namespace galaxy
 			void prepare();
 
 			///
-			/// Draw everything.
+			/// Sort everything submitted this frame and draw it.
 			///
 			void draw();
 
@@ -165,6 +166,20 @@ namespace galaxy
 			///
 			void draw_sprite_to_target(components::Sprite* sprite, components::Transform2D* transform, RenderTexture* target);
 
+			///
+			/// Describe vertex storage reserved by each spritebatch, plus totals.
+			///
+			/// \return Report with one line per layer batch.
+			///
+			[[nodiscard]] std::string memory_report() const;
+
+			///
+			/// Get draw and state change counts from the last draw().
+			///
+			/// \return Const reference to stats.
+			///
+			[[nodiscard]] const RenderStats& get_stats() const noexcept;
+
 		private:
 			///
 			/// Constructor.
@@ -220,6 +235,16 @@ namespace galaxy
 			/// Sorted renderlayer pointers.
 			///
 			std::vector<RenderLayer*> m_layers;
+
+			///
+			/// Commands for the current frame, across all layers.
+			///
+			RenderQueue m_queue;
+
+			///
+			/// Issues queued commands to OpenGL.
+			///
+			GLRenderDevice m_device;
 		};
 	} // namespace graphics
 } // namespace galaxy
@@ -199,6 +199,11 @@ namespace galaxy
 			return m_loaded;
 		}
 
+		const unsigned int Shader::id() const noexcept
+		{
+			return m_id;
+		}
+
 		const GLint Shader::get_uniform_location(std::string_view name)
 		{
 			const auto str = static_cast<std::string>(name);
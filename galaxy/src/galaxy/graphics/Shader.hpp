@@ -110,6 +110,13 @@ namespace galaxy
 			///
 			[[nodiscard]] const bool is_loaded() const noexcept;
 
+			///
+			/// Get OpenGL program id.
+			///
+			/// \return Const unsigned int.
+			///
+			[[nodiscard]] const unsigned int id() const noexcept;
+
 		private:
 			///
 			/// Copy constructor.
@@ -5,56 +5,43 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <array>
+#include <memory>
+
+#include "galaxy/graphics/GLStreamBackend.hpp"
+
 #include "SpriteBatch.hpp"
 
-constexpr const auto max_quads = 100000;
+///
+/// Quads a batch has room for when its storage is first mapped.
+///
+constexpr const std::size_t min_quads = 64;
 
 namespace galaxy
 {
 	namespace graphics
 	{
 		SpriteBatch::SpriteBatch() noexcept
-		    : m_texture {0}, m_width {0}, m_height {0}
+		    : m_texture {0}, m_width {0}, m_height {0}, m_quads {0}, m_bound_vbo {0}
 		{
-			VertexBuffer vbo;
-			IndexBuffer ibo;
-
-			vbo.create({}, false, max_quads * 4);
-
-			// Free memory immediately.
-			{
-				std::vector<unsigned int> is;
-				is.reserve(max_quads * 6);
-
-				unsigned int increment = 0;
-				for (unsigned int counter = 0; counter < max_quads; counter++)
-				{
-					is.push_back(0 + increment);
-					is.push_back(1 + increment);
-					is.push_back(3 + increment);
-					is.push_back(1 + increment);
-					is.push_back(2 + increment);
-					is.push_back(3 + increment);
-
-					increment += 4;
-				}
-
-				ibo.create(is, true);
-			}
-
-			m_vao.create(vbo, ibo);
-			m_vertices.reserve(max_quads * 4);
+			// Vertex storage is mapped on first add() and sized to what is drawn.
+			m_indices = QuadIndexBuffer::acquire();
+			m_stream.create(std::make_unique<GLStreamBackend>(), sizeof(Vertex) * 4 * min_quads, sizeof(Vertex) * 4 * QuadIndexBuffer::MAX_QUADS);
 		}
 
 		SpriteBatch::SpriteBatch(SpriteBatch&& sb) noexcept
 		{
-			this->m_vao      = std::move(sb.m_vao);
-			this->m_vertices = std::move(sb.m_vertices);
-			this->m_texture  = sb.m_texture;
-			this->m_width    = sb.m_width;
-			this->m_height   = sb.m_height;
-
-			sb.m_vertices.clear();
+			this->m_indices   = std::move(sb.m_indices);
+			this->m_vao       = std::move(sb.m_vao);
+			this->m_stream    = std::move(sb.m_stream);
+			this->m_quads     = sb.m_quads;
+			this->m_bound_vbo = sb.m_bound_vbo;
+			this->m_texture   = sb.m_texture;
+			this->m_width     = sb.m_width;
+			this->m_height    = sb.m_height;
+
+			sb.m_quads     = 0;
+			sb.m_bound_vbo = 0;
 			sb.m_texture = 0;
 			sb.m_width   = 0;
 			sb.m_height  = 0;
@@ -64,13 +51,17 @@ namespace galaxy
 		{
 			if (this != &sb)
 			{
-				this->m_vao      = std::move(sb.m_vao);
-				this->m_vertices = std::move(sb.m_vertices);
-				this->m_texture  = sb.m_texture;
-				this->m_width    = sb.m_width;
-				this->m_height   = sb.m_height;
-
-				sb.m_vertices.clear();
+				this->m_stream    = std::move(sb.m_stream);
+				this->m_vao       = std::move(sb.m_vao);
+				this->m_indices   = std::move(sb.m_indices);
+				this->m_quads     = sb.m_quads;
+				this->m_bound_vbo = sb.m_bound_vbo;
+				this->m_texture   = sb.m_texture;
+				this->m_width     = sb.m_width;
+				this->m_height    = sb.m_height;
+
+				sb.m_quads     = 0;
+				sb.m_bound_vbo = 0;
 				sb.m_texture = 0;
 				sb.m_width   = 0;
 				sb.m_height  = 0;
@@ -81,7 +72,11 @@ namespace galaxy
 
 		SpriteBatch::~SpriteBatch() noexcept
 		{
-			m_vertices.clear();
+			m_stream.destroy();
+			m_indices.reset();
+
+			m_quads     = 0;
+			m_bound_vbo = 0;
 			m_texture = 0;
 			m_width   = 0;
 			m_height  = 0;
@@ -89,50 +84,44 @@ namespace galaxy
 
 		void SpriteBatch::add(components::BatchSprite* sprite, components::Transform2D* transform)
 		{
-			if ((m_vertices.size() * 4) > (max_quads * 4))
+			if (!sprite || !transform)
 			{
-				GALAXY_LOG(GALAXY_ERROR, "Too many quads in batch. Sprite not added. Max is {0}.", max_quads);
+				GALAXY_LOG(GALAXY_WARNING, "Attempted to add nullptr to spritebatch.");
 				return;
 			}
-			else
-			{
-				if (!sprite || !transform)
-				{
-					GALAXY_LOG(GALAXY_WARNING, "Attempted to add nullptr to spritebatch.");
-				}
-				else
-				{
-					Vertex vertex;
 
-					auto result     = (transform->get_transform() * glm::vec4 {0.0f, 0.0f, 0.0f, 1.0f});
-					vertex.m_pos    = {result.x, result.y};
-					vertex.m_texels = {sprite->get_region().m_x, sprite->get_region().m_y + 0.5f};
-					vertex.set_colour({0, 0, 0, sprite->get_opacity()});
+			auto* dest = reinterpret_cast<Vertex*>(m_stream.allocate(sizeof(Vertex) * 4));
+			if (dest == nullptr)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Too many quads in batch. Sprite not added. Max is {0}.", QuadIndexBuffer::MAX_QUADS);
+				return;
+			}
 
-					m_vertices.emplace_back(vertex);
+			bind_storage();
 
-					result          = (transform->get_transform() * glm::vec4 {0.0f + sprite->get_region().m_width, 0.0f, 0.0f, 1.0f});
-					vertex.m_pos    = {result.x, result.y};
-					vertex.m_texels = {(sprite->get_region().m_x + sprite->get_region().m_width) - 0.5f, sprite->get_region().m_y + 0.5f};
-					vertex.set_colour({0, 0, 0, sprite->get_opacity()});
+			const auto& region = sprite->get_region();
+			std::array<Vertex, 4> quad;
 
-					m_vertices.emplace_back(vertex);
+			quad[0].m_pos    = transform->transform_point(0.0f, 0.0f);
+			quad[0].m_texels = {region.m_x, region.m_y + 0.5f};
 
-					result          = (transform->get_transform() * glm::vec4 {0.0f + sprite->get_region().m_width, 0.0f + sprite->get_region().m_height, 0.0f, 1.0f});
-					vertex.m_pos    = {result.x, result.y};
-					vertex.m_texels = {(sprite->get_region().m_x + sprite->get_region().m_width) - 0.5f, (sprite->get_region().m_y + sprite->get_region().m_height) - 0.5f};
-					vertex.set_colour({0, 0, 0, sprite->get_opacity()});
+			quad[1].m_pos    = transform->transform_point(region.m_width, 0.0f);
+			quad[1].m_texels = {(region.m_x + region.m_width) - 0.5f, region.m_y + 0.5f};
 
-					m_vertices.emplace_back(vertex);
+			quad[2].m_pos    = transform->transform_point(region.m_width, region.m_height);
+			quad[2].m_texels = {(region.m_x + region.m_width) - 0.5f, (region.m_y + region.m_height) - 0.5f};
 
-					result          = (transform->get_transform() * glm::vec4 {0.0f, 0.0f + sprite->get_region().m_height, 0.0f, 1.0f});
-					vertex.m_pos    = {result.x, result.y};
-					vertex.m_texels = {sprite->get_region().m_x, (sprite->get_region().m_y + sprite->get_region().m_height) - 0.5f};
-					vertex.set_colour({0, 0, 0, sprite->get_opacity()});
+			quad[3].m_pos    = transform->transform_point(0.0f, region.m_height);
+			quad[3].m_texels = {region.m_x, (region.m_y + region.m_height) - 0.5f};
 
-					m_vertices.emplace_back(vertex);
-				}
+			for (auto& vertex : quad)
+			{
+				vertex.set_colour({0, 0, 0, sprite->get_opacity()});
 			}
+
+			// Mapped memory is write-combined, so write the whole quad in one sequential pass.
+			std::uninitialized_copy(quad.begin(), quad.end(), dest);
+			m_quads++;
 		}
 
 		void SpriteBatch::add_texture(const unsigned int texture)
@@ -143,11 +132,6 @@ namespace galaxy
 			glGetTextureLevelParameteriv(m_texture, 0, GL_TEXTURE_HEIGHT, &m_height);
 		}
 
-		void SpriteBatch::buffer_data()
-		{
-			glNamedBufferData(m_vao.vbo(), sizeof(Vertex) * m_vertices.size(), m_vertices.data(), GL_DYNAMIC_DRAW);
-		}
-
 		void SpriteBatch::bind() noexcept
 		{
 			m_vao.bind();
@@ -162,7 +146,10 @@ namespace galaxy
 
 		void SpriteBatch::clear() noexcept
 		{
-			m_vertices.clear();
+			m_stream.begin();
+			m_quads = 0;
+
+			bind_storage();
 		}
 
 		const int SpriteBatch::get_width() const noexcept
@@ -177,15 +164,23 @@ namespace galaxy
 
 		const int SpriteBatch::count() const noexcept
 		{
-			// Prevents zero division.
-			if (m_vertices.size() == 0)
-			{
-				return 0;
-			}
+			// Six indicies per quad.
+			return 6 * m_quads;
+		}
 
-			// Six indicies per quad. Number of quads is total vertexs / 4.
-			// The size here is always a multiple of 4 so no "uneven" division takes place.
-			return 6 * (m_vertices.size() / 4);
+		const int SpriteBatch::base_vertex() const noexcept
+		{
+			return static_cast<int>(m_stream.get_segment_offset() / sizeof(Vertex));
+		}
+
+		const std::size_t SpriteBatch::uploaded_bytes() const noexcept
+		{
+			return m_stream.get_used();
+		}
+
+		const std::size_t SpriteBatch::reserved_bytes() const noexcept
+		{
+			return m_stream.get_reserved();
 		}
 
 		const unsigned int SpriteBatch::vao() const noexcept
@@ -197,5 +192,18 @@ namespace galaxy
 		{
 			return m_texture;
 		}
+
+		void SpriteBatch::bind_storage() noexcept
+		{
+			const auto vbo = m_stream.get_id();
+			if (vbo != m_bound_vbo)
+			{
+				m_bound_vbo = vbo;
+				if (vbo != 0)
+				{
+					m_vao.set_buffers(vbo, m_indices->id());
+				}
+			}
+		}
 	} // namespace graphics
 } // namespace galaxy
\ No newline at end of file
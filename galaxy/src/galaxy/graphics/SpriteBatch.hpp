@@ -10,6 +10,8 @@
 
 #include "galaxy/components/BatchSprite.hpp"
 #include "galaxy/components/Transform2D.hpp"
+#include "galaxy/graphics/QuadIndexBuffer.hpp"
+#include "galaxy/graphics/StreamBuffer.hpp"
 #include "galaxy/graphics/VertexArray.hpp"
 
 namespace galaxy
@@ -17,7 +19,11 @@ namespace galaxy
 	namespace graphics
 	{
 		///
-		///  Draw a batch of vertex data with a texture in one draw call.
+		/// \brief Draw a batch of vertex data with a texture in one draw call.
+		///
+		/// Vertices are written straight into a persistently mapped, triple buffered ring that grows and
+		/// shrinks with use. Draw with base_vertex() since each frame uses a different segment of the ring.
+		/// All batches share one quad index buffer.
 		///
 		class SpriteBatch final
 		{
@@ -57,11 +63,6 @@ namespace galaxy
 			///
 			void add_texture(const unsigned int texture);
 
-			///
-			/// Copy data from CPU to GPU.
-			///
-			void buffer_data();
-
 			///
 			/// Bind to OpenGL.
 			///
@@ -73,7 +74,7 @@ namespace galaxy
 			void unbind() noexcept;
 
 			///
-			/// Clears the spritebatch of data.
+			/// Clears the spritebatch of data and moves to the next ring segment.
 			///
 			void clear() noexcept;
 
@@ -98,6 +99,27 @@ namespace galaxy
 			///
 			[[nodiscard]] const int count() const noexcept;
 
+			///
+			/// Get base vertex to draw with.
+			///
+			/// \return Const integer.
+			///
+			[[nodiscard]] const int base_vertex() const noexcept;
+
+			///
+			/// Get bytes of vertex data written since last clear.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t uploaded_bytes() const noexcept;
+
+			///
+			/// Get bytes of vertex storage reserved by this batch.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t reserved_bytes() const noexcept;
+
 			///
 			/// Get GL VAO.
 			///
@@ -123,6 +145,11 @@ namespace galaxy
 			///
 			SpriteBatch& operator=(const SpriteBatch&) = delete;
 
+			///
+			/// Point the VAO at stream storage if it was reallocated.
+			///
+			void bind_storage() noexcept;
+
 		private:
 			///
 			/// Width cache.
@@ -139,15 +166,30 @@ namespace galaxy
 			///
 			unsigned int m_texture;
 
+			///
+			/// Shared quad indices.
+			///
+			std::shared_ptr<QuadIndexBuffer> m_indices;
+
 			///
 			/// Vertex data.
 			///
 			VertexArray m_vao;
 
 			///
-			/// Array of vertices.
+			/// Number of quads written since last clear.
+			///
+			int m_quads;
+
+			///
+			/// Stream storage the VAO currently points at.
+			///
+			unsigned int m_bound_vbo;
+
+			///
+			/// Mapped vertex storage. Declared after the VAO so it is unmapped before the buffer is deleted.
 			///
-			std::vector<Vertex> m_vertices;
+			StreamBuffer m_stream;
 		};
 	} // namespace graphics
 } // namespace galaxy
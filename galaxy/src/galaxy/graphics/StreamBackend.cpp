@@ -0,0 +1,8 @@
+///
+/// StreamBackend.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "StreamBackend.hpp"
\ No newline at end of file
@@ -0,0 +1,86 @@
+///
+/// StreamBackend.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_STREAMBACKEND_HPP_
+#define GALAXY_GRAPHICS_STREAMBACKEND_HPP_
+
+#include <cstddef>
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// \brief Storage and synchronisation used by a StreamBuffer.
+		///
+		/// Kept separate from the ring logic so the ring can be driven by a mock in tests.
+		///
+		class StreamBackend
+		{
+		public:
+			///
+			/// Virtual destructor.
+			///
+			virtual ~StreamBackend() noexcept = default;
+
+			///
+			/// Allocate new storage and map it for writing until it is unmapped.
+			/// Previously mapped storage stays valid so data can be carried over.
+			///
+			/// \param size Size in bytes.
+			///
+			/// \return Pointer to mapped memory, or nullptr on failure.
+			///
+			[[nodiscard]] virtual std::byte* map(const std::size_t size) = 0;
+
+			///
+			/// Unmap and release storage.
+			///
+			/// \param mapped Pointer returned by map().
+			///
+			virtual void unmap(std::byte* mapped) noexcept = 0;
+
+			///
+			/// Get handle of the most recently mapped storage, i.e. a buffer object id.
+			///
+			/// \return Const uint. 0 if nothing is mapped.
+			///
+			[[nodiscard]] virtual const unsigned int id() const noexcept = 0;
+
+			///
+			/// Insert a fence after all commands issued so far.
+			///
+			/// \return Opaque fence handle.
+			///
+			[[nodiscard]] virtual void* fence() = 0;
+
+			///
+			/// Block until a fence has been signaled.
+			///
+			/// \param fence Fence handle returned by fence().
+			///
+			/// \return True if the calling thread had to wait.
+			///
+			[[maybe_unused]] virtual const bool wait(void* fence) = 0;
+
+			///
+			/// Delete a fence.
+			///
+			/// \param fence Fence handle returned by fence().
+			///
+			virtual void destroy_fence(void* fence) noexcept = 0;
+
+		protected:
+			///
+			/// Constructor.
+			///
+			StreamBackend() noexcept = default;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
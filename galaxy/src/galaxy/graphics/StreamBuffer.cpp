@@ -0,0 +1,322 @@
+///
+/// StreamBuffer.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <cstring>
+
+#include "galaxy/error/Log.hpp"
+
+#include "StreamBuffer.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		StreamBuffer::StreamBuffer() noexcept
+		    : m_backend {nullptr}, m_mapped {nullptr}, m_segment_size {0}, m_min_segment {0}, m_max_segment {0}, m_idle_frames {0}, m_idle_peak {0}, m_current {0}, m_used {0}, m_total {0}, m_stalls {0}
+		{
+			m_fences.fill(nullptr);
+		}
+
+		StreamBuffer::StreamBuffer(StreamBuffer&& sb) noexcept
+		{
+			this->m_backend      = std::move(sb.m_backend);
+			this->m_mapped       = sb.m_mapped;
+			this->m_fences       = sb.m_fences;
+			this->m_segment_size = sb.m_segment_size;
+			this->m_min_segment  = sb.m_min_segment;
+			this->m_max_segment  = sb.m_max_segment;
+			this->m_idle_frames  = sb.m_idle_frames;
+			this->m_idle_peak    = sb.m_idle_peak;
+			this->m_current      = sb.m_current;
+			this->m_used         = sb.m_used;
+			this->m_total        = sb.m_total;
+			this->m_stalls       = sb.m_stalls;
+
+			sb.m_mapped = nullptr;
+			sb.m_fences.fill(nullptr);
+			sb.m_segment_size = 0;
+			sb.m_min_segment  = 0;
+			sb.m_max_segment  = 0;
+			sb.m_current      = 0;
+			sb.m_used         = 0;
+		}
+
+		StreamBuffer& StreamBuffer::operator=(StreamBuffer&& sb) noexcept
+		{
+			if (this != &sb)
+			{
+				destroy();
+
+				this->m_backend      = std::move(sb.m_backend);
+				this->m_mapped       = sb.m_mapped;
+				this->m_fences       = sb.m_fences;
+				this->m_segment_size = sb.m_segment_size;
+				this->m_min_segment  = sb.m_min_segment;
+				this->m_max_segment  = sb.m_max_segment;
+				this->m_idle_frames  = sb.m_idle_frames;
+				this->m_idle_peak    = sb.m_idle_peak;
+				this->m_current      = sb.m_current;
+				this->m_used         = sb.m_used;
+				this->m_total        = sb.m_total;
+				this->m_stalls       = sb.m_stalls;
+
+				sb.m_mapped = nullptr;
+				sb.m_fences.fill(nullptr);
+				sb.m_segment_size = 0;
+				sb.m_min_segment  = 0;
+				sb.m_max_segment  = 0;
+				sb.m_current      = 0;
+				sb.m_used         = 0;
+			}
+
+			return *this;
+		}
+
+		StreamBuffer::~StreamBuffer() noexcept
+		{
+			destroy();
+		}
+
+		void StreamBuffer::create(std::unique_ptr<StreamBackend>&& backend, const std::size_t min_segment, const std::size_t max_segment)
+		{
+			destroy();
+
+			if (!backend || min_segment == 0 || max_segment < min_segment)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Stream buffer needs a backend and a valid segment size range.");
+				return;
+			}
+
+			m_backend     = std::move(backend);
+			m_min_segment = min_segment;
+			m_max_segment = max_segment;
+		}
+
+		void StreamBuffer::destroy() noexcept
+		{
+			release();
+
+			m_backend.reset();
+			m_min_segment = 0;
+			m_max_segment = 0;
+		}
+
+		void StreamBuffer::begin()
+		{
+			if (m_mapped == nullptr)
+			{
+				return;
+			}
+
+			const auto frame = m_used;
+
+			// Only segments that were written to can still be read by the GPU.
+			if (frame > 0)
+			{
+				m_fences[m_current] = m_backend->fence();
+			}
+
+			m_current = (m_current + 1) % SEGMENTS;
+			m_used    = 0;
+
+			if (frame * 4 <= m_segment_size)
+			{
+				m_idle_frames++;
+				m_idle_peak = std::max(m_idle_peak, frame);
+			}
+			else
+			{
+				m_idle_frames = 0;
+				m_idle_peak   = 0;
+			}
+
+			if (m_idle_frames >= SHRINK_FRAMES)
+			{
+				const auto peak = m_idle_peak;
+				m_idle_frames   = 0;
+				m_idle_peak     = 0;
+
+				if (peak == 0)
+				{
+					release();
+					return;
+				}
+
+				auto target = m_min_segment;
+				while (target < peak * 2 && target < m_max_segment)
+				{
+					target *= 2;
+				}
+
+				// New storage has never been used by the GPU, so there is nothing to wait on.
+				if (target < m_segment_size && resize(target))
+				{
+					return;
+				}
+			}
+
+			auto& fence = m_fences[m_current];
+			if (fence != nullptr)
+			{
+				if (m_backend->wait(fence))
+				{
+					m_stalls++;
+				}
+
+				m_backend->destroy_fence(fence);
+				fence = nullptr;
+			}
+		}
+
+		std::byte* StreamBuffer::allocate(const std::size_t size) noexcept
+		{
+			if (m_used + size > m_segment_size)
+			{
+				if (!m_backend)
+				{
+					return nullptr;
+				}
+
+				auto target = std::max(m_min_segment, m_segment_size * 2);
+				while (target < m_used + size && target < m_max_segment)
+				{
+					target *= 2;
+				}
+
+				target = std::min(target, m_max_segment);
+				if (target < m_used + size || !resize(target))
+				{
+					return nullptr;
+				}
+			}
+
+			auto* ptr = m_mapped + get_segment_offset() + m_used;
+
+			m_used += size;
+			m_total += size;
+
+			return ptr;
+		}
+
+		const std::size_t StreamBuffer::get_segment() const noexcept
+		{
+			return m_current;
+		}
+
+		const std::size_t StreamBuffer::get_segment_offset() const noexcept
+		{
+			return m_current * m_segment_size;
+		}
+
+		const std::size_t StreamBuffer::get_segment_size() const noexcept
+		{
+			return m_segment_size;
+		}
+
+		const std::size_t StreamBuffer::get_used() const noexcept
+		{
+			return m_used;
+		}
+
+		const std::size_t StreamBuffer::get_reserved() const noexcept
+		{
+			return m_segment_size * SEGMENTS;
+		}
+
+		const unsigned int StreamBuffer::get_id() const noexcept
+		{
+			return m_mapped != nullptr ? m_backend->id() : 0;
+		}
+
+		const std::size_t StreamBuffer::get_total_bytes() const noexcept
+		{
+			return m_total;
+		}
+
+		const std::size_t StreamBuffer::get_stalls() const noexcept
+		{
+			return m_stalls;
+		}
+
+		const bool StreamBuffer::is_mapped() const noexcept
+		{
+			return m_mapped != nullptr;
+		}
+
+		const std::size_t StreamBuffer::get_total_reserved() noexcept
+		{
+			return s_total_reserved;
+		}
+
+		const bool StreamBuffer::resize(const std::size_t segment_size)
+		{
+			auto* mapped = m_backend->map(segment_size * SEGMENTS);
+			if (mapped == nullptr)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to map stream buffer of {0} bytes.", segment_size * SEGMENTS);
+				return false;
+			}
+
+			// Older segments are only read by the GPU, which keeps the old storage alive until it is done.
+			// Only what was written this frame has to move.
+			if (m_mapped != nullptr && m_used > 0)
+			{
+				std::memcpy(mapped + (m_current * segment_size), m_mapped + get_segment_offset(), m_used);
+			}
+
+			for (auto& fence : m_fences)
+			{
+				if (fence != nullptr)
+				{
+					m_backend->destroy_fence(fence);
+					fence = nullptr;
+				}
+			}
+
+			if (m_mapped != nullptr)
+			{
+				m_backend->unmap(m_mapped);
+				s_total_reserved -= get_reserved();
+			}
+
+			m_mapped       = mapped;
+			m_segment_size = segment_size;
+			s_total_reserved += get_reserved();
+
+			return true;
+		}
+
+		void StreamBuffer::release() noexcept
+		{
+			if (m_backend)
+			{
+				for (auto& fence : m_fences)
+				{
+					if (fence != nullptr)
+					{
+						m_backend->destroy_fence(fence);
+						fence = nullptr;
+					}
+				}
+
+				if (m_mapped != nullptr)
+				{
+					m_backend->unmap(m_mapped);
+					s_total_reserved -= get_reserved();
+				}
+			}
+
+			m_mapped       = nullptr;
+			m_segment_size = 0;
+			m_idle_frames  = 0;
+			m_idle_peak    = 0;
+			m_current      = 0;
+			m_used         = 0;
+		}
+	} // namespace graphics
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,256 @@
+///
+/// StreamBuffer.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_GRAPHICS_STREAMBUFFER_HPP_
+#define GALAXY_GRAPHICS_STREAMBUFFER_HPP_
+
+#include <array>
+#include <memory>
+
+#include "galaxy/graphics/StreamBackend.hpp"
+
+namespace galaxy
+{
+	namespace graphics
+	{
+		///
+		/// \brief Persistently mapped ring of buffer segments for streaming vertex data.
+		///
+		/// Storage is split into SEGMENTS equal segments. Data is written straight into mapped memory
+		/// of the current segment. begin() fences the segment that was just used and moves to the next
+		/// one, waiting only if the GPU is still reading it from SEGMENTS frames ago.
+		///
+		/// Storage is mapped on first use and sized to demand. A segment that fills up is doubled, up to a
+		/// maximum. After SHRINK_FRAMES frames using a quarter or less of a segment, storage is shrunk to
+		/// fit, or released if nothing was written.
+		///
+		class StreamBuffer final
+		{
+		public:
+			///
+			/// Number of segments in the ring.
+			///
+			inline static constexpr const std::size_t SEGMENTS = 3;
+
+			///
+			/// Number of underused frames before storage is shrunk.
+			///
+			inline static constexpr const std::size_t SHRINK_FRAMES = 120;
+
+			///
+			/// Constructor.
+			///
+			StreamBuffer() noexcept;
+
+			///
+			/// Move constructor.
+			///
+			StreamBuffer(StreamBuffer&&) noexcept;
+
+			///
+			/// Move assignment operator.
+			///
+			StreamBuffer& operator=(StreamBuffer&&) noexcept;
+
+			///
+			/// Destructor.
+			///
+			~StreamBuffer() noexcept;
+
+			///
+			/// Set backend and segment size limits. Storage is not mapped until first allocation.
+			///
+			/// \param backend Storage backend. Is move'd into this structure.
+			/// \param min_segment Smallest segment size in bytes. Total storage is SEGMENTS times segment size.
+			/// \param max_segment Largest segment size in bytes. Should be min_segment times a power of 2.
+			///
+			void create(std::unique_ptr<StreamBackend>&& backend, const std::size_t min_segment, const std::size_t max_segment);
+
+			///
+			/// Release storage and backend.
+			///
+			void destroy() noexcept;
+
+			///
+			/// Retire the current segment and start writing to the next one.
+			///
+			void begin();
+
+			///
+			/// Reserve space in the current segment.
+			///
+			/// \param size Size in bytes.
+			///
+			/// \return Pointer to mapped memory, or nullptr if the segment cannot grow to fit.
+			///
+			[[nodiscard]] std::byte* allocate(const std::size_t size) noexcept;
+
+			///
+			/// Get index of the current segment.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_segment() const noexcept;
+
+			///
+			/// Get offset of the current segment from the start of storage.
+			///
+			/// \return Const std::size_t in bytes.
+			///
+			[[nodiscard]] const std::size_t get_segment_offset() const noexcept;
+
+			///
+			/// Get size of a segment.
+			///
+			/// \return Const std::size_t in bytes.
+			///
+			[[nodiscard]] const std::size_t get_segment_size() const noexcept;
+
+			///
+			/// Get bytes written to the current segment since begin().
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_used() const noexcept;
+
+			///
+			/// Get bytes of mapped storage across all segments.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_reserved() const noexcept;
+
+			///
+			/// Get storage handle to bind, from the backend.
+			///
+			/// \return Const uint. 0 if nothing is mapped.
+			///
+			[[nodiscard]] const unsigned int get_id() const noexcept;
+
+			///
+			/// Get bytes written since creation.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_total_bytes() const noexcept;
+
+			///
+			/// Get number of times begin() had to wait on the GPU.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_stalls() const noexcept;
+
+			///
+			/// Is storage mapped.
+			///
+			/// \return True if storage has been allocated.
+			///
+			[[nodiscard]] const bool is_mapped() const noexcept;
+
+			///
+			/// Get bytes of storage mapped by all stream buffers.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] static const std::size_t get_total_reserved() noexcept;
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			StreamBuffer(const StreamBuffer&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+			///
+			/// Map new storage, carrying over data written to the current segment.
+			///
+			/// \param segment_size New segment size in bytes. Must fit data already written.
+			///
+			/// \return True if storage was mapped.
+			///
+			[[nodiscard]] const bool resize(const std::size_t segment_size);
+
+			///
+			/// Release fences and unmap storage. Backend is kept.
+			///
+			void release() noexcept;
+
+		private:
+			///
+			/// Storage backend.
+			///
+			std::unique_ptr<StreamBackend> m_backend;
+
+			///
+			/// Start of mapped storage.
+			///
+			std::byte* m_mapped;
+
+			///
+			/// Fence per segment. nullptr when segment is free.
+			///
+			std::array<void*, SEGMENTS> m_fences;
+
+			///
+			/// Size of one segment.
+			///
+			std::size_t m_segment_size;
+
+			///
+			/// Smallest segment size.
+			///
+			std::size_t m_min_segment;
+
+			///
+			/// Largest segment size.
+			///
+			std::size_t m_max_segment;
+
+			///
+			/// Consecutive frames using a quarter or less of a segment.
+			///
+			std::size_t m_idle_frames;
+
+			///
+			/// Most bytes written in a frame since m_idle_frames was reset.
+			///
+			std::size_t m_idle_peak;
+
+			///
+			/// Current segment.
+			///
+			std::size_t m_current;
+
+			///
+			/// Bytes written to current segment.
+			///
+			std::size_t m_used;
+
+			///
+			/// Bytes written since creation.
+			///
+			std::size_t m_total;
+
+			///
+			/// Times begin() waited on a fence.
+			///
+			std::size_t m_stalls;
+
+			///
+			/// Storage mapped by all stream buffers.
+			///
+			inline static std::size_t s_total_reserved = 0;
+		};
+	} // namespace graphics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
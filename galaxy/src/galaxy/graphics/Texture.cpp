@@ -7,7 +7,6 @@
 
 #include <vector>
 
-#include <stb/stb_image.h>
 #include <stb/stb_image_write.h>
 
 #include "galaxy/core/ServiceLocator.hpp"
@@ -64,88 +63,77 @@ namespace galaxy
 
 		void Texture::load(std::string_view file)
 		{
-			const auto path = SL_HANDLE.vfs()->absolute(file);
-			if (path == std::nullopt)
+			std::optional<Image> image;
+
+			// Archived textures are decoded straight from the mapping.
+			if (const auto packed = SL_HANDLE.vfs()->view(file))
 			{
-				GALAXY_LOG(GALAXY_ERROR, "Failed to find texture: {0}.", file);
+				m_path = static_cast<std::string>(file);
+				image  = decode_image(packed.value());
 			}
-			else
+			else if (const auto path = SL_HANDLE.vfs()->absolute(file))
 			{
 				m_path = path.value();
-
-				glBindTexture(GL_TEXTURE_2D, m_texture);
-
-				stbi_set_flip_vertically_on_load(true);
-				unsigned char* data = stbi_load(m_path.c_str(), &m_width, &m_height, nullptr, STBI_rgb_alpha);
-
-				if (data)
-				{
-					glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-					glGenerateMipmap(GL_TEXTURE_2D);
-
-					if (SL_HANDLE.config()->get<bool>("trilinear-filtering"))
-					{
-						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-					}
-					else
-					{
-						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-					}
-
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-					glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(SL_HANDLE.config()->get<int>("ansio-filter")));
-
-					clamp_to_edge();
-					m_loaded = true;
-				}
-				else
+				if (const auto data = SL_HANDLE.vfs()->open_binary(m_path))
 				{
-					GALAXY_LOG(GALAXY_ERROR, "Failed to load texture: {0}. {1}.", file, stbi_failure_reason());
+					image = decode_image(data.value());
 				}
+			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to find texture: {0}.", file);
+				return;
+			}
 
-				stbi_image_free(data);
-				glBindTexture(GL_TEXTURE_2D, 0);
+			if (image != std::nullopt)
+			{
+				load_image(image.value());
+				clamp_to_edge();
+			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to load texture: {0}.", file);
 			}
 		}
 
 		void Texture::load_mem(std::span<unsigned char> buffer)
 		{
-			glBindTexture(GL_TEXTURE_2D, m_texture);
-
-			stbi_set_flip_vertically_on_load(true);
-			unsigned char* data = stbi_load_from_memory(buffer.data(), static_cast<int>(buffer.size_bytes()), &m_width, &m_height, nullptr, STBI_rgb_alpha);
-
-			if (data)
+			const auto image = decode_image({reinterpret_cast<const char*>(buffer.data()), buffer.size()});
+			if (image != std::nullopt)
+			{
+				load_image(image.value());
+			}
+			else
 			{
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-				glGenerateMipmap(GL_TEXTURE_2D);
+				GALAXY_LOG(GALAXY_ERROR, "Failed to load texture from memory.");
+			}
+		}
 
-				if (SL_HANDLE.config()->get<bool>("trilinear-filtering"))
-				{
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				}
-				else
-				{
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-				}
+		void Texture::load_image(const Image& image)
+		{
+			m_width  = image.m_width;
+			m_height = image.m_height;
 
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-				glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(SL_HANDLE.config()->get<int>("ansio-filter")));
+			glBindTexture(GL_TEXTURE_2D, m_texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.m_pixels.data());
+			glGenerateMipmap(GL_TEXTURE_2D);
 
-				m_loaded = true;
+			if (SL_HANDLE.config()->get<bool>("trilinear-filtering"))
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 			}
 			else
 			{
-				GALAXY_LOG(GALAXY_ERROR, "Failed to load texture from memory: {0}.", stbi_failure_reason());
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 			}
 
-			stbi_image_free(data);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(SL_HANDLE.config()->get<int>("ansio-filter")));
+
+			m_loaded = true;
 			glBindTexture(GL_TEXTURE_2D, 0);
 		}
 
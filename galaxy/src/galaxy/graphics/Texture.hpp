@@ -11,6 +11,7 @@
 #include <span>
 #include <string_view>
 
+#include "galaxy/graphics/Image.hpp"
 #include "galaxy/graphics/TextureFilters.hpp"
 
 namespace galaxy
@@ -61,6 +62,15 @@ namespace galaxy
 			///
 			void load_mem(std::span<unsigned char> buffer);
 
+			///
+			/// \brief Upload decoded pixels.
+			///
+			/// Must be called on the thread that owns the GL context. Decoding can be done anywhere with decode_image().
+			///
+			/// \param image RGBA8 pixels to upload.
+			///
+			void load_image(const Image& image);
+
 			///
 			/// Saves texture to file on disk.
 			///
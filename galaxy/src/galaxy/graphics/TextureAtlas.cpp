@@ -6,6 +6,7 @@
 ///
 
 #include <glad/glad.h>
+#include <nlohmann/json.hpp>
 #include <stb/stb_image.h>
 
 #include "galaxy/components/Sprite.hpp"
@@ -29,7 +30,7 @@ namespace galaxy
 			m_size = std::min(m_size, 4096);
 
 			m_id = meta::StaticIDGen<TextureAtlas>::get();
-			m_packer.init(m_size, m_size);
+			m_packer.init(m_size, m_size, math::PackMethod::MAXRECTS_BSSF);
 
 			m_render_texture.create(m_size, m_size);
 			m_render_texture.clear();
@@ -41,7 +42,7 @@ namespace galaxy
 			m_size = std::min(m_size, 4096);
 
 			m_id = meta::StaticIDGen<TextureAtlas>::get();
-			m_packer.init(m_size, m_size);
+			m_packer.init(m_size, m_size, math::PackMethod::MAXRECTS_BSSF);
 
 			m_render_texture.create(m_size, m_size);
 			m_render_texture.clear();
@@ -93,40 +94,10 @@ namespace galaxy
 
 				if (!m_textures.contains(name.string()))
 				{
-					// Pack into rect then add to hashmap.
 					components::Sprite to_draw_spr;
 					to_draw_spr.load(path.string());
-					to_draw_spr.create("bg");
-
-					const auto opt = m_packer.pack(to_draw_spr.get_width(), to_draw_spr.get_height());
-					if (opt != std::nullopt)
-					{
-						m_render_texture.bind(false);
-
-						// Load texture.
-						components::Transform2D to_draw_tf;
-						to_draw_tf.move(static_cast<float>(opt.value().m_x), static_cast<float>(opt.value().m_y));
-
-						RENDERER_2D().bind_rtt();
-						RENDERER_2D().draw_sprite_to_target(&to_draw_spr, &to_draw_tf, &m_render_texture);
-
-						// clang-format off
-						m_textures[name.string()] =
-						{
-							.m_region = {static_cast<float>(opt.value().m_x), static_cast<float>(opt.value().m_y), static_cast<float>(opt.value().m_width), static_cast<float>(opt.value().m_height)},
-							.m_path = path.string(),
-							.m_index = m_id
-						};
-						// clang-format on
-
-						to_draw_spr.unbind();
-						m_render_texture.unbind();
-					}
-					else
-					{
-						GALAXY_LOG(GALAXY_ERROR, "Failed to pack texture: {0}.", name.string());
-						result = false;
-					}
+
+					result = pack(name.string(), path.string(), to_draw_spr);
 				}
 				else
 				{
@@ -143,6 +114,61 @@ namespace galaxy
 			return result;
 		}
 
+		const bool TextureAtlas::add(std::string_view file, const Image& image)
+		{
+			const auto name = std::filesystem::path(file).stem().string();
+			if (m_textures.contains(name))
+			{
+				GALAXY_LOG(GALAXY_WARNING, "Attempted to add pre-existing texture.");
+				return false;
+			}
+
+			const auto path = SL_HANDLE.vfs()->absolute(file);
+
+			components::Sprite to_draw_spr;
+			to_draw_spr.load_image(image);
+
+			return pack(name, path.value_or(static_cast<std::string>(file)), to_draw_spr);
+		}
+
+		const bool TextureAtlas::add_baked(std::string_view file, const Image& page, const nlohmann::json& textures)
+		{
+			if (!m_textures.empty())
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Baked atlas page {0} must go in an empty atlas.", file);
+				return false;
+			}
+
+			if (page.m_width > m_size || page.m_height > m_size)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Baked atlas page {0} is larger than the max atlas size of {1}.", file, m_size);
+				return false;
+			}
+
+			// Regions are from the top left, and rows are flipped, so the page sits against the top of the texture.
+			glBindTexture(GL_TEXTURE_2D, m_render_texture.get_texture());
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_size - page.m_height, page.m_width, page.m_height, GL_RGBA, GL_UNSIGNED_BYTE, page.m_pixels.data());
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			const auto path = SL_HANDLE.vfs()->absolute(file).value_or(static_cast<std::string>(file));
+			for (const auto& [name, texture] : textures.items())
+			{
+				// clang-format off
+				m_textures[name] =
+				{
+					.m_region = {texture.at("x").get<float>(), texture.at("y").get<float>(), texture.at("width").get<float>(), texture.at("height").get<float>()},
+					.m_path = path,
+					.m_index = m_id
+				};
+				// clang-format on
+			}
+
+			// Free space on the page isn't tracked, so stop anything else being packed over it.
+			static_cast<void>(m_packer.pack(m_size, m_size));
+
+			return true;
+		}
+
 		void TextureAtlas::add_multi(std::span<std::string> files)
 		{
 			for (const auto& file : files)
@@ -226,5 +252,43 @@ namespace galaxy
 		{
 			return m_render_texture.get_texture();
 		}
+
+		const bool TextureAtlas::pack(const std::string& name, const std::string& path, components::Sprite& sprite)
+		{
+			// Pack into rect then add to hashmap.
+			sprite.create("bg");
+
+			const auto opt = m_packer.pack(sprite.get_width(), sprite.get_height());
+			if (opt != std::nullopt)
+			{
+				m_render_texture.bind(false);
+
+				// Load texture.
+				components::Transform2D to_draw_tf;
+				to_draw_tf.move(static_cast<float>(opt.value().m_x), static_cast<float>(opt.value().m_y));
+
+				RENDERER_2D().bind_rtt();
+				RENDERER_2D().draw_sprite_to_target(&sprite, &to_draw_tf, &m_render_texture);
+
+				// clang-format off
+				m_textures[name] =
+				{
+					.m_region = {static_cast<float>(opt.value().m_x), static_cast<float>(opt.value().m_y), static_cast<float>(opt.value().m_width), static_cast<float>(opt.value().m_height)},
+					.m_path = path,
+					.m_index = m_id
+				};
+				// clang-format on
+
+				sprite.unbind();
+				m_render_texture.unbind();
+
+				return true;
+			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to pack texture: {0}.", name);
+				return false;
+			}
+		}
 	} // namespace graphics
 } // namespace galaxy
\ No newline at end of file
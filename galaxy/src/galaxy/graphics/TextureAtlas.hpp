@@ -8,13 +8,20 @@
 #ifndef GALAXY_GRAPHICS_TEXTUREATLAS_HPP_
 #define GALAXY_GRAPHICS_TEXTUREATLAS_HPP_
 
+#include <nlohmann/json_fwd.hpp>
 #include <robin_hood.h>
 
+#include "galaxy/graphics/Image.hpp"
 #include "galaxy/graphics/RenderTexture.hpp"
 #include "galaxy/math/RectPack.hpp"
 
 namespace galaxy
 {
+	namespace components
+	{
+		class Sprite;
+	} // namespace components
+
 	namespace graphics
 	{
 		///
@@ -85,6 +92,29 @@ namespace galaxy
 			///
 			[[maybe_unused]] const bool add(std::string_view file);
 
+			///
+			/// Add an already decoded texture to the atlas, i.e. one decoded by res::Loader.
+			///
+			/// \param file Texture file in the vfs the image was decoded from. Used for the name.
+			/// \param image Decoded pixels.
+			///
+			/// \return Const boolean True if add was successful.
+			///
+			[[maybe_unused]] const bool add(std::string_view file, const Image& image);
+
+			///
+			/// \brief Fill an empty atlas with a page baked by graphics::bake_atlas.
+			///
+			/// The page is uploaded as is, with no drawing. Nothing else can be packed into the atlas afterwards.
+			///
+			/// \param file Page image in the vfs.
+			/// \param page Page pixels, decoded flipped like any other texture.
+			/// \param textures Region of each texture on the page, from the manifest.
+			///
+			/// \return Const boolean True if successful.
+			///
+			[[maybe_unused]] const bool add_baked(std::string_view file, const Image& page, const nlohmann::json& textures);
+
 			///
 			/// Adds multiple files at once.
 			///
@@ -169,6 +199,17 @@ namespace galaxy
 			///
 			TextureAtlas& operator=(const TextureAtlas&) = delete;
 
+			///
+			/// Pack a loaded sprite into the atlas.
+			///
+			/// \param name Key of texture.
+			/// \param path Path the texture was loaded from.
+			/// \param sprite Sprite holding the texture.
+			///
+			/// \return False if there was no room.
+			///
+			[[nodiscard]] const bool pack(const std::string& name, const std::string& path, components::Sprite& sprite);
+
 		private:
 			///
 			/// Unique ID assigned to this texture atlas instance.
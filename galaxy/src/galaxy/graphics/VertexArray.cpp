@@ -27,6 +27,7 @@ namespace galaxy
 			this->m_counter = va.m_counter;
 			this->m_vbo     = std::move(va.m_vbo);
 			this->m_ibo     = std::move(va.m_ibo);
+			this->m_layout  = std::move(va.m_layout);
 
 			va.m_vao     = 0;
 			va.m_counter = 0;
@@ -36,10 +37,13 @@ namespace galaxy
 		{
 			if (this != &va)
 			{
+				glDeleteVertexArrays(1, &this->m_vao);
+
 				this->m_vao     = va.m_vao;
 				this->m_counter = va.m_counter;
 				this->m_vbo     = std::move(va.m_vbo);
 				this->m_ibo     = std::move(va.m_ibo);
+				this->m_layout  = std::move(va.m_layout);
 
 				va.m_vao     = 0;
 				va.m_counter = 0;
@@ -81,6 +85,28 @@ namespace galaxy
 			ib.unbind();
 		}
 
+		void VertexArray::set_buffers(const unsigned int vbo, const unsigned int ibo) noexcept
+		{
+			bind();
+			glBindBuffer(GL_ARRAY_BUFFER, vbo);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+			// Attribute pointers capture the bound array buffer, so they are respecified for the new buffer.
+			m_counter = 0;
+			for (const auto& attribute : m_layout.get_attributes())
+			{
+				glEnableVertexAttribArray(m_counter);
+				glVertexAttribPointer(m_counter, attribute.m_size, attribute.m_type, attribute.m_normalized, sizeof(Vertex), (GLvoid*)attribute.m_offset);
+
+				++m_counter;
+			}
+
+			// Element buffer binding is part of VAO state, so unbind the VAO first.
+			unbind();
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		}
+
 		void VertexArray::bind() noexcept
 		{
 			glBindVertexArray(m_vao);
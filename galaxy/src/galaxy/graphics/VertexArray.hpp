@@ -50,6 +50,16 @@ namespace galaxy
 			///
 			void create(VertexBuffer& vb, IndexBuffer& ib);
 
+			///
+			/// \brief Point vertex array at buffers it does not own.
+			///
+			/// Can be called again to swap buffers, i.e. when streamed storage is reallocated.
+			///
+			/// \param vbo OpenGL vertex buffer id. Caller manages lifetime.
+			/// \param ibo OpenGL index buffer id. Caller manages lifetime.
+			///
+			void set_buffers(const unsigned int vbo, const unsigned int ibo) noexcept;
+
 			///
 			/// Bind the current vertex array to current GL context.
 			///
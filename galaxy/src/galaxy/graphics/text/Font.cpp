@@ -76,6 +76,31 @@ namespace galaxy
 		}
 
 		const bool Font::create(std::string_view file, const int size)
+		{
+			// Archived fonts are read straight from the mapping.
+			if (const auto packed = SL_HANDLE.vfs()->view(file))
+			{
+				return create(file, packed.value(), size);
+			}
+
+			const auto path = SL_HANDLE.vfs()->absolute(file);
+			if (path == std::nullopt)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Tried to open non-existent font: {0}.", file);
+				return false;
+			}
+
+			const auto data = SL_HANDLE.vfs()->open_binary(path.value());
+			if (data == std::nullopt)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to read font: {0}.", file);
+				return false;
+			}
+
+			return create(file, std::span<const char> {data.value()}, size);
+		}
+
+		const bool Font::create(std::string_view file, std::span<const char> data, const int size)
 		{
 			bool success = true;
 
@@ -86,144 +111,136 @@ namespace galaxy
 			}
 			else
 			{
-				const auto path = SL_HANDLE.vfs()->absolute(file);
-				if (path == std::nullopt)
+				m_filename = static_cast<std::string>(file);
+				m_size     = size;
+
+				FT_Face face;
+				const auto error = FT_New_Memory_Face(FT_HANDLE.lib(), reinterpret_cast<const FT_Byte*>(data.data()), static_cast<FT_Long>(data.size()), 0, &face);
+				if (error != FT_OK)
 				{
-					GALAXY_LOG(GALAXY_ERROR, "Tried to open non-existent font: {0}.", file);
+					GALAXY_LOG(GALAXY_ERROR, "Failed to create font face for: {0}.", file);
 					success = false;
 				}
 				else
 				{
-					m_filename = static_cast<std::string>(file);
-					m_size     = size;
-
-					FT_Face face;
-					if (FT_New_Face(FT_HANDLE.lib(), path.value().c_str(), 0, &face) != FT_OK)
-					{
-						GALAXY_LOG(GALAXY_ERROR, "Failed to create font face for: {0}.", file);
-						success = false;
-					}
-					else
+					int orig_alignment = 0;
+					glGetIntegerv(GL_UNPACK_ALIGNMENT, &orig_alignment);
+					glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+					GLuint char_vbo = 0;
+					GLuint char_vao = 0;
+					glGenVertexArrays(1, &char_vao);
+					glGenBuffers(1, &char_vbo);
+					glBindVertexArray(char_vao);
+					glBindBuffer(GL_ARRAY_BUFFER, char_vbo);
+					glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+					glEnableVertexAttribArray(0);
+					glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+					glBindBuffer(GL_ARRAY_BUFFER, 0);
+					glBindVertexArray(0);
+
+					FT_Set_Pixel_Sizes(face, 0, size);
+
+					int max_ascent  = 0;
+					int max_descent = 0;
+					int total_width = 0;
+
+					FT_UInt index = 0;
+					auto c        = FT_Get_First_Char(face, &index);
+					while (index)
 					{
-						int orig_alignment = 0;
-						glGetIntegerv(GL_UNPACK_ALIGNMENT, &orig_alignment);
-						glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-						GLuint char_vbo = 0;
-						GLuint char_vao = 0;
-						glGenVertexArrays(1, &char_vao);
-						glGenBuffers(1, &char_vbo);
-						glBindVertexArray(char_vao);
-						glBindBuffer(GL_ARRAY_BUFFER, char_vbo);
-						glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-						glEnableVertexAttribArray(0);
-						glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-						glBindBuffer(GL_ARRAY_BUFFER, 0);
-						glBindVertexArray(0);
-
-						FT_Set_Pixel_Sizes(face, 0, size);
-
-						int max_ascent  = 0;
-						int max_descent = 0;
-						int total_width = 0;
+						Character c_obj;
+						FT_Load_Char(face, c, FT_LOAD_RENDER);
+
+						glBindTexture(GL_TEXTURE_2D, c_obj.m_gl_texture);
+						glTexImage2D(
+						    GL_TEXTURE_2D,
+						    0,
+						    GL_RED,
+						    face->glyph->bitmap.width,
+						    face->glyph->bitmap.rows,
+						    0,
+						    GL_RED,
+						    GL_UNSIGNED_BYTE,
+						    face->glyph->bitmap.buffer);
+
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+						glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+						glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(SL_HANDLE.config()->get<int>("ansio-filter")));
+
+						c_obj.m_size.x    = face->glyph->bitmap.width;
+						c_obj.m_size.y    = face->glyph->bitmap.rows;
+						c_obj.m_bearing.x = face->glyph->bitmap_left;
+						c_obj.m_bearing.y = face->glyph->bitmap_top;
+						c_obj.m_advance   = face->glyph->advance.x;
+
+						if (face->glyph->bitmap_top > max_ascent)
+						{
+							max_ascent = face->glyph->bitmap_top;
+						}
 
-						FT_UInt index = 0;
-						auto c        = FT_Get_First_Char(face, &index);
-						while (index)
+						if (((face->glyph->metrics.height >> 6) - face->glyph->bitmap_top) > max_descent)
 						{
-							Character c_obj;
-							FT_Load_Char(face, c, FT_LOAD_RENDER);
-
-							glBindTexture(GL_TEXTURE_2D, c_obj.m_gl_texture);
-							glTexImage2D(
-							    GL_TEXTURE_2D,
-							    0,
-							    GL_RED,
-							    face->glyph->bitmap.width,
-							    face->glyph->bitmap.rows,
-							    0,
-							    GL_RED,
-							    GL_UNSIGNED_BYTE,
-							    face->glyph->bitmap.buffer);
-
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-							glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-							glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(SL_HANDLE.config()->get<int>("ansio-filter")));
-
-							c_obj.m_size.x    = face->glyph->bitmap.width;
-							c_obj.m_size.y    = face->glyph->bitmap.rows;
-							c_obj.m_bearing.x = face->glyph->bitmap_left;
-							c_obj.m_bearing.y = face->glyph->bitmap_top;
-							c_obj.m_advance   = face->glyph->advance.x;
-
-							if (face->glyph->bitmap_top > max_ascent)
-							{
-								max_ascent = face->glyph->bitmap_top;
-							}
-
-							if (((face->glyph->metrics.height >> 6) - face->glyph->bitmap_top) > max_descent)
-							{
-								max_descent = (face->glyph->metrics.height >> 6) - face->glyph->bitmap_top;
-							}
-
-							total_width += (c_obj.m_advance >> 6);
-
-							m_characters.emplace(c, std::move(c_obj));
-							c = FT_Get_Next_Char(face, c, &index);
-							glBindTexture(GL_TEXTURE_2D, 0);
+							max_descent = (face->glyph->metrics.height >> 6) - face->glyph->bitmap_top;
 						}
 
-						m_height = max_ascent + max_descent;
-						glPixelStorei(GL_UNPACK_ALIGNMENT, orig_alignment);
+						total_width += (c_obj.m_advance >> 6);
 
-						m_fontmap.create(total_width, m_height);
-						m_fontmap.bind(true);
+						m_characters.emplace(c, std::move(c_obj));
+						c = FT_Get_Next_Char(face, c, &index);
+						glBindTexture(GL_TEXTURE_2D, 0);
+					}
 
-						m_shader.bind();
-						m_shader.set_uniform("u_proj", m_fontmap.get_proj());
-						glBindVertexArray(char_vao);
+					m_height = max_ascent + max_descent;
+					glPixelStorei(GL_UNPACK_ALIGNMENT, orig_alignment);
 
-						float offset_x = 0.0f;
-						for (auto& [c, c_obj] : m_characters)
-						{
-							float x = offset_x + c_obj.m_bearing.x;
-							float y = m_characters['X'].m_bearing.y - c_obj.m_bearing.y;
-							float w = c_obj.m_size.x;
-							float h = c_obj.m_size.y;
+					m_fontmap.create(total_width, m_height);
+					m_fontmap.bind(true);
 
-							float vertices[6][4] = {
-							    {x, y + h, 0.0f, 1.0f},
-							    {x + w, y, 1.0f, 0.0f},
-							    {x, y, 0.0f, 0.0f},
+					m_shader.bind();
+					m_shader.set_uniform("u_proj", m_fontmap.get_proj());
+					glBindVertexArray(char_vao);
 
-							    {x, y + h, 0.0f, 1.0f},
-							    {x + w, y + h, 1.0f, 1.0f},
-							    {x + w, y, 1.0f, 0.0f}};
+					float offset_x = 0.0f;
+					for (auto& [c, c_obj] : m_characters)
+					{
+						float x = offset_x + c_obj.m_bearing.x;
+						float y = m_characters['X'].m_bearing.y - c_obj.m_bearing.y;
+						float w = c_obj.m_size.x;
+						float h = c_obj.m_size.y;
 
-							c_obj.m_region = {x, 0.0f, w, static_cast<float>(m_height)};
-							glBindTexture(GL_TEXTURE_2D, c_obj.m_gl_texture);
+						float vertices[6][4] = {
+						    {x, y + h, 0.0f, 1.0f},
+						    {x + w, y, 1.0f, 0.0f},
+						    {x, y, 0.0f, 0.0f},
 
-							glBindBuffer(GL_ARRAY_BUFFER, char_vbo);
-							glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+						    {x, y + h, 0.0f, 1.0f},
+						    {x + w, y + h, 1.0f, 1.0f},
+						    {x + w, y, 1.0f, 0.0f}};
 
-							glDrawArrays(GL_TRIANGLES, 0, 6);
+						c_obj.m_region = {x, 0.0f, w, static_cast<float>(m_height)};
+						glBindTexture(GL_TEXTURE_2D, c_obj.m_gl_texture);
 
-							offset_x += (c_obj.m_advance >> 6);
-						}
+						glBindBuffer(GL_ARRAY_BUFFER, char_vbo);
+						glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
-						glBindBuffer(GL_ARRAY_BUFFER, 0);
-						glBindTexture(GL_TEXTURE_2D, 0);
-						m_fontmap.unbind();
+						glDrawArrays(GL_TRIANGLES, 0, 6);
 
-						glBindVertexArray(0);
-						glDeleteVertexArrays(1, &char_vao);
-						glDeleteBuffers(1, &char_vbo);
+						offset_x += (c_obj.m_advance >> 6);
 					}
 
-					FT_Done_Face(face);
+					glBindBuffer(GL_ARRAY_BUFFER, 0);
+					glBindTexture(GL_TEXTURE_2D, 0);
+					m_fontmap.unbind();
+
+					glBindVertexArray(0);
+					glDeleteVertexArrays(1, &char_vao);
+					glDeleteBuffers(1, &char_vbo);
 				}
+
+				FT_Done_Face(face);
 			}
 
 			return success;
@@ -8,6 +8,8 @@
 #ifndef GALAXY_GRAPHICS_TEXT_FONT_HPP_
 #define GALAXY_GRAPHICS_TEXT_FONT_HPP_
 
+#include <span>
+
 #include <robin_hood.h>
 
 #include "galaxy/graphics/text/Character.hpp"
@@ -64,6 +66,17 @@ namespace galaxy
 			///
 			[[maybe_unused]] const bool create(std::string_view file, const int size);
 
+			///
+			/// Creates the font from font file data already in memory. Must be called on the thread with the GL context.
+			///
+			/// \param file Path of the font file, for serialization.
+			/// \param data Contents of the font file. Only needs to live until this returns.
+			/// \param size Font size.
+			///
+			/// \return True if successful.
+			///
+			[[maybe_unused]] const bool create(std::string_view file, std::span<const char> data, const int size);
+
 			///
 			/// Get a character.
 			///
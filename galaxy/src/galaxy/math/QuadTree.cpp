@@ -5,16 +5,21 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "QuadTree.hpp"
 
 namespace galaxy
 {
 	namespace math
 	{
-		Quadtree::Quadtree(const int level, const Rect<float>& bounds, int max_objects, int max_levels) noexcept
-		    : m_level {level}, m_bounds {bounds}, m_max_objects {max_objects}, m_max_levels {max_levels}
+		Quadtree::Quadtree(const Rect<float>& bounds, const int max_levels)
+		    : m_bounds {bounds}, m_max_levels {static_cast<std::uint32_t>(std::clamp(max_levels, 0, MAX_LEVELS))}, m_free {NULL_ITEM}
 		{
-			m_objects.reserve(m_max_objects);
+			m_heads.resize(offset(m_max_levels + 1), NULL_ITEM);
+			m_counts.resize(m_heads.size(), 0);
 		}
 
 		Quadtree::~Quadtree() noexcept
@@ -24,136 +29,295 @@ namespace galaxy
 
 		void Quadtree::resize(const int width, const int height) noexcept
 		{
-			m_bounds.m_width  = width;
-			m_bounds.m_height = height;
+			const auto w = static_cast<float>(width);
+			const auto h = static_cast<float>(height);
+
+			if (m_bounds.m_width == w && m_bounds.m_height == h)
+			{
+				return;
+			}
+
+			m_bounds.m_width  = w;
+			m_bounds.m_height = h;
+
+			std::fill(m_heads.begin(), m_heads.end(), NULL_ITEM);
+			std::fill(m_counts.begin(), m_counts.end(), 0);
+
+			for (const auto& [entity, index] : m_lookup)
+			{
+				link(index, locate(m_items[index].m_aabb));
+			}
 		}
 
-		void Quadtree::insert(const Quadtree::Object& object)
+		void Quadtree::insert(const ecs::Entity entity, const AABB& aabb, const graphics::Renderables type)
 		{
-			if (m_nodes[0] != nullptr)
+			if (update(entity, aabb, type))
+			{
+				return;
+			}
+
+			std::uint32_t index = m_free;
+			if (index != NULL_ITEM)
+			{
+				m_free = m_items[index].m_next;
+			}
+			else
 			{
-				const auto index = get_index(object);
-				if (index != -1)
+				index = static_cast<std::uint32_t>(m_items.size());
+				m_items.emplace_back();
+			}
+
+			auto& item    = m_items[index];
+			item.m_aabb   = aabb;
+			item.m_object = {.m_entity = entity, .m_type = type};
+
+			link(index, locate(aabb));
+			m_lookup.emplace(entity, index);
+		}
+
+		const bool Quadtree::update(const ecs::Entity entity, const AABB& aabb, const graphics::Renderables type) noexcept
+		{
+			const auto it = m_lookup.find(entity);
+			if (it == m_lookup.end())
+			{
+				return false;
+			}
+
+			const auto index = it->second;
+			auto& item       = m_items[index];
+
+			item.m_object.m_type = type;
+
+			if (item.m_aabb != aabb)
+			{
+				item.m_aabb = aabb;
+
+				const auto cell = locate(aabb);
+				if (node_index(cell) != item.m_node)
 				{
-					m_nodes[index]->insert(object);
-					return;
+					unlink(index);
+					link(index, cell);
 				}
 			}
 
-			m_objects.push_back(object);
+			return true;
+		}
+
+		void Quadtree::erase(const ecs::Entity entity) noexcept
+		{
+			if (const auto it = m_lookup.find(entity); it != m_lookup.end())
+			{
+				const auto index = it->second;
+
+				unlink(index);
+				m_items[index].m_next = m_free;
+				m_free                = index;
+
+				m_lookup.erase(it);
+			}
+		}
+
+		void Quadtree::erase_if(const std::function<bool(const ecs::Entity)>& predicate)
+		{
+			for (auto it = m_lookup.begin(); it != m_lookup.end();)
+			{
+				if (predicate(it->first))
+				{
+					const auto index = it->second;
+
+					unlink(index);
+					m_items[index].m_next = m_free;
+					m_free                = index;
 
-			if (m_objects.size() > m_max_objects && m_level < m_max_levels)
+					it = m_lookup.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		const bool Quadtree::contains(const ecs::Entity entity) const noexcept
+		{
+			return m_lookup.contains(entity);
+		}
+
+		void Quadtree::query(const AABB& aabb, std::vector<Quadtree::Object>& output) const
+		{
+			// Each pop pushes at most 4 children, one level deeper.
+			std::array<Cell, 3 * MAX_LEVELS + 4> stack;
+			std::size_t top = 0;
+
+			stack[top++] = {0, 0, 0};
+			while (top > 0)
 			{
-				if (m_nodes[0] == nullptr)
+				const auto cell = stack[--top];
+				const auto node = node_index(cell);
+
+				if (m_counts[node] == 0)
 				{
-					split();
+					continue;
 				}
 
-				for (auto it = m_objects.begin(); it != m_objects.end();)
+				// Root also holds everything outside the tree, so it is always visited.
+				if (cell.m_level > 0)
 				{
-					const auto index = get_index(*it);
-					if (index != -1)
+					const auto cells = static_cast<float>(1u << cell.m_level);
+					const auto w     = m_bounds.m_width / cells;
+					const auto h     = m_bounds.m_height / cells;
+					const auto min_x = m_bounds.m_x + (static_cast<float>(cell.m_x) - 0.5f) * w;
+					const auto min_y = m_bounds.m_y + (static_cast<float>(cell.m_y) - 0.5f) * h;
+
+					if (aabb.max().x < min_x || aabb.min().x > min_x + w * 2.0f || aabb.max().y < min_y || aabb.min().y > min_y + h * 2.0f)
 					{
-						m_nodes[index]->insert(*it);
-						it = m_objects.erase(it);
+						continue;
 					}
-					else
+				}
+
+				for (auto index = m_heads[node]; index != NULL_ITEM; index = m_items[index].m_next)
+				{
+					const auto& item = m_items[index];
+					if (item.m_aabb.overlaps(aabb, true))
 					{
-						++it;
+						output.push_back(item.m_object);
 					}
 				}
+
+				if (cell.m_level < m_max_levels)
+				{
+					const auto level = cell.m_level + 1;
+					const auto x     = cell.m_x * 2;
+					const auto y     = cell.m_y * 2;
+
+					stack[top++] = {level, x, y};
+					stack[top++] = {level, x + 1, y};
+					stack[top++] = {level, x, y + 1};
+					stack[top++] = {level, x + 1, y + 1};
+				}
 			}
 		}
 
-		void Quadtree::query(const Quadtree::Object& object, std::vector<Quadtree::Object*>& output)
+		void Quadtree::clear() noexcept
+		{
+			m_items.clear();
+			m_lookup.clear();
+
+			std::fill(m_heads.begin(), m_heads.end(), NULL_ITEM);
+			std::fill(m_counts.begin(), m_counts.end(), 0);
+
+			m_free = NULL_ITEM;
+		}
+
+		const std::size_t Quadtree::size() const noexcept
+		{
+			return m_lookup.size();
+		}
+
+		const std::uint32_t Quadtree::offset(const std::uint32_t level) noexcept
 		{
-			const auto index = get_index(object);
-			if (index != -1 && m_nodes[0] != nullptr)
+			// Sum of 4^i for all levels above.
+			return ((1u << (2 * level)) - 1) / 3;
+		}
+
+		const std::uint32_t Quadtree::node_index(const Cell& cell) noexcept
+		{
+			return offset(cell.m_level) + cell.m_y * (1u << cell.m_level) + cell.m_x;
+		}
+
+		const Quadtree::Cell Quadtree::locate(const AABB& aabb) const noexcept
+		{
+			if (m_bounds.m_width <= 0.0f || m_bounds.m_height <= 0.0f)
 			{
-				m_nodes[index]->query(object, output);
+				return {0, 0, 0};
 			}
 
-			output.reserve(output.size() + m_objects.size());
-			for (auto& object : m_objects)
+			const auto size = aabb.size();
+			const auto cx   = (aabb.min().x + aabb.max().x) * 0.5f - m_bounds.m_x;
+			const auto cy   = (aabb.min().y + aabb.max().y) * 0.5f - m_bounds.m_y;
+
+			if (cx < 0.0f || cy < 0.0f || cx >= m_bounds.m_width || cy >= m_bounds.m_height)
 			{
-				output.push_back(&object);
+				return {0, 0, 0};
 			}
-		}
 
-		void Quadtree::clear()
-		{
-			m_objects.clear();
-
-			for (auto& node : m_nodes)
+			auto level = m_max_levels;
+			while (level > 0)
 			{
-				node.reset();
-				node = nullptr;
+				const auto cells = static_cast<float>(1u << level);
+				if (size.x <= m_bounds.m_width / cells && size.y <= m_bounds.m_height / cells)
+				{
+					break;
+				}
+
+				level--;
 			}
+
+			const auto cells = 1u << level;
+			const auto x     = std::min(static_cast<std::uint32_t>(cx / m_bounds.m_width * static_cast<float>(cells)), cells - 1);
+			const auto y     = std::min(static_cast<std::uint32_t>(cy / m_bounds.m_height * static_cast<float>(cells)), cells - 1);
+
+			return {level, x, y};
 		}
 
-		void Quadtree::split()
+		void Quadtree::link(const std::uint32_t index, const Cell& cell) noexcept
 		{
-			Rect<float> new_bounds;
+			const auto node = node_index(cell);
 
-			new_bounds.m_x      = m_bounds.m_x + (m_bounds.m_width / 2.0f);
-			new_bounds.m_y      = m_bounds.m_y;
-			new_bounds.m_width  = m_bounds.m_width / 2.0f;
-			new_bounds.m_height = m_bounds.m_height / 2.0f;
-			m_nodes[0]          = std::make_unique<Quadtree>(m_level + 1, new_bounds, m_max_objects, m_max_levels);
+			auto& item   = m_items[index];
+			item.m_node  = node;
+			item.m_level = cell.m_level;
+			item.m_prev  = NULL_ITEM;
+			item.m_next  = m_heads[node];
 
-			new_bounds.m_x      = m_bounds.m_x;
-			new_bounds.m_y      = m_bounds.m_y;
-			new_bounds.m_width  = m_bounds.m_width / 2.0f;
-			new_bounds.m_height = m_bounds.m_height / 2.0f;
-			m_nodes[1]          = std::make_unique<Quadtree>(m_level + 1, new_bounds, m_max_objects, m_max_levels);
+			if (item.m_next != NULL_ITEM)
+			{
+				m_items[item.m_next].m_prev = index;
+			}
 
-			new_bounds.m_x      = m_bounds.m_x;
-			new_bounds.m_y      = m_bounds.m_y + (m_bounds.m_height / 2.0f);
-			new_bounds.m_width  = m_bounds.m_width / 2.0f;
-			new_bounds.m_height = m_bounds.m_height / 2.0f;
-			m_nodes[2]          = std::make_unique<Quadtree>(m_level + 1, new_bounds, m_max_objects, m_max_levels);
+			m_heads[node] = index;
 
-			new_bounds.m_x      = m_bounds.m_x + (m_bounds.m_width / 2.0f);
-			new_bounds.m_y      = m_bounds.m_y + (m_bounds.m_height / 2.0f);
-			new_bounds.m_width  = m_bounds.m_width / 2.0f;
-			new_bounds.m_height = m_bounds.m_height / 2.0f;
-			m_nodes[3]          = std::make_unique<Quadtree>(m_level + 1, new_bounds, m_max_objects, m_max_levels);
+			auto x = cell.m_x;
+			auto y = cell.m_y;
+			for (auto level = static_cast<int>(cell.m_level); level >= 0; level--)
+			{
+				m_counts[node_index({static_cast<std::uint32_t>(level), x, y})]++;
+
+				x /= 2;
+				y /= 2;
+			}
 		}
 
-		const int Quadtree::get_index(const Quadtree::Object& object)
+		void Quadtree::unlink(const std::uint32_t index) noexcept
 		{
-			int index = -1;
-
-			const double vert_midpoint = object.m_aabb->min().x + (object.m_aabb->size().x / 2.0f);
-			const double hori_midpoint = object.m_aabb->min().y + (object.m_aabb->size().y / 2.0f);
+			const auto& item = m_items[index];
 
-			const bool fits_in_top    = (object.m_aabb->min().y < hori_midpoint && object.m_aabb->min().y + object.m_aabb->size().y < hori_midpoint);
-			const bool fits_in_bottom = (object.m_aabb->min().y > hori_midpoint);
-
-			if (object.m_aabb->min().x < vert_midpoint && object.m_aabb->min().x + object.m_aabb->size().x < vert_midpoint)
+			if (item.m_prev != NULL_ITEM)
 			{
-				if (fits_in_top)
-				{
-					index = 1;
-				}
-				else if (fits_in_bottom)
-				{
-					index = 2;
-				}
+				m_items[item.m_prev].m_next = item.m_next;
 			}
-			else if (object.m_aabb->min().x > vert_midpoint)
+			else
 			{
-				if (fits_in_top)
-				{
-					index = 0;
-				}
-				else if (fits_in_bottom)
-				{
-					index = 3;
-				}
+				m_heads[item.m_node] = item.m_next;
 			}
 
-			return index;
+			if (item.m_next != NULL_ITEM)
+			{
+				m_items[item.m_next].m_prev = item.m_prev;
+			}
+
+			const auto row   = 1u << item.m_level;
+			const auto local = item.m_node - offset(item.m_level);
+
+			auto x = local % row;
+			auto y = local / row;
+			for (auto level = static_cast<int>(item.m_level); level >= 0; level--)
+			{
+				m_counts[node_index({static_cast<std::uint32_t>(level), x, y})]--;
+
+				x /= 2;
+				y /= 2;
+			}
 		}
 	} // namespace math
 } // namespace galaxy
\ No newline at end of file
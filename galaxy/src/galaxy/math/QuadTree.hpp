@@ -8,10 +8,13 @@
 #ifndef GALAXY_MATH_QUADTREE_HPP_
 #define GALAXY_MATH_QUADTREE_HPP_
 
-#include <array>
-#include <memory>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <vector>
 
+#include <robin_hood.h>
+
 #include "galaxy/ecs/Entity.hpp"
 #include "galaxy/graphics/Renderables.hpp"
 #include "galaxy/math/AABB.hpp"
@@ -22,21 +25,24 @@ namespace galaxy
 	namespace math
 	{
 		///
-		/// 2D spacial partitioning.
+		/// \brief Loose quadtree for 2D spacial partitioning.
+		///
+		/// Every level is a fixed grid over the tree bounds, stored flat so nodes are found by index instead of pointer.
+		/// Each node has loose bounds twice the size of its cell. An object is stored in the deepest level whose cells
+		/// are at least as large as the object, in the cell containing its centre, so it always fits the loose bounds.
+		/// Objects too large or outside the tree bounds are kept in the root.
+		///
+		/// Objects live in a pooled array and are moved between nodes in place, so updating the tree each frame does
+		/// not allocate once it has grown to fit.
 		///
 		class Quadtree final
 		{
 		public:
 			///
-			/// Entity with AABB.
+			/// Entity in the quadtree.
 			///
 			struct Object final
 			{
-				///
-				/// Entity AABB from Renderable component.
-				///
-				AABB* m_aabb;
-
 				///
 				/// Entity AABB belongs to.
 				///
@@ -48,15 +54,18 @@ namespace galaxy
 				graphics::Renderables m_type;
 			};
 
+			///
+			/// Deepest allowed number of levels.
+			///
+			inline static constexpr const int MAX_LEVELS = 10;
+
 			///
 			/// Argument constructor.
 			///
-			/// \param level Level of this quadtree. First is 0.
 			/// \param bounds Quadtree bounds.
-			/// \param max_objects Optional. Max objects in a quadtree before splitting.
-			/// \param max_levels Optional. Total number of levels allowed in a quadtree.
+			/// \param max_levels Optional. Levels below the root. Clamped to MAX_LEVELS.
 			///
-			Quadtree(const int level, const Rect<float>& bounds, int max_objects = 10, int max_levels = 5) noexcept;
+			Quadtree(const Rect<float>& bounds, const int max_levels = 6);
 
 			///
 			/// Destructor.
@@ -64,7 +73,7 @@ namespace galaxy
 			~Quadtree() noexcept;
 
 			///
-			/// Resize quadtree bounds.
+			/// Resize quadtree bounds. Objects are re-distributed if the size changed.
 			///
 			/// \param width New quadtree width.
 			/// \param height New quadtree height.
@@ -72,77 +81,233 @@ namespace galaxy
 			void resize(const int width, const int height) noexcept;
 
 			///
-			/// \brief Insert an object into the quadtree.
+			/// Insert an object into the quadtree. Updates the object if the entity is already in the tree.
+			///
+			/// \param entity Entity to insert.
+			/// \param aabb Entity bounds.
+			/// \param type Renderable type.
+			///
+			void insert(const ecs::Entity entity, const AABB& aabb, const graphics::Renderables type);
+
+			///
+			/// Move an object in the quadtree.
+			///
+			/// \param entity Entity to update.
+			/// \param aabb New entity bounds.
+			/// \param type Renderable type.
+			///
+			/// \return False if the entity is not in the quadtree.
+			///
+			[[maybe_unused]] const bool update(const ecs::Entity entity, const AABB& aabb, const graphics::Renderables type) noexcept;
+
+			///
+			/// Remove an object from the quadtree.
+			///
+			/// \param entity Entity to remove.
+			///
+			void erase(const ecs::Entity entity) noexcept;
+
+			///
+			/// Remove all objects matching a predicate.
+			///
+			/// \param predicate Called with each entity. Return true to remove it.
+			///
+			void erase_if(const std::function<bool(const ecs::Entity)>& predicate);
+
+			///
+			/// Check if an entity is in the quadtree.
 			///
-			/// If the node exceeds the capacity, it will split and add all objects to their corresponding nodes.
+			/// \param entity Entity to check.
 			///
-			/// \param object Object to be inserted.
+			/// \return True if entity has been inserted.
 			///
-			void insert(const Quadtree::Object& object);
+			[[nodiscard]] const bool contains(const ecs::Entity entity) const noexcept;
 
 			///
-			/// Return all entities in the same spacial partition.
+			/// Find all objects overlapping an area.
 			///
-			/// \param object Object to check.
-			/// \param output Array of objects that are in the same spacial partition.
+			/// \param aabb Area to check, i.e. the camera bounds.
+			/// \param output Array to append objects to. Does not allocate if it has enough capacity.
 			///
-			void query(const Quadtree::Object& object, std::vector<Quadtree::Object*>& output);
+			void query(const AABB& aabb, std::vector<Quadtree::Object>& output) const;
 
 			///
 			/// Clears the quadtree.
 			///
-			void clear();
+			void clear() noexcept;
+
+			///
+			/// Get number of objects.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t size() const noexcept;
 
 		private:
+			///
+			/// Marks the end of a list.
+			///
+			inline static constexpr const std::uint32_t NULL_ITEM = std::numeric_limits<std::uint32_t>::max();
+
+			///
+			/// Object stored in a node list.
+			///
+			struct Item final
+			{
+				///
+				/// Object bounds.
+				///
+				AABB m_aabb;
+
+				///
+				/// Entity and type.
+				///
+				Object m_object;
+
+				///
+				/// Node item is stored in.
+				///
+				std::uint32_t m_node;
+
+				///
+				/// Level of node.
+				///
+				std::uint32_t m_level;
+
+				///
+				/// Next item in node, or next free item.
+				///
+				std::uint32_t m_next;
+
+				///
+				/// Previous item in node.
+				///
+				std::uint32_t m_prev;
+			};
+
+			///
+			/// Node position used when walking the tree.
+			///
+			struct Cell final
+			{
+				///
+				/// Level of cell.
+				///
+				std::uint32_t m_level;
+
+				///
+				/// Column of cell.
+				///
+				std::uint32_t m_x;
+
+				///
+				/// Row of cell.
+				///
+				std::uint32_t m_y;
+			};
+
 			///
 			/// Constructor.
 			///
 			Quadtree() = delete;
 
 			///
-			/// Splits the quadtree into 4 sub-trees.
+			/// Copy constructor.
+			///
+			Quadtree(const Quadtree&) = delete;
+
+			///
+			/// Move constructor.
 			///
-			void split();
+			Quadtree(Quadtree&&) = delete;
 
 			///
-			/// Determine which node the object belongs to.
+			/// Copy assignment operator.
 			///
-			/// \param object Object to query its spacial index.
+			Quadtree& operator=(const Quadtree&) = delete;
+
 			///
-			/// \return Index of object. -1 means object cannot completely fit within a child tree and is part of the parent tree.
+			/// Move assignment operator.
 			///
-			[[nodiscard]] const int get_index(const Quadtree::Object& object);
+			Quadtree& operator=(Quadtree&&) = delete;
 
-		private:
 			///
-			/// Current tree level.
+			/// Get index of the first node of a level.
+			///
+			/// \param level Level to get offset of.
+			///
+			/// \return Const std::uint32_t.
 			///
-			int m_level;
+			[[nodiscard]] static const std::uint32_t offset(const std::uint32_t level) noexcept;
 
+			///
+			/// Get index of the node of a cell.
+			///
+			/// \param cell Cell to get node of.
+			///
+			/// \return Const std::uint32_t.
+			///
+			[[nodiscard]] static const std::uint32_t node_index(const Cell& cell) noexcept;
+
+			///
+			/// Determine which cell an object belongs to.
+			///
+			/// \param aabb Object bounds.
+			///
+			/// \return Cell. Root if object does not fit inside the tree.
+			///
+			[[nodiscard]] const Cell locate(const AABB& aabb) const noexcept;
+
+			///
+			/// Add an item to the front of a node list.
+			///
+			/// \param index Index of item.
+			/// \param cell Cell to add item to.
+			///
+			void link(const std::uint32_t index, const Cell& cell) noexcept;
+
+			///
+			/// Remove an item from its node list.
+			///
+			/// \param index Index of item.
+			///
+			void unlink(const std::uint32_t index) noexcept;
+
+		private:
 			///
 			/// Tree bounds.
 			///
 			Rect<float> m_bounds;
 
 			///
-			/// Max objects in a partition.
+			/// Levels below the root.
+			///
+			std::uint32_t m_max_levels;
+
+			///
+			/// Pooled objects.
+			///
+			std::vector<Item> m_items;
+
+			///
+			/// First free item in pool.
 			///
-			int m_max_objects;
+			std::uint32_t m_free;
 
 			///
-			/// Max levels in the tree.
+			/// First item of each node.
 			///
-			int m_max_levels;
+			std::vector<std::uint32_t> m_heads;
 
 			///
-			/// List of stored objects.
+			/// Number of items in each node and all of its children, so empty branches are skipped.
 			///
-			std::vector<Quadtree::Object> m_objects;
+			std::vector<std::uint32_t> m_counts;
 
 			///
-			/// Sub-trees.
+			/// Item of each entity.
 			///
-			std::array<std::unique_ptr<Quadtree>, 4> m_nodes;
+			robin_hood::unordered_flat_map<ecs::Entity, std::uint32_t> m_lookup;
 		};
 	} // namespace math
 } // namespace galaxy
@@ -5,4 +5,151 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
-#include "Random.hpp"
\ No newline at end of file
+#include <atomic>
+
+#include "Random.hpp"
+
+namespace galaxy
+{
+	namespace math
+	{
+		namespace
+		{
+			///
+			/// Seed every thread derives its stream from.
+			///
+			std::atomic<std::uint64_t> s_seed {std::random_device {}()};
+
+			///
+			/// Bumped by seed(), so threads know to reseed.
+			///
+			std::atomic<std::uint64_t> s_generation {1};
+
+			///
+			/// Next stream to give a thread.
+			///
+			std::atomic<std::uint64_t> s_streams {0};
+
+			///
+			/// Generator of a thread and the seed generation it was made from.
+			///
+			struct ThreadGenerator final
+			{
+				Xoshiro256 m_generator;
+				std::uint64_t m_generation = 0;
+			};
+
+			thread_local ThreadGenerator t_generator;
+
+			///
+			/// Seed a generator and jump it to its own stream.
+			///
+			void reseed(ThreadGenerator& local, const std::uint64_t stream) noexcept
+			{
+				local.m_generator.seed(s_seed.load(std::memory_order_relaxed));
+				for (std::uint64_t i = 0; i < stream; i++)
+				{
+					local.m_generator.jump();
+				}
+			}
+
+			///
+			/// SplitMix64, used to expand a seed into generator state.
+			///
+			[[nodiscard]] std::uint64_t splitmix(std::uint64_t& x) noexcept
+			{
+				auto z = (x += 0x9e3779b97f4a7c15);
+				z      = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+				z      = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+				return z ^ (z >> 31);
+			}
+		} // namespace
+
+		Xoshiro256::Xoshiro256(const std::uint64_t seed) noexcept
+		{
+			this->seed(seed);
+		}
+
+		void Xoshiro256::seed(const std::uint64_t seed) noexcept
+		{
+			auto x = seed;
+			for (auto& state : m_state)
+			{
+				state = splitmix(x);
+			}
+		}
+
+		void Xoshiro256::jump() noexcept
+		{
+			constexpr const std::array<std::uint64_t, 4> table = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+
+			std::array<std::uint64_t, 4> state = {0, 0, 0, 0};
+			for (const auto word : table)
+			{
+				for (auto bit = 0; bit < 64; bit++)
+				{
+					if (word & (std::uint64_t {1} << bit))
+					{
+						state[0] ^= m_state[0];
+						state[1] ^= m_state[1];
+						state[2] ^= m_state[2];
+						state[3] ^= m_state[3];
+					}
+
+					static_cast<void>((*this)());
+				}
+			}
+
+			m_state = state;
+		}
+
+		void seed(const std::uint64_t seed) noexcept
+		{
+			s_seed.store(seed, std::memory_order_relaxed);
+			s_streams.store(1, std::memory_order_relaxed);
+
+			// Calling thread always gets the first stream, so its sequence only depends on the seed.
+			t_generator.m_generation = s_generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+			reseed(t_generator, 0);
+		}
+
+		const std::uint64_t get_seed() noexcept
+		{
+			return s_seed.load(std::memory_order_relaxed);
+		}
+
+		Xoshiro256& generator() noexcept
+		{
+			const auto generation = s_generation.load(std::memory_order_acquire);
+			if (t_generator.m_generation != generation)
+			{
+				t_generator.m_generation = generation;
+				reseed(t_generator, s_streams.fetch_add(1, std::memory_order_relaxed));
+			}
+
+			return t_generator.m_generator;
+		}
+
+		void fill_uniform(std::span<float> values, const float min, const float max) noexcept
+		{
+			auto& gen         = generator();
+			const auto range  = (max - min) * 0x1.0p-24f;
+			const auto size   = values.size();
+			std::size_t index = 0;
+
+			// Each 64 bit number gives two floats of 24 bits.
+			for (; index + 1 < size; index += 2)
+			{
+				const auto bits   = gen();
+				values[index]     = min + static_cast<float>(bits >> 40) * range;
+				values[index + 1] = min + static_cast<float>((bits >> 8) & 0xFFFFFF) * range;
+			}
+
+			if (index < size)
+			{
+				values[index] = min + static_cast<float>(gen() >> 40) * range;
+			}
+		}
+	} // namespace math
+} // namespace galaxy
\ No newline at end of file
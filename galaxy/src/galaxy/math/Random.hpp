@@ -8,7 +8,11 @@
 #ifndef GALAXY_MATH_RANDOM_HPP_
 #define GALAXY_MATH_RANDOM_HPP_
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <span>
 
 #include "galaxy/meta/Concepts.hpp"
 
@@ -17,31 +21,195 @@ namespace galaxy
 	namespace math
 	{
 		///
-		/// Source: http://stackoverflow.com/a/32907541.
+		/// \brief xoshiro256** pseudo random number generator.
 		///
-		template<typename Type>
-		using conditional_distribution = std::conditional_t<
-		    std::is_integral<Type>::value,
-		    std::uniform_int_distribution<Type>,
-		    std::conditional_t<std::is_floating_point<Type>::value, std::uniform_real_distribution<Type>, void>>;
+		/// Much faster and smaller than std::mt19937_64. Satisfies UniformRandomBitGenerator, so it can be used with
+		/// the standard distributions. Source: https://prng.di.unimi.it/.
+		///
+		class Xoshiro256 final
+		{
+		public:
+			using result_type = std::uint64_t;
+
+			///
+			/// Argument constructor.
+			///
+			/// \param seed Seed to expand into the generator state.
+			///
+			explicit Xoshiro256(const std::uint64_t seed = 0) noexcept;
+
+			///
+			/// Destructor.
+			///
+			~Xoshiro256() noexcept = default;
+
+			///
+			/// Reset state from a seed. The same seed always gives the same sequence.
+			///
+			/// \param seed Seed to expand into the generator state.
+			///
+			void seed(const std::uint64_t seed) noexcept;
+
+			///
+			/// Advance the generator by 2^128 steps. Used to give each thread a sequence that does not overlap.
+			///
+			void jump() noexcept;
+
+			///
+			/// Generate next number.
+			///
+			/// \return Uniformly distributed 64 bit integer.
+			///
+			inline result_type operator()() noexcept
+			{
+				const auto result = rotl(m_state[1] * 5, 7) * 9;
+				const auto t      = m_state[1] << 17;
+
+				m_state[2] ^= m_state[0];
+				m_state[3] ^= m_state[1];
+				m_state[1] ^= m_state[2];
+				m_state[0] ^= m_state[3];
+
+				m_state[2] ^= t;
+				m_state[3] = rotl(m_state[3], 45);
+
+				return result;
+			}
+
+			///
+			/// Generate a float in [0, 1).
+			///
+			/// \return Float made from the upper 24 bits.
+			///
+			inline float next_float() noexcept
+			{
+				return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+			}
+
+			///
+			/// Generate a double in [0, 1).
+			///
+			/// \return Double made from the upper 53 bits.
+			///
+			inline double next_double() noexcept
+			{
+				return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+			}
+
+			///
+			/// Smallest value generated.
+			///
+			[[nodiscard]] static constexpr result_type min() noexcept
+			{
+				return std::numeric_limits<result_type>::min();
+			}
+
+			///
+			/// Largest value generated.
+			///
+			[[nodiscard]] static constexpr result_type max() noexcept
+			{
+				return std::numeric_limits<result_type>::max();
+			}
+
+		private:
+			///
+			/// Copy constructor.
+			///
+			Xoshiro256(const Xoshiro256&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			Xoshiro256(Xoshiro256&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			Xoshiro256& operator=(const Xoshiro256&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			Xoshiro256& operator=(Xoshiro256&&) = delete;
+
+			///
+			/// Rotate bits left.
+			///
+			[[nodiscard]] static constexpr std::uint64_t rotl(const std::uint64_t x, const int k) noexcept
+			{
+				return (x << k) | (x >> (64 - k));
+			}
+
+		private:
+			///
+			/// Generator state.
+			///
+			std::array<std::uint64_t, 4> m_state;
+		};
+
+		///
+		/// \brief Seed the random number generator of every thread.
+		///
+		/// The calling thread is reseeded straight away. Other threads reseed on their next use, each with its own
+		/// stream, so a replay is deterministic for numbers drawn on the calling thread.
+		///
+		/// \param seed Seed to use. Seeded from std::random_device at startup if never called.
+		///
+		void seed(const std::uint64_t seed) noexcept;
+
+		///
+		/// Get the last seed.
+		///
+		/// \return Const std::uint64_t.
+		///
+		[[nodiscard]] const std::uint64_t get_seed() noexcept;
+
+		///
+		/// Get the random number generator of the calling thread.
+		///
+		/// \return Reference to thread local generator.
+		///
+		[[nodiscard]] Xoshiro256& generator() noexcept;
+
+		///
+		/// Fill an array with random floats.
+		///
+		/// \param values Array to fill.
+		/// \param min Minimum number inclusive.
+		/// \param max Maximum number exclusive.
+		///
+		void fill_uniform(std::span<float> values, const float min = 0.0f, const float max = 1.0f) noexcept;
 
 		///
 		/// Generate a random number of type T.
 		///
 		/// \param min Minimum number inclusive.
-		/// \param max Maximum number inclusive.
+		/// \param max Maximum number inclusive for integers, exclusive for floating point.
 		///
 		/// \return Returns number of the same type as inputs.
 		///
 		template<meta::is_arithmetic Type>
 		[[nodiscard]] inline Type random(const Type min, const Type max) noexcept
 		{
-			std::random_device rd;
-			std::mt19937_64 mt {rd()};
-
-			conditional_distribution<Type> dist {min, max};
+			auto& gen = generator();
 
-			return dist(mt);
+			if constexpr (std::is_floating_point<Type>::value)
+			{
+				if constexpr (std::is_same<Type, float>::value)
+				{
+					return min + (max - min) * gen.next_float();
+				}
+				else
+				{
+					return min + (max - min) * static_cast<Type>(gen.next_double());
+				}
+			}
+			else
+			{
+				std::uniform_int_distribution<Type> dist {min, max};
+				return dist(gen);
+			}
 		}
 	} // namespace math
 } // namespace galaxy
@@ -8,7 +8,13 @@
 #ifndef GALAXY_MATH_RECTPACK_HPP_
 #define GALAXY_MATH_RECTPACK_HPP_
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "galaxy/math/Rect.hpp"
@@ -18,6 +24,30 @@ namespace galaxy
 {
 	namespace math
 	{
+		///
+		/// Algorithm used to place rectangles.
+		///
+		enum class PackMethod : int
+		{
+			///
+			/// Takes the first free rectangle that fits and splits what is left in two. Fast, but free space is
+			/// never merged, so it wastes the most.
+			///
+			GUILLOTINE = 0,
+
+			///
+			/// MaxRects, best short side fit. Tracks every maximal free rectangle and picks the one leaving the
+			/// smallest leftover side. Packs tightest, at the most cost per rectangle.
+			///
+			MAXRECTS_BSSF = 1,
+
+			///
+			/// Skyline, bottom left. Only tracks the top edge of what is placed. Cheap and close to MaxRects when
+			/// rectangles are similar heights, but space under overhangs is lost.
+			///
+			SKYLINE_BL = 2
+		};
+
 		///
 		///	Rectangle 2D bin packing class.
 		///
@@ -36,14 +66,17 @@ namespace galaxy
 			~RectPack() noexcept;
 
 			///
-			/// Set starting width and height of rectangle.
+			/// Set starting width and height of rectangle. Clears anything already packed.
 			///
 			/// Generally should be a power of 2.
 			///
 			/// \param width Width of the master rectangle.
 			/// \param height Height of the master rectangle.
+			/// \param method Algorithm to place rectangles with.
+			/// \param allow_rotation Allow rectangles to be turned 90 degrees when that fits better. A rotated
+			///			result has its width and height swapped, so callers must check for that.
 			///
-			void init(const int width, const int height) noexcept;
+			void init(const int width, const int height, const PackMethod method = PackMethod::GUILLOTINE, const bool allow_rotation = false) noexcept;
 
 			///
 			/// Pack a rectangle into the master rectangle.
@@ -56,6 +89,16 @@ namespace galaxy
 			///
 			[[nodiscard]] std::optional<math::Rect<Type>> pack(const int width, const int height);
 
+			///
+			/// Pack many rectangles at once.
+			///
+			/// \param sizes Width and height of each rectangle.
+			/// \param sort_by_area Pack largest area first, which wastes much less space than packing in the order given.
+			///
+			/// \return Location of each rectangle, in the same order as sizes. std::nullopt for those that did not fit.
+			///
+			[[nodiscard]] std::vector<std::optional<math::Rect<Type>>> pack(std::span<const std::pair<int, int>> sizes, const bool sort_by_area = true);
+
 			///
 			/// Clear all data.
 			///
@@ -72,12 +115,80 @@ namespace galaxy
 			[[nodiscard]] const int get_height() const noexcept;
 
 			///
-			/// Get free rectangles.
+			/// Get packing algorithm.
+			///
+			/// \return Const PackMethod.
+			///
+			[[nodiscard]] const PackMethod get_method() const noexcept;
+
+			///
+			/// Get area covered by packed rectangles.
+			///
+			/// \return Const std::int64_t.
+			///
+			[[nodiscard]] const std::int64_t get_used_area() const noexcept;
+
+			///
+			/// Get fraction of the master rectangle covered by packed rectangles.
+			///
+			/// \return Const float, from 0 to 1.
+			///
+			[[nodiscard]] const float get_occupancy() const noexcept;
+
+			///
+			/// Get free rectangles. Empty when using PackMethod::SKYLINE_BL, which does not track them.
 			///
 			/// \return Const std::vector.
 			///
 			[[nodiscard]] const std::vector<math::Rect<Type>>& get_free_space() const noexcept;
 
+		private:
+			///
+			/// Segment of the skyline. Everything below y from x to x + width is considered used.
+			///
+			struct SkylineNode final
+			{
+				///
+				/// Left edge.
+				///
+				Type m_x;
+
+				///
+				/// Top of used space.
+				///
+				Type m_y;
+
+				///
+				/// Length of segment.
+				///
+				Type m_width;
+			};
+
+			///
+			/// Guillotine placement.
+			///
+			[[nodiscard]] std::optional<math::Rect<Type>> pack_guillotine(const Type width, const Type height);
+
+			///
+			/// MaxRects best short side fit placement.
+			///
+			[[nodiscard]] std::optional<math::Rect<Type>> pack_maxrects(const Type width, const Type height);
+
+			///
+			/// Skyline bottom left placement.
+			///
+			[[nodiscard]] std::optional<math::Rect<Type>> pack_skyline(const Type width, const Type height);
+
+			///
+			/// Find the y a rectangle would rest at if placed on a skyline node.
+			///
+			[[nodiscard]] std::optional<Type> skyline_fit(const std::size_t index, const Type width, const Type height) const noexcept;
+
+			///
+			/// Is a entirely inside b.
+			///
+			[[nodiscard]] static bool is_contained(const math::Rect<Type>& a, const math::Rect<Type>& b) noexcept;
+
 		private:
 			///
 			/// The starting width of the rectangle.
@@ -89,15 +200,35 @@ namespace galaxy
 			///
 			int m_height;
 
+			///
+			/// Placement algorithm.
+			///
+			PackMethod m_method;
+
+			///
+			/// Try rotated rectangles.
+			///
+			bool m_allow_rotation;
+
+			///
+			/// Area of packed rectangles.
+			///
+			std::int64_t m_used_area;
+
 			///
 			/// Free space in master rectangle.
 			///
 			std::vector<math::Rect<Type>> m_free_rects;
+
+			///
+			/// Top edge of packed space, left to right. Only used by PackMethod::SKYLINE_BL.
+			///
+			std::vector<SkylineNode> m_skyline;
 		};
 
 		template<meta::is_arithmetic Type>
 		inline RectPack<Type>::RectPack() noexcept
-		    : m_width {0}, m_height {0}
+		    : m_width {0}, m_height {0}, m_method {PackMethod::GUILLOTINE}, m_allow_rotation {false}, m_used_area {0}
 		{
 		}
 
@@ -105,19 +236,139 @@ namespace galaxy
 		inline RectPack<Type>::~RectPack() noexcept
 		{
 			m_free_rects.clear();
+			m_skyline.clear();
 		}
 
 		template<meta::is_arithmetic Type>
-		inline void RectPack<Type>::init(const int width, const int height) noexcept
+		inline void RectPack<Type>::init(const int width, const int height, const PackMethod method, const bool allow_rotation) noexcept
 		{
-			m_width  = width;
-			m_height = height;
+			m_width          = width;
+			m_height         = height;
+			m_method         = method;
+			m_allow_rotation = allow_rotation;
 
-			m_free_rects.emplace_back(0, 0, m_width, m_height);
+			clear();
 		}
 
 		template<meta::is_arithmetic Type>
 		inline std::optional<math::Rect<Type>> RectPack<Type>::pack(const int width, const int height)
+		{
+			std::optional<math::Rect<Type>> result = std::nullopt;
+
+			if (width > 0 && height > 0)
+			{
+				switch (m_method)
+				{
+					case PackMethod::GUILLOTINE:
+						result = pack_guillotine(static_cast<Type>(width), static_cast<Type>(height));
+						break;
+
+					case PackMethod::MAXRECTS_BSSF:
+						result = pack_maxrects(static_cast<Type>(width), static_cast<Type>(height));
+						break;
+
+					case PackMethod::SKYLINE_BL:
+						result = pack_skyline(static_cast<Type>(width), static_cast<Type>(height));
+						break;
+				}
+
+				if (result.has_value())
+				{
+					m_used_area += static_cast<std::int64_t>(width) * height;
+				}
+			}
+
+			return result;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline std::vector<std::optional<math::Rect<Type>>> RectPack<Type>::pack(std::span<const std::pair<int, int>> sizes, const bool sort_by_area)
+		{
+			std::vector<std::size_t> order(sizes.size());
+			std::iota(order.begin(), order.end(), 0);
+
+			if (sort_by_area)
+			{
+				// Ties go to the longer side, then input order, so results are stable.
+				std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b) {
+					const auto area_a = static_cast<std::int64_t>(sizes[a].first) * sizes[a].second;
+					const auto area_b = static_cast<std::int64_t>(sizes[b].first) * sizes[b].second;
+
+					if (area_a != area_b)
+					{
+						return area_a > area_b;
+					}
+
+					return std::max(sizes[a].first, sizes[a].second) > std::max(sizes[b].first, sizes[b].second);
+				});
+			}
+
+			std::vector<std::optional<math::Rect<Type>>> results(sizes.size());
+			for (const auto index : order)
+			{
+				results[index] = pack(sizes[index].first, sizes[index].second);
+			}
+
+			return results;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline void RectPack<Type>::clear()
+		{
+			m_used_area = 0;
+
+			m_free_rects.clear();
+			m_skyline.clear();
+
+			if (m_method == PackMethod::SKYLINE_BL)
+			{
+				m_skyline.push_back({0, 0, static_cast<Type>(m_width)});
+			}
+			else
+			{
+				m_free_rects.emplace_back(0, 0, m_width, m_height);
+			}
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const int RectPack<Type>::get_width() const noexcept
+		{
+			return m_width;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const int RectPack<Type>::get_height() const noexcept
+		{
+			return m_height;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const PackMethod RectPack<Type>::get_method() const noexcept
+		{
+			return m_method;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const std::int64_t RectPack<Type>::get_used_area() const noexcept
+		{
+			return m_used_area;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const float RectPack<Type>::get_occupancy() const noexcept
+		{
+			const auto total = static_cast<std::int64_t>(m_width) * m_height;
+			return total > 0 ? static_cast<float>(static_cast<double>(m_used_area) / static_cast<double>(total)) : 0.0f;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline const std::vector<math::Rect<Type>>& RectPack<Type>::get_free_space() const noexcept
+		{
+			return m_free_rects;
+		}
+
+		template<meta::is_arithmetic Type>
+		inline std::optional<math::Rect<Type>> RectPack<Type>::pack_guillotine(const Type width, const Type height)
 		{
 			// Result.
 			std::optional<math::Rect<Type>> result = std::nullopt;
@@ -127,38 +378,45 @@ namespace galaxy
 			{
 				auto& space = *rit;
 
-				// Check if rect can fit into space.
-				if (width <= space.m_width && height <= space.m_height)
+				// Check if rect can fit into space, turning it if that is the only way.
+				auto w = width;
+				auto h = height;
+				if (m_allow_rotation && !(w <= space.m_width && h <= space.m_height))
+				{
+					std::swap(w, h);
+				}
+
+				if (w <= space.m_width && h <= space.m_height)
 				{
 					// Make the packed area rectangle.
-					result = std::make_optional<math::Rect<Type>>(space.m_x, space.m_y, width, height);
+					result = std::make_optional<math::Rect<Type>>(space.m_x, space.m_y, w, h);
 
 					// Check to see if shape fills completely.
-					if (width == space.m_width && height == space.m_height)
+					if (w == space.m_width && h == space.m_height)
 					{
 						// Destroy since not free space anymore.
 						std::advance(rit, 1);
 						m_free_rects.erase(rit.base());
 					}
-					else if (width == space.m_width)
+					else if (w == space.m_width)
 					{
 						// If just width fits, shrink new space.
-						space.m_y += height;
-						space.m_height -= height;
+						space.m_y += h;
+						space.m_height -= h;
 					}
-					else if (height == space.m_height)
+					else if (h == space.m_height)
 					{
 						// Same as width, for height.
-						space.m_x += width;
-						space.m_width -= width;
+						space.m_x += w;
+						space.m_width -= w;
 					}
 					else
 					{
 						// Otherwise, split up existing space.
-						math::Rect<Type> temp = {space.m_x + width, space.m_y, space.m_width - width, height};
+						math::Rect<Type> temp = {space.m_x + w, space.m_y, space.m_width - w, h};
 
-						space.m_y += height;
-						space.m_height -= height;
+						space.m_y += h;
+						space.m_height -= h;
 
 						m_free_rects.emplace_back(temp);
 					}
@@ -177,28 +435,213 @@ namespace galaxy
 		}
 
 		template<meta::is_arithmetic Type>
-		inline void RectPack<Type>::clear()
+		inline std::optional<math::Rect<Type>> RectPack<Type>::pack_maxrects(const Type width, const Type height)
 		{
-			m_free_rects.clear();
-			m_free_rects.emplace_back(0, 0, m_width, m_height);
+			std::optional<math::Rect<Type>> result = std::nullopt;
+
+			auto best_short = std::numeric_limits<Type>::max();
+			auto best_long  = std::numeric_limits<Type>::max();
+
+			const auto score = [&](const math::Rect<Type>& space, const Type w, const Type h) {
+				if (w <= space.m_width && h <= space.m_height)
+				{
+					const auto leftover_x = space.m_width - w;
+					const auto leftover_y = space.m_height - h;
+					const auto short_side = std::min(leftover_x, leftover_y);
+					const auto long_side  = std::max(leftover_x, leftover_y);
+
+					if (short_side < best_short || (short_side == best_short && long_side < best_long))
+					{
+						best_short = short_side;
+						best_long  = long_side;
+						result     = std::make_optional<math::Rect<Type>>(space.m_x, space.m_y, w, h);
+					}
+				}
+			};
+
+			for (const auto& space : m_free_rects)
+			{
+				score(space, width, height);
+				if (m_allow_rotation && width != height)
+				{
+					score(space, height, width);
+				}
+			}
+
+			if (!result.has_value())
+			{
+				return result;
+			}
+
+			// Carve the placed rect out of every free rect it touches, keeping the maximal leftovers.
+			const auto& placed = result.value();
+			std::vector<math::Rect<Type>> split;
+
+			std::erase_if(m_free_rects, [&](const math::Rect<Type>& space) {
+				if (placed.m_x >= space.m_x + space.m_width || placed.m_x + placed.m_width <= space.m_x || placed.m_y >= space.m_y + space.m_height ||
+					placed.m_y + placed.m_height <= space.m_y)
+				{
+					return false;
+				}
+
+				if (placed.m_x > space.m_x)
+				{
+					split.emplace_back(space.m_x, space.m_y, placed.m_x - space.m_x, space.m_height);
+				}
+
+				if (placed.m_x + placed.m_width < space.m_x + space.m_width)
+				{
+					split.emplace_back(placed.m_x + placed.m_width, space.m_y, space.m_x + space.m_width - (placed.m_x + placed.m_width), space.m_height);
+				}
+
+				if (placed.m_y > space.m_y)
+				{
+					split.emplace_back(space.m_x, space.m_y, space.m_width, placed.m_y - space.m_y);
+				}
+
+				if (placed.m_y + placed.m_height < space.m_y + space.m_height)
+				{
+					split.emplace_back(space.m_x, placed.m_y + placed.m_height, space.m_width, space.m_y + space.m_height - (placed.m_y + placed.m_height));
+				}
+
+				return true;
+			});
+
+			// Only new rects can be redundant, the old ones were already maximal against each other.
+			for (std::size_t i = 0; i < split.size(); i++)
+			{
+				bool redundant = false;
+				for (std::size_t j = 0; j < split.size() && !redundant; j++)
+				{
+					// Of two equal rects, only the later one is dropped.
+					redundant = i != j && is_contained(split[i], split[j]) && (!is_contained(split[j], split[i]) || i > j);
+				}
+
+				for (std::size_t j = 0; j < m_free_rects.size() && !redundant; j++)
+				{
+					redundant = is_contained(split[i], m_free_rects[j]);
+				}
+
+				if (!redundant)
+				{
+					m_free_rects.push_back(split[i]);
+				}
+			}
+
+			return result;
 		}
 
 		template<meta::is_arithmetic Type>
-		inline const int RectPack<Type>::get_width() const noexcept
+		inline std::optional<math::Rect<Type>> RectPack<Type>::pack_skyline(const Type width, const Type height)
 		{
-			return m_width;
+			std::optional<math::Rect<Type>> result = std::nullopt;
+
+			auto best_top   = std::numeric_limits<Type>::max();
+			auto best_width = std::numeric_limits<Type>::max();
+			auto best_index = m_skyline.size();
+
+			const auto score = [&](const std::size_t index, const Type w, const Type h) {
+				const auto y = skyline_fit(index, w, h);
+				if (y.has_value())
+				{
+					// Lowest top edge wins, then the narrowest segment so wide gaps stay open.
+					const auto top = y.value() + h;
+					if (top < best_top || (top == best_top && m_skyline[index].m_width < best_width))
+					{
+						best_top   = top;
+						best_width = m_skyline[index].m_width;
+						best_index = index;
+						result     = std::make_optional<math::Rect<Type>>(m_skyline[index].m_x, y.value(), w, h);
+					}
+				}
+			};
+
+			for (std::size_t i = 0; i < m_skyline.size(); i++)
+			{
+				score(i, width, height);
+				if (m_allow_rotation && width != height)
+				{
+					score(i, height, width);
+				}
+			}
+
+			if (!result.has_value())
+			{
+				return result;
+			}
+
+			// Raise the skyline over the placed rect, trimming or removing the segments it covers.
+			const auto& placed = result.value();
+			m_skyline.insert(m_skyline.begin() + best_index, {placed.m_x, placed.m_y + placed.m_height, placed.m_width});
+
+			const auto right = placed.m_x + placed.m_width;
+			for (auto i = best_index + 1; i < m_skyline.size();)
+			{
+				auto& node = m_skyline[i];
+				if (node.m_x >= right)
+				{
+					break;
+				}
+
+				const auto node_right = node.m_x + node.m_width;
+				if (node_right <= right)
+				{
+					m_skyline.erase(m_skyline.begin() + i);
+				}
+				else
+				{
+					node.m_width = node_right - right;
+					node.m_x     = right;
+					break;
+				}
+			}
+
+			// Merge neighbours at the same height.
+			for (std::size_t i = 0; i + 1 < m_skyline.size();)
+			{
+				if (m_skyline[i].m_y == m_skyline[i + 1].m_y)
+				{
+					m_skyline[i].m_width += m_skyline[i + 1].m_width;
+					m_skyline.erase(m_skyline.begin() + i + 1);
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			return result;
 		}
 
 		template<meta::is_arithmetic Type>
-		inline const int RectPack<Type>::get_height() const noexcept
+		inline std::optional<Type> RectPack<Type>::skyline_fit(const std::size_t index, const Type width, const Type height) const noexcept
 		{
-			return m_height;
+			if (m_skyline[index].m_x + width > static_cast<Type>(m_width))
+			{
+				return std::nullopt;
+			}
+
+			// Rest on the highest segment the rect spans.
+			auto y         = m_skyline[index].m_y;
+			auto remaining = width;
+			for (auto i = index; remaining > 0; i++)
+			{
+				y = std::max(y, m_skyline[i].m_y);
+				if (y + height > static_cast<Type>(m_height))
+				{
+					return std::nullopt;
+				}
+
+				remaining -= m_skyline[i].m_width;
+			}
+
+			return std::make_optional(y);
 		}
 
 		template<meta::is_arithmetic Type>
-		inline const std::vector<math::Rect<Type>>& RectPack<Type>::get_free_space() const noexcept
+		inline bool RectPack<Type>::is_contained(const math::Rect<Type>& a, const math::Rect<Type>& b) noexcept
 		{
-			return m_free_rects;
+			return a.m_x >= b.m_x && a.m_y >= b.m_y && a.m_x + a.m_width <= b.m_x + b.m_width && a.m_y + a.m_height <= b.m_y + b.m_height;
 		}
 	} // namespace math
 } // namespace galaxy
@@ -8,6 +8,8 @@
 #ifndef GALAXY_META_UNIQUEID_HPP_
 #define GALAXY_META_UNIQUEID_HPP_
 
+#include <atomic>
+
 #include "galaxy/meta/Concepts.hpp"
 
 namespace galaxy
@@ -64,9 +66,9 @@ namespace galaxy
 
 		private:
 			///
-			/// Internal counter to keep track of allocated ids.
+			/// Internal counter to keep track of allocated ids. Atomic, since types can be first seen on different threads.
 			///
-			inline static std::size_t s_counter = 0;
+			inline static std::atomic<std::size_t> s_counter = 0;
 		};
 
 		template<is_class Specialization>
@@ -1,8 +1,8 @@
 ///
-/// Renderable.cpp
+/// Broadphase.cpp
 /// galaxy
 ///
 /// Refer to LICENSE.txt for more details.
 ///
 
-#include "Renderable.hpp"
\ No newline at end of file
+#include "Broadphase.hpp"
\ No newline at end of file
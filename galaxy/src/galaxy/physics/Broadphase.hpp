@@ -0,0 +1,33 @@
+///
+/// Broadphase.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_PHYSICS_BROADPHASE_HPP_
+#define GALAXY_PHYSICS_BROADPHASE_HPP_
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// Structure used to find pairs of bodies that might be colliding.
+		///
+		enum class Broadphase : int
+		{
+			///
+			/// physics::DynamicTree. Best when bodies vary a lot in size or are spread unevenly.
+			///
+			DYNAMIC_TREE,
+
+			///
+			/// physics::SpatialHash sized to the map tiles. Best when most bodies are about one tile in size.
+			///
+			SPATIAL_HASH
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
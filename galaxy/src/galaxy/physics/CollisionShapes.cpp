@@ -0,0 +1,298 @@
+///
+/// CollisionShapes.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+/// Separating axis test based on code from ghost7:
+/// https://github.com/ghost7/collision
+///
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+
+#include "CollisionShapes.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		CollisionShapes::CollisionShapes() noexcept
+		    : m_unused {0}
+		{
+		}
+
+		CollisionShapes::~CollisionShapes() noexcept
+		{
+			clear();
+		}
+
+		void CollisionShapes::update(const ecs::Entity entity, std::span<const glm::vec2> vertices, const glm::mat3x2& affine)
+		{
+			if (vertices.empty())
+			{
+				erase(entity);
+				return;
+			}
+
+			const auto count  = static_cast<std::uint32_t>(vertices.size());
+			const auto padded = static_cast<std::uint32_t>(((count + LANES - 1) / LANES) * LANES);
+
+			auto [it, inserted] = m_shapes.try_emplace(entity);
+			auto& shape         = it->second;
+
+			// Reuse the existing range when the polygon has the same size, which is almost always.
+			if (inserted || shape.m_vertex_count != padded || shape.m_axis_capacity < count)
+			{
+				if (!inserted)
+				{
+					m_unused += shape.m_vertex_count;
+				}
+
+				shape.m_first_vertex  = static_cast<std::uint32_t>(m_vertex_x.size());
+				shape.m_vertex_count  = padded;
+				shape.m_first_axis    = static_cast<std::uint32_t>(m_axis_x.size());
+				shape.m_axis_capacity = count;
+
+				m_vertex_x.resize(m_vertex_x.size() + padded);
+				m_vertex_y.resize(m_vertex_y.size() + padded);
+				m_axis_x.resize(m_axis_x.size() + count);
+				m_axis_y.resize(m_axis_y.size() + count);
+			}
+
+			shape.m_affine = affine;
+
+			auto* vx = m_vertex_x.data() + shape.m_first_vertex;
+			auto* vy = m_vertex_y.data() + shape.m_first_vertex;
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				const auto& vertex = vertices[i];
+
+				vx[i] = affine[0].x * vertex.x + affine[1].x * vertex.y + affine[2].x;
+				vy[i] = affine[0].y * vertex.x + affine[1].y * vertex.y + affine[2].y;
+			}
+
+			// Repeating a vertex does not change a projection.
+			std::fill(vx + count, vx + padded, vx[count - 1]);
+			std::fill(vy + count, vy + padded, vy[count - 1]);
+
+			auto* ax             = m_axis_x.data() + shape.m_first_axis;
+			auto* ay             = m_axis_y.data() + shape.m_first_axis;
+			std::uint32_t unique = 0;
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				const auto j = (i + 1) % count;
+
+				auto x            = vy[i] - vy[j];
+				auto y            = vx[j] - vx[i];
+				const auto length = std::sqrt(x * x + y * y);
+
+				if (length <= FLT_EPSILON)
+				{
+					continue;
+				}
+
+				x /= length;
+				y /= length;
+
+				// Opposite edges of boxes and other parallel edges share an axis.
+				bool parallel = false;
+				for (std::uint32_t k = 0; k < unique && !parallel; k++)
+				{
+					parallel = std::abs(x * ay[k] - y * ax[k]) <= 1e-6f;
+				}
+
+				if (!parallel)
+				{
+					ax[unique] = x;
+					ay[unique] = y;
+					unique++;
+				}
+			}
+
+			shape.m_axis_count = unique;
+
+			if (m_unused > m_vertex_x.size() / 2)
+			{
+				compact();
+			}
+		}
+
+		const bool CollisionShapes::is_current(const ecs::Entity entity, const glm::mat3x2& affine) const noexcept
+		{
+			const auto it = m_shapes.find(entity);
+			return it != m_shapes.end() && it->second.m_affine == affine;
+		}
+
+		void CollisionShapes::erase(const ecs::Entity entity)
+		{
+			if (const auto it = m_shapes.find(entity); it != m_shapes.end())
+			{
+				m_unused += it->second.m_vertex_count;
+				m_shapes.erase(it);
+			}
+		}
+
+		void CollisionShapes::clear() noexcept
+		{
+			m_shapes.clear();
+			m_vertex_x.clear();
+			m_vertex_y.clear();
+			m_axis_x.clear();
+			m_axis_y.clear();
+
+			m_unused = 0;
+		}
+
+		const bool CollisionShapes::intersects(const ecs::Entity a, const ecs::Entity b, glm::vec2& mtv) const noexcept
+		{
+			mtv.x = 0.0f;
+			mtv.y = 0.0f;
+
+			const auto it_a = m_shapes.find(a);
+			const auto it_b = m_shapes.find(b);
+			if (it_a == m_shapes.end() || it_b == m_shapes.end())
+			{
+				return false;
+			}
+
+			const auto& shape_a = it_a->second;
+			const auto& shape_b = it_b->second;
+			if (shape_a.m_axis_count + shape_b.m_axis_count == 0)
+			{
+				return false;
+			}
+
+			// Set the mtv to be the float max, so we can find a vector that is smaller.
+			float min_overlap  = FLT_MAX;
+			glm::vec2 min_axis = {0.0f, 0.0f};
+
+			// First test against this polygon's normals, then the other polygon's normals.
+			if (!test_axes(shape_a, shape_a, shape_b, min_overlap, min_axis) || !test_axes(shape_b, shape_a, shape_b, min_overlap, min_axis))
+			{
+				return false;
+			}
+
+			mtv = min_axis * min_overlap;
+			return true;
+		}
+
+		const std::size_t CollisionShapes::get_axis_count(const ecs::Entity entity) const noexcept
+		{
+			const auto it = m_shapes.find(entity);
+			return it != m_shapes.end() ? it->second.m_axis_count : 0;
+		}
+
+		const std::size_t CollisionShapes::size() const noexcept
+		{
+			return m_shapes.size();
+		}
+
+		const std::size_t CollisionShapes::get_stored_vertices() const noexcept
+		{
+			return m_vertex_x.size();
+		}
+
+		const CollisionShapes::Projection CollisionShapes::project(const Shape& shape, const float x, const float y) const noexcept
+		{
+			const auto* vx = m_vertex_x.data() + shape.m_first_vertex;
+			const auto* vy = m_vertex_y.data() + shape.m_first_vertex;
+
+			std::array<float, LANES> min;
+			std::array<float, LANES> max;
+			for (std::size_t lane = 0; lane < LANES; lane++)
+			{
+				min[lane] = vx[lane] * x + vy[lane] * y;
+				max[lane] = min[lane];
+			}
+
+			for (std::size_t block = LANES; block < shape.m_vertex_count; block += LANES)
+			{
+				for (std::size_t lane = 0; lane < LANES; lane++)
+				{
+					const auto magnitude = vx[block + lane] * x + vy[block + lane] * y;
+
+					min[lane] = std::min(min[lane], magnitude);
+					max[lane] = std::max(max[lane], magnitude);
+				}
+			}
+
+			return {*std::min_element(min.begin(), min.end()), *std::max_element(max.begin(), max.end())};
+		}
+
+		const bool CollisionShapes::test_axes(const Shape& axes, const Shape& a, const Shape& b, float& min_overlap, glm::vec2& min_axis) const noexcept
+		{
+			const auto* ax = m_axis_x.data() + axes.m_first_axis;
+			const auto* ay = m_axis_y.data() + axes.m_first_axis;
+
+			for (std::uint32_t i = 0; i < axes.m_axis_count; i++)
+			{
+				const auto p1 = project(a, ax[i], ay[i]);
+				const auto p2 = project(b, ax[i], ay[i]);
+
+				// Signed so that moving a by axis * overlap separates it from b.
+				float overlap = 0.0f;
+				if (p1.m_min > p2.m_max || p1.m_max < p2.m_min)
+				{
+					return false;
+				}
+				else if (p1.m_min < p2.m_min)
+				{
+					overlap = p2.m_min - p1.m_max;
+				}
+				else
+				{
+					overlap = p2.m_max - p1.m_min;
+				}
+
+				if (overlap == 0.0f)
+				{
+					return false;
+				}
+
+				if (std::abs(min_overlap) > std::abs(overlap))
+				{
+					min_overlap = overlap;
+					min_axis    = {ax[i], ay[i]};
+				}
+			}
+
+			return true;
+		}
+
+		void CollisionShapes::compact()
+		{
+			std::vector<float> vertex_x;
+			std::vector<float> vertex_y;
+			std::vector<float> axis_x;
+			std::vector<float> axis_y;
+
+			vertex_x.reserve(m_vertex_x.size() - m_unused);
+			vertex_y.reserve(m_vertex_y.size() - m_unused);
+			axis_x.reserve(m_axis_x.size());
+			axis_y.reserve(m_axis_y.size());
+
+			for (auto& [entity, shape] : m_shapes)
+			{
+				const auto first_vertex = static_cast<std::uint32_t>(vertex_x.size());
+				const auto first_axis   = static_cast<std::uint32_t>(axis_x.size());
+
+				vertex_x.insert(vertex_x.end(), m_vertex_x.begin() + shape.m_first_vertex, m_vertex_x.begin() + shape.m_first_vertex + shape.m_vertex_count);
+				vertex_y.insert(vertex_y.end(), m_vertex_y.begin() + shape.m_first_vertex, m_vertex_y.begin() + shape.m_first_vertex + shape.m_vertex_count);
+				axis_x.insert(axis_x.end(), m_axis_x.begin() + shape.m_first_axis, m_axis_x.begin() + shape.m_first_axis + shape.m_axis_capacity);
+				axis_y.insert(axis_y.end(), m_axis_y.begin() + shape.m_first_axis, m_axis_y.begin() + shape.m_first_axis + shape.m_axis_capacity);
+
+				shape.m_first_vertex = first_vertex;
+				shape.m_first_axis   = first_axis;
+			}
+
+			m_vertex_x = std::move(vertex_x);
+			m_vertex_y = std::move(vertex_y);
+			m_axis_x   = std::move(axis_x);
+			m_axis_y   = std::move(axis_y);
+			m_unused   = 0;
+		}
+	} // namespace physics
+} // namespace galaxy
\ No newline at end of file
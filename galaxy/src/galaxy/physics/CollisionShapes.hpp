@@ -0,0 +1,259 @@
+///
+/// CollisionShapes.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+/// Separating axis test based on code from ghost7:
+/// https://github.com/ghost7/collision
+///
+
+#ifndef GALAXY_PHYSICS_COLLISIONSHAPES_HPP_
+#define GALAXY_PHYSICS_COLLISIONSHAPES_HPP_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/mat3x2.hpp>
+#include <glm/vec2.hpp>
+#include <robin_hood.h>
+
+#include "galaxy/ecs/Entity.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// \brief Cache of world space collision polygons, tested with the separating axis theorem.
+		///
+		/// Vertices and axes of every shape are stored as separate x and y arrays. Vertex ranges are padded
+		/// to a multiple of LANES by repeating the last vertex, so projections run over fixed width blocks
+		/// the compiler can vectorise. Parallel edge normals are only stored once, so a box has two axes.
+		///
+		/// A shape is only recalculated when the affine transform it was built from changes.
+		///
+		class CollisionShapes final
+		{
+		public:
+			///
+			/// Number of vertices projected per block.
+			///
+			inline static constexpr const std::size_t LANES = 4;
+
+			///
+			/// Constructor.
+			///
+			CollisionShapes() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~CollisionShapes() noexcept;
+
+			///
+			/// Set the polygon of an entity, transformed into world space.
+			///
+			/// \param entity Entity to set shape for.
+			/// \param vertices Polygon vertices in local space, wound consistently.
+			/// \param affine Local to world transform.
+			///
+			void update(const ecs::Entity entity, std::span<const glm::vec2> vertices, const glm::mat3x2& affine);
+
+			///
+			/// Check if an entity has a shape built from this transform.
+			///
+			/// \param entity Entity to check.
+			/// \param affine Current local to world transform.
+			///
+			/// \return True if shape does not need to be updated.
+			///
+			[[nodiscard]] const bool is_current(const ecs::Entity entity, const glm::mat3x2& affine) const noexcept;
+
+			///
+			/// Remove the shape of an entity.
+			///
+			/// \param entity Entity to remove shape for.
+			///
+			void erase(const ecs::Entity entity);
+
+			///
+			/// Remove all shapes.
+			///
+			void clear() noexcept;
+
+			///
+			/// \brief Determine if two shapes intersect.
+			///
+			/// Also outputs the minimum translation vector that moves a out of b, if there is one.
+			/// Does not allocate.
+			///
+			/// \param a Entity of first shape.
+			/// \param b Entity of second shape.
+			/// \param mtv Minimum transation vector used to resolve the collision.
+			///
+			/// \return True if both shapes exist and intersect.
+			///
+			[[nodiscard]] const bool intersects(const ecs::Entity a, const ecs::Entity b, glm::vec2& mtv) const noexcept;
+
+			///
+			/// Get number of unique axes of a shape.
+			///
+			/// \param entity Entity of shape.
+			///
+			/// \return Const std::size_t. 0 if entity has no shape.
+			///
+			[[nodiscard]] const std::size_t get_axis_count(const ecs::Entity entity) const noexcept;
+
+			///
+			/// Get number of shapes.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t size() const noexcept;
+
+			///
+			/// Get number of vertices in storage, including padding and unused ranges.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_stored_vertices() const noexcept;
+
+		private:
+			///
+			/// Range of storage used by one shape.
+			///
+			struct Shape final
+			{
+				///
+				/// First vertex.
+				///
+				std::uint32_t m_first_vertex;
+
+				///
+				/// Number of vertices, including padding.
+				///
+				std::uint32_t m_vertex_count;
+
+				///
+				/// First axis.
+				///
+				std::uint32_t m_first_axis;
+
+				///
+				/// Number of axes reserved.
+				///
+				std::uint32_t m_axis_capacity;
+
+				///
+				/// Number of unique axes.
+				///
+				std::uint32_t m_axis_count;
+
+				///
+				/// Transform shape was built from.
+				///
+				glm::mat3x2 m_affine;
+			};
+
+			///
+			/// Min and max of a shape projected onto an axis.
+			///
+			struct Projection final
+			{
+				///
+				/// Projection min.
+				///
+				float m_min;
+
+				///
+				/// Projection max.
+				///
+				float m_max;
+			};
+
+			///
+			/// Copy constructor.
+			///
+			CollisionShapes(const CollisionShapes&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			CollisionShapes(CollisionShapes&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			CollisionShapes& operator=(const CollisionShapes&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			CollisionShapes& operator=(CollisionShapes&&) = delete;
+
+			///
+			/// Project a shape onto an axis.
+			///
+			/// \param shape Shape to project.
+			/// \param x Axis x.
+			/// \param y Axis y.
+			///
+			/// \return Projection.
+			///
+			[[nodiscard]] const Projection project(const Shape& shape, const float x, const float y) const noexcept;
+
+			///
+			/// Find the axis of least overlap among the axes of one shape.
+			///
+			/// \param axes Shape to take axes from.
+			/// \param a First shape.
+			/// \param b Second shape.
+			/// \param min_overlap Smallest overlap found so far. Updated in place.
+			/// \param min_axis Axis of smallest overlap so far. Updated in place.
+			///
+			/// \return False if a separating axis was found.
+			///
+			[[nodiscard]] const bool test_axes(const Shape& axes, const Shape& a, const Shape& b, float& min_overlap, glm::vec2& min_axis) const noexcept;
+
+			///
+			/// Rebuild storage without unused ranges.
+			///
+			void compact();
+
+		private:
+			///
+			/// Shape of each entity.
+			///
+			robin_hood::unordered_flat_map<ecs::Entity, Shape> m_shapes;
+
+			///
+			/// World space vertex x.
+			///
+			std::vector<float> m_vertex_x;
+
+			///
+			/// World space vertex y.
+			///
+			std::vector<float> m_vertex_y;
+
+			///
+			/// Unit axis x.
+			///
+			std::vector<float> m_axis_x;
+
+			///
+			/// Unit axis y.
+			///
+			std::vector<float> m_axis_y;
+
+			///
+			/// Vertices in ranges no longer used by a shape.
+			///
+			std::size_t m_unused;
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,107 @@
+///
+/// ContactEvents.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+
+#include "ContactEvents.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		ContactEvents::ContactEvents() noexcept
+		{
+		}
+
+		ContactEvents::~ContactEvents() noexcept
+		{
+			clear();
+		}
+
+		void ContactEvents::record(const ecs::Entity a, const ecs::Entity b, const glm::vec2& normal)
+		{
+			if (a < b)
+			{
+				m_current.push_back({.m_a = a, .m_b = b, .m_normal = normal});
+			}
+			else
+			{
+				m_current.push_back({.m_a = b, .m_b = a, .m_normal = {-normal.x, -normal.y}});
+			}
+		}
+
+		const bool ContactEvents::keep(const ecs::Entity a, const ecs::Entity b)
+		{
+			const Contact key {.m_a = std::min(a, b), .m_b = std::max(a, b), .m_normal = {0.0f, 0.0f}};
+
+			const auto it = std::lower_bound(m_previous.begin(), m_previous.end(), key, &ContactEvents::less);
+			if (it != m_previous.end() && it->m_a == key.m_a && it->m_b == key.m_b)
+			{
+				m_current.push_back(*it);
+				return true;
+			}
+
+			return false;
+		}
+
+		std::span<const events::Collision> ContactEvents::flush()
+		{
+			m_events.clear();
+
+			// Stable, so the first normal recorded for a pair is the one kept.
+			std::stable_sort(m_current.begin(), m_current.end(), &ContactEvents::less);
+			const auto last = std::unique(m_current.begin(), m_current.end(), [](const Contact& lhs, const Contact& rhs) {
+				return lhs.m_a == rhs.m_a && lhs.m_b == rhs.m_b;
+			});
+			m_current.erase(last, m_current.end());
+
+			auto current  = m_current.begin();
+			auto previous = m_previous.begin();
+			while (current != m_current.end() || previous != m_previous.end())
+			{
+				if (previous == m_previous.end() || (current != m_current.end() && less(*current, *previous)))
+				{
+					m_events.emplace_back(current->m_a, current->m_b, ContactPhase::BEGIN, current->m_normal);
+					++current;
+				}
+				else if (current == m_current.end() || less(*previous, *current))
+				{
+					m_events.emplace_back(previous->m_a, previous->m_b, ContactPhase::END, glm::vec2 {0.0f, 0.0f});
+					++previous;
+				}
+				else
+				{
+					m_events.emplace_back(current->m_a, current->m_b, ContactPhase::STAY, current->m_normal);
+					++current;
+					++previous;
+				}
+			}
+
+			std::swap(m_current, m_previous);
+			m_current.clear();
+
+			return m_events;
+		}
+
+		const std::size_t ContactEvents::size() const noexcept
+		{
+			return m_previous.size();
+		}
+
+		void ContactEvents::clear() noexcept
+		{
+			m_current.clear();
+			m_previous.clear();
+			m_events.clear();
+		}
+
+		const bool ContactEvents::less(const Contact& lhs, const Contact& rhs) noexcept
+		{
+			return lhs.m_a < rhs.m_a || (lhs.m_a == rhs.m_a && lhs.m_b < rhs.m_b);
+		}
+	} // namespace physics
+} // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,148 @@
+///
+/// ContactEvents.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_PHYSICS_CONTACTEVENTS_HPP_
+#define GALAXY_PHYSICS_CONTACTEVENTS_HPP_
+
+#include <span>
+#include <vector>
+
+#include "galaxy/events/Collision.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// \brief Per tick buffer of contacts, turned into begin, stay and end events.
+		///
+		/// Recording only appends, so the narrowphase does not depend on anything that reacts to a collision.
+		/// Duplicates are removed when the tick is flushed, by sorting and comparing against the last tick.
+		///
+		class ContactEvents final
+		{
+		public:
+			///
+			/// Constructor.
+			///
+			ContactEvents() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~ContactEvents() noexcept;
+
+			///
+			/// Record a contact this tick. Order of entities does not matter.
+			///
+			/// \param a First entity.
+			/// \param b Second entity.
+			/// \param normal Direction that moves a out of b.
+			///
+			void record(const ecs::Entity a, const ecs::Entity b, const glm::vec2& normal);
+
+			///
+			/// Record a contact again if it was touching last tick, i.e. for pairs that were not tested because they are asleep.
+			///
+			/// \param a First entity.
+			/// \param b Second entity.
+			///
+			/// \return True if contact was kept.
+			///
+			[[maybe_unused]] const bool keep(const ecs::Entity a, const ecs::Entity b);
+
+			///
+			/// End the tick.
+			///
+			/// \return Events for this tick, valid until the next flush. Entity a is always the lower entity.
+			///
+			[[nodiscard]] std::span<const events::Collision> flush();
+
+			///
+			/// Get number of contacts touching after the last flush.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t size() const noexcept;
+
+			///
+			/// Forget all contacts, without sending end events.
+			///
+			void clear() noexcept;
+
+		private:
+			///
+			/// Contact between two entities, with the lower entity first.
+			///
+			struct Contact final
+			{
+				///
+				/// Lower entity.
+				///
+				ecs::Entity m_a;
+
+				///
+				/// Higher entity.
+				///
+				ecs::Entity m_b;
+
+				///
+				/// Direction that moves a out of b.
+				///
+				glm::vec2 m_normal;
+			};
+
+			///
+			/// Copy constructor.
+			///
+			ContactEvents(const ContactEvents&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			ContactEvents(ContactEvents&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			ContactEvents& operator=(const ContactEvents&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			ContactEvents& operator=(ContactEvents&&) = delete;
+
+			///
+			/// Order contacts by entities.
+			///
+			/// \param lhs First contact.
+			/// \param rhs Second contact.
+			///
+			/// \return True if lhs comes first.
+			///
+			[[nodiscard]] static const bool less(const Contact& lhs, const Contact& rhs) noexcept;
+
+		private:
+			///
+			/// Contacts recorded this tick.
+			///
+			std::vector<Contact> m_current;
+
+			///
+			/// Sorted contacts from last tick.
+			///
+			std::vector<Contact> m_previous;
+
+			///
+			/// Events from last flush.
+			///
+			std::vector<events::Collision> m_events;
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
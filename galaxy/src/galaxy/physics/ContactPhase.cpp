@@ -0,0 +1,8 @@
+///
+/// ContactPhase.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "ContactPhase.hpp"
\ No newline at end of file
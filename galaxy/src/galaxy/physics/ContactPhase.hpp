@@ -0,0 +1,38 @@
+///
+/// ContactPhase.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_PHYSICS_CONTACTPHASE_HPP_
+#define GALAXY_PHYSICS_CONTACTPHASE_HPP_
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// Stage of a contact between two bodies.
+		///
+		enum class ContactPhase : int
+		{
+			///
+			/// Bodies started touching this tick.
+			///
+			BEGIN,
+
+			///
+			/// Bodies were already touching last tick.
+			///
+			STAY,
+
+			///
+			/// Bodies stopped touching this tick.
+			///
+			END
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -0,0 +1,380 @@
+///
+/// ContactSolver.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ContactSolver.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		ContactSolver::ContactSolver() noexcept
+		    : m_island_count {0}, m_contact_count {0}
+		{
+		}
+
+		ContactSolver::~ContactSolver() noexcept
+		{
+			clear();
+		}
+
+		void ContactSolver::set_body(const ecs::Entity entity, const glm::vec2& velocity, const float inv_mass, const float restitution)
+		{
+			const auto [it, inserted] = m_lookup.try_emplace(entity, static_cast<std::uint32_t>(m_bodies.size()));
+			if (inserted)
+			{
+				m_bodies.push_back({.m_entity = entity, .m_velocity = velocity, .m_correction = {0.0f, 0.0f}, .m_inv_mass = inv_mass, .m_restitution = restitution, .m_still_ticks = 0, .m_parent = it->second, .m_awake = inv_mass > 0.0f, .m_moved = inv_mass == 0.0f, .m_group = entity});
+
+				return;
+			}
+
+			auto& body            = m_bodies[it->second];
+			const bool was_static = body.m_inv_mass == 0.0f;
+
+			body.m_inv_mass    = inv_mass;
+			body.m_restitution = restitution;
+
+			if (inv_mass == 0.0f)
+			{
+				body.m_awake    = false;
+				body.m_moved    = body.m_moved || !was_static;
+				body.m_velocity = velocity;
+			}
+			else if (was_static)
+			{
+				body.m_awake       = true;
+				body.m_still_ticks = 0;
+				body.m_velocity    = velocity;
+			}
+			else if (body.m_velocity != velocity)
+			{
+				body.m_velocity = velocity;
+				wake_island(it->second);
+			}
+		}
+
+		void ContactSolver::erase(const ecs::Entity entity)
+		{
+			const auto it = m_lookup.find(entity);
+			if (it == m_lookup.end())
+			{
+				return;
+			}
+
+			const auto index = it->second;
+			const auto last  = static_cast<std::uint32_t>(m_bodies.size() - 1);
+
+			// Contacts refer to bodies by index, so they follow the body that is moved into the gap.
+			std::erase_if(m_contacts, [&](const Contact& contact) {
+				return contact.m_a == index || contact.m_b == index;
+			});
+
+			for (auto& contact : m_contacts)
+			{
+				contact.m_a = contact.m_a == last ? index : contact.m_a;
+				contact.m_b = contact.m_b == last ? index : contact.m_b;
+			}
+
+			if (index != last)
+			{
+				m_bodies[index]                    = m_bodies[last];
+				m_lookup[m_bodies[index].m_entity] = index;
+			}
+
+			m_bodies.pop_back();
+			m_lookup.erase(entity);
+		}
+
+		void ContactSolver::add_contact(const ecs::Entity a, const ecs::Entity b, const glm::vec2& normal, const float depth)
+		{
+			const auto it_a = m_lookup.find(a);
+			const auto it_b = m_lookup.find(b);
+			if (it_a == m_lookup.end() || it_b == m_lookup.end())
+			{
+				return;
+			}
+
+			// Nothing to solve between bodies that are asleep or static, unless a static body has moved into them.
+			const auto& body_a = m_bodies[it_a->second];
+			const auto& body_b = m_bodies[it_b->second];
+			if ((!body_a.m_awake && !body_a.m_moved && !body_b.m_awake && !body_b.m_moved) || (body_a.m_inv_mass == 0.0f && body_b.m_inv_mass == 0.0f))
+			{
+				return;
+			}
+
+			wake_island(it_a->second);
+			wake_island(it_b->second);
+
+			Contact contact {.m_a = it_a->second, .m_b = it_b->second, .m_normal = normal, .m_depth = depth, .m_impulse = 0.0f, .m_mass = 0.0f, .m_bias = 0.0f};
+
+			// Warm start from the last step if the pair is still touching the same way.
+			if (const auto cached = m_cache.find(pair_key(a, b)); cached != m_cache.end())
+			{
+				const auto& last = cached->second;
+				if (last.m_a == a && last.m_b == b && last.m_normal.x * normal.x + last.m_normal.y * normal.y > 0.95f)
+				{
+					contact.m_impulse = last.m_impulse;
+				}
+			}
+
+			m_contacts.push_back(contact);
+		}
+
+		void ContactSolver::solve()
+		{
+			m_solved.clear();
+			for (auto& body : m_bodies)
+			{
+				body.m_correction = {0.0f, 0.0f};
+				body.m_moved      = false;
+
+				if (body.m_awake)
+				{
+					m_solved.push_back(body.m_entity);
+				}
+			}
+
+			for (auto& contact : m_contacts)
+			{
+				auto& a = m_bodies[contact.m_a];
+				auto& b = m_bodies[contact.m_b];
+
+				const auto inv_mass = a.m_inv_mass + b.m_inv_mass;
+				contact.m_mass      = inv_mass > 0.0f ? 1.0f / inv_mass : 0.0f;
+
+				const auto relative = a.m_velocity - b.m_velocity;
+				const auto closing  = relative.x * contact.m_normal.x + relative.y * contact.m_normal.y;
+				contact.m_bias      = closing < -RESTITUTION_VELOCITY ? -std::max(a.m_restitution, b.m_restitution) * closing : 0.0f;
+
+				const auto impulse = contact.m_normal * contact.m_impulse;
+				a.m_velocity += impulse * a.m_inv_mass;
+				b.m_velocity -= impulse * b.m_inv_mass;
+			}
+
+			for (std::size_t i = 0; i < ITERATIONS; i++)
+			{
+				for (auto& contact : m_contacts)
+				{
+					auto& a = m_bodies[contact.m_a];
+					auto& b = m_bodies[contact.m_b];
+
+					const auto relative = a.m_velocity - b.m_velocity;
+					const auto closing  = relative.x * contact.m_normal.x + relative.y * contact.m_normal.y;
+
+					// Clamp the total, not the increment, so earlier iterations can be undone.
+					const auto total  = std::max(contact.m_impulse + contact.m_mass * (contact.m_bias - closing), 0.0f);
+					const auto change = total - contact.m_impulse;
+					contact.m_impulse = total;
+
+					const auto impulse = contact.m_normal * change;
+					a.m_velocity += impulse * a.m_inv_mass;
+					b.m_velocity -= impulse * b.m_inv_mass;
+				}
+			}
+
+			for (const auto& contact : m_contacts)
+			{
+				auto& a = m_bodies[contact.m_a];
+				auto& b = m_bodies[contact.m_b];
+
+				const auto push = contact.m_normal * (std::max(contact.m_depth - SLOP, 0.0f) * CORRECTION * contact.m_mass);
+				a.m_correction += push * a.m_inv_mass;
+				b.m_correction -= push * b.m_inv_mass;
+			}
+
+			m_cache.clear();
+			for (const auto& contact : m_contacts)
+			{
+				const auto a = m_bodies[contact.m_a].m_entity;
+				const auto b = m_bodies[contact.m_b].m_entity;
+
+				m_cache[pair_key(a, b)] = {.m_a = a, .m_b = b, .m_normal = contact.m_normal, .m_impulse = contact.m_impulse};
+			}
+
+			update_islands();
+
+			m_contact_count = m_contacts.size();
+			m_contacts.clear();
+		}
+
+		void ContactSolver::wake(const ecs::Entity entity)
+		{
+			const auto it = m_lookup.find(entity);
+			if (it == m_lookup.end())
+			{
+				return;
+			}
+
+			auto& body = m_bodies[it->second];
+			if (body.m_inv_mass == 0.0f)
+			{
+				body.m_moved = true;
+			}
+			else
+			{
+				wake_island(it->second);
+			}
+		}
+
+		void ContactSolver::wake_island(const std::uint32_t index)
+		{
+			const auto& body = m_bodies[index];
+			if (body.m_awake || body.m_inv_mass == 0.0f)
+			{
+				return;
+			}
+
+			// Waking is rare compared to solving, so islands are found by scanning instead of being stored.
+			const auto group = body.m_group;
+			for (auto& other : m_bodies)
+			{
+				if (!other.m_awake && other.m_inv_mass > 0.0f && other.m_group == group)
+				{
+					other.m_awake       = true;
+					other.m_still_ticks = 0;
+				}
+			}
+		}
+
+		const glm::vec2 ContactSolver::get_velocity(const ecs::Entity entity) const noexcept
+		{
+			const auto it = m_lookup.find(entity);
+			return it != m_lookup.end() ? m_bodies[it->second].m_velocity : glm::vec2 {0.0f, 0.0f};
+		}
+
+		const glm::vec2 ContactSolver::get_correction(const ecs::Entity entity) const noexcept
+		{
+			const auto it = m_lookup.find(entity);
+			return it != m_lookup.end() ? m_bodies[it->second].m_correction : glm::vec2 {0.0f, 0.0f};
+		}
+
+		const bool ContactSolver::is_awake(const ecs::Entity entity) const noexcept
+		{
+			const auto it = m_lookup.find(entity);
+			return it != m_lookup.end() && m_bodies[it->second].m_awake;
+		}
+
+		const bool ContactSolver::is_active(const ecs::Entity entity) const noexcept
+		{
+			const auto it = m_lookup.find(entity);
+			return it != m_lookup.end() && (m_bodies[it->second].m_awake || m_bodies[it->second].m_moved);
+		}
+
+		std::span<const ecs::Entity> ContactSolver::get_solved() const noexcept
+		{
+			return m_solved;
+		}
+
+		const std::size_t ContactSolver::get_island_count() const noexcept
+		{
+			return m_island_count;
+		}
+
+		const std::size_t ContactSolver::get_contact_count() const noexcept
+		{
+			return m_contact_count;
+		}
+
+		void ContactSolver::clear() noexcept
+		{
+			m_bodies.clear();
+			m_lookup.clear();
+			m_contacts.clear();
+			m_cache.clear();
+			m_solved.clear();
+			m_island_ticks.clear();
+
+			m_island_count  = 0;
+			m_contact_count = 0;
+		}
+
+		const std::uint64_t ContactSolver::pair_key(const ecs::Entity a, const ecs::Entity b) noexcept
+		{
+			// Entity index is the low 32 bits. Versions are checked against the cached entities.
+			return (static_cast<std::uint64_t>(a & 0xFFFFFFFF) << 32) | static_cast<std::uint64_t>(b & 0xFFFFFFFF);
+		}
+
+		const std::uint32_t ContactSolver::find(std::uint32_t index) noexcept
+		{
+			while (m_bodies[index].m_parent != index)
+			{
+				// Path halving.
+				m_bodies[index].m_parent = m_bodies[m_bodies[index].m_parent].m_parent;
+				index                    = m_bodies[index].m_parent;
+			}
+
+			return index;
+		}
+
+		void ContactSolver::update_islands()
+		{
+			m_island_ticks.assign(m_bodies.size(), std::numeric_limits<std::uint32_t>::max());
+
+			for (std::uint32_t i = 0; i < m_bodies.size(); i++)
+			{
+				auto& body    = m_bodies[i];
+				body.m_parent = i;
+
+				if (body.m_awake)
+				{
+					const auto speed = std::sqrt(body.m_velocity.x * body.m_velocity.x + body.m_velocity.y * body.m_velocity.y);
+					const auto moved = std::sqrt(body.m_correction.x * body.m_correction.x + body.m_correction.y * body.m_correction.y);
+
+					body.m_still_ticks = (speed <= SLEEP_VELOCITY && moved <= SLOP) ? body.m_still_ticks + 1 : 0;
+				}
+			}
+
+			// Static bodies do not join islands, otherwise everything on the same floor would sleep and wake together.
+			for (const auto& contact : m_contacts)
+			{
+				if (m_bodies[contact.m_a].m_awake && m_bodies[contact.m_b].m_awake)
+				{
+					const auto root_a = find(contact.m_a);
+					const auto root_b = find(contact.m_b);
+
+					if (root_a != root_b)
+					{
+						m_bodies[root_a].m_parent = root_b;
+					}
+				}
+			}
+
+			m_island_count = 0;
+			for (std::uint32_t i = 0; i < m_bodies.size(); i++)
+			{
+				if (m_bodies[i].m_awake)
+				{
+					const auto root = find(i);
+					if (root == i)
+					{
+						m_island_count++;
+					}
+
+					m_island_ticks[root] = std::min(m_island_ticks[root], m_bodies[i].m_still_ticks);
+				}
+			}
+
+			for (std::uint32_t i = 0; i < m_bodies.size(); i++)
+			{
+				auto& body = m_bodies[i];
+				if (body.m_awake)
+				{
+					const auto root = find(i);
+					if (m_island_ticks[root] >= SLEEP_TICKS)
+					{
+						body.m_awake    = false;
+						body.m_velocity = {0.0f, 0.0f};
+						body.m_group    = m_bodies[root].m_entity;
+					}
+				}
+			}
+		}
+	} // namespace physics
+} // namespace galaxy
\ No newline at end of file
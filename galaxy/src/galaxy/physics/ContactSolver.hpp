@@ -0,0 +1,405 @@
+///
+/// ContactSolver.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_PHYSICS_CONTACTSOLVER_HPP_
+#define GALAXY_PHYSICS_CONTACTSOLVER_HPP_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <robin_hood.h>
+
+#include "galaxy/ecs/Entity.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// \brief Sequential impulse solver for contacts between bodies that do not rotate.
+		///
+		/// Each contact is a manifold with one normal, taken from the minimum translation vector of the narrowphase.
+		/// Impulses are cached per pair and used to warm start the next step. Dynamic bodies touching each other form
+		/// islands, and an island where every body has been still for SLEEP_TICKS steps is put to sleep until something
+		/// touches it, moves it or changes its velocity.
+		///
+		/// Units are whatever the caller uses, i.e. pixels and seconds.
+		///
+		class ContactSolver final
+		{
+		public:
+			///
+			/// Velocity iterations per step.
+			///
+			inline static constexpr const std::size_t ITERATIONS = 8;
+
+			///
+			/// Steps an island must be still before it sleeps.
+			///
+			inline static constexpr const std::uint32_t SLEEP_TICKS = 30;
+
+			///
+			/// Bodies slower than this are considered still.
+			///
+			inline static constexpr const float SLEEP_VELOCITY = 1.0f;
+
+			///
+			/// Penetration allowed before position is corrected, so resting contacts stay touching.
+			///
+			inline static constexpr const float SLOP = 0.01f;
+
+			///
+			/// Fraction of penetration removed per step.
+			///
+			inline static constexpr const float CORRECTION = 0.8f;
+
+			///
+			/// Bodies closing slower than this do not bounce.
+			///
+			inline static constexpr const float RESTITUTION_VELOCITY = 30.0f;
+
+			///
+			/// Constructor.
+			///
+			ContactSolver() noexcept;
+
+			///
+			/// Destructor.
+			///
+			~ContactSolver() noexcept;
+
+			///
+			/// \brief Add or update a body.
+			///
+			/// A sleeping body is woken, with its island, if its velocity is changed.
+			///
+			/// \param entity Entity of body.
+			/// \param velocity Current velocity.
+			/// \param inv_mass Inverse mass. 0 for static bodies.
+			/// \param restitution Bounciness, from 0 to 1.
+			///
+			void set_body(const ecs::Entity entity, const glm::vec2& velocity, const float inv_mass, const float restitution);
+
+			///
+			/// Remove a body.
+			///
+			/// \param entity Entity of body.
+			///
+			void erase(const ecs::Entity entity);
+
+			///
+			/// \brief Add a contact for the next step.
+			///
+			/// A sleeping body touched by an awake dynamic body, or by a static body that has moved, is woken.
+			/// Ignored if either body is unknown.
+			///
+			/// \param a First body.
+			/// \param b Second body.
+			/// \param normal Unit direction that moves a out of b.
+			/// \param depth Penetration along normal.
+			///
+			void add_contact(const ecs::Entity a, const ecs::Entity b, const glm::vec2& normal, const float depth);
+
+			///
+			/// Solve contacts added since the last step, then update islands and sleeping.
+			///
+			void solve();
+
+			///
+			/// \brief Wake a body and the island it fell asleep with.
+			///
+			/// Static bodies never sleep. Waking one instead marks it as moved until the next step, so sleeping bodies
+			/// it now overlaps, i.e. under a moving platform or door, are woken and pushed out.
+			///
+			/// \param entity Entity of body.
+			///
+			void wake(const ecs::Entity entity);
+
+			///
+			/// Get velocity of a body after the last step.
+			///
+			/// \param entity Entity of body.
+			///
+			/// \return Const glm::vec2. Zero if unknown.
+			///
+			[[nodiscard]] const glm::vec2 get_velocity(const ecs::Entity entity) const noexcept;
+
+			///
+			/// Get position correction of a body from the last step.
+			///
+			/// \param entity Entity of body.
+			///
+			/// \return Const glm::vec2. Zero if unknown.
+			///
+			[[nodiscard]] const glm::vec2 get_correction(const ecs::Entity entity) const noexcept;
+
+			///
+			/// Is a body dynamic and awake.
+			///
+			/// \param entity Entity of body.
+			///
+			/// \return False for static, sleeping and unknown bodies.
+			///
+			[[nodiscard]] const bool is_awake(const ecs::Entity entity) const noexcept;
+
+			///
+			/// Does a body need testing for contacts this step.
+			///
+			/// \param entity Entity of body.
+			///
+			/// \return True for awake dynamic bodies, and static bodies that are new or moved since the last step.
+			///
+			[[nodiscard]] const bool is_active(const ecs::Entity entity) const noexcept;
+
+			///
+			/// Get dynamic bodies that were awake during the last step, including those that fell asleep in it.
+			///
+			/// \return Span of entities. Valid until the next call to solve() or erase().
+			///
+			[[nodiscard]] std::span<const ecs::Entity> get_solved() const noexcept;
+
+			///
+			/// Get number of islands solved in the last step.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_island_count() const noexcept;
+
+			///
+			/// Get number of contacts solved in the last step.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t get_contact_count() const noexcept;
+
+			///
+			/// Remove all bodies and contacts.
+			///
+			void clear() noexcept;
+
+		private:
+			///
+			/// Solver state of a body.
+			///
+			struct Body final
+			{
+				///
+				/// Entity of body.
+				///
+				ecs::Entity m_entity;
+
+				///
+				/// Velocity.
+				///
+				glm::vec2 m_velocity;
+
+				///
+				/// Position correction from last step.
+				///
+				glm::vec2 m_correction;
+
+				///
+				/// Inverse mass. 0 if static.
+				///
+				float m_inv_mass;
+
+				///
+				/// Bounciness.
+				///
+				float m_restitution;
+
+				///
+				/// Consecutive steps this body was still.
+				///
+				std::uint32_t m_still_ticks;
+
+				///
+				/// Union find parent while building islands.
+				///
+				std::uint32_t m_parent;
+
+				///
+				/// Is dynamic and awake.
+				///
+				bool m_awake;
+
+				///
+				/// Is static and has been added or moved since the last step.
+				///
+				bool m_moved;
+
+				///
+				/// Entity of the island root when this body fell asleep.
+				///
+				ecs::Entity m_group;
+			};
+
+			///
+			/// Contact between two bodies.
+			///
+			struct Contact final
+			{
+				///
+				/// First body.
+				///
+				std::uint32_t m_a;
+
+				///
+				/// Second body.
+				///
+				std::uint32_t m_b;
+
+				///
+				/// Direction that moves a out of b.
+				///
+				glm::vec2 m_normal;
+
+				///
+				/// Penetration.
+				///
+				float m_depth;
+
+				///
+				/// Accumulated normal impulse.
+				///
+				float m_impulse;
+
+				///
+				/// Inverse of the sum of inverse masses.
+				///
+				float m_mass;
+
+				///
+				/// Target separating velocity from restitution.
+				///
+				float m_bias;
+			};
+
+			///
+			/// Impulse kept from the last step.
+			///
+			struct Cached final
+			{
+				///
+				/// First body.
+				///
+				ecs::Entity m_a;
+
+				///
+				/// Second body.
+				///
+				ecs::Entity m_b;
+
+				///
+				/// Contact normal.
+				///
+				glm::vec2 m_normal;
+
+				///
+				/// Accumulated normal impulse.
+				///
+				float m_impulse;
+			};
+
+			///
+			/// Copy constructor.
+			///
+			ContactSolver(const ContactSolver&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			ContactSolver(ContactSolver&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			ContactSolver& operator=(const ContactSolver&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			ContactSolver& operator=(ContactSolver&&) = delete;
+
+			///
+			/// Key of a pair of bodies in the impulse cache.
+			///
+			/// \param a First body.
+			/// \param b Second body.
+			///
+			/// \return Const std::uint64_t.
+			///
+			[[nodiscard]] static const std::uint64_t pair_key(const ecs::Entity a, const ecs::Entity b) noexcept;
+
+			///
+			/// Find the island root of a body.
+			///
+			/// \param index Index of body.
+			///
+			/// \return Const std::uint32_t.
+			///
+			[[nodiscard]] const std::uint32_t find(std::uint32_t index) noexcept;
+
+			///
+			/// Wake a sleeping dynamic body and the island it fell asleep with.
+			///
+			/// \param index Index of body.
+			///
+			void wake_island(const std::uint32_t index);
+
+			///
+			/// Put islands that have been still long enough to sleep.
+			///
+			void update_islands();
+
+		private:
+			///
+			/// All bodies.
+			///
+			std::vector<Body> m_bodies;
+
+			///
+			/// Index of each body.
+			///
+			robin_hood::unordered_flat_map<ecs::Entity, std::uint32_t> m_lookup;
+
+			///
+			/// Contacts for the next step.
+			///
+			std::vector<Contact> m_contacts;
+
+			///
+			/// Impulses from the last step.
+			///
+			robin_hood::unordered_flat_map<std::uint64_t, Cached> m_cache;
+
+			///
+			/// Dynamic bodies awake during the last step.
+			///
+			std::vector<ecs::Entity> m_solved;
+
+			///
+			/// Smallest still ticks of each island, indexed by root.
+			///
+			std::vector<std::uint32_t> m_island_ticks;
+
+			///
+			/// Islands in last step.
+			///
+			std::size_t m_island_count;
+
+			///
+			/// Contacts in last step.
+			///
+			std::size_t m_contact_count;
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
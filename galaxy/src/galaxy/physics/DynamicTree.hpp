@@ -40,8 +40,11 @@
 
 #include <algorithm>
 #include <array>
-#include <memory_resource>
-#include <stack>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <robin_hood.h>
@@ -53,49 +56,72 @@ namespace galaxy
 {
 	namespace physics
 	{
-		using maybe_index = std::optional<std::size_t>;
+		///
+		/// Index of a node in a DynamicTree.
+		///
+		using tree_index = std::uint32_t;
+
+		///
+		/// Index representing no node.
+		///
+		inline constexpr const tree_index NULL_NODE = std::numeric_limits<tree_index>::max();
 
 		///
 		/// \brief Represents a node in an AABB tree.
 		///
-		/// Contains an AABBand the entity associated with the AABB,
+		/// Contains an AABB and the entity associated with the AABB,
 		/// along with tree information.
 		///
-		template<typename Key, typename T>
+		template<typename Key>
 		struct Node final
 		{
 			using key_type = Key;
 
-			std::optional<key_type> id;
 			math::AABB aabb;
+			key_type id {};
 
-			maybe_index parent;
-			maybe_index left;
-			maybe_index right;
-			maybe_index next;
-			int height = -1;
+			tree_index parent = NULL_NODE;
+			tree_index left   = NULL_NODE;
+			tree_index right  = NULL_NODE;
+			tree_index next   = NULL_NODE;
+			int height        = -1;
 
 			[[nodiscard]] inline const bool is_leaf() const noexcept
 			{
-				return left == std::nullopt;
+				return left == NULL_NODE;
 			}
 		};
 
 		///
-		/// Represents a tree of AABBs used for efficient collision detection.
+		/// \brief Represents a tree of AABBs used for efficient collision detection.
+		///
+		/// Nodes live in one flat array and link to each other with 32-bit indices.
+		/// Queries walk the tree with a fixed size stack and never allocate.
 		///
 		template<typename Key>
 		class DynamicTree final
 		{
-			template<typename U>
-			using pmr_stack = std::stack<U, std::pmr::deque<U>>;
-
 		public:
 			using value_type = float;
 			using key_type   = Key;
-			using node_type  = Node<key_type, value_type>;
+			using node_type  = Node<key_type>;
 			using size_type  = std::size_t;
-			using index_type = size_type;
+			using index_type = tree_index;
+
+			///
+			/// Size of the stack used to walk the tree. A tree can be walked if it is shallower than this.
+			///
+			inline static constexpr const size_type STACK_SIZE = 256;
+
+			///
+			/// Number of bins used to find a split when rebuilding.
+			///
+			inline static constexpr const size_type SAH_BINS = 16;
+
+			///
+			/// Depth after which rebuilding splits at the median, which keeps the tree shallow enough to query.
+			///
+			inline static constexpr const size_type MAX_SAH_DEPTH = 64;
 
 			///
 			/// Creates an AABB tree.
@@ -103,7 +129,7 @@ namespace galaxy
 			/// \param capacity The initial node capacity of the tree.
 			///
 			inline explicit DynamicTree(const size_type capacity = 16)
-			    : m_node_capacity {capacity}
+			    : m_node_capacity {std::max<size_type>(capacity, 1)}
 			{
 				resize_to_match_node_capacity(0);
 			}
@@ -117,18 +143,18 @@ namespace galaxy
 			///
 			inline void insert(const key_type& key, const glm::vec2& lower_bound, const glm::vec2& upper_bound)
 			{
-				if (!m_index_map.count(key))
+				if (!m_index_map.contains(key))
 				{
 					// Allocate a new node for the particle
-					const auto node_index = allocate_node();
-					auto& node            = m_nodes.at(node_index);
-					node.id               = key;
-					node.aabb             = {lower_bound, upper_bound};
+					const auto index = allocate_node();
+					auto& node       = m_nodes[index];
+					node.id          = key;
+					node.aabb        = {lower_bound, upper_bound};
 					node.aabb.fatten(m_skin_thickness);
 					node.height = 0;
 
-					insert_leaf(node_index);
-					m_index_map.emplace(key, node_index);
+					insert_leaf(index);
+					m_index_map.emplace(key, index);
 				}
 				else
 				{
@@ -147,12 +173,12 @@ namespace galaxy
 			{
 				if (const auto it = m_index_map.find(key); it != m_index_map.end())
 				{
-					const auto node = it->second; // Extract the node index.
+					const auto index = it->second;
 
 					m_index_map.erase(it);
 
-					remove_leaf(node);
-					free_node(node);
+					remove_leaf(index);
+					free_node(index);
 				}
 			}
 
@@ -161,23 +187,11 @@ namespace galaxy
 			///
 			inline void clear()
 			{
-				// Iterator pointing to the start of the particle map.
-				auto it = m_index_map.begin();
-
-				// Iterate over the map.
-				while (it != m_index_map.end())
-				{
-					// Extract the node index.
-					const auto node_index = it->second;
-
-					remove_leaf(node_index);
-					free_node(node_index);
-
-					++it;
-				}
-
-				// Clear the particle map.
 				m_index_map.clear();
+
+				m_root       = NULL_NODE;
+				m_node_count = 0;
+				resize_to_match_node_capacity(0);
 			}
 
 			///
@@ -196,23 +210,23 @@ namespace galaxy
 			{
 				if (const auto it = m_index_map.find(key); it != m_index_map.end())
 				{
-					const auto node_index = it->second; // Extract the node index.
+					const auto index = it->second;
 
 					// No need to update if the particle is still within its fattened AABB.
-					if (!force_reinsert && m_nodes.at(node_index).aabb.contains(aabb))
+					if (!force_reinsert && m_nodes[index].aabb.contains(aabb))
 					{
 						return false;
 					}
 
 					// Remove the current leaf.
-					remove_leaf(node_index);
+					remove_leaf(index);
 					aabb.fatten(m_skin_thickness);
 
-					auto& node = m_nodes.at(node_index);
+					auto& node = m_nodes[index];
 					node.aabb  = aabb;
 					node.aabb.update_area();
 
-					insert_leaf(node_index);
+					insert_leaf(index);
 					return true;
 				}
 				else
@@ -244,7 +258,7 @@ namespace galaxy
 			{
 				if (const auto it = m_index_map.find(key); it != m_index_map.end())
 				{
-					const auto& aabb = m_nodes.at(it->second).aabb;
+					const auto& aabb = m_nodes[it->second].aabb;
 					return update(key, {position, position + aabb.size()}, force_reinsert);
 				}
 				else
@@ -254,26 +268,61 @@ namespace galaxy
 			}
 
 			///
-			/// Rebuild an optimal tree.
+			/// \brief Insert many AABBs at once, then rebuild the tree.
+			///
+			/// Cheaper than inserting one at a time when the batch is large compared to the tree,
+			/// i.e. when a map is loaded.
+			///
+			/// \param boxes Keys and the AABBs to associate with them.
+			///
+			inline void insert(std::span<const std::pair<key_type, math::AABB>> boxes)
+			{
+				for (const auto& [key, aabb] : boxes)
+				{
+					if (!m_index_map.contains(key))
+					{
+						const auto index = allocate_node();
+						auto& node       = m_nodes[index];
+						node.id          = key;
+						node.aabb        = aabb;
+						node.aabb.fatten(m_skin_thickness);
+						node.height = 0;
+
+						m_index_map.emplace(key, index);
+					}
+					else
+					{
+						GALAXY_LOG(GALAXY_WARNING, "Cannot insert duplicate key.");
+					}
+				}
+
+				rebuild();
+			}
+
+			///
+			/// \brief Rebuild the tree top down.
+			///
+			/// Each node is split where the binned surface area heuristic is cheapest.
+			/// Runs in O(n log n).
 			///
 			inline void rebuild()
 			{
-				std::vector<index_type> node_indices(m_node_count);
-				int count {0};
+				std::vector<BuildEntry> entries;
+				entries.reserve(m_index_map.size());
 
-				for (auto index = 0; index < m_node_capacity; ++index)
+				for (index_type index = 0; index < m_node_capacity; ++index)
 				{
-					if (m_nodes.at(index).height < 0)
+					auto& node = m_nodes[index];
+					if (node.height < 0)
 					{
 						// Free node.
 						continue;
 					}
 
-					if (m_nodes.at(index).is_leaf())
+					if (node.is_leaf())
 					{
-						m_nodes.at(index).parent = std::nullopt;
-						node_indices.at(count)   = index;
-						++count;
+						node.parent = NULL_NODE;
+						entries.push_back({.m_leaf = index, .m_centroid = (node.aabb.min() + node.aabb.max()) * 0.5f});
 					}
 					else
 					{
@@ -281,54 +330,7 @@ namespace galaxy
 					}
 				}
 
-				while (count > 1)
-				{
-					auto min_cost = std::numeric_limits<double>::max();
-					int iMin {-1};
-					int jMin {-1};
-
-					for (auto i = 0; i < count; ++i)
-					{
-						const auto fst_aabb = m_nodes.at(node_indices.at(i)).aabb;
-
-						for (auto j = (i + 1); j < count; ++j)
-						{
-							const auto snd_aabb = m_nodes.at(node_indices.at(j)).aabb;
-							const auto cost     = math::AABB::merge(fst_aabb, snd_aabb).area();
-
-							if (cost < min_cost)
-							{
-								iMin     = i;
-								jMin     = j;
-								min_cost = cost;
-							}
-						}
-					}
-
-					const auto index1 = node_indices.at(iMin);
-					const auto index2 = node_indices.at(jMin);
-
-					const auto parent_index = allocate_node();
-					auto& parent_node       = m_nodes.at(parent_index);
-
-					auto& index1Node = m_nodes.at(index1);
-					auto& index2Node = m_nodes.at(index2);
-
-					parent_node.left   = index1;
-					parent_node.right  = index2;
-					parent_node.height = 1 + std::max(index1Node.height, index2Node.height);
-					parent_node.aabb   = math::AABB::merge(index1Node.aabb, index2Node.aabb);
-					parent_node.parent = std::nullopt;
-
-					index1Node.parent = parent_index;
-					index2Node.parent = parent_index;
-
-					node_indices.at(jMin) = node_indices.at(count - 1);
-					node_indices.at(iMin) = parent_index;
-					--count;
-				}
-
-				m_root = node_indices.at(0);
+				m_root = entries.empty() ? NULL_NODE : build_range(entries, 0, entries.size(), 0);
 			}
 
 			///
@@ -366,67 +368,270 @@ namespace galaxy
 			/// \param[out] iterator The output iterator used to write the collision
 			/// candidate IDs.
 			///
-			template<size_type buffer_size = 256, typename OutputIterator>
+			template<typename OutputIterator>
 			inline void query(const key_type& key, OutputIterator iterator) const
 			{
 				if (const auto it = m_index_map.find(key); it != m_index_map.end())
 				{
-					const auto& source_node = m_nodes.at(it->second);
+					const auto source = it->second;
+					const auto& aabb  = m_nodes[source].aabb;
+
+					traverse(
+						[&](const math::AABB& node_aabb) {
+							return aabb.overlaps(node_aabb, m_touch_is_overlap);
+						},
+						[&](const index_type leaf) {
+							// Can't interact with itself.
+							if (leaf != source)
+							{
+								*iterator = m_nodes[leaf].id;
+								++iterator;
+							}
+						});
+				}
+			}
+
+			///
+			/// Obtains the IDs of all AABBs overlapping an area.
+			///
+			/// \param aabb Area to test against.
+			/// \param[out] iterator The output iterator used to write the overlapping IDs.
+			///
+			template<typename OutputIterator>
+			inline void query(const math::AABB& aabb, OutputIterator iterator) const
+			{
+				traverse(
+					[&](const math::AABB& node_aabb) {
+						return aabb.overlaps(node_aabb, m_touch_is_overlap);
+					},
+					[&](const index_type leaf) {
+						*iterator = m_nodes[leaf].id;
+						++iterator;
+					});
+			}
+
+			///
+			/// Obtains the IDs of all AABBs crossed by a line segment, in no particular order.
+			///
+			/// \param from Start of segment.
+			/// \param to End of segment.
+			/// \param[out] iterator The output iterator used to write the IDs that were hit.
+			///
+			template<typename OutputIterator>
+			inline void ray_cast(const glm::vec2& from, const glm::vec2& to, OutputIterator iterator) const
+			{
+				const glm::vec2 direction = to - from;
+
+				traverse(
+					[&](const math::AABB& node_aabb) {
+						return segment_overlaps(node_aabb, from, direction, {0.0f, 0.0f});
+					},
+					[&](const index_type leaf) {
+						*iterator = m_nodes[leaf].id;
+						++iterator;
+					});
+			}
+
+			///
+			/// \brief Obtains the IDs of all AABBs touched by a box moving along a displacement, in no particular order.
+			///
+			/// Candidates are found against the fattened AABBs in the tree. Use time_of_impact() for the exact hit.
+			///
+			/// \param aabb Box at the start of the move.
+			/// \param displacement Distance moved.
+			/// \param[out] iterator The output iterator used to write the IDs that were hit.
+			///
+			template<typename OutputIterator>
+			inline void sweep(const math::AABB& aabb, const glm::vec2& displacement, OutputIterator iterator) const
+			{
+				// Sweeping a box is the same as casting its centre against boxes grown by its half size.
+				const glm::vec2 extents = (aabb.max() - aabb.min()) * 0.5f;
+				const glm::vec2 centre  = aabb.min() + extents;
+
+				traverse(
+					[&](const math::AABB& node_aabb) {
+						return segment_overlaps(node_aabb, centre, displacement, extents);
+					},
+					[&](const index_type leaf) {
+						*iterator = m_nodes[leaf].id;
+						++iterator;
+					});
+			}
+
+			///
+			/// \brief Find when a moving box first touches another box.
+			///
+			/// Boxes that already overlap, or only slide along each other, are not a hit.
+			///
+			/// \param moving Box at the start of the move.
+			/// \param displacement Distance moved.
+			/// \param target Box that is not moving.
+			///
+			/// \return Fraction of displacement in [0, 1] at first contact, or std::nullopt if there is none.
+			///
+			[[nodiscard]] static inline std::optional<float> time_of_impact(const math::AABB& moving, const glm::vec2& displacement, const math::AABB& target) noexcept
+			{
+				glm::vec2 normal;
+				return time_of_impact(moving, displacement, target, normal);
+			}
+
+			///
+			/// \brief Find when a moving box first touches another box, and which face of it was hit.
+			///
+			/// Boxes that already overlap, or only slide along each other, are not a hit.
+			///
+			/// \param moving Box at the start of the move.
+			/// \param displacement Distance moved.
+			/// \param target Box that is not moving.
+			/// \param[out] normal Unit normal of the face of target that was hit. Unchanged if there is no hit.
+			///
+			/// \return Fraction of displacement in [0, 1] at first contact, or std::nullopt if there is none.
+			///
+			[[nodiscard]] static inline std::optional<float> time_of_impact(const math::AABB& moving, const glm::vec2& displacement, const math::AABB& target, glm::vec2& normal) noexcept
+			{
+				float t_enter = -std::numeric_limits<float>::infinity();
+				float t_exit  = std::numeric_limits<float>::infinity();
+				int axis      = 0;
+
+				for (auto i = 0; i < 2; ++i)
+				{
+					if (displacement[i] == 0.0f)
+					{
+						if (moving.max()[i] <= target.min()[i] || moving.min()[i] >= target.max()[i])
+						{
+							return std::nullopt;
+						}
+					}
+					else
+					{
+						const auto inv = 1.0f / displacement[i];
+						auto t1        = (target.min()[i] - moving.max()[i]) * inv;
+						auto t2        = (target.max()[i] - moving.min()[i]) * inv;
+
+						if (t1 > t2)
+						{
+							std::swap(t1, t2);
+						}
+
+						// Last axis to start overlapping is the face that was hit.
+						if (t1 > t_enter)
+						{
+							t_enter = t1;
+							axis    = i;
+						}
+
+						t_exit = std::min(t_exit, t2);
+					}
+				}
+
+				if (t_enter >= t_exit || t_enter < 0.0f || t_enter > 1.0f)
+				{
+					return std::nullopt;
+				}
+
+				normal       = {0.0f, 0.0f};
+				normal[axis] = displacement[axis] > 0.0f ? -1.0f : 1.0f;
+
+				return t_enter;
+			}
 
-					std::array<std::byte, sizeof(maybe_index) * buffer_size> buffer;
-					std::pmr::monotonic_buffer_resource resource {buffer.data(), sizeof buffer};
+			///
+			/// Slab test of a line segment against an AABB grown by extents on each side.
+			///
+			/// \param aabb Box to test.
+			/// \param from Start of segment.
+			/// \param direction End of segment minus start.
+			/// \param extents Amount to grow the box by on each side.
+			///
+			/// \return True if the segment touches the grown box.
+			///
+			[[nodiscard]] static inline const bool segment_overlaps(const math::AABB& aabb, const glm::vec2& from, const glm::vec2& direction, const glm::vec2& extents) noexcept
+			{
+				float t_min = 0.0f;
+				float t_max = 1.0f;
 
-					pmr_stack<maybe_index> stack {&resource};
-					stack.push(m_root);
-					while (!stack.empty())
+				for (auto i = 0; i < 2; ++i)
+				{
+					if (direction[i] == 0.0f)
+					{
+						// Parallel to this slab, so it must start inside it.
+						if (from[i] < aabb.min()[i] - extents[i] || from[i] > aabb.max()[i] + extents[i])
+						{
+							return false;
+						}
+					}
+					else
 					{
-						const auto node_index = stack.top();
-						stack.pop();
+						const auto inv = 1.0f / direction[i];
+						auto t1        = (aabb.min()[i] - extents[i] - from[i]) * inv;
+						auto t2        = (aabb.max()[i] + extents[i] - from[i]) * inv;
 
-						if (!node_index)
+						if (t1 > t2)
 						{
-							continue;
+							std::swap(t1, t2);
 						}
 
-						const auto& node = m_nodes.at(*node_index);
+						t_min = std::max(t_min, t1);
+						t_max = std::min(t_max, t2);
 
-						// Test for overlap between the AABBs
-						if (source_node.aabb.overlaps(node.aabb, m_touch_is_overlap))
+						if (t_min > t_max)
 						{
-							if (node.is_leaf() && node.id)
-							{
-								if (node.id != key)
-								{
-									// Can't interact with itself
-									*iterator = *node.id;
-									++iterator;
-								}
-							}
-							else
-							{
-								stack.push(node.left);
-								stack.push(node.right);
-							}
+							return false;
 						}
 					}
 				}
+
+				return true;
+			}
+
+			///
+			/// \brief Obtains every pair of overlapping AABBs in the tree.
+			///
+			/// Each pair is written once, as a `std::pair<key_type, key_type>`.
+			///
+			/// \param[out] iterator The output iterator used to write the pairs.
+			///
+			template<typename OutputIterator>
+			inline void query_pairs(OutputIterator iterator) const
+			{
+				for (index_type source = 0; source < m_node_capacity; ++source)
+				{
+					const auto& node = m_nodes[source];
+					if (node.height != 0)
+					{
+						continue;
+					}
+
+					traverse(
+						[&](const math::AABB& node_aabb) {
+							return node.aabb.overlaps(node_aabb, m_touch_is_overlap);
+						},
+						[&](const index_type leaf) {
+							// Only the lower node index writes the pair.
+							if (leaf > source)
+							{
+								*iterator = std::make_pair(node.id, m_nodes[leaf].id);
+								++iterator;
+							}
+						});
+				}
 			}
 
 			///
 			/// Compute maximum balance.
 			///
-			/// \return Maximum balance as a size_type.
+			/// \return Largest height difference between the children of a node.
 			///
-			inline [[nodiscard]] const size_type compute_maximum_balance() const
+			[[nodiscard]] inline const size_type compute_maximum_balance() const
 			{
 				size_type max_balance {0};
-				for (auto i = 0; i < m_node_capacity; ++i)
+				for (index_type i = 0; i < m_node_capacity; ++i)
 				{
-					const auto& node = m_nodes.at(i);
-					if (node.height > 2)
+					const auto& node = m_nodes[i];
+					if (node.height >= 1)
 					{
-						const auto bal = std::abs(m_nodes.at(*node.left).height - m_nodes.at(*node.right).height);
-						max_balance    = std::max(max_balance, bal);
+						const auto bal = std::abs(m_nodes[node.left].height - m_nodes[node.right].height);
+						max_balance    = std::max(max_balance, static_cast<size_type>(bal));
 					}
 				}
 
@@ -440,17 +645,17 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const double compute_surface_area_ratio() const
 			{
-				if (m_root == std::nullopt)
+				if (m_root == NULL_NODE)
 				{
 					return 0;
 				}
 
-				const auto root_area = m_nodes.at(*m_root).aabb.compute_area();
+				const auto root_area = m_nodes[m_root].aabb.compute_area();
 				double total_area    = 0.0;
 
-				for (auto i = 0; i < m_node_capacity; ++i)
+				for (index_type i = 0; i < m_node_capacity; ++i)
 				{
-					const auto& node = m_nodes.at(i);
+					const auto& node = m_nodes[i];
 
 					if (node.height < 0)
 					{
@@ -472,7 +677,7 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const math::AABB& get_aabb(const key_type& key) const
 			{
-				return m_nodes.at(m_index_map.at(key)).aabb;
+				return m_nodes[m_index_map.at(key)].aabb;
 			}
 
 			///
@@ -482,13 +687,13 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const int height() const
 			{
-				if (m_root == std::nullopt)
+				if (m_root == NULL_NODE)
 				{
 					return 0;
 				}
 				else
 				{
-					return m_nodes.at(*m_root).height;
+					return m_nodes[m_root].height;
 				}
 			}
 
@@ -535,6 +740,199 @@ namespace galaxy
 			}
 
 		private:
+			///
+			/// \brief Walk every branch whose AABB passes a test, calling a visitor on each leaf reached.
+			///
+			/// The stack needs at most one slot per level plus one, so any tree shallower than STACK_SIZE fits.
+			///
+			/// \param overlaps Test taking a const math::AABB&.
+			/// \param visit Function taking the index_type of a leaf.
+			///
+			template<typename Overlaps, typename Visitor>
+			inline void traverse(Overlaps&& overlaps, Visitor&& visit) const
+			{
+				if (m_root == NULL_NODE)
+				{
+					return;
+				}
+
+				if (static_cast<size_type>(m_nodes[m_root].height) >= STACK_SIZE)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "DynamicTree is too deep to query.");
+					return;
+				}
+
+				std::array<index_type, STACK_SIZE> stack;
+				size_type top = 0;
+
+				stack[top++] = m_root;
+				while (top > 0)
+				{
+					const auto& node = m_nodes[stack[--top]];
+
+					if (overlaps(node.aabb))
+					{
+						if (node.is_leaf())
+						{
+							visit(static_cast<index_type>(&node - m_nodes.data()));
+						}
+						else
+						{
+							stack[top++] = node.left;
+							stack[top++] = node.right;
+						}
+					}
+				}
+			}
+
+			///
+			/// Leaf and its centroid, sorted while building.
+			///
+			struct BuildEntry final
+			{
+				index_type m_leaf;
+				glm::vec2 m_centroid;
+			};
+
+			///
+			/// Bounds and number of leaves in a SAH bin.
+			///
+			struct BuildBin final
+			{
+				glm::vec2 m_min {std::numeric_limits<float>::max()};
+				glm::vec2 m_max {std::numeric_limits<float>::lowest()};
+				size_type m_count = 0;
+
+				inline void merge(const glm::vec2& min, const glm::vec2& max) noexcept
+				{
+					m_min = {std::min(m_min.x, min.x), std::min(m_min.y, min.y)};
+					m_max = {std::max(m_max.x, max.x), std::max(m_max.y, max.y)};
+				}
+
+				[[nodiscard]] inline const double area() const noexcept
+				{
+					// Same measure as math::AABB::compute_area().
+					return 2.0 * ((m_max.x - m_min.x) + (m_max.y - m_min.y));
+				}
+			};
+
+			///
+			/// Build a subtree from a range of leaves.
+			///
+			/// \return Index of subtree root.
+			///
+			[[nodiscard]] inline const index_type build_range(std::vector<BuildEntry>& entries, const size_type first, const size_type last, const size_type depth)
+			{
+				if (last - first == 1)
+				{
+					const auto leaf      = entries[first].m_leaf;
+					m_nodes[leaf].height = 0;
+					return leaf;
+				}
+
+				const auto mid   = split_range(entries, first, last, depth);
+				const auto left  = build_range(entries, first, mid, depth + 1);
+				const auto right = build_range(entries, mid, last, depth + 1);
+
+				// Allocate after children, since growing the pool moves nodes.
+				const auto parent = allocate_node();
+				auto& node        = m_nodes[parent];
+				node.left         = left;
+				node.right        = right;
+				node.height       = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+				node.aabb         = math::AABB::merge(m_nodes[left].aabb, m_nodes[right].aabb);
+
+				m_nodes[left].parent  = parent;
+				m_nodes[right].parent = parent;
+
+				return parent;
+			}
+
+			///
+			/// Partition a range of leaves at the cheapest SAH bin boundary along the longest centroid axis.
+			/// Falls back to a median split if every centroid lands in one bin or the tree is getting too deep.
+			///
+			/// \return Index of first entry in the right half.
+			///
+			[[nodiscard]] inline const size_type split_range(std::vector<BuildEntry>& entries, const size_type first, const size_type last, const size_type depth)
+			{
+				glm::vec2 lo = entries[first].m_centroid;
+				glm::vec2 hi = lo;
+				for (auto i = first + 1; i < last; ++i)
+				{
+					const auto& centroid = entries[i].m_centroid;
+					lo                   = {std::min(lo.x, centroid.x), std::min(lo.y, centroid.y)};
+					hi                   = {std::max(hi.x, centroid.x), std::max(hi.y, centroid.y)};
+				}
+
+				const int axis     = (hi.x - lo.x) >= (hi.y - lo.y) ? 0 : 1;
+				const float extent = hi[axis] - lo[axis];
+
+				if (extent > 0.0f && depth < MAX_SAH_DEPTH)
+				{
+					const float scale = static_cast<float>(SAH_BINS) / extent;
+					const auto bin_of = [&](const BuildEntry& entry) {
+						return std::min(SAH_BINS - 1, static_cast<size_type>((entry.m_centroid[axis] - lo[axis]) * scale));
+					};
+
+					std::array<BuildBin, SAH_BINS> bins;
+					for (auto i = first; i < last; ++i)
+					{
+						const auto& aabb = m_nodes[entries[i].m_leaf].aabb;
+						auto& bin        = bins[bin_of(entries[i])];
+
+						bin.merge(aabb.min(), aabb.max());
+						bin.m_count++;
+					}
+
+					// Cost of everything left of each boundary.
+					std::array<double, SAH_BINS> left_cost;
+					BuildBin sweep;
+					for (size_type i = 0; i < SAH_BINS; ++i)
+					{
+						sweep.merge(bins[i].m_min, bins[i].m_max);
+						sweep.m_count += bins[i].m_count;
+						left_cost[i] = sweep.m_count > 0 ? sweep.m_count * sweep.area() : 0.0;
+					}
+
+					auto best_cost = std::numeric_limits<double>::max();
+					size_type best = 0;
+
+					sweep = {};
+					for (auto i = SAH_BINS - 1; i > 0; --i)
+					{
+						sweep.merge(bins[i].m_min, bins[i].m_max);
+						sweep.m_count += bins[i].m_count;
+
+						if (sweep.m_count > 0 && sweep.m_count < last - first)
+						{
+							const auto cost = left_cost[i - 1] + sweep.m_count * sweep.area();
+							if (cost < best_cost)
+							{
+								best_cost = cost;
+								best      = i;
+							}
+						}
+					}
+
+					if (best > 0)
+					{
+						const auto it = std::partition(entries.begin() + first, entries.begin() + last, [&](const BuildEntry& entry) {
+							return bin_of(entry) < best;
+						});
+
+						return static_cast<size_type>(it - entries.begin());
+					}
+				}
+
+				const auto mid = first + (last - first) / 2;
+				std::nth_element(entries.begin() + first, entries.begin() + mid, entries.begin() + last, [&](const BuildEntry& a, const BuildEntry& b) {
+					return a.m_centroid[axis] < b.m_centroid[axis];
+				});
+
+				return mid;
+			}
+
 			///
 			/// Private internal function.
 			///
@@ -543,14 +941,16 @@ namespace galaxy
 				m_nodes.resize(m_node_capacity);
 				for (auto i = begin_init_index; i < (m_node_capacity - 1); ++i)
 				{
-					auto& node  = m_nodes.at(i);
-					node.next   = static_cast<index_type>(i) + 1;
+					auto& node  = m_nodes[i];
+					node.next   = static_cast<index_type>(i + 1);
 					node.height = -1;
 				}
 
-				auto& node  = m_nodes.at(m_node_capacity - 1);
-				node.next   = std::nullopt;
+				auto& node  = m_nodes[m_node_capacity - 1];
+				node.next   = NULL_NODE;
 				node.height = -1;
+
+				m_next_free_index = static_cast<index_type>(begin_init_index);
 			}
 
 			///
@@ -561,9 +961,6 @@ namespace galaxy
 				// The free list is empty. Rebuild a bigger pool.
 				m_node_capacity *= 2;
 				resize_to_match_node_capacity(m_node_count);
-
-				// Assign the index of the first free node.
-				m_next_free_index = static_cast<index_type>(m_node_count);
 			}
 
 			///
@@ -571,38 +968,37 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const index_type allocate_node()
 			{
-				if (m_next_free_index == std::nullopt)
+				if (m_next_free_index == NULL_NODE)
 				{
 					grow_pool();
 				}
 
 				// Peel a node off the free list.
-				const auto node_index = m_next_free_index.value();
-				auto& node            = m_nodes.at(node_index);
+				const auto index = m_next_free_index;
+				auto& node       = m_nodes[index];
 
 				m_next_free_index = node.next;
-				node.parent       = std::nullopt;
-				node.left         = std::nullopt;
-				node.right        = std::nullopt;
+				node.parent       = NULL_NODE;
+				node.left         = NULL_NODE;
+				node.right        = NULL_NODE;
 				node.height       = 0;
 
 				++m_node_count;
 
-				return node_index;
+				return index;
 			}
 
 			///
 			/// Private internal function.
 			///
-			inline void free_node(const index_type node)
+			inline void free_node(const index_type index)
 			{
-				m_nodes.at(node).next   = m_next_free_index;
-				m_nodes.at(node).height = -1;
+				m_nodes[index].next   = m_next_free_index;
+				m_nodes[index].height = -1;
 
-				m_next_free_index = node;
+				m_next_free_index = index;
 				--m_node_count;
 			}
-
 			///
 			/// Private internal function.
 			///
@@ -644,13 +1040,13 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const index_type find_best_sibling(const math::AABB& leaf_aabb) const
 			{
-				auto index = m_root.value();
+				auto index = m_root;
 
-				while (!m_nodes.at(index).is_leaf())
+				while (!m_nodes[index].is_leaf())
 				{
-					const auto& node = m_nodes.at(index);
-					const auto left  = node.left.value();
-					const auto right = node.right.value();
+					const auto& node = m_nodes[index];
+					const auto left  = node.left;
+					const auto right = node.right;
 
 					const auto surface_area = node.aabb.area();
 					const auto combined_surface_area =
@@ -662,9 +1058,9 @@ namespace galaxy
 					// Minimum cost of pushing the leaf further down the tree.
 					const auto minimum_cost = 2.0 * (combined_surface_area - surface_area);
 
-					const auto cost_left = left_cost(leaf_aabb, m_nodes.at(left), minimum_cost);
+					const auto cost_left = left_cost(leaf_aabb, m_nodes[left], minimum_cost);
 					const auto cost_right =
-					    right_cost(leaf_aabb, m_nodes.at(right), minimum_cost);
+					    right_cost(leaf_aabb, m_nodes[right], minimum_cost);
 
 					// Descend according to the minimum cost.
 					if ((cost < cost_left) && (cost < cost_right))
@@ -691,15 +1087,15 @@ namespace galaxy
 			///
 			[[nodiscard]] inline const index_type balance(const index_type node_index)
 			{
-				if (m_nodes.at(node_index).is_leaf() || (m_nodes.at(node_index).height < 2))
+				if (m_nodes[node_index].is_leaf() || (m_nodes[node_index].height < 2))
 				{
 					return node_index;
 				}
 
-				const auto left_index  = m_nodes.at(node_index).left.value();
-				const auto right_index = m_nodes.at(node_index).right.value();
+				const auto left_index  = m_nodes[node_index].left;
+				const auto right_index = m_nodes[node_index].right;
 
-				const auto current_balance = m_nodes.at(right_index).height - m_nodes.at(left_index).height;
+				const auto current_balance = m_nodes[right_index].height - m_nodes[left_index].height;
 
 				// Rotate right branch up.
 				if (current_balance > 1)
@@ -721,19 +1117,19 @@ namespace galaxy
 			///
 			/// Private internal function.
 			///
-			inline void fix_tree_upwards(maybe_index index)
+			inline void fix_tree_upwards(index_type index)
 			{
-				while (index != std::nullopt)
+				while (index != NULL_NODE)
 				{
-					index = balance(*index);
+					index = balance(index);
 
-					auto& node = m_nodes.at(*index);
+					auto& node = m_nodes[index];
 
-					const auto left  = node.left.value();
-					const auto right = node.right.value();
+					const auto left  = node.left;
+					const auto right = node.right;
 
-					const auto& left_node  = m_nodes.at(left);
-					const auto& right_node = m_nodes.at(right);
+					const auto& left_node  = m_nodes[left];
+					const auto& right_node = m_nodes[right];
 
 					node.height = 1 + std::max(left_node.height, right_node.height);
 					node.aabb   = math::AABB::merge(left_node.aabb, right_node.aabb);
@@ -747,31 +1143,31 @@ namespace galaxy
 			///
 			inline void insert_leaf(const index_type leaf_index)
 			{
-				if (m_root == std::nullopt)
+				if (m_root == NULL_NODE)
 				{
-					m_root                     = leaf_index;
-					m_nodes.at(*m_root).parent = std::nullopt;
+					m_root                 = leaf_index;
+					m_nodes[m_root].parent = NULL_NODE;
 					return;
 				}
 
 				// Find the best sibling for the node.
-				const auto leaf_aabb     = m_nodes.at(leaf_index).aabb; // copy current AABB
+				const auto leaf_aabb     = m_nodes[leaf_index].aabb; // copy current AABB
 				const auto sibling_index = find_best_sibling(leaf_aabb);
 
 				// Create a new parent.
-				const auto old_parent_index = m_nodes.at(sibling_index).parent;
+				const auto old_parent_index = m_nodes[sibling_index].parent;
 				const auto new_parent_index = allocate_node();
 
-				auto& new_parent  = m_nodes.at(new_parent_index);
+				auto& new_parent  = m_nodes[new_parent_index];
 				new_parent.parent = old_parent_index;
-				new_parent.aabb   = math::AABB::merge(leaf_aabb, m_nodes.at(sibling_index).aabb);
+				new_parent.aabb   = math::AABB::merge(leaf_aabb, m_nodes[sibling_index].aabb);
 
-				new_parent.height = m_nodes.at(sibling_index).height + 1;
+				new_parent.height = m_nodes[sibling_index].height + 1;
 
-				if (old_parent_index != std::nullopt)
+				if (old_parent_index != NULL_NODE)
 				{
 					// The sibling was not the root.
-					auto& old_parent = m_nodes.at(*old_parent_index);
+					auto& old_parent = m_nodes[old_parent_index];
 					if (old_parent.left == sibling_index)
 					{
 						old_parent.left = new_parent_index;
@@ -790,28 +1186,28 @@ namespace galaxy
 				new_parent.left  = sibling_index;
 				new_parent.right = leaf_index;
 
-				m_nodes.at(sibling_index).parent = new_parent_index;
-				m_nodes.at(leaf_index).parent    = new_parent_index;
+				m_nodes[sibling_index].parent = new_parent_index;
+				m_nodes[leaf_index].parent    = new_parent_index;
 
 				// Walk back up the tree fixing heights and AABBs.
-				fix_tree_upwards(m_nodes.at(leaf_index).parent);
+				fix_tree_upwards(m_nodes[leaf_index].parent);
 			}
 
 			///
 			/// Private internal function.
 			///
-			inline void adjust_ancestor_bounds(maybe_index index)
+			inline void adjust_ancestor_bounds(index_type index)
 			{
-				while (index != std::nullopt)
+				while (index != NULL_NODE)
 				{
-					index = balance(*index);
+					index = balance(index);
 
-					auto& node = m_nodes.at(*index);
+					auto& node = m_nodes[index];
 
 					const auto left        = node.left;
 					const auto right       = node.right;
-					const auto& left_node  = m_nodes.at(left.value());
-					const auto& right_node = m_nodes.at(right.value());
+					const auto& left_node  = m_nodes[left];
+					const auto& right_node = m_nodes[right];
 
 					node.aabb   = math::AABB::merge(left_node.aabb, right_node.aabb);
 					node.height = 1 + std::max(left_node.height, right_node.height);
@@ -827,41 +1223,41 @@ namespace galaxy
 			{
 				if (leaf_index == m_root)
 				{
-					m_root = std::nullopt;
+					m_root = NULL_NODE;
 					return;
 				}
 
-				const auto parent_index       = m_nodes.at(leaf_index).parent;
-				const auto grand_parent_index = m_nodes.at(parent_index.value()).parent;
+				const auto parent_index       = m_nodes[leaf_index].parent;
+				const auto grand_parent_index = m_nodes[parent_index].parent;
 
 				const auto sibling_index =
-				    (m_nodes.at(parent_index.value()).left == leaf_index)
-				    ? m_nodes.at(parent_index.value()).right
-				    : m_nodes.at(parent_index.value()).left;
+				    (m_nodes[parent_index].left == leaf_index)
+				    ? m_nodes[parent_index].right
+				    : m_nodes[parent_index].left;
 
 				// Destroy the parent and connect the sibling to the grandparent.
-				if (grand_parent_index != std::nullopt)
+				if (grand_parent_index != NULL_NODE)
 				{
-					if (m_nodes.at(*grand_parent_index).left == parent_index)
+					if (m_nodes[grand_parent_index].left == parent_index)
 					{
-						m_nodes.at(*grand_parent_index).left = sibling_index;
+						m_nodes[grand_parent_index].left = sibling_index;
 					}
 					else
 					{
-						m_nodes.at(*grand_parent_index).right = sibling_index;
+						m_nodes[grand_parent_index].right = sibling_index;
 					}
 
-					m_nodes.at(sibling_index.value()).parent = grand_parent_index;
-					free_node(parent_index.value());
+					m_nodes[sibling_index].parent = grand_parent_index;
+					free_node(parent_index);
 
 					// Adjust ancestor bounds.
 					adjust_ancestor_bounds(grand_parent_index);
 				}
 				else
 				{
-					m_root                                   = sibling_index;
-					m_nodes.at(sibling_index.value()).parent = std::nullopt;
-					free_node(parent_index.value());
+					m_root                        = sibling_index;
+					m_nodes[sibling_index].parent = NULL_NODE;
+					free_node(parent_index);
 				}
 			}
 
@@ -870,11 +1266,11 @@ namespace galaxy
 			///
 			inline void rotate_right(const index_type node_index, const index_type left_index, const index_type right_index)
 			{
-				auto& node       = m_nodes.at(node_index);
-				auto& right_node = m_nodes.at(right_index);
+				auto& node       = m_nodes[node_index];
+				auto& right_node = m_nodes[right_index];
 
-				const auto right_left  = right_node.left.value();
-				const auto right_right = right_node.right.value();
+				const auto right_left  = right_node.left;
+				const auto right_right = right_node.right;
 
 				// Swap node and its right-hand child.
 				right_node.left   = node_index;
@@ -882,9 +1278,9 @@ namespace galaxy
 				node.parent       = right_index;
 
 				// The node's old parent should now point to its right-hand child.
-				if (right_node.parent != std::nullopt)
+				if (right_node.parent != NULL_NODE)
 				{
-					auto& right_parent = m_nodes.at(*right_node.parent);
+					auto& right_parent = m_nodes[right_node.parent];
 					if (right_parent.left == node_index)
 					{
 						right_parent.left = right_index;
@@ -899,9 +1295,9 @@ namespace galaxy
 					m_root = right_index;
 				}
 
-				auto& left_node        = m_nodes.at(left_index);
-				auto& right_right_node = m_nodes.at(right_right);
-				auto& right_left_node  = m_nodes.at(right_left);
+				auto& left_node        = m_nodes[left_index];
+				auto& right_right_node = m_nodes[right_right];
+				auto& right_left_node  = m_nodes[right_left];
 
 				// Rotate.
 				if (right_left_node.height > right_right_node.height)
@@ -937,11 +1333,11 @@ namespace galaxy
 			///
 			inline void rotate_left(const index_type node_index, const index_type left_index, const index_type right_index)
 			{
-				auto& node      = m_nodes.at(node_index);
-				auto& left_node = m_nodes.at(left_index);
+				auto& node      = m_nodes[node_index];
+				auto& left_node = m_nodes[left_index];
 
-				const auto left_left  = left_node.left.value();
-				const auto left_right = left_node.right.value();
+				const auto left_left  = left_node.left;
+				const auto left_right = left_node.right;
 
 				// Swap node and its left-hand child.
 				left_node.left   = node_index;
@@ -949,9 +1345,9 @@ namespace galaxy
 				node.parent      = left_index;
 
 				// The node's old parent should now point to its left-hand child.
-				if (left_node.parent != std::nullopt)
+				if (left_node.parent != NULL_NODE)
 				{
-					auto& left_parent = m_nodes.at(*left_node.parent);
+					auto& left_parent = m_nodes[left_node.parent];
 					if (left_parent.left == node_index)
 					{
 						left_parent.left = left_index;
@@ -966,9 +1362,9 @@ namespace galaxy
 					m_root = left_index;
 				}
 
-				auto& right_node      = m_nodes.at(right_index);
-				auto& left_left_node  = m_nodes.at(left_left);
-				auto& left_right_node = m_nodes.at(left_right);
+				auto& right_node      = m_nodes[right_index];
+				auto& left_left_node  = m_nodes[left_left];
+				auto& left_right_node = m_nodes[left_right];
 
 				// Rotate.
 				if (left_left_node.height > left_right_node.height)
@@ -1010,14 +1406,14 @@ namespace galaxy
 			///
 			/// Private internal function.
 			///
-			[[nodiscard]] inline const size_type compute_height(const maybe_index node_index) const
+			[[nodiscard]] inline const size_type compute_height(const index_type node_index) const
 			{
-				if (!node_index)
+				if (node_index == NULL_NODE)
 				{
 					return 0;
 				}
 
-				const auto& node = m_nodes.at(*node_index);
+				const auto& node = m_nodes[node_index];
 				if (node.is_leaf())
 				{
 					return 0;
@@ -1034,8 +1430,8 @@ namespace galaxy
 			std::vector<node_type> m_nodes;
 			robin_hood::unordered_map<key_type, index_type> m_index_map;
 
-			maybe_index m_root;
-			maybe_index m_next_free_index = 0;
+			index_type m_root            = NULL_NODE;
+			index_type m_next_free_index = 0;
 
 			size_type m_node_count = 0;
 			size_type m_node_capacity;
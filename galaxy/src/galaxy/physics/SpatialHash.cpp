@@ -0,0 +1,8 @@
+///
+/// SpatialHash.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include "SpatialHash.hpp"
\ No newline at end of file
@@ -0,0 +1,754 @@
+///
+/// SpatialHash.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_PHYSICS_SPATIALHASH_HPP_
+#define GALAXY_PHYSICS_SPATIALHASH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <robin_hood.h>
+
+#include "galaxy/error/Log.hpp"
+#include "galaxy/math/AABB.hpp"
+#include "galaxy/physics/DynamicTree.hpp"
+
+namespace galaxy
+{
+	namespace physics
+	{
+		///
+		/// \brief Uniform grid of AABBs, hashed by cell, used for efficient collision detection.
+		///
+		/// Has the same interface as DynamicTree, so either can be used as a broadphase. Inserting, moving and
+		/// querying a box only touches the cells it covers, so it beats the tree when boxes are about one cell
+		/// in size, i.e. tiles and tile sized sprites. Boxes covering more than MAX_CELLS cells are kept in a
+		/// separate list and tested against every query instead.
+		///
+		/// Cell lists are pooled in one flat array. A box found in several cells is only written once, by the
+		/// first cell it shares with the query, so queries do not allocate or keep state.
+		///
+		template<typename Key>
+		class SpatialHash final
+		{
+		public:
+			using value_type = float;
+			using key_type   = Key;
+			using size_type  = std::size_t;
+			using index_type = std::uint32_t;
+
+			///
+			/// Boxes covering more cells than this are not stored in cells.
+			///
+			inline static constexpr const size_type MAX_CELLS = 16;
+
+			///
+			/// Creates a spatial hash.
+			///
+			/// \param cell_size Width and height of a cell.
+			///
+			inline explicit SpatialHash(const glm::vec2& cell_size = {32.0f, 32.0f})
+			    : m_cell_size {1.0f, 1.0f}
+			{
+				set_cell_size(cell_size);
+			}
+
+			///
+			/// \brief Set the size of a cell.
+			///
+			/// Every box is moved to its new cells if the size changed. Fattened AABBs are kept, so cached pairs stay valid.
+			///
+			/// \param cell_size Width and height of a cell. Must be positive.
+			///
+			inline void set_cell_size(const glm::vec2& cell_size)
+			{
+				if (cell_size.x <= 0.0f || cell_size.y <= 0.0f)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Spatial hash cell size must be positive.");
+					return;
+				}
+
+				if (cell_size == m_cell_size)
+				{
+					return;
+				}
+
+				m_cell_size = cell_size;
+
+				m_cells.clear();
+				m_entries.clear();
+				m_large.clear();
+				m_free_entry = NULL_NODE;
+
+				for (const auto& [key, index] : m_index_map)
+				{
+					link(index);
+				}
+			}
+
+			///
+			/// Inserts an AABB.
+			///
+			/// \param key The ID that will be associated with the box.
+			/// \param lower_bound The lower bound position of the AABB, i.e. the position.
+			/// \param upper_bound The upper bound position of the AABB.
+			///
+			inline void insert(const key_type& key, const glm::vec2& lower_bound, const glm::vec2& upper_bound)
+			{
+				if (!m_index_map.contains(key))
+				{
+					const auto index = allocate_proxy();
+					auto& proxy      = m_proxies[index];
+					proxy.m_key      = key;
+					proxy.m_aabb     = {lower_bound, upper_bound};
+					proxy.m_aabb.fatten(m_skin_thickness);
+
+					link(index);
+					m_index_map.emplace(key, index);
+				}
+				else
+				{
+					GALAXY_LOG(GALAXY_WARNING, "Cannot insert duplicate key.");
+				}
+			}
+
+			///
+			/// Insert many AABBs at once. Cells are only ever touched by their own boxes, so this is the same as inserting one at a time.
+			///
+			/// \param boxes Keys and the AABBs to associate with them.
+			///
+			inline void insert(std::span<const std::pair<key_type, math::AABB>> boxes)
+			{
+				m_proxies.reserve(m_proxies.size() + boxes.size());
+				m_index_map.reserve(m_index_map.size() + boxes.size());
+
+				for (const auto& [key, aabb] : boxes)
+				{
+					insert(key, aabb.min(), aabb.max());
+				}
+			}
+
+			///
+			/// Removes the AABB associated with the specified ID.
+			///
+			/// This function has no effect if there is no AABB associated with the specified ID.
+			///
+			/// \param key The ID associated with the AABB that will be removed.
+			///
+			inline void erase(const key_type& key)
+			{
+				if (const auto it = m_index_map.find(key); it != m_index_map.end())
+				{
+					const auto index = it->second;
+
+					m_index_map.erase(it);
+
+					unlink(index);
+					m_proxies[index].m_first = m_free_proxy;
+					m_free_proxy             = index;
+				}
+			}
+
+			///
+			/// Clears all entries.
+			///
+			inline void clear()
+			{
+				m_index_map.clear();
+				m_proxies.clear();
+				m_entries.clear();
+				m_cells.clear();
+				m_large.clear();
+
+				m_free_proxy = NULL_NODE;
+				m_free_entry = NULL_NODE;
+			}
+
+			///
+			/// \brief Updates the AABB associated with the specified ID.
+			///
+			/// This function has no effect if there is no AABB associated with the specified ID.
+			///
+			/// \param key The ID associated with the AABB that will be replaced.
+			/// \param aabb The new AABB that will be associated with the specified ID.
+			/// \param force_reinsert Always replace the fattened AABB, even if the new AABB is within it.
+			///
+			/// \return True if the fattened AABB was replaced; `false` otherwise.
+			///
+			[[maybe_unused]] inline const bool update(const key_type& key, math::AABB aabb, bool force_reinsert = false)
+			{
+				if (const auto it = m_index_map.find(key); it != m_index_map.end())
+				{
+					const auto index = it->second;
+					auto& proxy      = m_proxies[index];
+
+					// No need to update if the box is still within its fattened AABB.
+					if (!force_reinsert && proxy.m_aabb.contains(aabb))
+					{
+						return false;
+					}
+
+					aabb.fatten(m_skin_thickness);
+					proxy.m_aabb = aabb;
+
+					// Most moves stay in the same cells.
+					const auto range = cells_of(aabb);
+					if (range != proxy.m_range)
+					{
+						unlink(index);
+						link(index);
+					}
+
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			///
+			/// Alternate Update Function.
+			///
+			[[maybe_unused]] inline const bool update(const key_type& key, const glm::vec2& lower_bound, const glm::vec2& upper_bound, bool force_reinsert = false)
+			{
+				return update(key, {lower_bound, upper_bound}, force_reinsert);
+			}
+
+			///
+			/// Set thickness factor.
+			///
+			/// \param thickness_factor Skin thickness factor.
+			///
+			inline void set_thickness_factor(std::optional<double> thickness_factor)
+			{
+				if (thickness_factor)
+				{
+					m_skin_thickness = std::max(*thickness_factor, 0.0);
+				}
+				else
+				{
+					m_skin_thickness = std::nullopt;
+				}
+			}
+
+			///
+			/// \brief Obtains collision candidates for the AABB associated with the specified ID.
+			///
+			/// This function has no effect if the supplied key is unknown.
+			///
+			/// \param key The ID associated with the AABB to obtain collision candidates for.
+			/// \param[out] iterator The output iterator used to write the collision candidate IDs.
+			///
+			template<typename OutputIterator>
+			inline void query(const key_type& key, OutputIterator iterator) const
+			{
+				if (const auto it = m_index_map.find(key); it != m_index_map.end())
+				{
+					const auto source = it->second;
+					const auto& aabb  = m_proxies[source].m_aabb;
+
+					const auto candidate = [&](const index_type index) {
+						// Can't interact with itself.
+						if (index != source && aabb.overlaps(m_proxies[index].m_aabb, true))
+						{
+							*iterator = m_proxies[index].m_key;
+							++iterator;
+						}
+					};
+
+					if (m_proxies[source].m_large)
+					{
+						// Not in any cell, so everything is a candidate.
+						for (const auto& [other, index] : m_index_map)
+						{
+							candidate(index);
+						}
+					}
+					else
+					{
+						traverse(m_proxies[source].m_range, candidate);
+					}
+				}
+			}
+
+			///
+			/// Obtains the IDs of all AABBs overlapping an area.
+			///
+			/// \param aabb Area to test against.
+			/// \param[out] iterator The output iterator used to write the overlapping IDs.
+			///
+			template<typename OutputIterator>
+			inline void query(const math::AABB& aabb, OutputIterator iterator) const
+			{
+				traverse(cells_of(aabb), [&](const index_type index) {
+					if (aabb.overlaps(m_proxies[index].m_aabb, true))
+					{
+						*iterator = m_proxies[index].m_key;
+						++iterator;
+					}
+				});
+			}
+
+			///
+			/// Obtains the IDs of all AABBs crossed by a line segment, in no particular order.
+			///
+			/// \param from Start of segment.
+			/// \param to End of segment.
+			/// \param[out] iterator The output iterator used to write the IDs that were hit.
+			///
+			template<typename OutputIterator>
+			inline void ray_cast(const glm::vec2& from, const glm::vec2& to, OutputIterator iterator) const
+			{
+				const glm::vec2 direction = to - from;
+				const math::AABB bounds {glm::min(from, to), glm::max(from, to)};
+
+				traverse(cells_of(bounds), [&](const index_type index) {
+					if (DynamicTree<key_type>::segment_overlaps(m_proxies[index].m_aabb, from, direction, {0.0f, 0.0f}))
+					{
+						*iterator = m_proxies[index].m_key;
+						++iterator;
+					}
+				});
+			}
+
+			///
+			/// \brief Obtains the IDs of all AABBs touched by a box moving along a displacement, in no particular order.
+			///
+			/// Candidates are found against the fattened AABBs. Use DynamicTree::time_of_impact() for the exact hit.
+			///
+			/// \param aabb Box at the start of the move.
+			/// \param displacement Distance moved.
+			/// \param[out] iterator The output iterator used to write the IDs that were hit.
+			///
+			template<typename OutputIterator>
+			inline void sweep(const math::AABB& aabb, const glm::vec2& displacement, OutputIterator iterator) const
+			{
+				const glm::vec2 extents = (aabb.max() - aabb.min()) * 0.5f;
+				const glm::vec2 centre  = aabb.min() + extents;
+				const math::AABB bounds {glm::min(aabb.min(), aabb.min() + displacement), glm::max(aabb.max(), aabb.max() + displacement)};
+
+				traverse(cells_of(bounds), [&](const index_type index) {
+					if (DynamicTree<key_type>::segment_overlaps(m_proxies[index].m_aabb, centre, displacement, extents))
+					{
+						*iterator = m_proxies[index].m_key;
+						++iterator;
+					}
+				});
+			}
+
+			///
+			/// \brief Obtains every pair of overlapping AABBs.
+			///
+			/// Each pair is written once, as a `std::pair<key_type, key_type>`.
+			///
+			/// \param[out] iterator The output iterator used to write the pairs.
+			///
+			template<typename OutputIterator>
+			inline void query_pairs(OutputIterator iterator) const
+			{
+				for (const auto& [cell, head] : m_cells)
+				{
+					const auto x = cell_x(cell);
+					const auto y = cell_y(cell);
+
+					for (auto a = head; a != NULL_NODE; a = m_entries[a].m_next)
+					{
+						const auto& proxy_a = m_proxies[m_entries[a].m_proxy];
+
+						for (auto b = m_entries[a].m_next; b != NULL_NODE; b = m_entries[b].m_next)
+						{
+							const auto& proxy_b = m_proxies[m_entries[b].m_proxy];
+
+							// Only the first cell both boxes are in writes the pair.
+							if (x == std::max(proxy_a.m_range.m_min_x, proxy_b.m_range.m_min_x) && y == std::max(proxy_a.m_range.m_min_y, proxy_b.m_range.m_min_y) &&
+								proxy_a.m_aabb.overlaps(proxy_b.m_aabb, true))
+							{
+								*iterator = std::make_pair(proxy_a.m_key, proxy_b.m_key);
+								++iterator;
+							}
+						}
+					}
+				}
+
+				for (const auto large : m_large)
+				{
+					const auto& proxy_a = m_proxies[large];
+
+					for (const auto& [key, index] : m_index_map)
+					{
+						// Pairs of large boxes are written by the lower index.
+						const auto& proxy_b = m_proxies[index];
+						if ((!proxy_b.m_large || index > large) && proxy_a.m_aabb.overlaps(proxy_b.m_aabb, true))
+						{
+							*iterator = std::make_pair(proxy_a.m_key, proxy_b.m_key);
+							++iterator;
+						}
+					}
+				}
+			}
+
+			///
+			/// Get the fattened AABB associated with a key.
+			///
+			/// \param key The key associated with the AABB.
+			///
+			/// \return Const reference to AABB.
+			///
+			[[nodiscard]] inline const math::AABB& get_aabb(const key_type& key) const
+			{
+				return m_proxies[m_index_map.at(key)].m_aabb;
+			}
+
+			///
+			/// Get size of a cell.
+			///
+			/// \return Const glm::vec2 reference.
+			///
+			[[nodiscard]] inline const glm::vec2& cell_size() const noexcept
+			{
+				return m_cell_size;
+			}
+
+			///
+			/// Get number of cells that contain at least one box.
+			///
+			/// \return Size type.
+			///
+			[[nodiscard]] inline const size_type cell_count() const noexcept
+			{
+				return m_cells.size();
+			}
+
+			///
+			/// Get number of boxes too large to be stored in cells.
+			///
+			/// \return Size type.
+			///
+			[[nodiscard]] inline const size_type large_count() const noexcept
+			{
+				return m_large.size();
+			}
+
+			///
+			/// Get number of boxes.
+			///
+			/// \return Size type.
+			///
+			[[nodiscard]] inline const size_type size() const noexcept
+			{
+				return m_index_map.size();
+			}
+
+			///
+			/// Is empty.
+			///
+			/// \return True if there are no boxes.
+			///
+			[[nodiscard]] inline const bool is_empty() const noexcept
+			{
+				return m_index_map.empty();
+			}
+
+			///
+			/// Get thickness factor.
+			///
+			/// \return Skin thickness factor.
+			///
+			[[nodiscard]] inline const std::optional<double> thickness_factor() const noexcept
+			{
+				return m_skin_thickness;
+			}
+
+		private:
+			///
+			/// Inclusive range of cells covered by a box.
+			///
+			struct Range final
+			{
+				std::int32_t m_min_x;
+				std::int32_t m_min_y;
+				std::int32_t m_max_x;
+				std::int32_t m_max_y;
+
+				[[nodiscard]] inline bool operator==(const Range&) const noexcept = default;
+
+				[[nodiscard]] inline const std::int64_t count() const noexcept
+				{
+					return (static_cast<std::int64_t>(m_max_x) - m_min_x + 1) * (static_cast<std::int64_t>(m_max_y) - m_min_y + 1);
+				}
+
+				[[nodiscard]] inline const bool contains(const std::int32_t x, const std::int32_t y) const noexcept
+				{
+					return x >= m_min_x && x <= m_max_x && y >= m_min_y && y <= m_max_y;
+				}
+			};
+
+			///
+			/// Box stored in the hash.
+			///
+			struct Proxy final
+			{
+				math::AABB m_aabb;
+				key_type m_key {};
+				Range m_range {};
+
+				///
+				/// First entry of this box, chained by Entry::m_sibling. Next free proxy when unused.
+				///
+				index_type m_first = NULL_NODE;
+
+				bool m_large = false;
+			};
+
+			///
+			/// Box in one cell list.
+			///
+			struct Entry final
+			{
+				index_type m_proxy   = NULL_NODE;
+				index_type m_next    = NULL_NODE;
+				index_type m_prev    = NULL_NODE;
+				index_type m_sibling = NULL_NODE;
+				std::uint64_t m_cell = 0;
+			};
+
+			///
+			/// Pack a cell position into a hash key.
+			///
+			[[nodiscard]] static inline const std::uint64_t cell_key(const std::int32_t x, const std::int32_t y) noexcept
+			{
+				return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+			}
+
+			[[nodiscard]] static inline const std::int32_t cell_x(const std::uint64_t key) noexcept
+			{
+				return static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32));
+			}
+
+			[[nodiscard]] static inline const std::int32_t cell_y(const std::uint64_t key) noexcept
+			{
+				return static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+			}
+
+			///
+			/// Cell containing a coordinate along one axis. Clamped so huge boxes do not overflow.
+			///
+			[[nodiscard]] static inline const std::int32_t to_cell(const float value, const float size) noexcept
+			{
+				constexpr const float limit = 1 << 30;
+				return static_cast<std::int32_t>(std::clamp(std::floor(value / size), -limit, limit));
+			}
+
+			///
+			/// Range of cells covered by a box.
+			///
+			[[nodiscard]] inline const Range cells_of(const math::AABB& aabb) const noexcept
+			{
+				return {to_cell(aabb.min().x, m_cell_size.x), to_cell(aabb.min().y, m_cell_size.y), to_cell(aabb.max().x, m_cell_size.x), to_cell(aabb.max().y, m_cell_size.y)};
+			}
+
+			///
+			/// \brief Visit every box stored in a range of cells once, followed by every large box.
+			///
+			/// A box is visited from the first cell it shares with the range. When the range covers more cells than
+			/// are in use, i.e. a camera sized query over a sparse map, the used cells are walked instead.
+			///
+			template<typename Visitor>
+			inline void traverse(const Range& range, Visitor&& visit) const
+			{
+				const auto visit_cell = [&](const std::int32_t x, const std::int32_t y, index_type entry) {
+					for (; entry != NULL_NODE; entry = m_entries[entry].m_next)
+					{
+						const auto index  = m_entries[entry].m_proxy;
+						const auto& other = m_proxies[index].m_range;
+
+						if (x == std::max(range.m_min_x, other.m_min_x) && y == std::max(range.m_min_y, other.m_min_y))
+						{
+							visit(index);
+						}
+					}
+				};
+
+				if (range.count() > static_cast<std::int64_t>(m_cells.size()))
+				{
+					for (const auto& [cell, head] : m_cells)
+					{
+						const auto x = cell_x(cell);
+						const auto y = cell_y(cell);
+
+						if (range.contains(x, y))
+						{
+							visit_cell(x, y, head);
+						}
+					}
+				}
+				else
+				{
+					for (auto y = range.m_min_y; y <= range.m_max_y; ++y)
+					{
+						for (auto x = range.m_min_x; x <= range.m_max_x; ++x)
+						{
+							if (const auto it = m_cells.find(cell_key(x, y)); it != m_cells.end())
+							{
+								visit_cell(x, y, it->second);
+							}
+						}
+					}
+				}
+
+				for (const auto index : m_large)
+				{
+					visit(index);
+				}
+			}
+
+			///
+			/// Add a box to every cell it covers, or to the large list.
+			///
+			inline void link(const index_type index)
+			{
+				auto& proxy   = m_proxies[index];
+				proxy.m_range = cells_of(proxy.m_aabb);
+				proxy.m_first = NULL_NODE;
+				proxy.m_large = proxy.m_range.count() > static_cast<std::int64_t>(MAX_CELLS);
+
+				if (proxy.m_large)
+				{
+					m_large.push_back(index);
+					return;
+				}
+
+				const auto range = proxy.m_range;
+				for (auto y = range.m_min_y; y <= range.m_max_y; ++y)
+				{
+					for (auto x = range.m_min_x; x <= range.m_max_x; ++x)
+					{
+						const auto key      = cell_key(x, y);
+						const auto entry    = allocate_entry();
+						auto [it, inserted] = m_cells.try_emplace(key, NULL_NODE);
+
+						auto& node     = m_entries[entry];
+						node.m_proxy   = index;
+						node.m_cell    = key;
+						node.m_prev    = NULL_NODE;
+						node.m_next    = it->second;
+						node.m_sibling = m_proxies[index].m_first;
+
+						if (node.m_next != NULL_NODE)
+						{
+							m_entries[node.m_next].m_prev = entry;
+						}
+
+						it->second               = entry;
+						m_proxies[index].m_first = entry;
+					}
+				}
+			}
+
+			///
+			/// Remove a box from its cells, or from the large list.
+			///
+			inline void unlink(const index_type index)
+			{
+				auto& proxy = m_proxies[index];
+
+				if (proxy.m_large)
+				{
+					std::erase(m_large, index);
+					proxy.m_large = false;
+
+					return;
+				}
+
+				for (auto entry = proxy.m_first; entry != NULL_NODE;)
+				{
+					const auto& node = m_entries[entry];
+
+					if (node.m_prev != NULL_NODE)
+					{
+						m_entries[node.m_prev].m_next = node.m_next;
+					}
+					else if (node.m_next != NULL_NODE)
+					{
+						m_cells[node.m_cell] = node.m_next;
+					}
+					else
+					{
+						// Empty cells are removed so they are not walked by large queries.
+						m_cells.erase(node.m_cell);
+					}
+
+					if (node.m_next != NULL_NODE)
+					{
+						m_entries[node.m_next].m_prev = node.m_prev;
+					}
+
+					const auto sibling      = node.m_sibling;
+					m_entries[entry].m_next = m_free_entry;
+					m_free_entry            = entry;
+
+					entry = sibling;
+				}
+
+				proxy.m_first = NULL_NODE;
+			}
+
+			[[nodiscard]] inline const index_type allocate_proxy()
+			{
+				if (m_free_proxy != NULL_NODE)
+				{
+					const auto index = m_free_proxy;
+					m_free_proxy     = m_proxies[index].m_first;
+
+					return index;
+				}
+
+				m_proxies.emplace_back();
+				return static_cast<index_type>(m_proxies.size() - 1);
+			}
+
+			[[nodiscard]] inline const index_type allocate_entry()
+			{
+				if (m_free_entry != NULL_NODE)
+				{
+					const auto index = m_free_entry;
+					m_free_entry     = m_entries[index].m_next;
+
+					return index;
+				}
+
+				m_entries.emplace_back();
+				return static_cast<index_type>(m_entries.size() - 1);
+			}
+
+		private:
+			std::vector<Proxy> m_proxies;
+			std::vector<Entry> m_entries;
+			std::vector<index_type> m_large;
+
+			robin_hood::unordered_map<key_type, index_type> m_index_map;
+			robin_hood::unordered_flat_map<std::uint64_t, index_type> m_cells;
+
+			index_type m_free_proxy = NULL_NODE;
+			index_type m_free_entry = NULL_NODE;
+
+			glm::vec2 m_cell_size;
+
+			std::optional<double> m_skin_thickness = 0.05;
+		};
+	} // namespace physics
+} // namespace galaxy
+
+#endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <nlohmann/json.hpp>
 
 #include "galaxy/fs/FileSystem.hpp"
+#include "galaxy/resource/Loader.hpp"
 #include "galaxy/scripting/JSONUtils.hpp"
 
 #include "FontBook.hpp"
@@ -16,6 +17,11 @@ namespace galaxy
 {
 	namespace res
 	{
+		FontBook::FontBook() noexcept
+		    : Serializable {this}
+		{
+		}
+
 		FontBook::FontBook(std::string_view file)
 		    : Serializable {this}
 		{
@@ -40,6 +46,29 @@ namespace galaxy
 			}
 		}
 
+		void FontBook::create_from_json(std::string_view file, Loader& loader)
+		{
+			const auto json_opt = json::parse_from_disk(file);
+			if (json_opt == std::nullopt)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to create parse/load json file: {0}, for Fontbook.", file);
+			}
+			else
+			{
+				clear();
+
+				for (const auto& [name, obj] : json_opt.value().at("fontbook").items())
+				{
+					const std::string font = obj.at("file");
+					const int size         = obj.at("size");
+
+					loader.bytes(font, [this, name = name, font, size](std::vector<char>& data) {
+						return create(name)->create(font, data, size);
+					});
+				}
+			}
+		}
+
 		void FontBook::clear() noexcept
 		{
 			m_resources.clear();
@@ -16,6 +16,8 @@ namespace galaxy
 {
 	namespace res
 	{
+		class Loader;
+
 		///
 		/// Resource manager for fonts.
 		///
@@ -25,7 +27,7 @@ namespace galaxy
 			///
 			/// Constructor.
 			///
-			FontBook() noexcept = default;
+			FontBook() noexcept;
 
 			///
 			/// JSON constructor.
@@ -46,6 +48,16 @@ namespace galaxy
 			///
 			void create_from_json(std::string_view file);
 
+			///
+			/// \brief Create FontBook from JSON, reading font files in the background.
+			///
+			/// Fonts are created as the loader is polled, so they are not available until then.
+			///
+			/// \param file JSON file to load.
+			/// \param loader Loader to read fonts with.
+			///
+			void create_from_json(std::string_view file, Loader& loader);
+
 			///
 			/// Clean up.
 			///
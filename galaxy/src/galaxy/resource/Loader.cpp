@@ -0,0 +1,100 @@
+///
+/// Loader.cpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "Loader.hpp"
+
+namespace galaxy
+{
+	namespace res
+	{
+		Loader::Loader(async::ThreadPool* pool, fs::Virtual* vfs) noexcept
+		    : m_pool {pool}, m_vfs {vfs}, m_pending {0}
+		{
+		}
+
+		Loader::~Loader() noexcept
+		{
+			for (const auto& job : m_jobs)
+			{
+				m_pool->wait(job);
+			}
+
+			m_jobs.clear();
+
+			std::lock_guard<std::mutex> lock {m_mutex};
+			m_uploads.clear();
+		}
+
+		const std::size_t Loader::poll(const std::size_t max)
+		{
+			std::vector<std::function<void(void)>> uploads;
+
+			{
+				std::lock_guard<std::mutex> lock {m_mutex};
+
+				const auto count = std::min(max, m_uploads.size());
+				uploads.assign(std::make_move_iterator(m_uploads.begin()), std::make_move_iterator(m_uploads.begin() + count));
+				m_uploads.erase(m_uploads.begin(), m_uploads.begin() + count);
+			}
+
+			// Run without the lock, since an upload may submit more loads.
+			for (auto& upload : uploads)
+			{
+				upload();
+				m_pending--;
+			}
+
+			std::erase_if(m_jobs, [](const async::JobHandle& job) {
+				return job.is_done();
+			});
+
+			return uploads.size();
+		}
+
+		const bool Loader::wait(const std::shared_future<bool>& future)
+		{
+			while (future.wait_for(std::chrono::seconds {0}) != std::future_status::ready)
+			{
+				if (poll() == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			return future.get();
+		}
+
+		void Loader::wait_all()
+		{
+			while (m_pending > 0)
+			{
+				// Help decode, then upload what finished.
+				for (const auto& job : m_jobs)
+				{
+					m_pool->wait(job);
+				}
+
+				poll();
+			}
+		}
+
+		const std::size_t Loader::pending() const noexcept
+		{
+			return m_pending;
+		}
+
+		void Loader::queue(std::function<void(void)>&& upload)
+		{
+			std::lock_guard<std::mutex> lock {m_mutex};
+			m_uploads.push_back(std::move(upload));
+		}
+	} // namespace res
+} // namespace galaxy
\ No newline at end of file
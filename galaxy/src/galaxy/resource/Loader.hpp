@@ -0,0 +1,300 @@
+///
+/// Loader.hpp
+/// galaxy
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#ifndef GALAXY_RESOURCE_LOADER_HPP_
+#define GALAXY_RESOURCE_LOADER_HPP_
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "galaxy/async/ThreadPool.hpp"
+#include "galaxy/audio/Samples.hpp"
+#include "galaxy/error/Log.hpp"
+#include "galaxy/fs/FileSystem.hpp"
+#include "galaxy/graphics/Image.hpp"
+
+namespace galaxy
+{
+	namespace res
+	{
+		///
+		/// \brief Loads assets in the background.
+		///
+		/// Each load has two stages. Reading and decoding run on a thread pool worker. The upload, which needs the
+		/// GL or AL context, is queued and run by poll() on the owning thread. Every load returns a future, so
+		/// callers can start before everything is resident. Submit, poll and wait from the owning thread only.
+		///
+		class Loader final
+		{
+		public:
+			///
+			/// Argument constructor.
+			///
+			/// \param pool Pool to decode on.
+			/// \param vfs File system to read from.
+			///
+			Loader(async::ThreadPool* pool, fs::Virtual* vfs) noexcept;
+
+			///
+			/// Destructor. Waits for decoding to finish. Uploads that have not run are dropped.
+			///
+			~Loader() noexcept;
+
+			///
+			/// Submit a load.
+			///
+			/// \param decode Called on a worker. Returns a std::optional of the decoded data, or std::nullopt on failure.
+			/// \param upload Called on the owning thread with the decoded data. Returns true if successful.
+			///
+			/// \return Future that is true once uploaded, or false if any stage failed.
+			///
+			template<typename Decode, typename Upload>
+			[[maybe_unused]] std::shared_future<bool> submit(Decode&& decode, Upload&& upload);
+
+			///
+			/// Decode an image from the file system.
+			///
+			/// \param file File to decode.
+			/// \param upload Called on the owning thread with a graphics::Image&.
+			///
+			/// \return Future that is true once uploaded.
+			///
+			template<typename Upload>
+			[[maybe_unused]] std::shared_future<bool> image(std::string_view file, Upload&& upload);
+
+			///
+			/// Decode an ogg vorbis file from the file system.
+			///
+			/// \param file File to decode.
+			/// \param upload Called on the owning thread with an audio::Samples&.
+			///
+			/// \return Future that is true once uploaded.
+			///
+			template<typename Upload>
+			[[maybe_unused]] std::shared_future<bool> sound(std::string_view file, Upload&& upload);
+
+			///
+			/// Read a file from the file system.
+			///
+			/// \param file File to read.
+			/// \param upload Called on the owning thread with a std::vector<char>&.
+			///
+			/// \return Future that is true once uploaded.
+			///
+			template<typename Upload>
+			[[maybe_unused]] std::shared_future<bool> bytes(std::string_view file, Upload&& upload);
+
+			///
+			/// Run uploads of loads that have finished decoding.
+			///
+			/// \param max Most uploads to run, to spread them over frames.
+			///
+			/// \return Number of uploads run.
+			///
+			[[maybe_unused]] const std::size_t poll(const std::size_t max = std::numeric_limits<std::size_t>::max());
+
+			///
+			/// Block until a load is done, running uploads while waiting.
+			///
+			/// \param future Future returned when the load was submitted.
+			///
+			/// \return Result of the load.
+			///
+			[[maybe_unused]] const bool wait(const std::shared_future<bool>& future);
+
+			///
+			/// Block until every load is done, running uploads while waiting.
+			///
+			void wait_all();
+
+			///
+			/// Get number of loads that are not yet done.
+			///
+			/// \return Const std::size_t.
+			///
+			[[nodiscard]] const std::size_t pending() const noexcept;
+
+		private:
+			///
+			/// Constructor.
+			///
+			Loader() = delete;
+
+			///
+			/// Copy constructor.
+			///
+			Loader(const Loader&) = delete;
+
+			///
+			/// Move constructor.
+			///
+			Loader(Loader&&) = delete;
+
+			///
+			/// Copy assignment operator.
+			///
+			Loader& operator=(const Loader&) = delete;
+
+			///
+			/// Move assignment operator.
+			///
+			Loader& operator=(Loader&&) = delete;
+
+			///
+			/// Decode a file straight from an archive view if mounted in one, otherwise from a copy read off disk.
+			///
+			/// \param file File to decode.
+			/// \param decoder Called with std::span<const char>, returns a std::optional.
+			///
+			/// \return Result of decoder, or std::nullopt if the file could not be read.
+			///
+			template<typename Decoder>
+			[[nodiscard]] auto decode_file(const std::string& file, Decoder&& decoder) -> decltype(decoder(std::span<const char> {}));
+
+			///
+			/// Queue an upload for the owning thread. Called from workers.
+			///
+			/// \param upload Upload to queue.
+			///
+			void queue(std::function<void(void)>&& upload);
+
+		private:
+			///
+			/// Pool to decode on.
+			///
+			async::ThreadPool* m_pool;
+
+			///
+			/// File system to read from.
+			///
+			fs::Virtual* m_vfs;
+
+			///
+			/// Decode jobs, so they can be waited on.
+			///
+			std::vector<async::JobHandle> m_jobs;
+
+			///
+			/// Uploads waiting for the owning thread.
+			///
+			std::vector<std::function<void(void)>> m_uploads;
+
+			///
+			/// Guards uploads.
+			///
+			std::mutex m_mutex;
+
+			///
+			/// Loads not yet done.
+			///
+			std::atomic<std::size_t> m_pending;
+		};
+
+		template<typename Decode, typename Upload>
+		inline std::shared_future<bool> Loader::submit(Decode&& decode, Upload&& upload)
+		{
+			using Decoded = typename std::invoke_result_t<Decode>::value_type;
+
+			auto promise = std::make_shared<std::promise<bool>>();
+			auto future  = promise->get_future().share();
+
+			m_pending++;
+			m_jobs.push_back(m_pool->submit([this, promise, decode = std::forward<Decode>(decode), upload = std::forward<Upload>(upload)]() mutable {
+				std::shared_ptr<Decoded> decoded;
+
+				try
+				{
+					auto result = decode();
+					if (result.has_value())
+					{
+						decoded = std::make_shared<Decoded>(std::move(result.value()));
+					}
+				}
+				catch (const std::exception& e)
+				{
+					GALAXY_LOG(GALAXY_ERROR, "Failed to decode asset: {0}.", e.what());
+				}
+
+				if (!decoded)
+				{
+					promise->set_value(false);
+					m_pending--;
+				}
+				else
+				{
+					queue([promise, decoded, upload = std::move(upload)]() mutable {
+						promise->set_value(upload(*decoded));
+					});
+				}
+			}));
+
+			return future;
+		}
+
+		template<typename Upload>
+		inline std::shared_future<bool> Loader::image(std::string_view file, Upload&& upload)
+		{
+			return submit(
+				[this, file = static_cast<std::string>(file)]() {
+					return decode_file(file, [](std::span<const char> data) {
+						return graphics::decode_image(data);
+					});
+				},
+				std::forward<Upload>(upload));
+		}
+
+		template<typename Upload>
+		inline std::shared_future<bool> Loader::sound(std::string_view file, Upload&& upload)
+		{
+			return submit(
+				[this, file = static_cast<std::string>(file)]() {
+					return decode_file(file, [](std::span<const char> data) {
+						return audio::decode_vorbis(data);
+					});
+				},
+				std::forward<Upload>(upload));
+		}
+
+		template<typename Upload>
+		inline std::shared_future<bool> Loader::bytes(std::string_view file, Upload&& upload)
+		{
+			return submit(
+				[this, file = static_cast<std::string>(file)]() {
+					return decode_file(file, [](std::span<const char> data) {
+						return std::make_optional<std::vector<char>>(data.begin(), data.end());
+					});
+				},
+				std::forward<Upload>(upload));
+		}
+
+		template<typename Decoder>
+		inline auto Loader::decode_file(const std::string& file, Decoder&& decoder) -> decltype(decoder(std::span<const char> {}))
+		{
+			if (const auto packed = m_vfs->view(file))
+			{
+				return decoder(packed.value());
+			}
+
+			const auto data = m_vfs->open_binary(file);
+			if (data == std::nullopt)
+			{
+				return std::nullopt;
+			}
+
+			return decoder(std::span<const char> {data.value()});
+		}
+	} // namespace res
+} // namespace galaxy
+
+#endif
\ No newline at end of file
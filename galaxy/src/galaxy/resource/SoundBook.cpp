@@ -8,6 +8,7 @@
 #include <nlohmann/json.hpp>
 
 #include "galaxy/fs/FileSystem.hpp"
+#include "galaxy/resource/Loader.hpp"
 #include "galaxy/scripting/JSONUtils.hpp"
 
 #include "SoundBook.hpp"
@@ -16,6 +17,11 @@ namespace galaxy
 {
 	namespace res
 	{
+		SoundBook::SoundBook() noexcept
+		    : Serializable {this}
+		{
+		}
+
 		SoundBook::SoundBook(std::string_view file)
 		    : Serializable {this}
 		{
@@ -40,6 +46,26 @@ namespace galaxy
 			}
 		}
 
+		void SoundBook::create_from_json(std::string_view file, Loader& loader)
+		{
+			const auto json_opt = json::parse_from_disk(file);
+			if (json_opt == std::nullopt)
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to create parse/load json file: {0}, for Soundbook.", file);
+			}
+			else
+			{
+				clear();
+
+				for (const auto& [name, obj] : json_opt.value().at("soundbook").items())
+				{
+					loader.sound(obj.at("file").get<std::string>(), [this, name = name, obj = obj](audio::Samples& samples) {
+						return create(name)->deserialize(obj, samples);
+					});
+				}
+			}
+		}
+
 		void SoundBook::clear() noexcept
 		{
 			m_resources.clear();
@@ -16,6 +16,8 @@ namespace galaxy
 {
 	namespace res
 	{
+		class Loader;
+
 		///
 		/// Resource manager for fonts.
 		///
@@ -25,7 +27,7 @@ namespace galaxy
 			///
 			/// Constructor.
 			///
-			SoundBook() noexcept = default;
+			SoundBook() noexcept;
 
 			///
 			/// JSON constructor.
@@ -46,6 +48,16 @@ namespace galaxy
 			///
 			void create_from_json(std::string_view file);
 
+			///
+			/// \brief Create SoundBook from JSON, decoding sounds in the background.
+			///
+			/// Sounds are added as the loader is polled, so they are not available until then.
+			///
+			/// \param file JSON file to load.
+			/// \param loader Loader to decode sounds with.
+			///
+			void create_from_json(std::string_view file, Loader& loader);
+
 			///
 			/// Clean up.
 			///
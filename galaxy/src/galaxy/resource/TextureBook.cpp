@@ -7,7 +7,10 @@
 
 #include <nlohmann/json.hpp>
 
+#include "galaxy/core/ServiceLocator.hpp"
 #include "galaxy/error/Log.hpp"
+#include "galaxy/fs/FileSystem.hpp"
+#include "galaxy/resource/Loader.hpp"
 #include "galaxy/scripting/JSONUtils.hpp"
 
 #include "TextureBook.hpp"
@@ -43,29 +46,16 @@ namespace galaxy
 
 		const bool TextureBook::add(std::string_view file)
 		{
-			bool result = false;
-
-			for (auto& [index, atlas] : m_atlas)
-			{
-				result = atlas.add(file);
-				if (result)
-				{
-					break;
-				}
-			}
-
-			if (!result)
-			{
-				graphics::TextureAtlas atlas;
-				auto id = atlas.get_id();
-
-				auto pair = m_atlas.emplace(id, std::move(atlas));
-				pair.first->second.add(file);
-
-				result = true;
-			}
+			return insert([&](graphics::TextureAtlas& atlas) {
+				return atlas.add(file);
+			});
+		}
 
-			return result;
+		const bool TextureBook::add(std::string_view file, const graphics::Image& image)
+		{
+			return insert([&](graphics::TextureAtlas& atlas) {
+				return atlas.add(file, image);
+			});
 		}
 
 		void TextureBook::add_multi(std::span<std::string> files)
@@ -81,11 +71,69 @@ namespace galaxy
 			const auto json_opt = json::parse_from_disk(file);
 			if (json_opt != std::nullopt)
 			{
-				const auto& json     = json_opt.value();
-				const auto& textures = json.at("textures");
-				std::for_each(textures.begin(), textures.end(), [&](const nlohmann::json& texture) {
-					add(texture.get<std::string>());
-				});
+				const auto& json = json_opt.value();
+				if (json.contains("pages"))
+				{
+					for (const auto& page : json.at("pages"))
+					{
+						const std::string image_file = page.at("image");
+
+						std::optional<graphics::Image> image = std::nullopt;
+						if (const auto packed = SL_HANDLE.vfs()->view(image_file))
+						{
+							image = graphics::decode_image(packed.value());
+						}
+						else if (const auto data = SL_HANDLE.vfs()->open_binary(image_file))
+						{
+							image = graphics::decode_image(data.value());
+						}
+
+						if (image == std::nullopt || !add_page(image_file, image.value(), page.at("textures")))
+						{
+							GALAXY_LOG(GALAXY_ERROR, "Failed to load baked atlas page: {0}.", image_file);
+						}
+					}
+				}
+				else
+				{
+					const auto& textures = json.at("textures");
+					std::for_each(textures.begin(), textures.end(), [&](const nlohmann::json& texture) {
+						add(texture.get<std::string>());
+					});
+				}
+			}
+			else
+			{
+				GALAXY_LOG(GALAXY_ERROR, "Failed to create parse/load json file: {0}, for ", file);
+			}
+		}
+
+		void TextureBook::add_json(std::string_view file, Loader& loader)
+		{
+			const auto json_opt = json::parse_from_disk(file);
+			if (json_opt != std::nullopt)
+			{
+				const auto& json = json_opt.value();
+				if (json.contains("pages"))
+				{
+					for (const auto& page : json.at("pages"))
+					{
+						const std::string image_file = page.at("image");
+						loader.image(image_file, [this, image_file, textures = page.at("textures")](graphics::Image& image) {
+							return add_page(image_file, image, textures);
+						});
+					}
+				}
+				else
+				{
+					const auto& textures = json.at("textures");
+					std::for_each(textures.begin(), textures.end(), [&](const nlohmann::json& texture) {
+						const auto name = texture.get<std::string>();
+						loader.image(name, [this, name](graphics::Image& image) {
+							return add(name, image);
+						});
+					});
+				}
 			}
 			else
 			{
@@ -125,5 +173,36 @@ namespace galaxy
 		{
 			return m_atlas;
 		}
+
+		const bool TextureBook::add_page(std::string_view file, const graphics::Image& page, const nlohmann::json& textures)
+		{
+			graphics::TextureAtlas atlas;
+			auto id = atlas.get_id();
+
+			if (!atlas.add_baked(file, page, textures))
+			{
+				return false;
+			}
+
+			m_atlas.emplace(id, std::move(atlas));
+			return true;
+		}
+
+		const bool TextureBook::insert(const std::function<bool(graphics::TextureAtlas&)>& add)
+		{
+			for (auto& [index, atlas] : m_atlas)
+			{
+				if (add(atlas))
+				{
+					return true;
+				}
+			}
+
+			graphics::TextureAtlas atlas;
+			auto id = atlas.get_id();
+
+			auto pair = m_atlas.emplace(id, std::move(atlas));
+			return add(pair.first->second);
+		}
 	} // namespace res
 } // namespace galaxy
\ No newline at end of file
@@ -8,6 +8,7 @@
 #ifndef GALAXY_RESOURCE_TEXTUREATLAS_HPP_
 #define GALAXY_RESOURCE_TEXTUREATLAS_HPP_
 
+#include <functional>
 #include <span>
 
 #include "galaxy/graphics/TextureAtlas.hpp"
@@ -16,6 +17,8 @@ namespace galaxy
 {
 	namespace res
 	{
+		class Loader;
+
 		///
 		/// Holds all the different potential texture atlas'.
 		///
@@ -60,6 +63,16 @@ namespace galaxy
 			///
 			[[maybe_unused]] const bool add(std::string_view file);
 
+			///
+			/// Add an already decoded texture to the atlas.
+			///
+			/// \param file Texture file in the vfs the image was decoded from.
+			/// \param image Decoded pixels.
+			///
+			/// \return Const boolean True if add was successful.
+			///
+			[[maybe_unused]] const bool add(std::string_view file, const graphics::Image& image);
+
 			///
 			/// Adds multiple files at once.
 			///
@@ -70,12 +83,23 @@ namespace galaxy
 			///
 			/// \brief Add textures defined in a json file to atlas.
 			///
-			/// Uses galaxy::filesystem for parsed texture names.
+			/// Uses galaxy::filesystem for parsed texture names. Also accepts a manifest from graphics::bake_atlas,
+			/// in which case each baked page is uploaded as its own atlas.
 			///
 			/// \param file JSON filepath. Uses galaxy::filesystem to look in json folder.
 			///
 			void add_json(std::string_view file);
 
+			///
+			/// \brief Add textures defined in a json file or baked manifest to atlas, decoding them in the background.
+			///
+			/// Textures are packed as the loader is polled, so they are not available until then.
+			///
+			/// \param file JSON filepath. Uses galaxy::filesystem to look in json folder.
+			/// \param loader Loader to decode textures with.
+			///
+			void add_json(std::string_view file, Loader& loader);
+
 			///
 			/// \brief Allows you to define a custom region on a texture atlas.
 			///
@@ -130,6 +154,26 @@ namespace galaxy
 			///
 			TextureBook& operator=(const TextureBook&) = delete;
 
+			///
+			/// Add a baked page as a new atlas.
+			///
+			/// \param file Page image in the vfs.
+			/// \param page Decoded page.
+			/// \param textures Regions from the manifest.
+			///
+			/// \return Const boolean True if add was successful.
+			///
+			[[nodiscard]] const bool add_page(std::string_view file, const graphics::Image& page, const nlohmann::json& textures);
+
+			///
+			/// Add to the first atlas with room, creating a new atlas if none have room.
+			///
+			/// \param add Adds the texture to an atlas. Returns false if there was no room.
+			///
+			/// \return Const boolean True if add was successful.
+			///
+			[[nodiscard]] const bool insert(const std::function<bool(graphics::TextureAtlas&)>& add);
+
 		private:
 			///
 			/// Texture storage.
@@ -19,6 +19,11 @@ namespace galaxy
 	{
 		std::optional<nlohmann::json> parse_from_disk(std::string_view file)
 		{
+			if (const auto packed = SL_HANDLE.vfs()->view(file))
+			{
+				return std::make_optional(nlohmann::json::parse(packed->begin(), packed->end()));
+			}
+
 			const auto path = SL_HANDLE.vfs()->absolute(file);
 			if (path != std::nullopt)
 			{
@@ -8,6 +8,7 @@
 #include <sol/sol.hpp>
 
 #include "galaxy/error/Log.hpp"
+#include "galaxy/physics/ContactPhase.hpp"
 
 #include "LuaUtils.hpp"
 
@@ -111,6 +112,15 @@ namespace galaxy
 		void register_physics()
 		{
 			auto lua = SL_HANDLE.lua();
+
+			// clang-format off
+			lua->new_enum<physics::ContactPhase>("gContactPhase",
+			{
+				{"BEGIN", physics::ContactPhase::BEGIN},
+				{"STAY", physics::ContactPhase::STAY},
+				{"END", physics::ContactPhase::END}
+			});
+			// clang-format on
 		}
 
 		void register_platform()
@@ -16,6 +16,7 @@ namespace galaxy
 	{
 		AnimationSystem::AnimationSystem() noexcept
 		{
+			writes<components::Animated, components::BatchSprite>();
 		}
 
 		AnimationSystem::~AnimationSystem() noexcept
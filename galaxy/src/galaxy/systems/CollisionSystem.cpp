@@ -5,6 +5,11 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <algorithm>
+#include <cmath>
+
+#include <sol/sol.hpp>
+
 #include "galaxy/components/BatchSprite.hpp"
 #include "galaxy/components/OnCollision.hpp"
 #include "galaxy/components/Primitive2D.hpp"
@@ -13,8 +18,7 @@
 #include "galaxy/components/Sprite.hpp"
 #include "galaxy/components/Transform2D.hpp"
 #include "galaxy/core/ServiceLocator.hpp"
-#include "galaxy/core/Window.hpp"
-#include "galaxy/physics/SAT.hpp"
+#include "galaxy/events/Collision.hpp"
 #include "galaxy/resource/ScriptBook.hpp"
 
 #include "CollisionSystem.hpp"
@@ -24,71 +28,462 @@ namespace galaxy
 	namespace systems
 	{
 		CollisionSystem::CollisionSystem() noexcept
-		    : m_mtv {0.0f, 0.0f}, m_quadtree {0, {0, 0, 0, 0}}
+		    : m_broadphase {physics::Broadphase::DYNAMIC_TREE}, m_mtv {0.0f, 0.0f}, m_tick {0}
 		{
+			// Runs collision scripts.
+			reads<components::Renderable, components::OnCollision, components::BatchSprite, components::Sprite, components::Primitive2D>();
+			writes<components::RigidBody, components::Transform2D>();
+			main_thread_only();
 		}
 
 		CollisionSystem::~CollisionSystem() noexcept
 		{
 			m_bvh.clear();
+			m_grid.clear();
 			m_possible.clear();
-			m_quadtree.clear();
-			m_output.clear();
+			m_proxies.clear();
+			m_pairs.clear();
+			m_moved.clear();
+			m_inserted.clear();
+			m_sweeps.clear();
+			m_invalidated.clear();
+			m_shapes.clear();
+			m_solver.clear();
+			m_events.clear();
+			m_calls.clear();
+			m_local.clear();
 		}
 
 		void CollisionSystem::update(core::Scene2D* scene, const double dt)
 		{
-			m_quadtree.clear();
-			m_output.clear();
+			const auto broadphase = [&](auto& structure) {
+				sync_proxies(scene, structure);
+				resolve_sweeps(scene, structure);
+				update_pairs(structure);
+			};
 
-			if (!scene->get_active_map())
+			// Chosen once per tick, so the broadphase calls below are not dispatched per entity.
+			if (scene->m_broadphase == physics::Broadphase::SPATIAL_HASH)
 			{
-				m_quadtree.resize(SL_HANDLE.window()->get_width(), SL_HANDLE.window()->get_height());
+				broadphase(m_grid);
 			}
 			else
 			{
-				m_quadtree.resize(scene->get_active_map()->get_width(), scene->get_active_map()->get_height());
+				broadphase(m_bvh);
 			}
 
-			scene->m_world.operate<components::RigidBody, components::Renderable>([&](const ecs::Entity entity, components::RigidBody* body, components::Renderable* renderable) {
-				m_quadtree.insert({.m_aabb = &renderable->get_aabb(), .m_entity = entity});
-			});
+			for (const auto& pair : m_pairs)
+			{
+				// Sleeping and static bodies only need testing against something awake, or a static body that moved.
+				// Resting contacts carry over.
+				if (!m_solver.is_active(pair.m_a) && !m_solver.is_active(pair.m_b))
+				{
+					m_events.keep(pair.m_a, pair.m_b);
+					continue;
+				}
+
+				auto* proxy_a = refresh_shape(scene, pair.m_a);
+				auto* proxy_b = refresh_shape(scene, pair.m_b);
+
+				if (!proxy_a || !proxy_b)
+				{
+					continue;
+				}
+
+				if (m_shapes.intersects(pair.m_a, pair.m_b, m_mtv))
+				{
+					// MTV pushes a out of b.
+					const auto depth = std::sqrt(m_mtv.x * m_mtv.x + m_mtv.y * m_mtv.y);
+					if (depth > 0.0f)
+					{
+						const auto normal = m_mtv / depth;
+
+						m_solver.add_contact(pair.m_a, pair.m_b, normal, depth);
+						m_events.record(pair.m_a, pair.m_b, normal);
+					}
+				}
+			}
 
-			m_quadtree.query({.m_aabb = &scene->m_camera.get_aabb(), .m_entity = 0}, m_output);
+			m_solver.solve();
+			integrate(scene, dt);
+			dispatch_events(scene);
+		}
+
+		void CollisionSystem::configure_broadphase(core::Scene2D* scene)
+		{
+			// Most bodies in a tile map are about one tile, which makes tiles the best cell size.
+			if (auto* map = scene->get_active_map(); map && map->get_tile_width() > 0 && map->get_tile_height() > 0)
+			{
+				m_grid.set_cell_size({static_cast<float>(map->get_tile_width()), static_cast<float>(map->get_tile_height())});
+			}
+
+			if (scene->m_broadphase == m_broadphase)
+			{
+				return;
+			}
+
+			m_broadphase = scene->m_broadphase;
+
+			m_inserted.clear();
+			for (const auto& [entity, proxy] : m_proxies)
+			{
+				m_inserted.emplace_back(entity, proxy.m_aabb);
+			}
 
 			m_bvh.clear();
-			for (auto* object : m_output)
+			m_grid.clear();
+
+			if (m_broadphase == physics::Broadphase::SPATIAL_HASH)
+			{
+				m_grid.insert(m_inserted);
+			}
+			else
 			{
-				m_bvh.insert(object->m_entity, object->m_aabb->min(), object->m_aabb->max());
+				m_bvh.insert(m_inserted);
 			}
 
-			scene->m_world.operate<components::RigidBody, components::Transform2D>([&](const ecs::Entity entity_a, components::RigidBody* body, components::Transform2D* transform) {
-				m_possible.clear();
-				m_bvh.query(entity_a, std::back_inserter(m_possible));
+			// Fattened AABBs are rebuilt, so every pair is found again this tick.
+			m_pairs.clear();
+			for (const auto& [entity, aabb] : m_inserted)
+			{
+				m_moved.push_back(entity);
+			}
+
+			m_inserted.clear();
+		}
+
+		template<typename Broadphase>
+		void CollisionSystem::sync_proxies(core::Scene2D* scene, Broadphase& broadphase)
+		{
+			m_tick++;
+			m_moved.clear();
+			m_inserted.clear();
+			m_sweeps.clear();
+			m_invalidated.clear();
+
+			configure_broadphase(scene);
 
-				for (const auto& entity_b : m_possible)
+			std::size_t seen = 0;
+			scene->m_world.operate<components::RigidBody, components::Renderable>([&](const ecs::Entity entity, components::RigidBody* body, components::Renderable* renderable) {
+				const auto& aabb = renderable->get_aabb();
+				seen++;
+
+				const auto inv_mass = body->m_type == physics::BodyType::DYNAMIC && body->m_mass > 0.0f ? 1.0f / body->m_mass : 0.0f;
+				m_solver.set_body(entity, body->m_velocity, inv_mass, body->m_restitution);
+
+				auto [it, inserted] = m_proxies.try_emplace(entity);
+				auto& proxy         = it->second;
+				proxy.m_tick        = m_tick;
+
+				if (inserted)
 				{
-					m_mtv.x = 0.0f;
-					m_mtv.y = 0.0f;
+					proxy.m_aabb       = aabb;
+					proxy.m_type       = body->m_type;
+					proxy.m_shape_tick = 0;
 
-					physics::SAT object_a {scene->m_world, entity_a};
-					physics::SAT object_b {scene->m_world, entity_b};
+					m_inserted.emplace_back(entity, aabb);
+					m_moved.push_back(entity);
+				}
+				else if (proxy.m_aabb != aabb || proxy.m_type != body->m_type)
+				{
+					// TransformSystem only refreshes the AABB of dirty transforms, so everything else skips the tree.
+					// Small moves stay within the fattened AABB and keep their pairs.
+					const bool retyped = proxy.m_type != body->m_type;
+					const auto from    = proxy.m_aabb;
+					proxy.m_aabb       = aabb;
+					proxy.m_type       = body->m_type;
+
+					// Moved by something other than the solver, i.e. a script.
+					m_solver.wake(entity);
 
-					if (object_a.intersects(object_b, m_mtv))
+					const bool moved = broadphase.update(entity, aabb) || retyped;
+					if (moved)
 					{
-						if (body->m_type == physics::BodyType::DYNAMIC)
-						{
-							transform->move(m_mtv.x, m_mtv.y);
-						}
+						m_moved.push_back(entity);
+					}
+
+					// Moves shorter than half the body overlap anything they pass, so the discrete test catches them.
+					if (body->m_ccd && !retyped && body->m_type == physics::BodyType::DYNAMIC)
+					{
+						const auto displacement = (aabb.min() + aabb.max() - from.min() - from.max()) * 0.5f;
+						const auto half_size    = from.size() * 0.5f;
 
-						auto collision_a = scene->m_world.get<components::OnCollision>(entity_a);
-						if (collision_a)
+						if (std::abs(displacement.x) > half_size.x || std::abs(displacement.y) > half_size.y)
 						{
-							SL_HANDLE.scriptbook()->run(collision_a->m_script);
+							m_sweeps.push_back({.m_entity = entity, .m_from = from, .m_displacement = displacement, .m_moved = moved});
 						}
 					}
 				}
 			});
+
+			// A burst of new entities, i.e. from loading a map, is cheaper to build in bulk.
+			if (m_inserted.size() > broadphase.size())
+			{
+				broadphase.insert(m_inserted);
+			}
+			else
+			{
+				for (const auto& [entity, aabb] : m_inserted)
+				{
+					broadphase.insert(entity, aabb.min(), aabb.max());
+				}
+			}
+
+			// Every proxy was seen unless an entity was destroyed or lost a component.
+			if (seen != m_proxies.size())
+			{
+				for (auto it = m_proxies.begin(); it != m_proxies.end();)
+				{
+					if (it->second.m_tick != m_tick)
+					{
+						broadphase.erase(it->first);
+						m_shapes.erase(it->first);
+						m_solver.erase(it->first);
+						m_invalidated.insert(it->first);
+
+						it = m_proxies.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+			}
+		}
+
+		template<typename Broadphase>
+		void CollisionSystem::resolve_sweeps(core::Scene2D* scene, Broadphase& broadphase)
+		{
+			for (const auto& sweep : m_sweeps)
+			{
+				m_possible.clear();
+				broadphase.sweep(sweep.m_from, sweep.m_displacement, std::back_inserter(m_possible));
+
+				// Only static bodies stop a sweep, so the result does not depend on the order bodies are moved in.
+				float toi         = 1.0f;
+				ecs::Entity other = 0;
+				glm::vec2 normal  = {0.0f, 0.0f};
+				for (const auto entity : m_possible)
+				{
+					const auto& proxy = m_proxies.at(entity);
+					if (entity == sweep.m_entity || proxy.m_type != physics::BodyType::STATIC)
+					{
+						continue;
+					}
+
+					glm::vec2 face;
+					if (const auto hit = physics::DynamicTree<ecs::Entity>::time_of_impact(sweep.m_from, sweep.m_displacement, proxy.m_aabb, face); hit.has_value() && hit.value() < toi)
+					{
+						toi    = hit.value();
+						other  = entity;
+						normal = face;
+					}
+				}
+
+				if (toi == 1.0f)
+				{
+					continue;
+				}
+
+				auto* transform = scene->m_world.get<components::Transform2D>(sweep.m_entity);
+				if (!transform)
+				{
+					continue;
+				}
+
+				// Stop at first contact. Narrowphase resolves anything left over.
+				const auto back = sweep.m_displacement * (toi - 1.0f);
+				transform->move(back.x, back.y);
+
+				auto& proxy        = m_proxies.at(sweep.m_entity);
+				proxy.m_aabb       = {proxy.m_aabb.min() + back, proxy.m_aabb.max() + back};
+				proxy.m_shape_tick = 0;
+
+				if (broadphase.update(sweep.m_entity, proxy.m_aabb) && !sweep.m_moved)
+				{
+					m_moved.push_back(sweep.m_entity);
+				}
+
+				// Left exactly touching, which the narrowphase does not count as a contact.
+				// Without one, integrate() would carry the body back through the wall.
+				m_solver.add_contact(sweep.m_entity, other, normal, 0.0f);
+				m_events.record(sweep.m_entity, other, normal);
+			}
+		}
+
+		template<typename Broadphase>
+		void CollisionSystem::update_pairs(Broadphase& broadphase)
+		{
+			if (m_moved.empty() && m_invalidated.empty())
+			{
+				return;
+			}
+
+			m_invalidated.insert(m_moved.begin(), m_moved.end());
+			std::erase_if(m_pairs, [&](const Pair& pair) {
+				return m_invalidated.contains(pair.m_a) || m_invalidated.contains(pair.m_b);
+			});
+
+			for (const auto entity_a : m_moved)
+			{
+				const auto type_a = m_proxies.at(entity_a).m_type;
+
+				m_possible.clear();
+				broadphase.query(entity_a, std::back_inserter(m_possible));
+
+				for (const auto entity_b : m_possible)
+				{
+					// When both moved, only the lower entity adds the pair.
+					if (entity_b < entity_a && m_invalidated.contains(entity_b))
+					{
+						continue;
+					}
+
+					if (type_a == physics::BodyType::STATIC && m_proxies.at(entity_b).m_type == physics::BodyType::STATIC)
+					{
+						continue;
+					}
+
+					m_pairs.push_back({.m_a = entity_a, .m_b = entity_b});
+				}
+			}
+		}
+
+		void CollisionSystem::integrate(core::Scene2D* scene, const double dt)
+		{
+			const auto step = static_cast<float>(dt);
+
+			for (const auto entity : m_solver.get_solved())
+			{
+				auto* body      = scene->m_world.get<components::RigidBody>(entity);
+				auto* transform = scene->m_world.get<components::Transform2D>(entity);
+
+				if (!body || !transform)
+				{
+					continue;
+				}
+
+				body->m_velocity = m_solver.get_velocity(entity);
+
+				// Bodies that just fell asleep stay where they are, so they are not woken by their own move next tick.
+				if (m_solver.is_awake(entity))
+				{
+					const auto offset = body->m_velocity * step + m_solver.get_correction(entity);
+					if (offset.x != 0.0f || offset.y != 0.0f)
+					{
+						transform->move(offset.x, offset.y);
+					}
+				}
+			}
+		}
+
+		void CollisionSystem::dispatch_events(core::Scene2D* scene)
+		{
+			const auto contacts = m_events.flush();
+			if (contacts.empty())
+			{
+				return;
+			}
+
+			// END is still sent to the surviving side of a pair whose other entity was destroyed this tick.
+			// The destroyed side has no script left to run.
+			const auto queue = [&](const ecs::Entity entity, const ecs::Entity other, const physics::ContactPhase phase) {
+				if (scene->m_world.has(entity))
+				{
+					if (auto* collision = scene->m_world.get<components::OnCollision>(entity); collision)
+					{
+						m_calls.push_back({.m_script = collision->m_script, .m_entity = entity, .m_other = other, .m_phase = phase});
+					}
+				}
+			};
+
+			m_calls.clear();
+			for (const auto& contact : contacts)
+			{
+				scene->m_dispatcher.trigger<events::Collision>(contact);
+
+				queue(contact.m_a, contact.m_b, contact.m_phase);
+				queue(contact.m_b, contact.m_a, contact.m_phase);
+			}
+
+			if (m_calls.empty())
+			{
+				return;
+			}
+
+			// Each script runs once per tick, with every contact of the entities using it.
+			std::stable_sort(m_calls.begin(), m_calls.end(), [](const ScriptCall& lhs, const ScriptCall& rhs) {
+				return lhs.m_script < rhs.m_script;
+			});
+
+			auto lua = SL_HANDLE.lua();
+			for (auto first = m_calls.begin(); first != m_calls.end();)
+			{
+				const auto last = std::find_if(first, m_calls.end(), [&](const ScriptCall& call) {
+					return call.m_script != first->m_script;
+				});
+
+				auto collisions = lua->create_table(static_cast<int>(std::distance(first, last)), 0);
+				for (auto it = first; it != last; ++it)
+				{
+					collisions.add(lua->create_table_with("entity", it->m_entity, "other", it->m_other, "phase", it->m_phase));
+				}
+
+				(*lua)["galaxy_collisions"] = collisions;
+				SL_HANDLE.scriptbook()->run(first->m_script);
+
+				first = last;
+			}
+
+			(*lua)["galaxy_collisions"] = sol::lua_nil;
+		}
+
+		CollisionSystem::Proxy* CollisionSystem::refresh_shape(core::Scene2D* scene, const ecs::Entity entity)
+		{
+			auto& proxy = m_proxies.at(entity);
+			if (proxy.m_shape_tick == m_tick)
+			{
+				return &proxy;
+			}
+
+			auto* transform = scene->m_world.get<components::Transform2D>(entity);
+			if (!transform)
+			{
+				return nullptr;
+			}
+
+			const auto& affine = transform->get_affine();
+			if (!m_shapes.is_current(entity, affine))
+			{
+				auto* renderable = scene->m_world.get<components::Renderable>(entity);
+
+				m_local.clear();
+				if (renderable->m_type == graphics::Renderables::BATCHED)
+				{
+					const auto& region = scene->m_world.get<components::BatchSprite>(entity)->get_region();
+					m_local.insert(m_local.end(), {{0.0f, 0.0f}, {region.m_width, 0.0f}, {region.m_width, region.m_height}, {0.0f, region.m_height}});
+				}
+				else if (renderable->m_type == graphics::Renderables::SPRITE)
+				{
+					auto* sprite      = scene->m_world.get<components::Sprite>(entity);
+					const auto width  = static_cast<float>(sprite->get_width());
+					const auto height = static_cast<float>(sprite->get_height());
+
+					m_local.insert(m_local.end(), {{0.0f, 0.0f}, {width, 0.0f}, {width, height}, {0.0f, height}});
+				}
+				else
+				{
+					for (const auto& vertex : scene->m_world.get<components::Primitive2D>(entity)->get_vertices())
+					{
+						m_local.emplace_back(vertex.m_pos.x, vertex.m_pos.y);
+					}
+				}
+
+				m_shapes.update(entity, m_local, affine);
+			}
+
+			proxy.m_shape_tick = m_tick;
+			return &proxy;
 		}
 	} // namespace systems
 } // namespace galaxy
\ No newline at end of file
@@ -9,15 +9,33 @@
 #define GALAXY_SYSTEM_COLLISIONSYSTEM_HPP_
 
 #include "galaxy/core/Scene2D.hpp"
-#include "galaxy/math/QuadTree.hpp"
+#include "galaxy/physics/BodyType.hpp"
+#include "galaxy/physics/Broadphase.hpp"
+#include "galaxy/physics/CollisionShapes.hpp"
+#include "galaxy/physics/ContactEvents.hpp"
+#include "galaxy/physics/ContactSolver.hpp"
 #include "galaxy/physics/DynamicTree.hpp"
+#include "galaxy/physics/SpatialHash.hpp"
 
 namespace galaxy
 {
 	namespace systems
 	{
 		///
-		/// Collision system.
+		/// \brief Collision system.
+		///
+		/// The broadphase persists across ticks. An entity is only reinserted into the tree when its AABB
+		/// leaves its fattened bounds, and overlapping pairs are only recalculated for entities that moved.
+		/// Pairs where both bodies are static are never cached, so static geometry is never re-tested.
+		///
+		/// The broadphase is a physics::DynamicTree or a physics::SpatialHash, chosen by Scene2D::m_broadphase. Hash cells
+		/// are sized to the tiles of the active map. Switching moves every entity to the new structure on the next tick.
+		///
+		/// Contacts are resolved by a physics::ContactSolver, which then moves dynamic bodies by their velocity.
+		/// Bodies that come to rest are put to sleep and skipped by the narrowphase until something wakes them.
+		///
+		/// Contacts are only recorded during the narrowphase. Begin, stay and end events are sent to the scene
+		/// dispatcher as events::Collision, and to OnCollision scripts, after the physics step.
 		///
 		class CollisionSystem final : public ecs::System
 		{
@@ -40,12 +58,176 @@ namespace galaxy
 			///
 			void update(core::Scene2D* scene, const double dt) override;
 
+		private:
+			///
+			/// Broadphase state of an entity.
+			///
+			struct Proxy final
+			{
+				///
+				/// Renderable AABB when last synced with the tree.
+				///
+				math::AABB m_aabb;
+
+				///
+				/// Body type when last synced with the tree.
+				///
+				physics::BodyType m_type;
+
+				///
+				/// Tick this entity was last seen.
+				///
+				std::uint64_t m_tick;
+
+				///
+				/// Tick the collision shape was last checked against the transform.
+				///
+				std::uint64_t m_shape_tick;
+			};
+
+			///
+			/// Pair of entities with overlapping fattened AABBs.
+			///
+			struct Pair final
+			{
+				///
+				/// First entity.
+				///
+				ecs::Entity m_a;
+
+				///
+				/// Second entity.
+				///
+				ecs::Entity m_b;
+			};
+
+			///
+			/// Move of a continuous collision body this tick.
+			///
+			struct Sweep final
+			{
+				///
+				/// Entity that moved.
+				///
+				ecs::Entity m_entity;
+
+				///
+				/// AABB before the move.
+				///
+				math::AABB m_from;
+
+				///
+				/// Distance moved.
+				///
+				glm::vec2 m_displacement;
+
+				///
+				/// Already in m_moved.
+				///
+				bool m_moved;
+			};
+
+			///
+			/// Contact of an entity passed to its collision script.
+			///
+			struct ScriptCall final
+			{
+				///
+				/// Script of entity.
+				///
+				std::string m_script;
+
+				///
+				/// Entity with the script.
+				///
+				ecs::Entity m_entity;
+
+				///
+				/// Entity it touched.
+				///
+				ecs::Entity m_other;
+
+				///
+				/// Stage of the contact.
+				///
+				physics::ContactPhase m_phase;
+			};
+
+			///
+			/// Move entities to the broadphase chosen by the scene and size hash cells to the active map.
+			///
+			/// \param scene Currently active scene.
+			///
+			void configure_broadphase(core::Scene2D* scene);
+
+			///
+			/// Insert new entities, update moved entities and remove entities no longer colliding.
+			///
+			/// \param scene Currently active scene.
+			/// \param broadphase Broadphase chosen by the scene.
+			///
+			template<typename Broadphase>
+			void sync_proxies(core::Scene2D* scene, Broadphase& broadphase);
+
+			///
+			/// Move continuous collision bodies back to the first static body they passed through this tick.
+			///
+			/// \param scene Currently active scene.
+			/// \param broadphase Broadphase chosen by the scene.
+			///
+			template<typename Broadphase>
+			void resolve_sweeps(core::Scene2D* scene, Broadphase& broadphase);
+
+			///
+			/// Write solved velocities back to bodies and move awake bodies.
+			///
+			/// \param scene Currently active scene.
+			/// \param dt DeltaTime from gameloop.
+			///
+			void integrate(core::Scene2D* scene, const double dt);
+
+			///
+			/// Send this tick's contact events to the scene dispatcher and collision scripts.
+			///
+			/// \param scene Currently active scene.
+			///
+			void dispatch_events(core::Scene2D* scene);
+
+			///
+			/// Recalculate cached pairs for entities that moved or were removed.
+			///
+			/// \param broadphase Broadphase chosen by the scene.
+			///
+			template<typename Broadphase>
+			void update_pairs(Broadphase& broadphase);
+
+			///
+			/// Rebuild the collision shape of an entity if its transform changed. Checked at most once per tick,
+			/// unless the entity is moved to resolve a collision.
+			///
+			/// \param scene Currently active scene.
+			/// \param entity Entity to refresh.
+			///
+			/// \return Pointer to proxy of entity, or nullptr if entity has no transform.
+			///
+			[[nodiscard]] Proxy* refresh_shape(core::Scene2D* scene, const ecs::Entity entity);
+
 		private:
 			///
 			/// Dynamic Tree for efficient collision detection.
 			///
 			physics::DynamicTree<ecs::Entity> m_bvh;
 
+			///
+			/// Spatial hash for maps of tile sized bodies.
+			///
+			physics::SpatialHash<ecs::Entity> m_grid;
+
+			///
+			/// Broadphase entities are currently in.
+			///
+			physics::Broadphase m_broadphase;
+
 			///
 			/// Offset from collision.
 			///
@@ -57,14 +239,64 @@ namespace galaxy
 			std::vector<ecs::Entity> m_possible;
 
 			///
-			/// Quadtree for spacial partitioning.
+			/// Broadphase state of each entity in the tree.
+			///
+			robin_hood::unordered_flat_map<ecs::Entity, Proxy> m_proxies;
+
+			///
+			/// Cached pairs to run narrowphase on.
+			///
+			std::vector<Pair> m_pairs;
+
+			///
+			/// Entities reinserted into the tree this tick.
+			///
+			std::vector<ecs::Entity> m_moved;
+
+			///
+			/// Entities added to the tree this tick.
+			///
+			std::vector<std::pair<ecs::Entity, math::AABB>> m_inserted;
+
+			///
+			/// Continuous collision bodies that moved far enough to pass through something this tick.
+			///
+			std::vector<Sweep> m_sweeps;
+
+			///
+			/// Entities whose pairs are invalidated this tick.
+			///
+			robin_hood::unordered_flat_set<ecs::Entity> m_invalidated;
+
+			///
+			/// World space collision shapes.
+			///
+			physics::CollisionShapes m_shapes;
+
+			///
+			/// Contact response, islands and sleeping.
+			///
+			physics::ContactSolver m_solver;
+
+			///
+			/// Contacts recorded this tick.
+			///
+			physics::ContactEvents m_events;
+
+			///
+			/// Script call memory cache.
+			///
+			std::vector<ScriptCall> m_calls;
+
+			///
+			/// Local space vertex memory cache.
 			///
-			math::Quadtree m_quadtree;
+			std::vector<glm::vec2> m_local;
 
 			///
-			/// Output memory cache.
+			/// Current tick.
 			///
-			std::vector<math::Quadtree::Object*> m_output;
+			std::uint64_t m_tick;
 		};
 	} // namespace systems
 } // namespace galaxy
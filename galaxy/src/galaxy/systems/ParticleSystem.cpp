@@ -17,6 +17,9 @@ namespace galaxy
 	{
 		ParticleSystem::ParticleSystem() noexcept
 		{
+			// Buffers particle instances to OpenGL.
+			writes<components::ParticleEffect>();
+			main_thread_only();
 		}
 
 		ParticleSystem::~ParticleSystem() noexcept
@@ -22,8 +22,10 @@ namespace galaxy
 	namespace systems
 	{
 		RenderSystem2D::RenderSystem2D() noexcept
-		    : m_quadtree {0, {0, 0, 0, 0}}
+		    : m_quadtree {{0, 0, 0, 0}}
 		{
+			reads<components::Renderable>();
+			main_thread_only();
 		}
 
 		RenderSystem2D::~RenderSystem2D() noexcept
@@ -34,51 +36,70 @@ namespace galaxy
 
 		void RenderSystem2D::update(core::Scene2D* scene, const double dt)
 		{
-			m_quadtree.clear();
 			m_output.clear();
 
-			m_quadtree.resize(SL_HANDLE.window()->get_width(), SL_HANDLE.window()->get_height());
+			// Cover the whole map so objects off screen are still partitioned.
+			if (auto* map = scene->get_active_map(); map != nullptr)
+			{
+				m_quadtree.resize(map->get_width() * map->get_tile_width(), map->get_height() * map->get_tile_height());
+			}
+			else
+			{
+				m_quadtree.resize(SL_HANDLE.window()->get_width(), SL_HANDLE.window()->get_height());
+			}
+
+			std::size_t seen = 0;
 			scene->m_world.operate<components::Renderable>([&](const ecs::Entity entity, components::Renderable* renderable) {
-				m_quadtree.insert({.m_aabb = &renderable->get_aabb(), .m_entity = entity, .m_type = renderable->m_type});
+				m_quadtree.insert(entity, renderable->get_aabb(), renderable->m_type);
+				seen++;
 			});
 
-			m_quadtree.query({.m_aabb = &scene->m_camera.get_aabb()}, m_output);
+			// Only sweep for destroyed or disabled entities when something went missing.
+			if (seen != m_quadtree.size())
+			{
+				auto& world = scene->m_world;
+				m_quadtree.erase_if([&](const ecs::Entity entity) {
+					return !world.has(entity) || !world.is_enabled(entity) || world.get<components::Renderable>(entity) == nullptr;
+				});
+			}
+
+			m_quadtree.query(scene->m_camera.get_aabb(), m_output);
 		}
 
 		void RenderSystem2D::render(core::World& world, graphics::Camera2D& camera)
 		{
-			for (auto* object : m_output)
+			for (const auto& object : m_output)
 			{
 				// Ordered this way for compiler optimizations.
 				// Most-Least common.
-				switch (object->m_type)
+				switch (object.m_type)
 				{
 					case graphics::Renderables::BATCHED:
-						RENDERER_2D().submit(world.get<components::BatchSprite>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::BatchSprite>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 
 					case graphics::Renderables::SPRITE:
-						RENDERER_2D().submit(world.get<components::Sprite>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::Sprite>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 
 					case graphics::Renderables::PARTICLE:
-						RENDERER_2D().submit(world.get<components::ParticleEffect>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::ParticleEffect>(object.m_entity));
 						break;
 
 					case graphics::Renderables::TEXT:
-						RENDERER_2D().submit(world.get<components::Text>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::Text>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 
 					case graphics::Renderables::LINE_LOOP:
-						RENDERER_2D().submit(world.get<components::Primitive2D>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::Primitive2D>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 
 					case graphics::Renderables::LINE:
-						RENDERER_2D().submit(world.get<components::Primitive2D>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::Primitive2D>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 
 					case graphics::Renderables::POINT:
-						RENDERER_2D().submit(world.get<components::Primitive2D>(object->m_entity), world.get<components::Transform2D>(object->m_entity));
+						RENDERER_2D().submit(world.get<components::Primitive2D>(object.m_entity), world.get<components::Transform2D>(object.m_entity));
 						break;
 				}
 			}
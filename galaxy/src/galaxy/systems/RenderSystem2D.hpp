@@ -49,14 +49,14 @@ namespace galaxy
 
 		private:
 			///
-			/// Quadtree for spacial partitioning.
+			/// Quadtree for spacial partitioning. Kept between frames and only updated for entities that moved.
 			///
 			math::Quadtree m_quadtree;
 
 			///
 			/// Output memory cache.
 			///
-			std::vector<math::Quadtree::Object*> m_output;
+			std::vector<math::Quadtree::Object> m_output;
 		};
 	} // namespace systems
 } // namespace galaxy
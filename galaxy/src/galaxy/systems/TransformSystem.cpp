@@ -20,6 +20,8 @@ namespace galaxy
 	{
 		TransformSystem::TransformSystem() noexcept
 		{
+			reads<components::BatchSprite, components::Sprite, components::Text, components::Primitive2D>();
+			writes<components::Transform2D, components::Renderable>();
 		}
 
 		TransformSystem::~TransformSystem() noexcept
@@ -78,6 +80,9 @@ namespace galaxy
 					}
 				}
 			});
+
+			// Recalculate every dirty transform in one sweep, so rendering and collision only read cached results.
+			components::Transform2D::recalculate_batch(scene->m_world.get_components<components::Transform2D>());
 		}
 	} // namespace systems
 } // namespace galaxy
\ No newline at end of file
@@ -0,0 +1,99 @@
+///
+/// main.cpp
+/// packer
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <galaxy/async/ThreadPool.hpp>
+#include <galaxy/fs/Archive.hpp>
+#include <galaxy/fs/Packer.hpp>
+#include <galaxy/graphics/AtlasBaker.hpp>
+
+namespace
+{
+	///
+	/// Default atlas page size. Matches the largest atlas TextureAtlas creates.
+	///
+	constexpr const int DEFAULT_ATLAS_SIZE = 4096;
+
+	///
+	/// Print usage.
+	///
+	int usage()
+	{
+		std::cout << "Usage: packer <asset directory> <output" << galaxy::fs::Archive::EXTENSION << "> [--store]\n";
+		std::cout << "       packer --atlas <texture directory> <manifest.json> [page size]\n";
+		std::cout << "  --store  Do not compress anything.\n";
+		std::cout << "  --atlas  Bake textures into atlas pages and a manifest TextureBook can load.\n";
+		return 1;
+	}
+
+	///
+	/// Bake an atlas.
+	///
+	int bake(int argsc, char* argsv[])
+	{
+		auto size = DEFAULT_ATLAS_SIZE;
+		if (argsc == 5)
+		{
+			try
+			{
+				size = std::stoi(argsv[4]);
+			}
+			catch (const std::exception&)
+			{
+				size = 0;
+			}
+
+			if (size <= 0)
+			{
+				std::cout << "Invalid page size " << argsv[4] << ".\n";
+				return 1;
+			}
+		}
+
+		galaxy::async::ThreadPool pool;
+		if (!galaxy::graphics::bake_atlas(argsv[2], argsv[3], size, pool))
+		{
+			std::cout << "Failed to bake " << argsv[2] << ".\n";
+			return 1;
+		}
+
+		std::cout << "Baked " << argsv[2] << " into " << argsv[3] << ".\n";
+		return 0;
+	}
+} // namespace
+
+int main(int argsc, char* argsv[])
+{
+	if (argsc > 1 && std::string_view {argsv[1]} == "--atlas")
+	{
+		return (argsc < 4 || argsc > 5) ? usage() : bake(argsc, argsv);
+	}
+
+	if (argsc < 3 || argsc > 4 || (argsc == 4 && std::string_view {argsv[3]} != "--store"))
+	{
+		return usage();
+	}
+
+	if (!galaxy::fs::pack(argsv[1], argsv[2], argsc != 4))
+	{
+		std::cout << "Failed to pack " << argsv[1] << ".\n";
+		return 1;
+	}
+
+	galaxy::fs::Archive archive;
+	if (!archive.load(argsv[2]))
+	{
+		std::cout << "Packed archive " << argsv[2] << " could not be read back.\n";
+		return 1;
+	}
+
+	std::cout << "Packed " << archive.size() << " files into " << argsv[2] << ".\n";
+	return 0;
+}
\ No newline at end of file
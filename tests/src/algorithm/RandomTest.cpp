@@ -1,14 +1,36 @@
 ///
-/// DispatcherTest.cpp
+/// RandomTest.cpp
 /// tests
 ///
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <galaxy/math/Random.hpp>
 
+namespace
+{
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+} // namespace
+
 TEST(Algorithm, RandomLargeMinMax)
 {
 	constexpr auto min = 10;
@@ -43,4 +65,126 @@ TEST(Algorithm, RandomSameMinMax)
 
 	const auto result = galaxy::math::random(min, max);
 	EXPECT_TRUE(result == 10);
+}
+
+TEST(Algorithm, RandomFloatRange)
+{
+	for (int i = 0; i < 10000; i++)
+	{
+		const auto f = galaxy::math::random(-2.5f, 4.0f);
+		const auto d = galaxy::math::random(0.01, 0.1);
+
+		ASSERT_TRUE(f >= -2.5f && f < 4.0f);
+		ASSERT_TRUE(d >= 0.01 && d < 0.1);
+	}
+}
+
+TEST(Algorithm, RandomSeedIsDeterministic)
+{
+	galaxy::math::seed(1234);
+	EXPECT_EQ(galaxy::math::get_seed(), 1234);
+
+	std::vector<float> first(64);
+	std::vector<int> first_ints;
+	galaxy::math::fill_uniform(first);
+	for (int i = 0; i < 16; i++)
+	{
+		first_ints.push_back(galaxy::math::random(0, 1000));
+	}
+
+	galaxy::math::seed(1234);
+
+	std::vector<float> second(64);
+	std::vector<int> second_ints;
+	galaxy::math::fill_uniform(second);
+	for (int i = 0; i < 16; i++)
+	{
+		second_ints.push_back(galaxy::math::random(0, 1000));
+	}
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first_ints, second_ints);
+
+	galaxy::math::seed(4321);
+	galaxy::math::fill_uniform(second);
+	EXPECT_NE(first, second);
+}
+
+TEST(Algorithm, RandomFillUniform)
+{
+	// Odd size, so the last value comes from its own number.
+	std::vector<float> values(10001);
+	galaxy::math::fill_uniform(values, 5.0f, 10.0f);
+
+	const auto [min, max] = std::minmax_element(values.begin(), values.end());
+	EXPECT_GE(*min, 5.0f);
+	EXPECT_LT(*max, 10.0f);
+
+	double sum = 0.0;
+	for (const auto value : values)
+	{
+		sum += value;
+	}
+
+	EXPECT_NEAR(sum / values.size(), 7.5, 0.1);
+}
+
+TEST(Algorithm, RandomThreadsGetOwnStreams)
+{
+	galaxy::math::seed(99);
+
+	std::vector<float> main_thread(32);
+	std::vector<float> other_thread(32);
+
+	galaxy::math::fill_uniform(main_thread);
+	std::thread thread {[&]() {
+		galaxy::math::fill_uniform(other_thread);
+	}};
+	thread.join();
+
+	EXPECT_NE(main_thread, other_thread);
+}
+
+TEST(Algorithm, RandomBenchmark)
+{
+	constexpr const int COUNT = 1'000'000;
+
+	std::vector<float> values(COUNT);
+
+	// What math::random used to do on every call.
+	const auto per_call = time_ms([&]() {
+		for (int i = 0; i < COUNT / 100; i++)
+		{
+			std::random_device rd;
+			std::mt19937_64 mt {rd()};
+			std::uniform_real_distribution<float> dist {0.0f, 1.0f};
+
+			values[i] = dist(mt);
+		}
+	});
+
+	std::mt19937_64 mt {1};
+	std::uniform_real_distribution<float> dist {0.0f, 1.0f};
+	const auto mersenne = time_ms([&]() {
+		for (auto& value : values)
+		{
+			value = dist(mt);
+		}
+	});
+
+	const auto random = time_ms([&]() {
+		for (auto& value : values)
+		{
+			value = galaxy::math::random(0.0f, 1.0f);
+		}
+	});
+
+	const auto fill = time_ms([&]() {
+		galaxy::math::fill_uniform(values);
+	});
+
+	std::cout << "[ RandomBenchmark ] " << COUNT << " floats. random_device + mt19937_64 per call: " << per_call * 100.0 << " ms (extrapolated from " << COUNT / 100
+			  << "). shared mt19937_64: " << mersenne << " ms. math::random: " << random << " ms. math::fill_uniform: " << fill << " ms.\n";
+
+	EXPECT_LT(random, per_call * 100.0);
 }
\ No newline at end of file
@@ -5,10 +5,131 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
 #include <gtest/gtest.h>
+#include <stb/stb_image.h>
 
 #include <galaxy/math/RectPack.hpp>
 
+namespace
+{
+	using Sizes = std::vector<std::pair<int, int>>;
+
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Packs a batch and checks every result is in bounds, does not overlap and keeps its size.
+	///
+	std::vector<std::optional<galaxy::math::Rect<int>>> pack_checked(galaxy::math::RectPack<int>& packer, const Sizes& sizes, const bool rotated = false)
+	{
+		const auto results = packer.pack(sizes);
+		EXPECT_EQ(results.size(), sizes.size());
+
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			if (!results[i].has_value())
+			{
+				continue;
+			}
+
+			const auto& a = results[i].value();
+			EXPECT_GE(a.m_x, 0);
+			EXPECT_GE(a.m_y, 0);
+			EXPECT_LE(a.m_x + a.m_width, packer.get_width());
+			EXPECT_LE(a.m_y + a.m_height, packer.get_height());
+
+			const bool same    = a.m_width == sizes[i].first && a.m_height == sizes[i].second;
+			const bool swapped = a.m_width == sizes[i].second && a.m_height == sizes[i].first;
+			EXPECT_TRUE(same || (rotated && swapped));
+
+			for (std::size_t j = i + 1; j < results.size(); j++)
+			{
+				if (results[j].has_value())
+				{
+					const auto& b = results[j].value();
+					EXPECT_FALSE(a.m_x < b.m_x + b.m_width && b.m_x < a.m_x + a.m_width && a.m_y < b.m_y + b.m_height && b.m_y < a.m_y + a.m_height);
+				}
+			}
+		}
+
+		return results;
+	}
+
+	///
+	/// Packs into as many pages as needed, each item into the first page with room.
+	///
+	std::size_t pack_pages(const Sizes& sizes, const int size, const galaxy::math::PackMethod method, float& occupancy)
+	{
+		std::vector<galaxy::math::RectPack<int>> pages;
+		std::int64_t used = 0;
+
+		for (const auto& [width, height] : sizes)
+		{
+			bool placed = false;
+			for (auto& page : pages)
+			{
+				if (page.pack(width, height).has_value())
+				{
+					placed = true;
+					break;
+				}
+			}
+
+			if (!placed)
+			{
+				pages.emplace_back().init(size, size, method);
+				placed = pages.back().pack(width, height).has_value();
+			}
+
+			if (placed)
+			{
+				used += static_cast<std::int64_t>(width) * height;
+			}
+		}
+
+		occupancy = static_cast<float>(static_cast<double>(used) / (static_cast<double>(size) * size * pages.size()));
+		return pages.size();
+	}
+
+	///
+	/// Sizes of the textures shipped with the sandbox, or nothing if it is not next to the tests.
+	///
+	Sizes sandbox_textures()
+	{
+		Sizes sizes;
+
+		const auto dir = std::filesystem::path {__FILE__}.parent_path() / ".." / ".." / ".." / "sandbox_tests" / "bin" / "Debug" / "assets" / "textures";
+		if (std::filesystem::is_directory(dir))
+		{
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(dir))
+			{
+				int width = 0, height = 0, channels = 0;
+				if (entry.is_regular_file() && stbi_info(entry.path().string().c_str(), &width, &height, &channels))
+				{
+					sizes.emplace_back(width, height);
+				}
+			}
+		}
+
+		return sizes;
+	}
+} // namespace
+
 TEST(RectPack, Init)
 {
 	galaxy::math::RectPack<int> p;
@@ -95,4 +216,206 @@ TEST(RectPack, Fits)
 
 	EXPECT_EQ(spaceB.m_width, 90);
 	EXPECT_EQ(spaceB.m_height, res->m_height);
+}
+
+TEST(RectPack, InitResets)
+{
+	galaxy::math::RectPack<int> p;
+	p.init(100, 100);
+	ASSERT_TRUE(p.pack(50, 50).has_value());
+
+	p.init(100, 100, galaxy::math::PackMethod::MAXRECTS_BSSF);
+	EXPECT_EQ(p.get_method(), galaxy::math::PackMethod::MAXRECTS_BSSF);
+	EXPECT_EQ(p.get_used_area(), 0);
+	ASSERT_EQ(p.get_free_space().size(), 1);
+	EXPECT_EQ(p.get_free_space()[0].m_width, 100);
+}
+
+TEST(RectPack, MaxRectsKeepsMaximalSpace)
+{
+	galaxy::math::RectPack<int> p;
+	p.init(100, 100, galaxy::math::PackMethod::MAXRECTS_BSSF);
+	ASSERT_TRUE(p.pack(10, 10).has_value());
+
+	// Both leftovers span the full master rectangle, unlike a guillotine split.
+	ASSERT_EQ(p.get_free_space().size(), 2);
+	for (const auto& space : p.get_free_space())
+	{
+		EXPECT_TRUE((space.m_width == 100 && space.m_height == 90) || (space.m_width == 90 && space.m_height == 100));
+	}
+
+	// Exactly fills the gap the guillotine would have cut off.
+	EXPECT_TRUE(p.pack(90, 100).has_value());
+	EXPECT_TRUE(p.pack(10, 90).has_value());
+	EXPECT_FALSE(p.pack(1, 1).has_value());
+	EXPECT_FLOAT_EQ(p.get_occupancy(), 1.0f);
+}
+
+TEST(RectPack, MaxRectsBestShortSide)
+{
+	galaxy::math::RectPack<int> p;
+	p.init(100, 100, galaxy::math::PackMethod::MAXRECTS_BSSF);
+	ASSERT_TRUE(p.pack(60, 60).has_value());
+
+	// 40 wide strip on the right fits a 40 wide rect exactly, so it is chosen over the bottom strip.
+	const auto res = p.pack(40, 20);
+	ASSERT_TRUE(res.has_value());
+	EXPECT_EQ(res->m_x, 60);
+	EXPECT_EQ(res->m_y, 0);
+}
+
+TEST(RectPack, SkylineBottomLeft)
+{
+	galaxy::math::RectPack<int> p;
+	p.init(100, 100, galaxy::math::PackMethod::SKYLINE_BL);
+	EXPECT_TRUE(p.get_free_space().empty());
+
+	const auto a = p.pack(60, 30);
+	const auto b = p.pack(40, 10);
+	const auto c = p.pack(40, 10);
+	const auto d = p.pack(100, 70);
+
+	ASSERT_TRUE(a.has_value() && b.has_value() && c.has_value() && d.has_value());
+	EXPECT_EQ(b->m_x, 60);
+	EXPECT_EQ(b->m_y, 0);
+	EXPECT_EQ(c->m_y, 10);
+	EXPECT_EQ(d->m_y, 30);
+	EXPECT_FALSE(p.pack(1, 1).has_value());
+}
+
+TEST(RectPack, Rotation)
+{
+	for (const auto method : {galaxy::math::PackMethod::GUILLOTINE, galaxy::math::PackMethod::MAXRECTS_BSSF, galaxy::math::PackMethod::SKYLINE_BL})
+	{
+		galaxy::math::RectPack<int> fixed;
+		fixed.init(100, 20, method);
+		EXPECT_FALSE(fixed.pack(20, 100).has_value());
+
+		galaxy::math::RectPack<int> rotating;
+		rotating.init(100, 20, method, true);
+
+		const auto res = rotating.pack(20, 100);
+		ASSERT_TRUE(res.has_value());
+		EXPECT_EQ(res->m_width, 100);
+		EXPECT_EQ(res->m_height, 20);
+	}
+}
+
+TEST(RectPack, BatchKeepsInputOrder)
+{
+	const Sizes sizes = {{10, 10}, {64, 64}, {999, 1}, {32, 16}, {0, 5}};
+
+	for (const auto method : {galaxy::math::PackMethod::GUILLOTINE, galaxy::math::PackMethod::MAXRECTS_BSSF, galaxy::math::PackMethod::SKYLINE_BL})
+	{
+		galaxy::math::RectPack<int> p;
+		p.init(128, 128, method);
+
+		const auto results = pack_checked(p, sizes);
+		EXPECT_TRUE(results[0].has_value());
+		EXPECT_TRUE(results[1].has_value());
+		EXPECT_FALSE(results[2].has_value());
+		EXPECT_TRUE(results[3].has_value());
+		EXPECT_FALSE(results[4].has_value());
+
+		// Largest goes first, into the corner.
+		EXPECT_EQ(results[1]->m_x, 0);
+		EXPECT_EQ(results[1]->m_y, 0);
+		EXPECT_EQ(p.get_used_area(), 10 * 10 + 64 * 64 + 32 * 16);
+	}
+}
+
+TEST(RectPack, ManyRectsNeverOverlap)
+{
+	std::mt19937 rng {1337};
+	std::uniform_int_distribution<int> dist {1, 48};
+
+	Sizes sizes(400);
+	for (auto& [width, height] : sizes)
+	{
+		width  = dist(rng);
+		height = dist(rng);
+	}
+
+	for (const auto rotate : {false, true})
+	{
+		for (const auto method : {galaxy::math::PackMethod::GUILLOTINE, galaxy::math::PackMethod::MAXRECTS_BSSF, galaxy::math::PackMethod::SKYLINE_BL})
+		{
+			galaxy::math::RectPack<int> p;
+			p.init(512, 512, method, rotate);
+
+			const auto results = pack_checked(p, sizes, rotate);
+
+			std::int64_t area = 0;
+			for (const auto& res : results)
+			{
+				area += res.has_value() ? static_cast<std::int64_t>(res->m_width) * res->m_height : 0;
+			}
+
+			EXPECT_EQ(p.get_used_area(), area);
+			EXPECT_GT(p.get_occupancy(), 0.5f);
+			EXPECT_LE(p.get_occupancy(), 1.0f);
+		}
+	}
+}
+
+TEST(RectPack, Benchmark)
+{
+	std::mt19937 rng {42};
+	std::uniform_int_distribution<int> dist {8, 128};
+
+	Sizes sprites(1000);
+	for (auto& [width, height] : sprites)
+	{
+		width  = dist(rng);
+		height = dist(rng);
+	}
+
+	auto textures = sandbox_textures();
+	if (textures.empty())
+	{
+		textures = sprites;
+	}
+
+	const std::pair<const char*, galaxy::math::PackMethod> methods[] = {{"guillotine", galaxy::math::PackMethod::GUILLOTINE},
+		{"maxrects", galaxy::math::PackMethod::MAXRECTS_BSSF},
+		{"skyline", galaxy::math::PackMethod::SKYLINE_BL}};
+
+	const std::tuple<const char*, const Sizes*, int> sets[] = {{"sprites", &sprites, 1024}, {"sandbox textures", &textures, 2048}};
+
+	for (const auto& [set_name, set, size] : sets)
+	{
+		// Same order an atlas would get them in, and sorted by area like a baker would.
+		auto sorted = *set;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+			return a.first * a.second > b.first * b.second;
+		});
+
+		std::size_t maxrects_pages   = 0;
+		std::size_t guillotine_pages = 0;
+
+		for (const auto& [method_name, method] : methods)
+		{
+			float unsorted_occupancy = 0.0f, sorted_occupancy = 0.0f;
+			std::size_t unsorted_pages = 0, sorted_pages = 0;
+
+			const auto ms = time_ms([&]() {
+				unsorted_pages = pack_pages(*set, size, method, unsorted_occupancy);
+				sorted_pages   = pack_pages(sorted, size, method, sorted_occupancy);
+			});
+
+			std::cout << "[ RectPackBenchmark ] " << set->size() << " " << set_name << " with " << method_name << ". Unsorted: " << unsorted_pages << " pages at "
+					  << unsorted_occupancy * 100.0f << "%. Sorted by area: " << sorted_pages << " pages at " << sorted_occupancy * 100.0f << "%. " << ms << " ms.\n";
+
+			if (method == galaxy::math::PackMethod::GUILLOTINE)
+			{
+				guillotine_pages = sorted_pages;
+			}
+			else if (method == galaxy::math::PackMethod::MAXRECTS_BSSF)
+			{
+				maxrects_pages = sorted_pages;
+			}
+		}
+
+		EXPECT_LE(maxrects_pages, guillotine_pages);
+	}
 }
\ No newline at end of file
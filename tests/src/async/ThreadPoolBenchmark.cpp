@@ -0,0 +1,190 @@
+///
+/// ThreadPoolBenchmark.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <semaphore>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/async/ThreadPool.hpp>
+
+namespace
+{
+	///
+	/// Single queue, mutex and semaphore pool. Same design as the pool the job system replaced, kept as a baseline.
+	///
+	class LockedPool final
+	{
+	public:
+		LockedPool(const unsigned int workers)
+		    : m_sync {0}, m_running {true}
+		{
+			for (unsigned int i = 0; i < workers; i++)
+			{
+				m_workers.emplace_back([this]() {
+					while (m_running)
+					{
+						m_sync.acquire();
+
+						std::function<void(void)> task;
+						{
+							std::lock_guard<std::mutex> lock {m_mutex};
+							if (!m_tasks.empty())
+							{
+								task = std::move(m_tasks.front());
+								m_tasks.pop();
+							}
+						}
+
+						if (task)
+						{
+							task();
+						}
+					}
+				});
+			}
+		}
+
+		~LockedPool()
+		{
+			m_running = false;
+			m_sync.release(m_workers.size());
+			m_workers.clear();
+		}
+
+		void queue(std::function<void(void)>&& task)
+		{
+			{
+				std::lock_guard<std::mutex> lock {m_mutex};
+				m_tasks.emplace(std::move(task));
+			}
+
+			m_sync.release();
+		}
+
+	private:
+		std::vector<std::jthread> m_workers;
+		std::queue<std::function<void(void)>> m_tasks;
+		std::counting_semaphore<> m_sync;
+		std::mutex m_mutex;
+		std::atomic<bool> m_running;
+	};
+
+	constexpr const int JOBS      = 200'000;
+	constexpr const int PRODUCERS = 4;
+
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	void spin_until(const std::atomic<int>& count, const int target)
+	{
+		while (count.load() < target)
+		{
+			std::this_thread::yield();
+		}
+	}
+} // namespace
+
+TEST(ThreadPoolBenchmark, SingleProducer)
+{
+	const auto workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	std::atomic<int> locked_count = 0;
+	const auto locked = time_ms([&]() {
+		LockedPool pool {workers};
+		for (int i = 0; i < JOBS; i++)
+		{
+			pool.queue([&]() {
+				locked_count++;
+			});
+		}
+
+		spin_until(locked_count, JOBS);
+	});
+
+	std::atomic<int> stealing_count = 0;
+	const auto stealing = time_ms([&]() {
+		galaxy::async::ThreadPool pool {workers};
+		galaxy::async::JobHandle root;
+		root = pool.submit([&]() {
+			for (int i = 0; i < JOBS; i++)
+			{
+				pool.submit(root, [&]() {
+					stealing_count++;
+				});
+			}
+		});
+
+		pool.wait(root);
+		pool.finish();
+	});
+
+	std::cout << "[ ThreadPoolBenchmark ] " << JOBS << " jobs, 1 producer. locked: " << locked << " ms, work stealing: " << stealing << " ms.\n";
+
+	EXPECT_EQ(locked_count.load(), JOBS);
+	EXPECT_EQ(stealing_count.load(), JOBS);
+}
+
+TEST(ThreadPoolBenchmark, MultipleProducers)
+{
+	const auto workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+	std::atomic<int> locked_count = 0;
+	const auto locked = time_ms([&]() {
+		LockedPool pool {workers};
+		{
+			std::vector<std::jthread> producers;
+			for (int p = 0; p < PRODUCERS; p++)
+			{
+				producers.emplace_back([&]() {
+					for (int i = 0; i < JOBS / PRODUCERS; i++)
+					{
+						pool.queue([&]() {
+							locked_count++;
+						});
+					}
+				});
+			}
+		}
+
+		spin_until(locked_count, JOBS);
+	});
+
+	std::atomic<int> stealing_count = 0;
+	const auto stealing = time_ms([&]() {
+		galaxy::async::ThreadPool pool {workers};
+		pool.parallel_for(0, PRODUCERS, 1, [&](const std::size_t begin, const std::size_t end) {
+			for (int i = 0; i < JOBS / PRODUCERS; i++)
+			{
+				pool.submit([&]() {
+					stealing_count++;
+				});
+			}
+		});
+
+		spin_until(stealing_count, JOBS);
+		pool.finish();
+	});
+
+	std::cout << "[ ThreadPoolBenchmark ] " << JOBS << " jobs, " << PRODUCERS << " producers. locked: " << locked << " ms, work stealing: " << stealing << " ms.\n";
+
+	EXPECT_EQ(locked_count.load(), JOBS);
+	EXPECT_EQ(stealing_count.load(), JOBS);
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <galaxy/async/ThreadPool.hpp>
@@ -23,4 +25,160 @@ TEST(Async, ThreadPool)
 	pool.finish();
 
 	EXPECT_EQ(count.load(), 2);
+}
+
+TEST(Async, ThreadPoolSubmitWait)
+{
+	galaxy::async::ThreadPool pool {2};
+
+	std::atomic<int> count = 0;
+
+	auto job = pool.submit([&]() {
+		count++;
+	});
+
+	pool.wait(job);
+
+	EXPECT_TRUE(job.is_done());
+	EXPECT_EQ(count.load(), 1);
+}
+
+TEST(Async, ThreadPoolChildJobs)
+{
+	galaxy::async::ThreadPool pool {2};
+
+	std::atomic<int> count = 0;
+	galaxy::async::JobHandle parent;
+	parent = pool.submit([&]() {
+		for (int i = 0; i < 10; i++)
+		{
+			pool.submit(parent, [&]() {
+				count++;
+			});
+		}
+	});
+
+	pool.wait(parent);
+
+	EXPECT_EQ(count.load(), 10);
+}
+
+TEST(Async, ThreadPoolContinuation)
+{
+	galaxy::async::ThreadPool pool {2};
+
+	std::atomic<int> value = 0;
+
+	auto first = pool.submit([&]() {
+		value = 1;
+	});
+
+	auto second = pool.then(first, [&]() {
+		value = value * 10;
+	});
+
+	pool.wait(second);
+
+	EXPECT_TRUE(first.is_done());
+	EXPECT_EQ(value.load(), 10);
+}
+
+TEST(Async, ThreadPoolManyJobs)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	// More than a single deque can hold.
+	std::atomic<int> count = 0;
+	std::vector<galaxy::async::JobHandle> jobs;
+	for (int i = 0; i < 10000; i++)
+	{
+		jobs.emplace_back(pool.submit([&]() {
+			count++;
+		}));
+	}
+
+	for (const auto& job : jobs)
+	{
+		pool.wait(job);
+	}
+
+	EXPECT_EQ(count.load(), 10000);
+}
+
+TEST(Async, ThreadPoolSubmitFromOtherThread)
+{
+	galaxy::async::ThreadPool pool {2};
+
+	std::atomic<int> count = 0;
+	std::thread thread {[&]() {
+		auto job = pool.submit([&]() {
+			count++;
+		});
+
+		pool.wait(job);
+	}};
+
+	thread.join();
+
+	EXPECT_EQ(count.load(), 1);
+}
+
+TEST(Async, ThreadPoolParallelFor)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	std::vector<int> data(100000, 1);
+	std::atomic<long long> sum = 0;
+
+	pool.parallel_for(0, data.size(), 1024, [&](const std::size_t begin, const std::size_t end) {
+		EXPECT_LE(end - begin, 1024);
+
+		long long local = 0;
+		for (auto i = begin; i < end; i++)
+		{
+			local += data[i];
+		}
+
+		sum += local;
+	});
+
+	EXPECT_EQ(sum.load(), 100000);
+}
+
+TEST(Async, ThreadPoolNestedParallelFor)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	std::atomic<int> count = 0;
+	pool.parallel_for(0, 16, 1, [&](const std::size_t begin, const std::size_t end) {
+		pool.parallel_for(0, 100, 10, [&](const std::size_t inner_begin, const std::size_t inner_end) {
+			count += static_cast<int>(inner_end - inner_begin);
+		});
+	});
+
+	EXPECT_EQ(count.load(), 1600);
+}
+
+TEST(Async, ThreadPoolTwoPoolsOnOneThread)
+{
+	galaxy::async::ThreadPool first {2};
+
+	std::atomic<int> count = 0;
+	{
+		// Second pool made and destroyed on the same thread must not take deque 0 away from the first.
+		galaxy::async::ThreadPool second {2};
+		second.parallel_for(0, 100, 10, [&](const std::size_t begin, const std::size_t end) {
+			count += static_cast<int>(end - begin);
+		});
+
+		first.parallel_for(0, 100, 10, [&](const std::size_t begin, const std::size_t end) {
+			count += static_cast<int>(end - begin);
+		});
+	}
+
+	first.parallel_for(0, 100, 10, [&](const std::size_t begin, const std::size_t end) {
+		count += static_cast<int>(end - begin);
+	});
+
+	EXPECT_EQ(count.load(), 300);
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+///
+/// Transform2DTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <array>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+#include <galaxy/components/Transform2D.hpp>
+
+namespace
+{
+	constexpr const float EPSILON = 1e-3f;
+
+	///
+	/// Values a transform is set up with.
+	///
+	struct Setup final
+	{
+		glm::vec2 m_pos;
+		glm::vec2 m_origin;
+		float m_degrees;
+		float m_scale;
+	};
+
+	///
+	/// Offset origin, rotation and scale away from 1, alone and together.
+	///
+	const std::array<Setup, 4> SETUPS = {{
+		{.m_pos = {120.0f, -35.0f}, .m_origin = {16.0f, 8.0f}, .m_degrees = 30.0f, .m_scale = 1.5f},
+		{.m_pos = {-4.0f, 250.0f}, .m_origin = {32.0f, -12.0f}, .m_degrees = 215.0f, .m_scale = 0.5f},
+		{.m_pos = {10.0f, 20.0f}, .m_origin = {0.0f, 0.0f}, .m_degrees = 90.0f, .m_scale = 1.0f},
+		{.m_pos = {0.0f, 0.0f}, .m_origin = {24.0f, 24.0f}, .m_degrees = 0.0f, .m_scale = 2.0f},
+	}};
+
+	///
+	/// Apply a setup to a transform.
+	///
+	void apply(galaxy::components::Transform2D& transform, const Setup& setup)
+	{
+		transform.set_pos(setup.m_pos.x, setup.m_pos.y);
+		transform.set_origin(setup.m_origin.x, setup.m_origin.y);
+		transform.rotate(setup.m_degrees);
+		transform.scale(setup.m_scale);
+	}
+
+	///
+	/// Model matrix from the translate * rotate * scale chain Transform2D used before caching an affine.
+	///
+	glm::mat4 reference(const Setup& setup)
+	{
+		const glm::mat4 identity {1.0f};
+		const glm::vec3 origin {setup.m_origin, 0.0f};
+
+		const auto translation = glm::translate(identity, {setup.m_pos.x, setup.m_pos.y, 0.0f});
+
+		auto rotation = glm::translate(identity, origin);
+		rotation      = glm::rotate(rotation, glm::radians(setup.m_degrees), {0.0f, 0.0f, 1.0f});
+		rotation      = glm::translate(rotation, -origin);
+
+		auto scale = glm::translate(identity, origin);
+		scale      = glm::scale(scale, {setup.m_scale, setup.m_scale, 1.0f});
+		scale      = glm::translate(scale, -origin);
+
+		return translation * rotation * scale;
+	}
+} // namespace
+
+TEST(Transform2D, AffineMatchesMatrixChain)
+{
+	for (const auto& setup : SETUPS)
+	{
+		galaxy::components::Transform2D transform;
+		apply(transform, setup);
+
+		const auto expected = reference(setup);
+		const auto& affine  = transform.get_affine();
+
+		// Affine keeps the x axis, y axis and translation columns of the 4x4.
+		EXPECT_NEAR(affine[0].x, expected[0].x, EPSILON);
+		EXPECT_NEAR(affine[0].y, expected[0].y, EPSILON);
+		EXPECT_NEAR(affine[1].x, expected[1].x, EPSILON);
+		EXPECT_NEAR(affine[1].y, expected[1].y, EPSILON);
+		EXPECT_NEAR(affine[2].x, expected[3].x, EPSILON);
+		EXPECT_NEAR(affine[2].y, expected[3].y, EPSILON);
+	}
+}
+
+TEST(Transform2D, TransformMatchesMatrixChain)
+{
+	for (const auto& setup : SETUPS)
+	{
+		galaxy::components::Transform2D transform;
+		apply(transform, setup);
+
+		const auto expected = reference(setup);
+		const auto model    = transform.get_transform();
+
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				EXPECT_NEAR(model[column][row], expected[column][row], EPSILON);
+			}
+		}
+	}
+}
+
+TEST(Transform2D, TransformPointMatchesMatrixChain)
+{
+	const std::array<glm::vec2, 4> points = {{{0.0f, 0.0f}, {32.0f, 0.0f}, {32.0f, 16.0f}, {-7.5f, 3.25f}}};
+
+	for (const auto& setup : SETUPS)
+	{
+		galaxy::components::Transform2D transform;
+		apply(transform, setup);
+
+		const auto expected = reference(setup);
+		for (const auto& point : points)
+		{
+			const auto world = expected * glm::vec4 {point, 0.0f, 1.0f};
+			const auto moved = transform.transform_point(point.x, point.y);
+
+			EXPECT_NEAR(moved.x, world.x, EPSILON);
+			EXPECT_NEAR(moved.y, world.y, EPSILON);
+		}
+	}
+}
+
+TEST(Transform2D, RecalculateClearsDirty)
+{
+	galaxy::components::Transform2D transform;
+	EXPECT_TRUE(transform.is_dirty());
+
+	transform.recalculate();
+	EXPECT_FALSE(transform.is_dirty());
+
+	transform.move(5.0f, 5.0f);
+	EXPECT_TRUE(transform.is_dirty());
+
+	// Reading the affine brings it up to date.
+	EXPECT_NEAR(transform.get_affine()[2].x, 5.0f, EPSILON);
+	EXPECT_FALSE(transform.is_dirty());
+}
+
+TEST(Transform2D, RecalculateBatchMatchesRecalculate)
+{
+	std::vector<galaxy::components::Transform2D> batched(SETUPS.size() * 2);
+	std::vector<galaxy::components::Transform2D> single(SETUPS.size() * 2);
+
+	// Some transforms have never been calculated, some have a stale cache and some are already clean.
+	for (std::size_t i = 0; i < batched.size(); i++)
+	{
+		apply(batched[i], SETUPS[i % SETUPS.size()]);
+		apply(single[i], SETUPS[i % SETUPS.size()]);
+
+		if (i % 3 != 0)
+		{
+			batched[i].recalculate();
+			single[i].recalculate();
+		}
+
+		if (i % 3 == 1)
+		{
+			batched[i].move(1.0f, -1.0f);
+			single[i].move(1.0f, -1.0f);
+		}
+	}
+
+	galaxy::components::Transform2D::recalculate_batch(batched);
+	for (auto& transform : single)
+	{
+		transform.recalculate();
+	}
+
+	for (std::size_t i = 0; i < batched.size(); i++)
+	{
+		EXPECT_FALSE(batched[i].is_dirty());
+
+		const auto& expected = single[i].get_affine();
+		const auto& actual   = batched[i].get_affine();
+		for (int column = 0; column < 3; column++)
+		{
+			EXPECT_EQ(actual[column].x, expected[column].x);
+			EXPECT_EQ(actual[column].y, expected[column].y);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+///
+/// WorldBenchmark.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/core/World.hpp>
+
+namespace
+{
+	struct BenchPosition
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	struct BenchVelocity
+	{
+		float x = 1.0f;
+		float y = 1.0f;
+	};
+
+	///
+	/// Returns average nanoseconds per entity for one operate() pass.
+	///
+	double time_operate(const std::size_t count)
+	{
+		galaxy::core::World world;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const auto e = world.create();
+			world.create_component<BenchPosition>(e);
+			world.create_component<BenchVelocity>(e);
+			world.enable(e);
+		}
+
+		const auto pass = [&]() {
+			world.operate<BenchPosition, BenchVelocity>([](const galaxy::ecs::Entity entity, BenchPosition* pos, BenchVelocity* vel) {
+				pos->x += vel->x;
+				pos->y += vel->y;
+			});
+		};
+
+		// Warm up group cache.
+		pass();
+
+		constexpr const int passes = 5;
+		const auto start           = std::chrono::steady_clock::now();
+		for (int i = 0; i < passes; i++)
+		{
+			pass();
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+		return ns / static_cast<double>(passes * count);
+	}
+} // namespace
+
+TEST(WorldBenchmark, Operate)
+{
+	const auto small  = time_operate(10'000);
+	const auto medium = time_operate(100'000);
+	const auto large  = time_operate(1'000'000);
+
+	std::cout << "[ WorldBenchmark ] operate 10k: " << small << " ns/entity, 100k: " << medium << " ns/entity, 1M: " << large << " ns/entity.\n";
+}
+
+TEST(WorldBenchmark, Destroy)
+{
+	constexpr const std::size_t count = 100'000;
+
+	galaxy::core::World world;
+	std::vector<galaxy::ecs::Entity> entities;
+	entities.reserve(count);
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		entities.push_back(world.create());
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	for (const auto entity : entities)
+	{
+		world.destroy(entity);
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	std::cout << "[ WorldBenchmark ] destroy 100k: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms.\n";
+
+	for (const auto entity : entities)
+	{
+		EXPECT_FALSE(world.has(entity));
+	}
+}
\ No newline at end of file
@@ -5,9 +5,20 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <mutex>
+#include <numeric>
+
 #include <gtest/gtest.h>
 
+#include <galaxy/components/Animated.hpp>
+#include <galaxy/components/BatchSprite.hpp>
+#include <galaxy/components/ParticleEffect.hpp>
 #include <galaxy/core/World.hpp>
+#include <galaxy/systems/AnimationSystem.hpp>
+#include <galaxy/systems/CollisionSystem.hpp>
+#include <galaxy/systems/ParticleSystem.hpp>
+#include <galaxy/systems/RenderSystem2D.hpp>
+#include <galaxy/systems/TransformSystem.hpp>
 
 struct Component
 {
@@ -84,6 +95,52 @@ struct DemoSystem : public galaxy::ecs::System
 	int val = 0;
 };
 
+std::mutex g_order_mutex;
+std::vector<int> g_order;
+
+template<int ID>
+struct WritesA : public galaxy::ecs::System
+{
+	WritesA()
+	{
+		writes<AA>();
+	}
+
+	void update(galaxy::core::Scene2D* scene, const double dt) override
+	{
+		std::lock_guard<std::mutex> lock {g_order_mutex};
+		g_order.push_back(ID);
+	}
+};
+
+struct WritesB : public galaxy::ecs::System
+{
+	WritesB()
+	{
+		writes<BB>();
+	}
+
+	void update(galaxy::core::Scene2D* scene, const double dt) override
+	{
+		std::lock_guard<std::mutex> lock {g_order_mutex};
+		g_order.push_back(2);
+	}
+};
+
+struct ReadsA : public galaxy::ecs::System
+{
+	ReadsA()
+	{
+		reads<AA>();
+	}
+
+	void update(galaxy::core::Scene2D* scene, const double dt) override
+	{
+		std::lock_guard<std::mutex> lock {g_order_mutex};
+		g_order.push_back(3);
+	}
+};
+
 TEST(ECS, CreateHasEntity)
 {
 	galaxy::core::World m;
@@ -270,6 +327,41 @@ TEST(ECS, OperateMissing)
 	EXPECT_EQ(a->val, 5);
 }
 
+TEST(ECS, OperateNeverAdded)
+{
+	struct NeverAdded
+	{
+		int val = 0;
+	};
+
+	galaxy::async::ThreadPool pool {2};
+
+	galaxy::core::World m;
+	m.set_thread_pool(&pool);
+
+	auto e = m.create();
+	m.enable(e);
+	m.create_component<AA>(e);
+
+	int calls = 0;
+	m.operate<AA, NeverAdded>(std::execution::seq, [&](const galaxy::ecs::Entity entity, AA* a, NeverAdded* n) {
+		calls++;
+	});
+
+	m.operate<NeverAdded>(std::execution::par, [&](const galaxy::ecs::Entity entity, NeverAdded* n) {
+		calls++;
+	});
+
+	const auto results = m.operate_chunked<int, NeverAdded>([&](int& sum, const galaxy::ecs::Entity entity, NeverAdded* n) {
+		sum++;
+	});
+
+	EXPECT_EQ(calls, 0);
+	EXPECT_TRUE(results.empty());
+
+	pool.finish();
+}
+
 TEST(ECS, OperateAddRemove)
 {
 	galaxy::core::World m;
@@ -317,6 +409,203 @@ TEST(ECS, OperateAddRemove)
 	EXPECT_EQ(b2->val, 2);
 }
 
+TEST(ECS, OperateDisabled)
+{
+	galaxy::core::World m;
+	auto e = m.create();
+	m.create_component<AA>(e);
+	m.create_component<BB>(e);
+
+	int count = 0;
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		count++;
+	});
+
+	EXPECT_EQ(count, 0);
+
+	m.enable(e);
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		count++;
+	});
+
+	EXPECT_EQ(count, 1);
+
+	m.disable(e);
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		count++;
+	});
+
+	EXPECT_EQ(count, 1);
+}
+
+TEST(ECS, OperateAfterGroupCreated)
+{
+	galaxy::core::World m;
+	auto e1 = m.create();
+	m.enable(e1);
+	m.create_component<AA>(e1);
+	m.create_component<BB>(e1);
+
+	int count = 0;
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		count++;
+	});
+
+	EXPECT_EQ(count, 1);
+
+	// Group already exists, so these must be picked up incrementally.
+	auto e2 = m.create();
+	m.enable(e2);
+	m.create_component<BB>(e2);
+	m.create_component<AA>(e2);
+
+	count = 0;
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		a->val = static_cast<int>(entity) + 1;
+		count++;
+	});
+
+	EXPECT_EQ(count, 2);
+	EXPECT_EQ(m.get<AA>(e1)->val, static_cast<int>(e1) + 1);
+	EXPECT_EQ(m.get<AA>(e2)->val, static_cast<int>(e2) + 1);
+}
+
+TEST(ECS, OperateAfterDestroy)
+{
+	galaxy::core::World m;
+	auto e1 = m.create();
+	auto e2 = m.create();
+	m.enable(e1);
+	m.enable(e2);
+	m.create_component<AA>(e1);
+	m.create_component<AA>(e2);
+
+	int count = 0;
+	m.operate<AA>([&](const galaxy::ecs::Entity entity, AA* a) {
+		count++;
+	});
+
+	EXPECT_EQ(count, 2);
+
+	m.destroy(e1);
+
+	count = 0;
+	m.operate<AA>([&](const galaxy::ecs::Entity entity, AA* a) {
+		EXPECT_EQ(entity, e2);
+		count++;
+	});
+
+	EXPECT_EQ(count, 1);
+}
+
+TEST(ECS, RecycledEntityDoesNotAlias)
+{
+	galaxy::core::World m;
+	auto e1 = m.create();
+	m.create_component<Component>(e1, 10);
+	m.destroy(e1);
+
+	auto e2 = m.create();
+	EXPECT_NE(e1, e2);
+	EXPECT_EQ(galaxy::ecs::entity_index(e1), galaxy::ecs::entity_index(e2));
+	EXPECT_FALSE(m.has(e1));
+
+	m.create_component<Component>(e2, 20);
+	EXPECT_EQ(m.get<Component>(e1), nullptr);
+	EXPECT_EQ(m.get<Component>(e2)->val, 20);
+}
+
+TEST(ECS, ComponentManyAddRemove)
+{
+	galaxy::core::World m;
+	std::vector<galaxy::ecs::Entity> entities;
+
+	// Spans multiple sparse pages.
+	for (int i = 0; i < 10000; i++)
+	{
+		const auto e = m.create();
+		m.create_component<Component>(e, i);
+		entities.push_back(e);
+	}
+
+	for (int i = 0; i < 10000; i += 2)
+	{
+		m.remove<Component>(entities[i]);
+	}
+
+	for (int i = 0; i < 10000; i++)
+	{
+		auto* comp = m.get<Component>(entities[i]);
+		if (i % 2 == 0)
+		{
+			EXPECT_EQ(comp, nullptr);
+		}
+		else
+		{
+			ASSERT_TRUE(comp != nullptr);
+			EXPECT_EQ(comp->val, i);
+		}
+	}
+
+	EXPECT_EQ(m.query_count<Component>(), 5000);
+}
+
+TEST(ECS, OperateParallelPool)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	galaxy::core::World m;
+	m.set_thread_pool(&pool);
+
+	for (int i = 0; i < 10000; i++)
+	{
+		const auto e = m.create();
+		m.create_component<AA>(e);
+		m.create_component<BB>(e);
+		m.enable(e);
+	}
+
+	m.operate<AA, BB>(std::execution::par, [](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		a->val += 1;
+		b->val += 2;
+	});
+
+	int total = 0;
+	m.operate<AA, BB>([&](const galaxy::ecs::Entity entity, AA* a, BB* b) {
+		total += a->val + b->val;
+	});
+
+	EXPECT_EQ(total, 30000);
+
+	pool.finish();
+}
+
+TEST(ECS, OperateChunked)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	galaxy::core::World m;
+	m.set_thread_pool(&pool);
+
+	constexpr const int count = 5000;
+	for (int i = 0; i < count; i++)
+	{
+		const auto e = m.create();
+		m.create_component<AA>(e);
+		m.get<AA>(e)->val = 2;
+		m.enable(e);
+	}
+
+	const auto sums = m.operate_chunked<int, AA>([](int& sum, const galaxy::ecs::Entity entity, AA* a) {
+		sum += a->val;
+	});
+
+	EXPECT_EQ(sums.size(), (count + galaxy::core::World::OPERATE_CHUNK_SIZE - 1) / galaxy::core::World::OPERATE_CHUNK_SIZE);
+	EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0), count * 2);
+
+	pool.finish();
+}
+
 TEST(ECS, Destroy)
 {
 	galaxy::core::World m;
@@ -388,6 +677,127 @@ TEST(ECS, UpdatesWithNoSystems)
 	m.update(nullptr, 0.0);
 }
 
+TEST(ECS, ScheduleIndependentSystems)
+{
+	galaxy::core::World m;
+	m.create_system<WritesA<1>>();
+	m.create_system<WritesB>();
+
+	const auto& stages = m.get_scheduler().get_stages();
+	ASSERT_EQ(stages.size(), 1);
+	EXPECT_EQ(stages[0].size(), 2);
+}
+
+TEST(ECS, ScheduleDependentSystems)
+{
+	galaxy::core::World m;
+	m.create_system<WritesA<1>>();
+	m.create_system<WritesB>();
+	m.create_system<ReadsA>();
+	m.create_system<WritesA<4>>();
+
+	const auto& stages = m.get_scheduler().get_stages();
+	ASSERT_EQ(stages.size(), 3);
+	EXPECT_EQ(stages[0], (std::vector<std::size_t> {0, 1}));
+	EXPECT_EQ(stages[1], (std::vector<std::size_t> {2}));
+	EXPECT_EQ(stages[2], (std::vector<std::size_t> {3}));
+}
+
+TEST(ECS, ScheduleUndeclaredSystem)
+{
+	galaxy::core::World m;
+	m.create_system<WritesA<1>>();
+	m.create_system<DemoSystem>(5);
+	m.create_system<WritesB>();
+
+	EXPECT_EQ(m.get_scheduler().get_stages().size(), 3);
+}
+
+TEST(ECS, UpdatesParallel)
+{
+	galaxy::async::ThreadPool pool;
+
+	galaxy::core::World m;
+	m.set_thread_pool(&pool);
+	m.create_system<WritesA<1>>();
+	m.create_system<WritesB>();
+	m.create_system<ReadsA>();
+
+	for (int i = 0; i < 100; i++)
+	{
+		g_order.clear();
+		m.update(nullptr, 0.0);
+
+		ASSERT_EQ(g_order.size(), 3);
+		EXPECT_EQ(g_order.back(), 3);
+	}
+
+	pool.finish();
+}
+
+TEST(ECS, UpdatesSingleThreaded)
+{
+	galaxy::async::ThreadPool pool;
+
+	galaxy::core::World m;
+	m.set_thread_pool(&pool);
+	m.set_execution_mode(galaxy::ecs::ExecutionMode::SINGLE_THREADED);
+	m.create_system<ReadsA>();
+	m.create_system<WritesB>();
+	m.create_system<WritesA<1>>();
+
+	g_order.clear();
+	m.update(nullptr, 0.0);
+
+	EXPECT_EQ(g_order, (std::vector<int> {3, 2, 1}));
+
+	pool.finish();
+}
+
+TEST(ECS, SceneSystemsFirstFrameParallel)
+{
+	galaxy::async::ThreadPool pool {4};
+
+	for (int i = 0; i < 50; i++)
+	{
+		// Same systems, in the same order, as Scene2D.
+		galaxy::core::World m;
+		m.set_thread_pool(&pool);
+		m.set_execution_mode(galaxy::ecs::ExecutionMode::PARALLEL);
+		m.create_system<galaxy::systems::ParticleSystem>();
+		m.create_system<galaxy::systems::AnimationSystem>();
+		m.create_system<galaxy::systems::TransformSystem>();
+		m.create_system<galaxy::systems::CollisionSystem>();
+		m.create_system<galaxy::systems::RenderSystem2D>();
+
+		const auto& stages = m.get_scheduler().get_stages();
+		ASSERT_FALSE(stages.empty());
+		ASSERT_EQ(stages[0], (std::vector<std::size_t> {0, 1}));
+
+		// Run what the first stage does on its first frame, where both systems create their groups at once.
+		int animated  = 0;
+		int particles = 0;
+
+		auto job = pool.submit([&m, &animated]() {
+			m.operate<galaxy::components::Animated, galaxy::components::BatchSprite>(std::execution::par,
+				[&](const galaxy::ecs::Entity, galaxy::components::Animated*, galaxy::components::BatchSprite*) {
+					animated++;
+				});
+		});
+
+		m.operate<galaxy::components::ParticleEffect>([&](const galaxy::ecs::Entity, galaxy::components::ParticleEffect*) {
+			particles++;
+		});
+
+		pool.wait(job);
+
+		EXPECT_EQ(animated, 0);
+		EXPECT_EQ(particles, 0);
+	}
+
+	pool.finish();
+}
+
 TEST(ECS, Clear)
 {
 	galaxy::core::World m;
@@ -0,0 +1,207 @@
+///
+/// ArchiveTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/fs/FileSystem.hpp>
+#include <galaxy/fs/Packer.hpp>
+
+namespace
+{
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Asset folder with a compressible json file and a binary that won't shrink, packed next to it.
+	///
+	class ArchiveTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_root = std::filesystem::temp_directory_path() / "galaxy_archive_test";
+			std::filesystem::remove_all(m_root);
+			std::filesystem::create_directories(m_root / "assets" / "json");
+			std::filesystem::create_directories(m_root / "assets" / "textures");
+
+			for (int i = 0; i < 200; i++)
+			{
+				m_json += "{\"key\": " + std::to_string(i) + ", \"value\": \"repeated text\"},";
+			}
+
+			for (int i = 0; i < 1000; i++)
+			{
+				m_binary.push_back(static_cast<char>((i * 7919) ^ (i >> 3)));
+			}
+
+			write(m_root / "assets" / "json" / "data.json", m_json);
+			write(m_root / "assets" / "textures" / "player.png", m_binary);
+			write(m_root / "assets" / "empty.txt", "");
+
+			m_archive = m_root / "assets.gpak";
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_root);
+		}
+
+		void write(const std::filesystem::path& path, const std::string& data)
+		{
+			std::ofstream ofs {path, std::ofstream::binary};
+			ofs << data;
+		}
+
+		std::filesystem::path m_root;
+		std::filesystem::path m_archive;
+		std::string m_json;
+		std::string m_binary;
+	};
+} // namespace
+
+TEST_F(ArchiveTest, PackAndView)
+{
+	ASSERT_TRUE(galaxy::fs::pack(m_root / "assets", m_archive));
+
+	// Json is compressed, the png is not worth it.
+	EXPECT_LT(std::filesystem::file_size(m_archive), m_json.size());
+
+	galaxy::fs::Archive archive;
+	ASSERT_TRUE(archive.load(m_archive));
+	EXPECT_EQ(archive.size(), 3);
+	EXPECT_TRUE(archive.contains("json/data.json"));
+	EXPECT_FALSE(archive.contains("data.json"));
+
+	const auto json = archive.view("json/data.json");
+	ASSERT_TRUE(json.has_value());
+	EXPECT_EQ(std::string(json->begin(), json->end()), m_json);
+
+	// Inflated once, then the same buffer is handed out.
+	EXPECT_EQ(archive.view("json/data.json")->data(), json->data());
+
+	const auto png = archive.view("textures/player.png");
+	ASSERT_TRUE(png.has_value());
+	EXPECT_EQ(std::string(png->begin(), png->end()), m_binary);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(png->data()) % galaxy::fs::Archive::ALIGNMENT, 0);
+
+	EXPECT_TRUE(archive.view("empty.txt")->empty());
+	EXPECT_FALSE(archive.view("missing.txt").has_value());
+
+	archive.close();
+	EXPECT_FALSE(archive.is_open());
+	EXPECT_EQ(archive.size(), 0);
+}
+
+TEST_F(ArchiveTest, StoreOnly)
+{
+	ASSERT_TRUE(galaxy::fs::pack(m_root / "assets", m_archive, false));
+	EXPECT_GT(std::filesystem::file_size(m_archive), m_json.size() + m_binary.size());
+
+	galaxy::fs::Archive archive;
+	ASSERT_TRUE(archive.load(m_archive));
+
+	const auto json = archive.view("json/data.json");
+	ASSERT_TRUE(json.has_value());
+	EXPECT_EQ(std::string(json->begin(), json->end()), m_json);
+}
+
+TEST_F(ArchiveTest, RejectsMalformed)
+{
+	galaxy::fs::Archive archive;
+
+	write(m_archive, "GPAK but not really an archive at all");
+	EXPECT_FALSE(archive.load(m_archive));
+
+	ASSERT_TRUE(galaxy::fs::pack(m_root / "assets", m_archive));
+	std::filesystem::resize_file(m_archive, std::filesystem::file_size(m_archive) - 4);
+	EXPECT_FALSE(archive.load(m_archive));
+	EXPECT_FALSE(archive.is_open());
+
+	EXPECT_FALSE(archive.load(m_root / "missing.gpak"));
+}
+
+TEST_F(ArchiveTest, MountInVirtual)
+{
+	ASSERT_TRUE(galaxy::fs::pack(m_root / "assets", m_archive));
+
+	galaxy::fs::Virtual vfs;
+	ASSERT_TRUE(vfs.mount(m_archive.string()));
+
+	const auto json = vfs.open("data.json");
+	ASSERT_TRUE(json.has_value());
+	EXPECT_EQ(json.value(), m_json);
+
+	const auto png = vfs.view("player.png");
+	ASSERT_TRUE(png.has_value());
+	EXPECT_EQ(png->size(), m_binary.size());
+	EXPECT_EQ(vfs.get_stats().m_archived, 2);
+
+	// Loose files win, so they can be edited without repacking.
+	const auto loose = m_root / "loose";
+	std::filesystem::create_directories(loose);
+	write(loose / "data.json", "{}");
+	ASSERT_TRUE(vfs.mount(loose.string()));
+
+	EXPECT_FALSE(vfs.view("data.json").has_value());
+	EXPECT_EQ(vfs.open("data.json").value(), "{}");
+	EXPECT_TRUE(vfs.view("player.png").has_value());
+}
+
+TEST_F(ArchiveTest, Benchmark)
+{
+	constexpr const int COUNT = 2000;
+
+	const auto assets = m_root / "many";
+	std::filesystem::create_directories(assets);
+	for (int i = 0; i < COUNT; i++)
+	{
+		write(assets / ("file" + std::to_string(i) + ".json"), m_json);
+	}
+
+	ASSERT_TRUE(galaxy::fs::pack(assets, m_archive, false));
+
+	galaxy::fs::Virtual loose;
+	ASSERT_TRUE(loose.mount(assets.string()));
+
+	std::size_t loose_bytes = 0;
+	const auto loose_ms     = time_ms([&]() {
+		for (int i = 0; i < COUNT; i++)
+		{
+			loose_bytes += loose.open_binary("file" + std::to_string(i) + ".json")->size();
+		}
+	});
+
+	galaxy::fs::Virtual packed;
+	std::size_t packed_bytes = 0;
+	const auto packed_ms     = time_ms([&]() {
+		packed.mount(m_archive.string());
+		for (int i = 0; i < COUNT; i++)
+		{
+			packed_bytes += packed.view("file" + std::to_string(i) + ".json")->size();
+		}
+	});
+
+	std::cout << "[ ArchiveBenchmark ] " << COUNT << " files of " << m_json.size() << " bytes. loose open_binary: " << loose_ms << " ms. mount archive and view: " << packed_ms
+			  << " ms.\n";
+
+	EXPECT_EQ(loose_bytes, packed_bytes);
+}
\ No newline at end of file
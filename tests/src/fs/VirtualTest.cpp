@@ -0,0 +1,111 @@
+///
+/// VirtualTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/fs/FileSystem.hpp>
+
+namespace
+{
+	///
+	/// Fresh folder in the system temp directory, removed when the test ends.
+	///
+	class VirtualTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_root = std::filesystem::temp_directory_path() / "galaxy_vfs_test";
+			std::filesystem::remove_all(m_root);
+			std::filesystem::create_directories(m_root / "textures" / "ui");
+
+			write(m_root / "textures" / "player.png");
+			write(m_root / "textures" / "ui" / "button.png");
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_root);
+		}
+
+		void write(const std::filesystem::path& path)
+		{
+			std::ofstream ofs {path};
+			ofs << "data";
+		}
+
+		std::filesystem::path m_root;
+	};
+} // namespace
+
+TEST_F(VirtualTest, MountIndexesEverything)
+{
+	galaxy::fs::Virtual vfs;
+	ASSERT_TRUE(vfs.mount(m_root.string()));
+
+	// Two folders and two files.
+	EXPECT_EQ(vfs.get_stats().m_indexed, 4);
+
+	const auto path = vfs.absolute("button.png");
+	ASSERT_TRUE(path.has_value());
+	EXPECT_TRUE(std::filesystem::equivalent(path.value(), m_root / "textures" / "ui" / "button.png"));
+
+	EXPECT_FALSE(vfs.absolute("missing.png").has_value());
+
+	const auto stats = vfs.get_stats();
+	EXPECT_EQ(stats.m_lookups, 2);
+	EXPECT_EQ(stats.m_hits, 1);
+	EXPECT_EQ(stats.m_misses, 1);
+
+	vfs.reset_stats();
+	EXPECT_EQ(vfs.get_stats().m_lookups, 0);
+	EXPECT_EQ(vfs.get_stats().m_indexed, 4);
+}
+
+TEST_F(VirtualTest, UnwatchedFilesFallBackToDisk)
+{
+	galaxy::fs::Virtual vfs;
+	ASSERT_TRUE(vfs.mount(m_root.string()));
+
+	write(m_root / "late.json");
+
+	EXPECT_TRUE(vfs.absolute("late.json").has_value());
+	EXPECT_TRUE(vfs.absolute("late.json").has_value());
+
+	const auto stats = vfs.get_stats();
+	EXPECT_EQ(stats.m_fallbacks, 1);
+	EXPECT_EQ(stats.m_hits, 1);
+	EXPECT_EQ(stats.m_indexed, 5);
+}
+
+TEST_F(VirtualTest, IndexAndUnindex)
+{
+	galaxy::fs::Virtual vfs;
+	ASSERT_TRUE(vfs.mount(m_root.string()));
+
+	std::filesystem::create_directories(m_root / "maps" / "level1");
+	write(m_root / "maps" / "level1" / "map.tmx");
+	vfs.index(m_root / "maps");
+	EXPECT_EQ(vfs.get_stats().m_indexed, 7);
+
+	// Outside of every mounted folder.
+	vfs.index(std::filesystem::temp_directory_path());
+	EXPECT_EQ(vfs.get_stats().m_indexed, 7);
+
+	// Removing a folder removes everything under it, even once it's gone from disk.
+	std::filesystem::remove_all(m_root / "textures");
+	vfs.unindex(m_root / "textures");
+	EXPECT_EQ(vfs.get_stats().m_indexed, 3);
+	EXPECT_FALSE(vfs.absolute("player.png").has_value());
+	EXPECT_TRUE(vfs.absolute("map.tmx").has_value());
+
+	EXPECT_TRUE(vfs.save("{}", (m_root / "saved.json").string()));
+	EXPECT_EQ(vfs.get_stats().m_indexed, 4);
+	EXPECT_EQ(vfs.get_stats().m_fallbacks, 0);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+///
+/// AtlasBakerTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <stb/stb_image_write.h>
+
+#include <galaxy/graphics/AtlasBaker.hpp>
+
+namespace
+{
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Folder of solid colour pngs. The colour of each is derived from its size, so blits can be checked.
+	///
+	class AtlasBakerTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_root = std::filesystem::temp_directory_path() / "galaxy_atlas_baker_test";
+			std::filesystem::remove_all(m_root);
+			std::filesystem::create_directories(m_root / "textures" / "ui");
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_root);
+		}
+
+		static unsigned char colour(const int width, const int height)
+		{
+			return static_cast<unsigned char>((width * 31 + height * 17) % 255);
+		}
+
+		std::filesystem::path write_png(const std::filesystem::path& path, const int width, const int height)
+		{
+			std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4, colour(width, height));
+			stbi_write_png(path.string().c_str(), width, height, 4, pixels.data(), width * 4);
+
+			return path;
+		}
+
+		std::filesystem::path m_root;
+		galaxy::async::ThreadPool m_pool {4};
+	};
+} // namespace
+
+TEST_F(AtlasBakerTest, PacksAndBlits)
+{
+	std::vector<std::filesystem::path> files;
+	files.push_back(write_png(m_root / "textures" / "wide.png", 40, 10));
+	files.push_back(write_png(m_root / "textures" / "tall.png", 10, 40));
+	files.push_back(write_png(m_root / "textures" / "ui" / "button.png", 16, 16));
+	files.push_back(write_png(m_root / "textures" / "ui" / "wide.png", 8, 8));
+	files.push_back(m_root / "textures" / "missing.png");
+
+	const auto pages = galaxy::graphics::bake_atlas(files, 64, m_pool);
+	ASSERT_EQ(pages.size(), 1);
+
+	// Duplicate name and missing file are skipped. Regions are in name order.
+	const auto& page = pages[0];
+	ASSERT_EQ(page.m_regions.size(), 3);
+	EXPECT_EQ(page.m_regions[0].m_name, "button");
+	EXPECT_EQ(page.m_regions[1].m_name, "tall");
+	EXPECT_EQ(page.m_regions[2].m_name, "wide");
+
+	for (const auto& region : page.m_regions)
+	{
+		const auto& rect = region.m_region;
+		EXPECT_LE(rect.m_x + rect.m_width, page.m_image.m_width);
+		EXPECT_LE(rect.m_y + rect.m_height, page.m_image.m_height);
+
+		for (const auto& other : page.m_regions)
+		{
+			if (&other != &region)
+			{
+				const auto& b = other.m_region;
+				EXPECT_FALSE(rect.m_x < b.m_x + b.m_width && b.m_x < rect.m_x + rect.m_width && rect.m_y < b.m_y + b.m_height && b.m_y < rect.m_y + rect.m_height);
+			}
+		}
+
+		// Opposite corners of each region hold the source colour.
+		const auto expected = colour(rect.m_width, rect.m_height);
+		const auto first    = (static_cast<std::size_t>(rect.m_y) * page.m_image.m_width + rect.m_x) * 4;
+		const auto last     = (static_cast<std::size_t>(rect.m_y + rect.m_height - 1) * page.m_image.m_width + rect.m_x + rect.m_width - 1) * 4;
+		EXPECT_EQ(page.m_image.m_pixels[first], expected);
+		EXPECT_EQ(page.m_image.m_pixels[last + 3], expected);
+	}
+
+	// Trimmed to the area in use.
+	EXPECT_LE(page.m_image.m_width, 64);
+	EXPECT_LE(page.m_image.m_height, 64);
+	EXPECT_EQ(page.m_image.m_pixels.size(), static_cast<std::size_t>(page.m_image.m_width) * page.m_image.m_height * 4);
+}
+
+TEST_F(AtlasBakerTest, OverflowsToNewPages)
+{
+	std::vector<std::filesystem::path> files;
+	for (int i = 0; i < 5; i++)
+	{
+		files.push_back(write_png(m_root / "textures" / ("block" + std::to_string(i) + ".png"), 32, 32));
+	}
+
+	files.push_back(write_png(m_root / "textures" / "huge.png", 128, 128));
+
+	// Four blocks fill a page, the fifth starts another, and the huge one fits nowhere.
+	const auto pages = galaxy::graphics::bake_atlas(files, 64, m_pool);
+	ASSERT_EQ(pages.size(), 2);
+	EXPECT_EQ(pages[0].m_regions.size(), 4);
+	EXPECT_EQ(pages[1].m_regions.size(), 1);
+	EXPECT_EQ(pages[1].m_image.m_width, 32);
+}
+
+TEST_F(AtlasBakerTest, WritesManifest)
+{
+	write_png(m_root / "textures" / "player.png", 24, 32);
+	write_png(m_root / "textures" / "ui" / "button.png", 16, 8);
+
+	std::ofstream {m_root / "textures" / "notes.txt"} << "not an image";
+
+	const auto manifest = m_root / "textures" / "atlas.json";
+	ASSERT_TRUE(galaxy::graphics::bake_atlas(m_root / "textures", manifest, 256, m_pool));
+
+	std::ifstream ifs {manifest};
+	const auto json = nlohmann::json::parse(ifs);
+	EXPECT_EQ(json.at("size"), 256);
+	ASSERT_EQ(json.at("pages").size(), 1);
+
+	const auto& page = json.at("pages")[0];
+	EXPECT_EQ(page.at("image"), "atlas_0.png");
+	EXPECT_TRUE(std::filesystem::exists(m_root / "textures" / "atlas_0.png"));
+	EXPECT_EQ(page.at("textures").size(), 2);
+	EXPECT_EQ(page.at("textures").at("player").at("width"), 24);
+	EXPECT_EQ(page.at("textures").at("button").at("height"), 8);
+
+	// Baking again skips the pages from the first bake, so the output is the same.
+	ASSERT_TRUE(galaxy::graphics::bake_atlas(m_root / "textures", manifest, 256, m_pool));
+
+	std::ifstream again {manifest};
+	EXPECT_EQ(nlohmann::json::parse(again), json);
+
+	EXPECT_FALSE(galaxy::graphics::bake_atlas(m_root / "missing", manifest, 256, m_pool));
+}
+
+TEST_F(AtlasBakerTest, Benchmark)
+{
+	constexpr const int COUNT = 400;
+
+	std::vector<std::filesystem::path> files;
+	for (int i = 0; i < COUNT; i++)
+	{
+		files.push_back(write_png(m_root / "textures" / ("sprite" + std::to_string(i) + ".png"), 16 + (i % 7) * 8, 16 + (i % 5) * 8));
+	}
+
+	galaxy::async::ThreadPool single {1};
+
+	std::size_t single_pages = 0;
+	const auto single_ms     = time_ms([&]() {
+		single_pages = galaxy::graphics::bake_atlas(files, 1024, single).size();
+	});
+
+	std::size_t pool_pages = 0;
+	const auto pool_ms     = time_ms([&]() {
+		pool_pages = galaxy::graphics::bake_atlas(files, 1024, m_pool).size();
+	});
+
+	std::cout << "[ AtlasBakerBenchmark ] " << COUNT << " textures into " << pool_pages << " pages. 1 worker: " << single_ms << " ms. " << m_pool.get_thread_count()
+			  << " workers: " << pool_ms << " ms.\n";
+
+	EXPECT_EQ(single_pages, pool_pages);
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+///
+/// RenderQueueTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/graphics/RenderQueue.hpp>
+
+namespace
+{
+	///
+	/// Records every call as a string.
+	///
+	class MockDevice final : public galaxy::graphics::RenderDevice
+	{
+	public:
+		void bind_shader(const galaxy::graphics::RenderShader shader) override
+		{
+			m_calls.push_back("shader " + std::to_string(static_cast<int>(shader)));
+		}
+
+		void upload_uniforms(const galaxy::graphics::RenderShader shader, const galaxy::graphics::RenderUniforms& uniforms) override
+		{
+			m_calls.push_back("uniforms " + std::to_string(static_cast<int>(uniforms.m_width)));
+		}
+
+		void bind_texture(const unsigned int texture) override
+		{
+			m_calls.push_back("texture " + std::to_string(texture));
+		}
+
+		void bind_vao(const unsigned int vao) override
+		{
+			m_calls.push_back("vao " + std::to_string(vao));
+		}
+
+		void draw(const galaxy::graphics::RenderCommand& command) override
+		{
+			m_calls.push_back("draw " + std::to_string(command.m_index_count));
+		}
+
+		void reset() override
+		{
+			m_calls.push_back("reset");
+		}
+
+		std::vector<std::string> m_calls;
+	};
+
+	galaxy::graphics::RenderCommand make_command(const int layer, const galaxy::graphics::RenderShader shader, const unsigned int texture, const int id)
+	{
+		galaxy::graphics::RenderCommand command;
+		command.m_key         = galaxy::graphics::RenderCommand::make_key(layer, shader, texture, 0);
+		command.m_shader      = shader;
+		command.m_texture     = texture;
+		command.m_vao         = texture;
+		command.m_index_count = id;
+
+		return command;
+	}
+} // namespace
+
+TEST(RenderQueue, KeyOrdersLayerThenShaderThenTextureThenDepth)
+{
+	using galaxy::graphics::RenderCommand;
+	using galaxy::graphics::RenderShader;
+
+	EXPECT_LT(RenderCommand::make_key(-5, RenderShader::INSTANCE, 99, 99), RenderCommand::make_key(0, RenderShader::POINT, 0, 0));
+	EXPECT_LT(RenderCommand::make_key(1, RenderShader::POINT, 99, 99), RenderCommand::make_key(1, RenderShader::TEXT, 0, 0));
+	EXPECT_LT(RenderCommand::make_key(1, RenderShader::TEXT, 1, 99), RenderCommand::make_key(1, RenderShader::TEXT, 2, 0));
+	EXPECT_LT(RenderCommand::make_key(1, RenderShader::TEXT, 1, 1), RenderCommand::make_key(1, RenderShader::TEXT, 1, 2));
+}
+
+TEST(RenderQueue, SortMatchesStableSort)
+{
+	galaxy::graphics::RenderQueue queue;
+
+	std::mt19937_64 rng {1234};
+	std::vector<std::uint64_t> keys;
+
+	for (int i = 0; i < 5000; i++)
+	{
+		// Narrow key range so there are plenty of duplicates.
+		galaxy::graphics::RenderCommand command;
+		command.m_key = rng() % 64 | ((rng() % 4) << 48);
+
+		keys.push_back(command.m_key);
+		queue.submit(command);
+	}
+
+	queue.sort();
+
+	std::vector<std::uint32_t> expected(keys.size());
+	for (std::uint32_t i = 0; i < expected.size(); i++)
+	{
+		expected[i] = i;
+	}
+
+	std::stable_sort(expected.begin(), expected.end(), [&](const auto left, const auto right) {
+		return keys[left] < keys[right];
+	});
+
+	EXPECT_EQ(queue.get_order(), expected);
+}
+
+TEST(RenderQueue, SortsAcrossLayers)
+{
+	galaxy::graphics::RenderQueue queue;
+	queue.submit(make_command(2, galaxy::graphics::RenderShader::SPRITE, 1, 0));
+	queue.submit(make_command(-1, galaxy::graphics::RenderShader::SPRITE, 1, 1));
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::BATCH, 1, 2));
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::POINT, 1, 3));
+
+	queue.sort();
+
+	const std::vector<std::uint32_t> expected = {1, 3, 2, 0};
+	EXPECT_EQ(queue.get_order(), expected);
+}
+
+TEST(RenderQueue, DepthOrdersWithinLayerAndTexture)
+{
+	using galaxy::graphics::RenderCommand;
+
+	EXPECT_LT(RenderCommand::make_depth(-40000.0f), RenderCommand::make_depth(-10.0f));
+	EXPECT_LT(RenderCommand::make_depth(-10.0f), RenderCommand::make_depth(0.0f));
+	EXPECT_LT(RenderCommand::make_depth(0.0f), RenderCommand::make_depth(250.0f));
+	EXPECT_EQ(RenderCommand::make_depth(40000.0f), 0xFFFF);
+
+	// Same layer, shader and texture, submitted out of order. The lowest on screen draws last.
+	galaxy::graphics::RenderQueue queue;
+	for (const auto [id, bottom] : {std::pair {0, 300.0f}, std::pair {1, -20.0f}, std::pair {2, 100.0f}, std::pair {3, 100.0f}})
+	{
+		auto command  = make_command(1, galaxy::graphics::RenderShader::SPRITE, 7, id);
+		command.m_key = RenderCommand::make_key(1, galaxy::graphics::RenderShader::SPRITE, 7, RenderCommand::make_depth(bottom));
+
+		queue.submit(command);
+	}
+
+	queue.sort();
+
+	// Equal depths keep submission order.
+	const std::vector<std::uint32_t> expected = {1, 2, 3, 0};
+	EXPECT_EQ(queue.get_order(), expected);
+
+	MockDevice device;
+	queue.execute(device);
+
+	// Depth only reorders draws, the texture is still bound once.
+	EXPECT_EQ(std::count(device.m_calls.begin(), device.m_calls.end(), "texture 7"), 1);
+}
+
+TEST(RenderQueue, ExecuteSkipsRedundantState)
+{
+	galaxy::graphics::RenderQueue queue;
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::SPRITE, 2, 1));
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::SPRITE, 1, 2));
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::SPRITE, 1, 3));
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::TEXT, 1, 4));
+
+	queue.sort();
+
+	MockDevice device;
+	queue.execute(device);
+
+	// Text sorts before sprites. The texture and vertex array bound for text carry over to the first sprite.
+	const std::vector<std::string> expected = {
+		"shader 1",
+		"uniforms 0",
+		"texture 1",
+		"vao 1",
+		"draw 4",
+		"shader 2",
+		"uniforms 0",
+		"draw 2",
+		"draw 3",
+		"texture 2",
+		"vao 2",
+		"draw 1",
+		"reset",
+	};
+
+	EXPECT_EQ(device.m_calls, expected);
+
+	const auto& stats = queue.get_stats();
+	EXPECT_EQ(stats.m_draws, 4);
+	EXPECT_EQ(stats.m_shader_binds, 2);
+	EXPECT_EQ(stats.m_uniform_uploads, 2);
+	EXPECT_EQ(stats.m_texture_binds, 2);
+	EXPECT_EQ(stats.m_vao_binds, 2);
+}
+
+TEST(RenderQueue, UniformsTrackedPerShader)
+{
+	galaxy::graphics::RenderQueue queue;
+
+	auto a = make_command(0, galaxy::graphics::RenderShader::SPRITE, 1, 1);
+	auto b = make_command(0, galaxy::graphics::RenderShader::SPRITE, 1, 2);
+	auto c = make_command(1, galaxy::graphics::RenderShader::TEXT, 1, 3);
+	auto d = make_command(2, galaxy::graphics::RenderShader::SPRITE, 1, 4);
+
+	a.m_uniforms.m_width = 10.0f;
+	b.m_uniforms.m_width = 20.0f;
+	c.m_uniforms.m_width = 20.0f;
+	d.m_uniforms.m_width = 20.0f;
+
+	queue.submit(a);
+	queue.submit(b);
+	queue.submit(c);
+	queue.submit(d);
+	queue.sort();
+
+	MockDevice device;
+	queue.execute(device);
+
+	// d switches back to the sprite shader, which still holds b's values, so only the bind is needed.
+	EXPECT_EQ(std::count(device.m_calls.begin(), device.m_calls.end(), "uniforms 20"), 2);
+	EXPECT_EQ(std::count(device.m_calls.begin(), device.m_calls.end(), "uniforms 10"), 1);
+	EXPECT_EQ(queue.get_stats().m_shader_binds, 3);
+}
+
+TEST(RenderQueue, ClearEmptiesQueue)
+{
+	galaxy::graphics::RenderQueue queue;
+	queue.submit(make_command(0, galaxy::graphics::RenderShader::SPRITE, 1, 1));
+	queue.clear();
+
+	MockDevice device;
+	queue.sort();
+	queue.execute(device);
+
+	EXPECT_TRUE(queue.get_commands().empty());
+	EXPECT_TRUE(device.m_calls.empty());
+}
\ No newline at end of file
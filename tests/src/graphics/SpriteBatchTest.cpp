@@ -0,0 +1,123 @@
+///
+/// SpriteBatchTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <deque>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <gtest/gtest.h>
+
+#include <galaxy/components/BatchSprite.hpp>
+#include <galaxy/components/Transform2D.hpp>
+#include <galaxy/graphics/SpriteBatch.hpp>
+
+namespace
+{
+	///
+	/// Hidden window with an OpenGL 4.5 context. Tests are skipped when there is no display or driver.
+	///
+	class SpriteBatchTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			if (!glfwInit())
+			{
+				GTEST_SKIP() << "No display available for an OpenGL context.";
+			}
+
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+			m_window = glfwCreateWindow(16, 16, "SpriteBatchTest", nullptr, nullptr);
+			if (m_window == nullptr)
+			{
+				GTEST_SKIP() << "OpenGL 4.5 is not available.";
+			}
+
+			glfwMakeContextCurrent(m_window);
+			if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+			{
+				GTEST_SKIP() << "Failed to load OpenGL functions.";
+			}
+		}
+
+		void TearDown() override
+		{
+			if (m_window != nullptr)
+			{
+				glfwDestroyWindow(m_window);
+				m_window = nullptr;
+			}
+
+			glfwTerminate();
+		}
+
+		///
+		/// Add quads to a batch.
+		///
+		void add(galaxy::graphics::SpriteBatch& batch, const int count)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				m_sprites.emplace_back().create({0.0f, 0.0f, 16.0f, 16.0f}, "default");
+				batch.add(&m_sprites.back(), &m_transform);
+			}
+		}
+
+		///
+		/// Buffer the first attribute of a vertex array reads from, or 0 if it is not enabled.
+		///
+		static GLint attribute_buffer(const unsigned int vao)
+		{
+			GLint enabled = GL_FALSE;
+			glGetVertexArrayIndexediv(vao, 0, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+
+			GLint buffer = 0;
+			glGetVertexArrayIndexediv(vao, 0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+
+			return enabled ? buffer : 0;
+		}
+
+		GLFWwindow* m_window = nullptr;
+		std::deque<galaxy::components::BatchSprite> m_sprites;
+		galaxy::components::Transform2D m_transform;
+	};
+} // namespace
+
+TEST_F(SpriteBatchTest, MovedBatchKeepsLayoutWhenGrowing)
+{
+	galaxy::graphics::SpriteBatch original;
+	galaxy::graphics::SpriteBatch batch {std::move(original)};
+
+	// First add maps storage and specifies attributes on the moved vertex array.
+	add(batch, 1);
+
+	const auto first = attribute_buffer(batch.vao());
+	ASSERT_NE(first, 0);
+
+	for (GLuint index = 0; index < 3; index++)
+	{
+		GLint enabled = GL_FALSE;
+		glGetVertexArrayIndexediv(batch.vao(), index, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+		EXPECT_EQ(enabled, GL_TRUE);
+	}
+
+	// Past the initial storage, so vertices move to a new buffer.
+	const auto reserved = batch.reserved_bytes();
+	add(batch, 200);
+	ASSERT_GT(batch.reserved_bytes(), reserved);
+
+	const auto grown = attribute_buffer(batch.vao());
+	EXPECT_NE(grown, 0);
+	EXPECT_NE(grown, first);
+	EXPECT_EQ(glIsBuffer(static_cast<GLuint>(grown)), GL_TRUE);
+	EXPECT_EQ(batch.count(), 6 * 201);
+}
\ No newline at end of file
@@ -0,0 +1,395 @@
+///
+/// StreamBufferTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/graphics/StreamBuffer.hpp>
+
+namespace
+{
+	///
+	/// Records calls and hands out fences whose signaled state is controlled by the test.
+	///
+	class MockBackend final : public galaxy::graphics::StreamBackend
+	{
+	public:
+		struct State
+		{
+			std::vector<std::vector<std::byte>> m_storage;
+			std::vector<bool> m_signaled;
+			int m_live_fences   = 0;
+			int m_live_mappings = 0;
+			int m_waits         = 0;
+		};
+
+		MockBackend(State& state)
+		    : m_state {state}
+		{
+		}
+
+		std::byte* map(const std::size_t size) override
+		{
+			m_state.m_storage.emplace_back(size);
+			m_state.m_live_mappings++;
+
+			return m_state.m_storage.back().data();
+		}
+
+		void unmap(std::byte* mapped) noexcept override
+		{
+			m_state.m_live_mappings--;
+		}
+
+		const unsigned int id() const noexcept override
+		{
+			return static_cast<unsigned int>(m_state.m_storage.size());
+		}
+
+		void* fence() override
+		{
+			m_state.m_signaled.push_back(false);
+			m_state.m_live_fences++;
+
+			// Fence handles are 1-based indices into m_signaled.
+			return reinterpret_cast<void*>(m_state.m_signaled.size());
+		}
+
+		const bool wait(void* fence) override
+		{
+			const auto index   = reinterpret_cast<std::size_t>(fence) - 1;
+			const bool stalled = !m_state.m_signaled[index];
+
+			m_state.m_signaled[index] = true;
+			m_state.m_waits++;
+
+			return stalled;
+		}
+
+		void destroy_fence(void* fence) noexcept override
+		{
+			m_state.m_live_fences--;
+		}
+
+	private:
+		State& m_state;
+	};
+
+	constexpr const std::size_t SEGMENT = 256;
+} // namespace
+
+TEST(StreamBuffer, MapsOnFirstAllocate)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+	EXPECT_FALSE(stream.is_mapped());
+	EXPECT_EQ(stream.get_reserved(), 0);
+	EXPECT_EQ(stream.get_id(), 0);
+
+	auto* ptr = stream.allocate(16);
+
+	ASSERT_EQ(state.m_storage.size(), 1);
+	EXPECT_EQ(ptr, state.m_storage[0].data());
+	EXPECT_EQ(state.m_storage[0].size(), SEGMENT * galaxy::graphics::StreamBuffer::SEGMENTS);
+	EXPECT_EQ(stream.get_reserved(), SEGMENT * galaxy::graphics::StreamBuffer::SEGMENTS);
+	EXPECT_EQ(stream.get_id(), 1);
+}
+
+TEST(StreamBuffer, AllocateWithinSegment)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+	auto* first  = stream.allocate(64);
+	auto* second = stream.allocate(64);
+
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(second, first + 64);
+	EXPECT_EQ(stream.get_used(), 128);
+
+	EXPECT_NE(stream.allocate(128), nullptr);
+	EXPECT_EQ(stream.allocate(1), nullptr);
+	EXPECT_EQ(stream.get_used(), SEGMENT);
+}
+
+TEST(StreamBuffer, GrowKeepsFrameData)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT * 4);
+
+	// Move off segment 0 so the carried over data has to land at the new segment offset.
+	static_cast<void>(stream.allocate(16));
+	stream.begin();
+
+	for (std::size_t i = 0; i < SEGMENT; i++)
+	{
+		*stream.allocate(1) = static_cast<std::byte>(i);
+	}
+
+	auto* ptr = stream.allocate(SEGMENT + 1);
+
+	ASSERT_NE(ptr, nullptr);
+	EXPECT_EQ(stream.get_segment_size(), SEGMENT * 4);
+	EXPECT_EQ(stream.get_id(), 2);
+	EXPECT_EQ(state.m_live_mappings, 1);
+	EXPECT_EQ(state.m_live_fences, 0);
+
+	const auto* segment = state.m_storage[1].data() + stream.get_segment_offset();
+	for (std::size_t i = 0; i < SEGMENT; i++)
+	{
+		EXPECT_EQ(segment[i], static_cast<std::byte>(i));
+	}
+
+	EXPECT_EQ(ptr, segment + SEGMENT);
+	EXPECT_EQ(stream.allocate(SEGMENT * 4), nullptr);
+}
+
+TEST(StreamBuffer, ShrinkAfterIdleFrames)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT * 8);
+
+	static_cast<void>(stream.allocate(SEGMENT * 8));
+	EXPECT_EQ(stream.get_segment_size(), SEGMENT * 8);
+
+	const auto reserved = galaxy::graphics::StreamBuffer::get_total_reserved();
+
+	for (std::size_t frame = 0; frame < galaxy::graphics::StreamBuffer::SHRINK_FRAMES; frame++)
+	{
+		stream.begin();
+		static_cast<void>(stream.allocate(SEGMENT));
+	}
+
+	EXPECT_EQ(stream.get_segment_size(), SEGMENT * 8);
+
+	stream.begin();
+
+	// Peak was SEGMENT, so shrink to the smallest size with double that.
+	EXPECT_EQ(stream.get_segment_size(), SEGMENT * 2);
+	EXPECT_EQ(state.m_live_mappings, 1);
+	EXPECT_EQ(galaxy::graphics::StreamBuffer::get_total_reserved(), reserved - (SEGMENT * 6 * galaxy::graphics::StreamBuffer::SEGMENTS));
+}
+
+TEST(StreamBuffer, BusyFramesDoNotShrink)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT * 8);
+
+	static_cast<void>(stream.allocate(SEGMENT * 8));
+
+	for (std::size_t frame = 0; frame < galaxy::graphics::StreamBuffer::SHRINK_FRAMES * 2; frame++)
+	{
+		stream.begin();
+		static_cast<void>(stream.allocate(frame % 10 == 0 ? SEGMENT * 4 : 16));
+	}
+
+	EXPECT_EQ(stream.get_segment_size(), SEGMENT * 8);
+}
+
+TEST(StreamBuffer, ReleaseWhenUnused)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT * 4);
+
+	const auto reserved = galaxy::graphics::StreamBuffer::get_total_reserved();
+	static_cast<void>(stream.allocate(16));
+
+	// The first window saw a write. Storage is only released after a whole window without one.
+	for (std::size_t frame = 0; frame < galaxy::graphics::StreamBuffer::SHRINK_FRAMES * 2; frame++)
+	{
+		stream.begin();
+	}
+
+	EXPECT_FALSE(stream.is_mapped());
+	EXPECT_EQ(state.m_live_mappings, 0);
+	EXPECT_EQ(state.m_live_fences, 0);
+	EXPECT_EQ(galaxy::graphics::StreamBuffer::get_total_reserved(), reserved);
+
+	// Maps again on demand.
+	EXPECT_NE(stream.allocate(16), nullptr);
+	EXPECT_EQ(stream.get_reserved(), SEGMENT * galaxy::graphics::StreamBuffer::SEGMENTS);
+}
+
+TEST(StreamBuffer, BeginAdvancesSegments)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+	for (std::size_t frame = 0; frame < 7; frame++)
+	{
+		const auto expected = frame % galaxy::graphics::StreamBuffer::SEGMENTS;
+		auto* ptr = stream.allocate(16);
+
+		EXPECT_EQ(stream.get_segment(), expected);
+		EXPECT_EQ(stream.get_segment_offset(), expected * SEGMENT);
+		EXPECT_EQ(ptr, state.m_storage[0].data() + (expected * SEGMENT));
+
+		stream.begin();
+		EXPECT_EQ(stream.get_used(), 0);
+	}
+
+	EXPECT_EQ(stream.get_total_bytes(), 7 * 16);
+}
+
+TEST(StreamBuffer, FencesGuardReuse)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+	// Use segments 0 and 1. Nothing to wait on yet.
+	for (int i = 0; i < 2; i++)
+	{
+		static_cast<void>(stream.allocate(16));
+		stream.begin();
+	}
+
+	EXPECT_EQ(state.m_waits, 0);
+	EXPECT_EQ(state.m_live_fences, 2);
+
+	// Wrapping back to segment 0 waits on the fence from its previous use. GPU has not finished so it stalls.
+	static_cast<void>(stream.allocate(16));
+	stream.begin();
+
+	EXPECT_EQ(stream.get_segment(), 0);
+	EXPECT_EQ(state.m_waits, 1);
+	EXPECT_EQ(stream.get_stalls(), 1);
+	EXPECT_EQ(state.m_live_fences, 2);
+
+	// Segment 1 was signaled before we reach it, so no stall.
+	state.m_signaled[1] = true;
+	static_cast<void>(stream.allocate(16));
+	stream.begin();
+
+	EXPECT_EQ(state.m_waits, 2);
+	EXPECT_EQ(stream.get_stalls(), 1);
+}
+
+TEST(StreamBuffer, EmptySegmentsAreNotFenced)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+	for (int i = 0; i < 6; i++)
+	{
+		stream.begin();
+	}
+
+	EXPECT_TRUE(state.m_signaled.empty());
+	EXPECT_EQ(state.m_waits, 0);
+}
+
+TEST(StreamBuffer, DestroyReleasesFences)
+{
+	MockBackend::State state;
+
+	{
+		galaxy::graphics::StreamBuffer stream;
+		stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+
+		static_cast<void>(stream.allocate(16));
+		stream.begin();
+		static_cast<void>(stream.allocate(16));
+		stream.begin();
+	}
+
+	EXPECT_EQ(state.m_live_fences, 0);
+	EXPECT_EQ(state.m_live_mappings, 0);
+}
+
+TEST(StreamBuffer, MoveKeepsMapping)
+{
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), SEGMENT, SEGMENT);
+	static_cast<void>(stream.allocate(32));
+
+	galaxy::graphics::StreamBuffer moved {std::move(stream)};
+
+	EXPECT_FALSE(stream.is_mapped());
+	EXPECT_TRUE(moved.is_mapped());
+	EXPECT_EQ(moved.get_used(), 32);
+	EXPECT_EQ(state.m_live_mappings, 1);
+}
+
+TEST(StreamBuffer, BytesPerFrameBenchmark)
+{
+	// 20k quads of 4 vertices, 10 floats each. Same layout as graphics::Vertex.
+	constexpr const std::size_t quads  = 20'000;
+	constexpr const std::size_t quad   = sizeof(float) * 10 * 4;
+	constexpr const std::size_t frames = 60;
+
+	float data[40];
+	for (int i = 0; i < 40; i++)
+	{
+		data[i] = static_cast<float>(i);
+	}
+
+	// Old path. Build into a CPU vector then copy the whole thing into driver memory each frame.
+	std::vector<std::byte> staging;
+	std::vector<std::byte> driver(quads * quad);
+	staging.reserve(quads * quad);
+
+	const auto copy_start = std::chrono::steady_clock::now();
+	for (std::size_t frame = 0; frame < frames; frame++)
+	{
+		staging.clear();
+		for (std::size_t i = 0; i < quads; i++)
+		{
+			const auto* bytes = reinterpret_cast<const std::byte*>(data);
+			staging.insert(staging.end(), bytes, bytes + quad);
+		}
+
+		std::memcpy(driver.data(), staging.data(), staging.size());
+	}
+	const auto copy_end = std::chrono::steady_clock::now();
+
+	// Ring path. Write straight into mapped memory.
+	MockBackend::State state;
+	galaxy::graphics::StreamBuffer stream;
+	stream.create(std::make_unique<MockBackend>(state), quads * quad, quads * quad);
+
+	std::size_t per_frame = 0;
+
+	const auto ring_start = std::chrono::steady_clock::now();
+	for (std::size_t frame = 0; frame < frames; frame++)
+	{
+		stream.begin();
+		for (std::size_t i = 0; i < quads; i++)
+		{
+			std::memcpy(stream.allocate(quad), data, quad);
+		}
+
+		per_frame = stream.get_used();
+
+		// Pretend the GPU keeps up.
+		state.m_signaled.assign(state.m_signaled.size(), true);
+	}
+	const auto ring_end = std::chrono::steady_clock::now();
+
+	const auto copy_ms = std::chrono::duration<double, std::milli>(copy_end - copy_start).count() / frames;
+	const auto ring_ms = std::chrono::duration<double, std::milli>(ring_end - ring_start).count() / frames;
+
+	std::cout << "[ StreamBufferBenchmark ] " << per_frame << " bytes/frame. copy: " << copy_ms << " ms/frame, ring: " << ring_ms << " ms/frame.\n";
+
+	EXPECT_EQ(per_frame, quads * quad);
+	EXPECT_EQ(stream.get_total_bytes(), frames * quads * quad);
+	EXPECT_EQ(stream.get_stalls(), 0);
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+///
+/// QuadTreeBenchmark.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/math/QuadTree.hpp>
+
+namespace
+{
+	constexpr const int FRAMES = 60;
+
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Simulates RenderSystem2D culling a scrolling 1280x720 camera over a map of sprites,
+	/// with a tenth of the sprites moving each frame.
+	///
+	void run(const int count)
+	{
+		const auto world = std::sqrt(static_cast<float>(count)) * 32.0f;
+
+		std::mt19937 gen {1};
+		std::uniform_real_distribution<float> pos {0.0f, world};
+		std::uniform_real_distribution<float> size {8.0f, 64.0f};
+		std::uniform_real_distribution<float> step {-4.0f, 4.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {size(gen), size(gen)});
+		}
+
+		galaxy::math::Quadtree tree {{0.0f, 0.0f, world, world}};
+		const auto build = time_ms([&]() {
+			for (int i = 0; i < count; i++)
+			{
+				tree.insert(i, boxes[i], galaxy::graphics::Renderables::SPRITE);
+			}
+		});
+
+		std::vector<galaxy::math::Quadtree::Object> output;
+		output.reserve(count);
+
+		std::size_t tree_hits  = 0;
+		std::size_t brute_hits = 0;
+		double update          = 0.0;
+		double query           = 0.0;
+		double brute           = 0.0;
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			for (int i = frame % 10; i < count; i += 10)
+			{
+				const glm::vec2 offset = {step(gen), step(gen)};
+				boxes[i]               = {boxes[i].min() + offset, boxes[i].max() + offset};
+			}
+
+			update += time_ms([&]() {
+				for (int i = 0; i < count; i++)
+				{
+					tree.update(i, boxes[i], galaxy::graphics::Renderables::SPRITE);
+				}
+			});
+
+			const glm::vec2 camera = {(world - 1280.0f) * frame / FRAMES, (world - 720.0f) * 0.5f};
+			const galaxy::math::AABB view {camera, camera + glm::vec2 {1280.0f, 720.0f}};
+
+			query += time_ms([&]() {
+				output.clear();
+				tree.query(view, output);
+			});
+			tree_hits += output.size();
+
+			brute += time_ms([&]() {
+				for (const auto& box : boxes)
+				{
+					brute_hits += box.overlaps(view, true);
+				}
+			});
+		}
+
+		std::cout << "[ QuadTreeBenchmark ] " << count << " renderables. insert: " << build << " ms. per frame, update: " << update / FRAMES << " ms, cull: " << query / FRAMES
+				  << " ms, brute force cull: " << brute / FRAMES << " ms (" << tree_hits / FRAMES << " visible).\n";
+
+		EXPECT_EQ(tree_hits, brute_hits);
+	}
+} // namespace
+
+TEST(QuadTreeBenchmark, TenThousand)
+{
+	run(10'000);
+}
+
+TEST(QuadTreeBenchmark, OneHundredThousand)
+{
+	run(100'000);
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+///
+/// QuadTreeTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/math/QuadTree.hpp>
+
+namespace
+{
+	constexpr const auto TYPE = galaxy::graphics::Renderables::SPRITE;
+
+	///
+	/// Boxes scattered over and slightly past a square world.
+	///
+	std::vector<galaxy::math::AABB> make_boxes(const int count, const float world, const unsigned int seed)
+	{
+		std::mt19937 gen {seed};
+		std::uniform_real_distribution<float> pos {-64.0f, world + 64.0f};
+		std::uniform_real_distribution<float> size {1.0f, 96.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {size(gen), size(gen)});
+		}
+
+		return boxes;
+	}
+
+	///
+	/// Sorted entities from a query.
+	///
+	std::vector<galaxy::ecs::Entity> query(const galaxy::math::Quadtree& tree, const galaxy::math::AABB& aabb)
+	{
+		std::vector<galaxy::math::Quadtree::Object> output;
+		tree.query(aabb, output);
+
+		std::vector<galaxy::ecs::Entity> result;
+		for (const auto& object : output)
+		{
+			result.push_back(object.m_entity);
+		}
+
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	///
+	/// Sorted entities of boxes overlapping an area, found by testing every box.
+	///
+	std::vector<galaxy::ecs::Entity> brute_force(const std::vector<galaxy::math::AABB>& boxes, const galaxy::math::AABB& aabb)
+	{
+		std::vector<galaxy::ecs::Entity> result;
+		for (std::size_t i = 0; i < boxes.size(); i++)
+		{
+			if (boxes[i].overlaps(aabb, true))
+			{
+				result.push_back(i);
+			}
+		}
+
+		return result;
+	}
+} // namespace
+
+TEST(Quadtree, QueryMatchesBruteForce)
+{
+	const auto boxes   = make_boxes(2000, 1024.0f, 1);
+	const auto queries = make_boxes(100, 1024.0f, 2);
+
+	galaxy::math::Quadtree tree {{0.0f, 0.0f, 1024.0f, 1024.0f}};
+	for (std::size_t i = 0; i < boxes.size(); i++)
+	{
+		tree.insert(i, boxes[i], TYPE);
+	}
+
+	ASSERT_EQ(tree.size(), boxes.size());
+	for (const auto& aabb : queries)
+	{
+		EXPECT_EQ(query(tree, aabb), brute_force(boxes, aabb));
+	}
+}
+
+TEST(Quadtree, UpdateMovesObjects)
+{
+	auto boxes         = make_boxes(1000, 512.0f, 3);
+	const auto targets = make_boxes(1000, 512.0f, 4);
+
+	galaxy::math::Quadtree tree {{0.0f, 0.0f, 512.0f, 512.0f}, 4};
+	for (std::size_t i = 0; i < boxes.size(); i++)
+	{
+		tree.insert(i, boxes[i], TYPE);
+	}
+
+	for (std::size_t i = 0; i < boxes.size(); i += 2)
+	{
+		boxes[i] = targets[i];
+		EXPECT_TRUE(tree.update(i, boxes[i], TYPE));
+	}
+
+	EXPECT_FALSE(tree.update(boxes.size(), boxes[0], TYPE));
+	EXPECT_EQ(tree.size(), boxes.size());
+
+	for (const auto& aabb : make_boxes(50, 512.0f, 5))
+	{
+		EXPECT_EQ(query(tree, aabb), brute_force(boxes, aabb));
+	}
+}
+
+TEST(Quadtree, EraseRemovesObjects)
+{
+	const auto boxes = make_boxes(500, 256.0f, 6);
+
+	galaxy::math::Quadtree tree {{0.0f, 0.0f, 256.0f, 256.0f}};
+	for (std::size_t i = 0; i < boxes.size(); i++)
+	{
+		tree.insert(i, boxes[i], TYPE);
+	}
+
+	tree.erase(0);
+	tree.erase_if([](const galaxy::ecs::Entity entity) {
+		return entity % 2 == 1;
+	});
+
+	EXPECT_FALSE(tree.contains(0));
+	EXPECT_FALSE(tree.contains(1));
+	EXPECT_TRUE(tree.contains(2));
+	EXPECT_EQ(tree.size(), 249);
+
+	const galaxy::math::AABB all {{-1000.0f, -1000.0f}, {1000.0f, 1000.0f}};
+	const auto result = query(tree, all);
+
+	ASSERT_EQ(result.size(), 249);
+	for (const auto entity : result)
+	{
+		EXPECT_EQ(entity % 2, 0);
+		EXPECT_NE(entity, 0);
+	}
+
+	// Freed items are reused.
+	tree.insert(1, boxes[1], TYPE);
+	EXPECT_EQ(query(tree, boxes[1]).front(), 1);
+}
+
+TEST(Quadtree, ResizeKeepsObjects)
+{
+	const auto boxes = make_boxes(500, 2048.0f, 7);
+
+	galaxy::math::Quadtree tree {{0.0f, 0.0f, 0.0f, 0.0f}};
+	for (std::size_t i = 0; i < boxes.size(); i++)
+	{
+		tree.insert(i, boxes[i], TYPE);
+	}
+
+	const galaxy::math::AABB view {{100.0f, 100.0f}, {900.0f, 700.0f}};
+	EXPECT_EQ(query(tree, view), brute_force(boxes, view));
+
+	tree.resize(2048, 2048);
+	EXPECT_EQ(query(tree, view), brute_force(boxes, view));
+
+	tree.resize(640, 480);
+	EXPECT_EQ(query(tree, view), brute_force(boxes, view));
+}
+
+TEST(Quadtree, UpdateStoresType)
+{
+	galaxy::math::Quadtree tree {{0.0f, 0.0f, 100.0f, 100.0f}};
+
+	const galaxy::math::AABB box {{10.0f, 10.0f}, {20.0f, 20.0f}};
+	tree.insert(7, box, galaxy::graphics::Renderables::SPRITE);
+	tree.insert(7, box, galaxy::graphics::Renderables::TEXT);
+
+	std::vector<galaxy::math::Quadtree::Object> output;
+	tree.query(box, output);
+
+	ASSERT_EQ(output.size(), 1);
+	EXPECT_EQ(output[0].m_entity, 7);
+	EXPECT_EQ(output[0].m_type, galaxy::graphics::Renderables::TEXT);
+}
\ No newline at end of file
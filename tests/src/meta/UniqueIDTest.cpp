@@ -5,12 +5,16 @@
 /// Refer to LICENSE.txt for more details.
 ///
 
+#include <algorithm>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <galaxy/meta/UniqueID.hpp>
 
 using TestUID1 = galaxy::meta::UniqueID<struct Test_>;
 using TestUID2 = galaxy::meta::UniqueID<struct _Test>;
+using TestUID3 = galaxy::meta::UniqueID<struct Threaded_>;
 
 struct TestA
 {
@@ -35,4 +39,34 @@ TEST(UniqueID, Get)
 
 	EXPECT_EQ(a2, 0);
 	EXPECT_EQ(b2, 1);
+}
+
+template<int N>
+struct Threaded
+{
+};
+
+TEST(UniqueID, ThreadedFirstUse)
+{
+	std::vector<std::size_t> ids(8);
+	std::vector<std::thread> threads;
+
+	[&]<int... N>(std::integer_sequence<int, N...>) {
+		(threads.emplace_back([&ids]() {
+			ids[N] = TestUID3::get<Threaded<N>>();
+		}),
+			...);
+	}(std::make_integer_sequence<int, 8> {});
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	// Every type gets its own id, whichever thread saw it first.
+	std::sort(ids.begin(), ids.end());
+	for (std::size_t i = 0; i < ids.size(); i++)
+	{
+		EXPECT_EQ(ids[i], i);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+///
+/// CollisionShapesTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/CollisionShapes.hpp>
+
+namespace
+{
+	constexpr const std::array<glm::vec2, 4> BOX = {glm::vec2 {0.0f, 0.0f}, glm::vec2 {10.0f, 0.0f}, glm::vec2 {10.0f, 10.0f}, glm::vec2 {0.0f, 10.0f}};
+
+	glm::mat3x2 translate(const float x, const float y)
+	{
+		glm::mat3x2 affine {1.0f};
+		affine[2] = {x, y};
+
+		return affine;
+	}
+
+	glm::mat3x2 rotate(const float degrees, const float x, const float y)
+	{
+		const auto radians = degrees * 3.14159265f / 180.0f;
+
+		glm::mat3x2 affine {1.0f};
+		affine[0] = {std::cos(radians), std::sin(radians)};
+		affine[1] = {-std::sin(radians), std::cos(radians)};
+		affine[2] = {x, y};
+
+		return affine;
+	}
+} // namespace
+
+TEST(CollisionShapes, BoxesShareAxes)
+{
+	galaxy::physics::CollisionShapes shapes;
+	shapes.update(1, BOX, translate(0.0f, 0.0f));
+	EXPECT_EQ(shapes.get_axis_count(1), 2);
+
+	shapes.update(2, BOX, rotate(30.0f, 0.0f, 0.0f));
+	EXPECT_EQ(shapes.get_axis_count(2), 2);
+
+	const std::array<glm::vec2, 3> triangle = {glm::vec2 {0.0f, 0.0f}, glm::vec2 {10.0f, 0.0f}, glm::vec2 {5.0f, 10.0f}};
+	shapes.update(3, triangle, translate(0.0f, 0.0f));
+	EXPECT_EQ(shapes.get_axis_count(3), 3);
+
+	EXPECT_EQ(shapes.get_axis_count(4), 0);
+}
+
+TEST(CollisionShapes, Intersects)
+{
+	galaxy::physics::CollisionShapes shapes;
+	shapes.update(1, BOX, translate(0.0f, 0.0f));
+	shapes.update(2, BOX, translate(8.0f, 1.0f));
+	shapes.update(3, BOX, translate(20.0f, 0.0f));
+
+	glm::vec2 mtv;
+	ASSERT_TRUE(shapes.intersects(1, 2, mtv));
+
+	// Pushes 1 out of 2, to the left.
+	EXPECT_FLOAT_EQ(mtv.x, -2.0f);
+	EXPECT_FLOAT_EQ(mtv.y, 0.0f);
+
+	// Identical boxes.
+	shapes.update(4, BOX, translate(0.0f, 0.0f));
+	ASSERT_TRUE(shapes.intersects(4, 1, mtv));
+
+	EXPECT_FALSE(shapes.intersects(1, 3, mtv));
+	EXPECT_FLOAT_EQ(mtv.x, 0.0f);
+	EXPECT_FLOAT_EQ(mtv.y, 0.0f);
+
+	// Touching is not intersecting.
+	shapes.update(3, BOX, translate(10.0f, 0.0f));
+	EXPECT_FALSE(shapes.intersects(1, 3, mtv));
+
+	EXPECT_FALSE(shapes.intersects(1, 99, mtv));
+}
+
+TEST(CollisionShapes, ResolvesRotatedOverlap)
+{
+	galaxy::physics::CollisionShapes shapes;
+	shapes.update(1, BOX, rotate(45.0f, 5.0f, -2.0f));
+	shapes.update(2, BOX, translate(0.0f, 0.0f));
+
+	glm::vec2 mtv;
+	ASSERT_TRUE(shapes.intersects(1, 2, mtv));
+
+	// Moving by the mtv separates the shapes, up to touching.
+	auto affine = rotate(45.0f, 5.0f, -2.0f);
+	affine[2]   = affine[2] + mtv * 1.001f;
+	shapes.update(1, BOX, affine);
+
+	EXPECT_FALSE(shapes.intersects(1, 2, mtv));
+}
+
+TEST(CollisionShapes, ReusesStorage)
+{
+	galaxy::physics::CollisionShapes shapes;
+	shapes.update(1, BOX, translate(0.0f, 0.0f));
+	shapes.update(2, BOX, translate(5.0f, 0.0f));
+
+	const auto stored = shapes.get_stored_vertices();
+	EXPECT_EQ(stored, 2 * galaxy::physics::CollisionShapes::LANES);
+
+	EXPECT_TRUE(shapes.is_current(1, translate(0.0f, 0.0f)));
+	EXPECT_FALSE(shapes.is_current(1, translate(1.0f, 0.0f)));
+	EXPECT_FALSE(shapes.is_current(3, translate(0.0f, 0.0f)));
+
+	for (int i = 0; i < 100; i++)
+	{
+		shapes.update(1, BOX, translate(static_cast<float>(i), 0.0f));
+	}
+
+	EXPECT_EQ(shapes.get_stored_vertices(), stored);
+
+	// Different vertex count needs a new range, old ranges are compacted away.
+	const std::array<glm::vec2, 5> pentagon = {glm::vec2 {0.0f, 0.0f}, glm::vec2 {10.0f, 0.0f}, glm::vec2 {12.0f, 6.0f}, glm::vec2 {5.0f, 10.0f}, glm::vec2 {-2.0f, 6.0f}};
+	for (int i = 0; i < 10; i++)
+	{
+		shapes.update(1, i % 2 == 0 ? std::span<const glm::vec2> {pentagon} : std::span<const glm::vec2> {BOX}, translate(0.0f, 0.0f));
+	}
+
+	EXPECT_LE(shapes.get_stored_vertices(), 4 * stored);
+
+	glm::vec2 mtv;
+	EXPECT_TRUE(shapes.intersects(1, 2, mtv));
+
+	shapes.erase(1);
+	EXPECT_EQ(shapes.size(), 1);
+	EXPECT_FALSE(shapes.intersects(1, 2, mtv));
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+///
+/// ContactEventsTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/ContactEvents.hpp>
+
+using galaxy::physics::ContactPhase;
+
+TEST(ContactEvents, BeginStayEnd)
+{
+	galaxy::physics::ContactEvents buffer;
+
+	buffer.record(1, 2, {1.0f, 0.0f});
+	auto events = buffer.flush();
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_EQ(events[0].m_phase, ContactPhase::BEGIN);
+
+	buffer.record(1, 2, {1.0f, 0.0f});
+	events = buffer.flush();
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_EQ(events[0].m_phase, ContactPhase::STAY);
+	EXPECT_EQ(buffer.size(), 1);
+
+	events = buffer.flush();
+	ASSERT_EQ(events.size(), 1);
+	EXPECT_EQ(events[0].m_phase, ContactPhase::END);
+	EXPECT_EQ(events[0].m_a, 1);
+	EXPECT_EQ(events[0].m_b, 2);
+
+	EXPECT_TRUE(buffer.flush().empty());
+	EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(ContactEvents, DeduplicatesAndOrdersPairs)
+{
+	galaxy::physics::ContactEvents buffer;
+
+	buffer.record(5, 3, {0.0f, 1.0f});
+	buffer.record(3, 5, {0.0f, 1.0f});
+	buffer.record(5, 3, {1.0f, 0.0f});
+	buffer.record(1, 9, {1.0f, 0.0f});
+
+	const auto events = buffer.flush();
+	ASSERT_EQ(events.size(), 2);
+
+	EXPECT_EQ(events[0].m_a, 1);
+	EXPECT_EQ(events[0].m_b, 9);
+
+	// First record wins, flipped so it moves the lower entity.
+	EXPECT_EQ(events[1].m_a, 3);
+	EXPECT_EQ(events[1].m_b, 5);
+	EXPECT_EQ(events[1].m_normal.x, 0.0f);
+	EXPECT_EQ(events[1].m_normal.y, -1.0f);
+}
+
+TEST(ContactEvents, KeepCarriesContactOver)
+{
+	galaxy::physics::ContactEvents buffer;
+
+	buffer.record(1, 2, {1.0f, 0.0f});
+	buffer.record(3, 4, {1.0f, 0.0f});
+	buffer.flush();
+
+	EXPECT_TRUE(buffer.keep(2, 1));
+	EXPECT_FALSE(buffer.keep(1, 3));
+
+	const auto events = buffer.flush();
+	ASSERT_EQ(events.size(), 2);
+	EXPECT_EQ(events[0].m_phase, ContactPhase::STAY);
+	EXPECT_EQ(events[0].m_normal.x, 1.0f);
+	EXPECT_EQ(events[1].m_phase, ContactPhase::END);
+	EXPECT_EQ(events[1].m_a, 3);
+}
\ No newline at end of file
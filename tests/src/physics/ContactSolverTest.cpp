@@ -0,0 +1,285 @@
+///
+/// ContactSolverTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/ContactSolver.hpp>
+#include <galaxy/physics/DynamicTree.hpp>
+
+namespace
+{
+	constexpr const float DT = 1.0f / 60.0f;
+
+	///
+	/// Axis aligned box for a tiny headless simulation.
+	///
+	struct Box final
+	{
+		galaxy::ecs::Entity m_entity;
+		glm::vec2 m_min;
+		glm::vec2 m_max;
+		float m_inv_mass;
+	};
+
+	///
+	/// Add a contact if two boxes overlap, with the normal along the axis of least penetration.
+	///
+	void collide(galaxy::physics::ContactSolver& solver, const Box& a, const Box& b)
+	{
+		const auto x = std::min(a.m_max.x, b.m_max.x) - std::max(a.m_min.x, b.m_min.x);
+		const auto y = std::min(a.m_max.y, b.m_max.y) - std::max(a.m_min.y, b.m_min.y);
+
+		if (x <= 0.0f || y <= 0.0f)
+		{
+			return;
+		}
+
+		if (x < y)
+		{
+			solver.add_contact(a.m_entity, b.m_entity, {a.m_min.x < b.m_min.x ? -1.0f : 1.0f, 0.0f}, x);
+		}
+		else
+		{
+			solver.add_contact(a.m_entity, b.m_entity, {0.0f, a.m_min.y < b.m_min.y ? -1.0f : 1.0f}, y);
+		}
+	}
+
+	///
+	/// Step boxes under gravity, pointing down the screen.
+	///
+	void step(galaxy::physics::ContactSolver& solver, std::vector<Box>& boxes)
+	{
+		for (auto& box : boxes)
+		{
+			if (box.m_inv_mass > 0.0f && solver.is_awake(box.m_entity))
+			{
+				const auto velocity = solver.get_velocity(box.m_entity) + glm::vec2 {0.0f, 500.0f * DT};
+				solver.set_body(box.m_entity, velocity, box.m_inv_mass, 0.0f);
+			}
+		}
+
+		for (std::size_t i = 0; i < boxes.size(); i++)
+		{
+			for (std::size_t j = i + 1; j < boxes.size(); j++)
+			{
+				collide(solver, boxes[i], boxes[j]);
+			}
+		}
+
+		solver.solve();
+
+		for (auto& box : boxes)
+		{
+			if (solver.is_awake(box.m_entity))
+			{
+				const auto offset = solver.get_velocity(box.m_entity) * DT + solver.get_correction(box.m_entity);
+				box.m_min += offset;
+				box.m_max += offset;
+			}
+		}
+	}
+} // namespace
+
+TEST(ContactSolver, StopsBodyAtFloor)
+{
+	galaxy::physics::ContactSolver solver;
+	solver.set_body(1, {0.0f, 0.0f}, 0.0f, 0.0f);
+	solver.set_body(2, {50.0f, 200.0f}, 1.0f, 0.0f);
+
+	solver.add_contact(2, 1, {0.0f, -1.0f}, 1.0f);
+	solver.solve();
+
+	// Sideways motion is kept, motion into the floor is removed and penetration is pushed out.
+	EXPECT_FLOAT_EQ(solver.get_velocity(2).x, 50.0f);
+	EXPECT_NEAR(solver.get_velocity(2).y, 0.0f, 1e-4f);
+	EXPECT_LT(solver.get_correction(2).y, 0.0f);
+	EXPECT_EQ(solver.get_correction(1).y, 0.0f);
+	EXPECT_FALSE(solver.is_awake(1));
+	EXPECT_EQ(solver.get_contact_count(), 1);
+}
+
+TEST(ContactSolver, Restitution)
+{
+	galaxy::physics::ContactSolver solver;
+	solver.set_body(1, {0.0f, 0.0f}, 0.0f, 0.0f);
+	solver.set_body(2, {0.0f, 200.0f}, 1.0f, 1.0f);
+
+	solver.add_contact(2, 1, {0.0f, -1.0f}, 0.0f);
+	solver.solve();
+
+	EXPECT_NEAR(solver.get_velocity(2).y, -200.0f, 1e-3f);
+}
+
+TEST(ContactSolver, SplitsByMass)
+{
+	galaxy::physics::ContactSolver solver;
+	solver.set_body(1, {0.0f, 0.0f}, 1.0f, 0.0f);
+	solver.set_body(2, {0.0f, 0.0f}, 0.25f, 0.0f);
+
+	solver.add_contact(1, 2, {-1.0f, 0.0f}, 10.0f);
+	solver.solve();
+
+	// Lighter body moves four times as far, in the other direction.
+	const auto a = solver.get_correction(1);
+	const auto b = solver.get_correction(2);
+	EXPECT_LT(a.x, 0.0f);
+	EXPECT_GT(b.x, 0.0f);
+	EXPECT_NEAR(a.x, -4.0f * b.x, 1e-4f);
+	EXPECT_NEAR(b.x - a.x, (10.0f - galaxy::physics::ContactSolver::SLOP) * galaxy::physics::ContactSolver::CORRECTION, 1e-3f);
+	EXPECT_EQ(solver.get_island_count(), 1);
+}
+
+TEST(ContactSolver, StackSleepsAndWakesTogether)
+{
+	galaxy::physics::ContactSolver solver;
+
+	std::vector<Box> boxes;
+	boxes.push_back({.m_entity = 1, .m_min = {0.0f, 100.0f}, .m_max = {200.0f, 120.0f}, .m_inv_mass = 0.0f});
+	boxes.push_back({.m_entity = 2, .m_min = {50.0f, 70.0f}, .m_max = {70.0f, 90.0f}, .m_inv_mass = 1.0f});
+	boxes.push_back({.m_entity = 3, .m_min = {52.0f, 40.0f}, .m_max = {68.0f, 60.0f}, .m_inv_mass = 1.0f});
+	boxes.push_back({.m_entity = 4, .m_min = {150.0f, 80.0f}, .m_max = {160.0f, 90.0f}, .m_inv_mass = 1.0f});
+
+	for (const auto& box : boxes)
+	{
+		solver.set_body(box.m_entity, {0.0f, 0.0f}, box.m_inv_mass, 0.0f);
+	}
+
+	for (int i = 0; i < 300; i++)
+	{
+		step(solver, boxes);
+	}
+
+	// Both boxes rest on the floor, stacked, without sinking in.
+	EXPECT_NEAR(boxes[1].m_max.y, 100.0f, 0.5f);
+	EXPECT_NEAR(boxes[2].m_max.y, boxes[1].m_min.y, 0.5f);
+	EXPECT_NEAR(boxes[3].m_max.y, 100.0f, 0.5f);
+
+	EXPECT_FALSE(solver.is_awake(2));
+	EXPECT_FALSE(solver.is_awake(3));
+	EXPECT_FALSE(solver.is_awake(4));
+
+	solver.solve();
+	EXPECT_TRUE(solver.get_solved().empty());
+	EXPECT_EQ(solver.get_island_count(), 0);
+
+	// Pushing the bottom box wakes the box on top of it, but not the unrelated box.
+	solver.set_body(2, {10.0f, 0.0f}, 1.0f, 0.0f);
+	EXPECT_TRUE(solver.is_awake(2));
+	EXPECT_TRUE(solver.is_awake(3));
+	EXPECT_FALSE(solver.is_awake(4));
+}
+
+TEST(ContactSolver, EraseKeepsContacts)
+{
+	galaxy::physics::ContactSolver solver;
+	solver.set_body(1, {0.0f, 0.0f}, 0.0f, 0.0f);
+	solver.set_body(2, {0.0f, 100.0f}, 1.0f, 0.0f);
+	solver.set_body(3, {0.0f, 100.0f}, 1.0f, 0.0f);
+
+	solver.add_contact(3, 1, {0.0f, -1.0f}, 0.0f);
+	solver.add_contact(2, 1, {0.0f, -1.0f}, 0.0f);
+	solver.erase(2);
+	solver.solve();
+
+	EXPECT_EQ(solver.get_contact_count(), 1);
+	EXPECT_NEAR(solver.get_velocity(3).y, 0.0f, 1e-4f);
+	EXPECT_EQ(solver.get_velocity(2).y, 0.0f);
+	ASSERT_EQ(solver.get_solved().size(), 1);
+	EXPECT_EQ(solver.get_solved()[0], 3);
+}
+
+TEST(ContactSolver, MovedStaticWakesSleepingBody)
+{
+	galaxy::physics::ContactSolver solver;
+
+	std::vector<Box> boxes;
+	boxes.push_back({.m_entity = 1, .m_min = {0.0f, 100.0f}, .m_max = {200.0f, 120.0f}, .m_inv_mass = 0.0f});
+	boxes.push_back({.m_entity = 2, .m_min = {50.0f, 80.0f}, .m_max = {70.0f, 100.0f}, .m_inv_mass = 1.0f});
+	boxes.push_back({.m_entity = 3, .m_min = {150.0f, 0.0f}, .m_max = {160.0f, 100.0f}, .m_inv_mass = 0.0f});
+
+	for (const auto& box : boxes)
+	{
+		solver.set_body(box.m_entity, {0.0f, 0.0f}, box.m_inv_mass, 0.0f);
+	}
+
+	for (int i = 0; i < 100; i++)
+	{
+		step(solver, boxes);
+	}
+
+	// Resting on a static body that has not moved keeps it asleep.
+	ASSERT_FALSE(solver.is_awake(2));
+	EXPECT_FALSE(solver.is_active(1));
+	EXPECT_FALSE(solver.is_active(3));
+
+	// Slide the wall into the sleeping box, like a door or platform moved by a script.
+	boxes[2].m_min.x = boxes[1].m_max.x - 5.0f;
+	boxes[2].m_max.x = boxes[2].m_min.x + 10.0f;
+	solver.wake(3);
+
+	EXPECT_FALSE(solver.is_awake(3));
+	EXPECT_TRUE(solver.is_active(3));
+
+	step(solver, boxes);
+	EXPECT_TRUE(solver.is_awake(2));
+	EXPECT_FALSE(solver.is_active(3));
+
+	for (int i = 0; i < 10; i++)
+	{
+		step(solver, boxes);
+	}
+
+	// Pushed out of the wall rather than left inside it.
+	EXPECT_LE(boxes[1].m_max.x, boxes[2].m_min.x + 0.5f);
+}
+
+TEST(ContactSolver, SweptBodyStaysAtWall)
+{
+	galaxy::physics::ContactSolver solver;
+
+	// One pixel wall, and a bullet that crosses it in a single step.
+	const Box wall {.m_entity = 1, .m_min = {50.0f, 0.0f}, .m_max = {51.0f, 100.0f}, .m_inv_mass = 0.0f};
+	Box bullet {.m_entity = 2, .m_min = {0.0f, 40.0f}, .m_max = {4.0f, 44.0f}, .m_inv_mass = 1.0f};
+
+	solver.set_body(wall.m_entity, {0.0f, 0.0f}, wall.m_inv_mass, 0.0f);
+	solver.set_body(bullet.m_entity, {6000.0f, 60.0f}, bullet.m_inv_mass, 0.0f);
+
+	// Same order as CollisionSystem: sweep last move, solve, then integrate.
+	// The narrowphase does not count boxes that are only touching, so it is left out.
+	galaxy::math::AABB last {bullet.m_min, bullet.m_max};
+	for (int i = 0; i < 10; i++)
+	{
+		const glm::vec2 displacement = bullet.m_min - last.min();
+
+		glm::vec2 normal;
+		if (const auto toi = galaxy::physics::DynamicTree<int>::time_of_impact(last, displacement, {wall.m_min, wall.m_max}, normal); toi.has_value())
+		{
+			const auto back = displacement * (toi.value() - 1.0f);
+			bullet.m_min += back;
+			bullet.m_max += back;
+
+			EXPECT_EQ(normal, glm::vec2(-1.0f, 0.0f));
+			solver.add_contact(bullet.m_entity, wall.m_entity, normal, 0.0f);
+		}
+
+		last = {bullet.m_min, bullet.m_max};
+		solver.solve();
+
+		const auto offset = solver.get_velocity(bullet.m_entity) * DT + solver.get_correction(bullet.m_entity);
+		bullet.m_min += offset;
+		bullet.m_max += offset;
+	}
+
+	// Stopped on the near side, with motion into the wall removed and sliding along it kept.
+	EXPECT_NEAR(bullet.m_max.x, wall.m_min.x, 1e-3f);
+	EXPECT_LE(bullet.m_max.x, wall.m_min.x + 1e-3f);
+	EXPECT_NEAR(solver.get_velocity(bullet.m_entity).x, 0.0f, 1e-4f);
+	EXPECT_FLOAT_EQ(solver.get_velocity(bullet.m_entity).y, 60.0f);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+///
+/// DynamicTreeBenchmark.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/DynamicTree.hpp>
+
+namespace
+{
+	constexpr const int QUERIES = 1000;
+
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Tile sized boxes over a world that keeps density constant as count grows.
+	///
+	std::vector<galaxy::math::AABB> make_boxes(const int count, const unsigned int seed)
+	{
+		const auto world = std::sqrt(static_cast<float>(count)) * 32.0f;
+
+		std::mt19937 gen {seed};
+		std::uniform_real_distribution<float> pos {0.0f, world};
+		std::uniform_real_distribution<float> size {8.0f, 32.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {size(gen), size(gen)});
+		}
+
+		return boxes;
+	}
+
+	void run(const int count)
+	{
+		const auto boxes   = make_boxes(count, 1);
+		const auto queries = make_boxes(QUERIES, 2);
+
+		galaxy::physics::DynamicTree<int> tree;
+		tree.set_thickness_factor(std::nullopt);
+
+		const auto build = time_ms([&]() {
+			for (int i = 0; i < count; i++)
+			{
+				tree.insert(i, boxes[i].min(), boxes[i].max());
+			}
+		});
+
+		std::size_t brute_hits = 0;
+		const auto brute = time_ms([&]() {
+			for (const auto& query : queries)
+			{
+				for (const auto& box : boxes)
+				{
+					brute_hits += query.overlaps(box, true);
+				}
+			}
+		});
+
+		std::size_t tree_hits = 0;
+		std::vector<int> result;
+		const auto queried = time_ms([&]() {
+			for (const auto& query : queries)
+			{
+				result.clear();
+				tree.query(query, std::back_inserter(result));
+				tree_hits += result.size();
+			}
+		});
+
+		std::size_t rays = 0;
+		const auto cast = time_ms([&]() {
+			for (const auto& query : queries)
+			{
+				result.clear();
+				tree.ray_cast(query.min(), query.min() + glm::vec2 {256.0f, 64.0f}, std::back_inserter(result));
+				rays += result.size();
+			}
+		});
+
+		std::vector<std::pair<int, int>> pairs;
+		const auto paired = time_ms([&]() {
+			tree.query_pairs(std::back_inserter(pairs));
+		});
+
+		std::cout << "[ DynamicTreeBenchmark ] " << count << " boxes. insert: " << build << " ms. " << QUERIES << " queries, brute force: " << brute << " ms, tree: " << queried
+				  << " ms. " << QUERIES << " ray casts: " << cast << " ms (" << rays << " hits). self query: " << paired << " ms (" << pairs.size() << " pairs).\n";
+
+		EXPECT_EQ(tree_hits, brute_hits);
+	}
+
+	void run_build(const int count)
+	{
+		const auto boxes   = make_boxes(count, 1);
+		const auto queries = make_boxes(QUERIES, 2);
+
+		std::vector<std::pair<int, galaxy::math::AABB>> entries;
+		entries.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			entries.emplace_back(i, boxes[i]);
+		}
+
+		galaxy::physics::DynamicTree<int> incremental;
+		incremental.set_thickness_factor(std::nullopt);
+		const auto inserted = time_ms([&]() {
+			for (const auto& [key, aabb] : entries)
+			{
+				incremental.insert(key, aabb.min(), aabb.max());
+			}
+		});
+
+		galaxy::physics::DynamicTree<int> bulk;
+		bulk.set_thickness_factor(std::nullopt);
+		const auto built = time_ms([&]() {
+			bulk.insert(entries);
+		});
+
+		const auto query_time = [&](const galaxy::physics::DynamicTree<int>& tree) {
+			std::vector<int> result;
+			return time_ms([&]() {
+				for (const auto& query : queries)
+				{
+					result.clear();
+					tree.query(query, std::back_inserter(result));
+				}
+			});
+		};
+
+		std::cout << "[ DynamicTreeBenchmark ] " << count << " boxes. incremental: " << inserted << " ms, SAR " << incremental.compute_surface_area_ratio() << ", balance "
+				  << incremental.compute_maximum_balance() << ", height " << incremental.height() << ", queries " << query_time(incremental) << " ms. bulk SAH: " << built
+				  << " ms, SAR " << bulk.compute_surface_area_ratio() << ", balance " << bulk.compute_maximum_balance() << ", height " << bulk.height() << ", queries "
+				  << query_time(bulk) << " ms.\n";
+
+		EXPECT_EQ(bulk.size(), incremental.size());
+		EXPECT_LT(bulk.height(), static_cast<int>(galaxy::physics::DynamicTree<int>::STACK_SIZE));
+	}
+} // namespace
+
+TEST(DynamicTreeBenchmark, OneThousand)
+{
+	run(1'000);
+}
+
+TEST(DynamicTreeBenchmark, TenThousand)
+{
+	run(10'000);
+}
+
+TEST(DynamicTreeBenchmark, OneHundredThousand)
+{
+	run(100'000);
+}
+
+TEST(DynamicTreeBenchmark, BulkBuild)
+{
+	run_build(1'000);
+	run_build(10'000);
+	run_build(100'000);
+}
\ No newline at end of file
@@ -0,0 +1,386 @@
+///
+/// DynamicTreeTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/DynamicTree.hpp>
+
+namespace
+{
+	///
+	/// Boxes scattered over a square world.
+	///
+	std::vector<galaxy::math::AABB> make_boxes(const int count, const float world, const unsigned int seed)
+	{
+		std::mt19937 gen {seed};
+		std::uniform_real_distribution<float> pos {0.0f, world};
+		std::uniform_real_distribution<float> size {1.0f, 16.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {size(gen), size(gen)});
+		}
+
+		return boxes;
+	}
+
+	///
+	/// Tree with no skin, so stored boxes match the input exactly.
+	///
+	galaxy::physics::DynamicTree<int> make_tree(const std::vector<galaxy::math::AABB>& boxes)
+	{
+		galaxy::physics::DynamicTree<int> tree;
+		tree.set_thickness_factor(std::nullopt);
+
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			tree.insert(i, boxes[i].min(), boxes[i].max());
+		}
+
+		return tree;
+	}
+} // namespace
+
+TEST(DynamicTree, QueryKeyWritesOverlappingKeys)
+{
+	galaxy::physics::DynamicTree<int> tree;
+	tree.set_thickness_factor(std::nullopt);
+
+	tree.insert(1, {0.0f, 0.0f}, {10.0f, 10.0f});
+	tree.insert(2, {5.0f, 5.0f}, {15.0f, 15.0f});
+	tree.insert(3, {100.0f, 100.0f}, {110.0f, 110.0f});
+
+	std::vector<int> result;
+	tree.query(1, std::back_inserter(result));
+
+	ASSERT_EQ(result.size(), 1);
+	EXPECT_EQ(result[0], 2);
+
+	result.clear();
+	tree.query(3, std::back_inserter(result));
+	EXPECT_TRUE(result.empty());
+
+	result.clear();
+	tree.query(4, std::back_inserter(result));
+	EXPECT_TRUE(result.empty());
+}
+
+TEST(DynamicTree, QueryAABBMatchesBruteForce)
+{
+	const auto boxes = make_boxes(2000, 1000.0f, 1);
+	const auto tree  = make_tree(boxes);
+
+	const auto queries = make_boxes(100, 1000.0f, 2);
+	for (const auto& query : queries)
+	{
+		std::vector<int> expected;
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			if (query.overlaps(boxes[i], true))
+			{
+				expected.push_back(i);
+			}
+		}
+
+		std::vector<int> result;
+		tree.query(query, std::back_inserter(result));
+
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, expected);
+	}
+}
+
+TEST(DynamicTree, RayCastHitsCrossedBoxes)
+{
+	galaxy::physics::DynamicTree<int> tree;
+	tree.set_thickness_factor(std::nullopt);
+
+	// Row of boxes along the x axis, with a gap at 2.
+	for (int i = 0; i < 5; i++)
+	{
+		if (i != 2)
+		{
+			const glm::vec2 min = {i * 10.0f, 0.0f};
+			tree.insert(i, min, min + glm::vec2 {5.0f, 5.0f});
+		}
+	}
+
+	std::vector<int> result;
+	tree.ray_cast({-1.0f, 2.0f}, {100.0f, 2.0f}, std::back_inserter(result));
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(result, (std::vector<int> {0, 1, 3, 4}));
+
+	// Segment ends before reaching box 3.
+	result.clear();
+	tree.ray_cast({-1.0f, 2.0f}, {25.0f, 2.0f}, std::back_inserter(result));
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(result, (std::vector<int> {0, 1}));
+
+	// Vertical segment through the gap.
+	result.clear();
+	tree.ray_cast({22.0f, -10.0f}, {22.0f, 10.0f}, std::back_inserter(result));
+	EXPECT_TRUE(result.empty());
+
+	// Diagonal segment only crosses box 0.
+	result.clear();
+	tree.ray_cast({-5.0f, -5.0f}, {7.0f, 7.0f}, std::back_inserter(result));
+	EXPECT_EQ(result, (std::vector<int> {0}));
+}
+
+TEST(DynamicTree, QueryPairsMatchesBruteForce)
+{
+	const auto boxes = make_boxes(1000, 500.0f, 3);
+	const auto tree  = make_tree(boxes);
+
+	std::vector<std::pair<int, int>> expected;
+	for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+	{
+		for (int j = i + 1; j < static_cast<int>(boxes.size()); j++)
+		{
+			if (boxes[i].overlaps(boxes[j], true))
+			{
+				expected.emplace_back(i, j);
+			}
+		}
+	}
+
+	std::vector<std::pair<int, int>> result;
+	tree.query_pairs(std::back_inserter(result));
+
+	for (auto& [a, b] : result)
+	{
+		if (a > b)
+		{
+			std::swap(a, b);
+		}
+	}
+
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(result, expected);
+}
+
+TEST(DynamicTree, UpdateAndErase)
+{
+	auto boxes = make_boxes(500, 500.0f, 4);
+	auto tree  = make_tree(boxes);
+
+	std::mt19937 gen {5};
+	std::uniform_real_distribution<float> offset {-50.0f, 50.0f};
+	for (int i = 0; i < static_cast<int>(boxes.size()); i += 2)
+	{
+		const glm::vec2 delta = {offset(gen), offset(gen)};
+		boxes[i]              = {boxes[i].min() + delta, boxes[i].max() + delta};
+		tree.update(i, boxes[i]);
+	}
+
+	for (int i = 1; i < static_cast<int>(boxes.size()); i += 4)
+	{
+		tree.erase(i);
+	}
+
+	EXPECT_EQ(tree.size(), boxes.size() - boxes.size() / 4);
+	EXPECT_LE(tree.compute_maximum_balance(), 1);
+
+	const galaxy::math::AABB all {{-100.0f, -100.0f}, {700.0f, 700.0f}};
+	std::vector<int> result;
+	tree.query(all, std::back_inserter(result));
+	EXPECT_EQ(result.size(), tree.size());
+
+	const auto queries = make_boxes(50, 500.0f, 6);
+	for (const auto& query : queries)
+	{
+		std::vector<int> expected;
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			if (i % 4 != 1 && query.overlaps(boxes[i], true))
+			{
+				expected.push_back(i);
+			}
+		}
+
+		result.clear();
+		tree.query(query, std::back_inserter(result));
+
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, expected);
+	}
+
+	tree.clear();
+	EXPECT_TRUE(tree.is_empty());
+	EXPECT_EQ(tree.node_count(), 0);
+	EXPECT_EQ(tree.height(), 0);
+
+	result.clear();
+	tree.query(all, std::back_inserter(result));
+	EXPECT_TRUE(result.empty());
+
+	tree.insert(0, {0.0f, 0.0f}, {1.0f, 1.0f});
+	tree.query(all, std::back_inserter(result));
+	EXPECT_EQ(result, (std::vector<int> {0}));
+}
+
+TEST(DynamicTree, BulkInsertMatchesBruteForce)
+{
+	const auto boxes = make_boxes(3000, 1000.0f, 7);
+
+	galaxy::physics::DynamicTree<int> tree;
+	tree.set_thickness_factor(std::nullopt);
+
+	// Half one at a time, half in bulk, so the rebuild has to take in existing leaves.
+	std::vector<std::pair<int, galaxy::math::AABB>> bulk;
+	for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+	{
+		if (i % 2 == 0)
+		{
+			tree.insert(i, boxes[i].min(), boxes[i].max());
+		}
+		else
+		{
+			bulk.emplace_back(i, boxes[i]);
+		}
+	}
+
+	tree.insert(bulk);
+	EXPECT_EQ(tree.size(), boxes.size());
+	EXPECT_EQ(tree.node_count(), boxes.size() * 2 - 1);
+
+	const auto queries = make_boxes(100, 1000.0f, 8);
+	for (const auto& query : queries)
+	{
+		std::vector<int> expected;
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			if (query.overlaps(boxes[i], true))
+			{
+				expected.push_back(i);
+			}
+		}
+
+		std::vector<int> result;
+		tree.query(query, std::back_inserter(result));
+
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, expected);
+	}
+
+	// Incremental changes still work on a bulk built tree.
+	for (int i = 0; i < static_cast<int>(boxes.size()); i += 3)
+	{
+		tree.erase(i);
+	}
+
+	std::vector<int> result;
+	tree.query(galaxy::math::AABB {{-100.0f, -100.0f}, {1100.0f, 1100.0f}}, std::back_inserter(result));
+	EXPECT_EQ(result.size(), boxes.size() - boxes.size() / 3);
+}
+
+TEST(DynamicTree, RebuildKeepsEntries)
+{
+	const auto boxes = make_boxes(1000, 500.0f, 9);
+	auto tree        = make_tree(boxes);
+
+	std::vector<std::pair<int, int>> before;
+	tree.query_pairs(std::back_inserter(before));
+
+	tree.rebuild();
+	EXPECT_EQ(tree.size(), boxes.size());
+	EXPECT_EQ(tree.node_count(), boxes.size() * 2 - 1);
+	EXPECT_LT(tree.height(), 64);
+
+	std::vector<std::pair<int, int>> after;
+	tree.query_pairs(std::back_inserter(after));
+
+	const auto normalise = [](std::vector<std::pair<int, int>>& pairs) {
+		for (auto& [a, b] : pairs)
+		{
+			if (a > b)
+			{
+				std::swap(a, b);
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end());
+	};
+
+	normalise(before);
+	normalise(after);
+	EXPECT_EQ(before, after);
+
+	galaxy::physics::DynamicTree<int> empty;
+	empty.rebuild();
+	EXPECT_EQ(empty.height(), 0);
+	EXPECT_EQ(empty.compute_surface_area_ratio(), 0.0);
+}
+
+TEST(DynamicTree, SweepFindsThinWall)
+{
+	galaxy::physics::DynamicTree<int> tree;
+	tree.set_thickness_factor(std::nullopt);
+
+	// One pixel wall between start and end of a bullet moving 100 pixels in a tick.
+	tree.insert(1, {50.0f, 0.0f}, {51.0f, 100.0f});
+	tree.insert(2, {200.0f, 0.0f}, {210.0f, 100.0f});
+	tree.insert(3, {50.0f, 200.0f}, {51.0f, 300.0f});
+
+	const galaxy::math::AABB bullet {{0.0f, 40.0f}, {4.0f, 44.0f}};
+	const glm::vec2 displacement = {100.0f, 0.0f};
+
+	// Neither end overlaps the wall.
+	const galaxy::math::AABB end {bullet.min() + displacement, bullet.max() + displacement};
+	std::vector<int> discrete;
+	tree.query(end, std::back_inserter(discrete));
+	EXPECT_TRUE(discrete.empty());
+
+	std::vector<int> swept;
+	tree.sweep(bullet, displacement, std::back_inserter(swept));
+	ASSERT_EQ(swept.size(), 1);
+	EXPECT_EQ(swept[0], 1);
+
+	glm::vec2 normal;
+	const auto toi = galaxy::physics::DynamicTree<int>::time_of_impact(bullet, displacement, {{50.0f, 0.0f}, {51.0f, 100.0f}}, normal);
+	ASSERT_TRUE(toi.has_value());
+	EXPECT_FLOAT_EQ(toi.value(), 0.46f);
+	EXPECT_EQ(normal, glm::vec2(-1.0f, 0.0f));
+}
+
+TEST(DynamicTree, TimeOfImpactIgnoresOverlapAndSliding)
+{
+	using Tree = galaxy::physics::DynamicTree<int>;
+
+	const galaxy::math::AABB floor {{0.0f, 10.0f}, {100.0f, 20.0f}};
+
+	// Resting on top and sliding along it.
+	EXPECT_FALSE(Tree::time_of_impact({{0.0f, 0.0f}, {10.0f, 10.0f}}, {50.0f, 0.0f}, floor).has_value());
+
+	// Already overlapping.
+	EXPECT_FALSE(Tree::time_of_impact({{0.0f, 5.0f}, {10.0f, 15.0f}}, {0.0f, 50.0f}, floor).has_value());
+
+	// Moving away.
+	EXPECT_FALSE(Tree::time_of_impact({{0.0f, 0.0f}, {10.0f, 10.0f}}, {0.0f, -50.0f}, floor).has_value());
+
+	// Too short to reach.
+	EXPECT_FALSE(Tree::time_of_impact({{0.0f, -20.0f}, {10.0f, -10.0f}}, {0.0f, 10.0f}, floor).has_value());
+
+	// Touching and pushing into it.
+	const auto pushing = Tree::time_of_impact({{0.0f, 0.0f}, {10.0f, 10.0f}}, {0.0f, 5.0f}, floor);
+	ASSERT_TRUE(pushing.has_value());
+	EXPECT_FLOAT_EQ(pushing.value(), 0.0f);
+
+	// Diagonal hit.
+	glm::vec2 normal;
+	const auto diagonal = Tree::time_of_impact({{-30.0f, -30.0f}, {-20.0f, -20.0f}}, {40.0f, 40.0f}, floor, normal);
+	ASSERT_TRUE(diagonal.has_value());
+	EXPECT_FLOAT_EQ(diagonal.value(), 0.75f);
+	EXPECT_EQ(normal, glm::vec2(0.0f, -1.0f));
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+///
+/// SpatialHashBenchmark.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/SpatialHash.hpp>
+
+namespace
+{
+	constexpr const int FRAMES = 30;
+
+	///
+	/// Times a functor in milliseconds.
+	///
+	template<typename Lambda>
+	double time_ms(Lambda&& func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	///
+	/// Tilemap of 32x32 walls, with one tenth as many tile sized bodies walking around it.
+	///
+	std::vector<galaxy::math::AABB> make_tiles(const int count)
+	{
+		const auto side = static_cast<int>(std::sqrt(static_cast<float>(count)));
+
+		std::mt19937 gen {1};
+		std::uniform_real_distribution<float> pos {0.0f, static_cast<float>(side) * 32.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; static_cast<int>(boxes.size()) < count - count / 10; i++)
+		{
+			const glm::vec2 min = {static_cast<float>(i % side) * 32.0f, static_cast<float>(i / side) * 32.0f};
+			boxes.emplace_back(min, min + glm::vec2 {32.0f, 32.0f});
+		}
+
+		while (static_cast<int>(boxes.size()) < count)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {24.0f, 30.0f});
+		}
+
+		return boxes;
+	}
+
+	///
+	/// Bodies from 4 to 256 pixels, clustered around a few points of a large world.
+	///
+	std::vector<galaxy::math::AABB> make_scattered(const int count)
+	{
+		const auto world = std::sqrt(static_cast<float>(count)) * 64.0f;
+
+		std::mt19937 gen {2};
+		std::uniform_real_distribution<float> centre {0.0f, world};
+		std::normal_distribution<float> spread {0.0f, world * 0.1f};
+		std::uniform_real_distribution<float> exponent {2.0f, 8.0f};
+
+		std::vector<glm::vec2> clusters;
+		for (int i = 0; i < 8; i++)
+		{
+			clusters.emplace_back(centre(gen), centre(gen));
+		}
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = clusters[i % clusters.size()] + glm::vec2 {spread(gen), spread(gen)};
+			boxes.emplace_back(min, min + glm::vec2 {std::exp2(exponent(gen)), std::exp2(exponent(gen))});
+		}
+
+		return boxes;
+	}
+
+	///
+	/// Simulates CollisionSystem: build, then each frame move the last tenth of the boxes and query their candidates.
+	///
+	template<typename Broadphase>
+	void simulate(Broadphase& broadphase, std::vector<galaxy::math::AABB> boxes, double& build, double& step, std::size_t& hits)
+	{
+		const auto count = static_cast<int>(boxes.size());
+
+		build = time_ms([&]() {
+			for (int i = 0; i < count; i++)
+			{
+				broadphase.insert(i, boxes[i].min(), boxes[i].max());
+			}
+		});
+
+		std::mt19937 gen {3};
+		std::uniform_real_distribution<float> velocity {-6.0f, 6.0f};
+
+		std::vector<int> result;
+		step = time_ms([&]() {
+			for (int frame = 0; frame < FRAMES; frame++)
+			{
+				for (int i = count - count / 10; i < count; i++)
+				{
+					const glm::vec2 offset = {velocity(gen), velocity(gen)};
+					boxes[i]               = {boxes[i].min() + offset, boxes[i].max() + offset};
+
+					if (broadphase.update(i, boxes[i]))
+					{
+						result.clear();
+						broadphase.query(i, std::back_inserter(result));
+						hits += result.size();
+					}
+				}
+			}
+		});
+	}
+
+	void run(const std::string_view name, const std::vector<galaxy::math::AABB>& boxes)
+	{
+		galaxy::physics::DynamicTree<int> tree;
+		galaxy::physics::SpatialHash<int> hash {{32.0f, 32.0f}};
+
+		double tree_build     = 0.0;
+		double tree_step      = 0.0;
+		double hash_build     = 0.0;
+		double hash_step      = 0.0;
+		std::size_t tree_hits = 0;
+		std::size_t hash_hits = 0;
+
+		simulate(tree, boxes, tree_build, tree_step, tree_hits);
+		simulate(hash, boxes, hash_build, hash_step, hash_hits);
+
+		std::cout << "[ SpatialHashBenchmark ] " << name << ", " << boxes.size() << " boxes. tree insert: " << tree_build << " ms, " << FRAMES << " frames: " << tree_step
+				  << " ms. hash insert: " << hash_build << " ms, " << FRAMES << " frames: " << hash_step << " ms (" << hash.cell_count() << " cells, " << hash.large_count()
+				  << " large).\n";
+
+		// Same skin, same moves, so both see the same candidates.
+		EXPECT_EQ(tree_hits, hash_hits);
+	}
+} // namespace
+
+TEST(SpatialHashBenchmark, Tiles)
+{
+	run("tiles", make_tiles(10'000));
+	run("tiles", make_tiles(100'000));
+}
+
+TEST(SpatialHashBenchmark, Scattered)
+{
+	// Every large box is a candidate for every query, so this is kept small.
+	run("scattered", make_scattered(1'000));
+	run("scattered", make_scattered(10'000));
+}
\ No newline at end of file
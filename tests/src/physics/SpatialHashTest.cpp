@@ -0,0 +1,224 @@
+///
+/// SpatialHashTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <galaxy/physics/SpatialHash.hpp>
+
+namespace
+{
+	///
+	/// Boxes scattered over a square world. Every tenth box spans many cells.
+	///
+	std::vector<galaxy::math::AABB> make_boxes(const int count, const float world, const unsigned int seed)
+	{
+		std::mt19937 gen {seed};
+		std::uniform_real_distribution<float> pos {-world * 0.5f, world};
+		std::uniform_real_distribution<float> size {1.0f, 40.0f};
+		std::uniform_real_distribution<float> large {100.0f, 300.0f};
+
+		std::vector<galaxy::math::AABB> boxes;
+		boxes.reserve(count);
+		for (int i = 0; i < count; i++)
+		{
+			const glm::vec2 min = {pos(gen), pos(gen)};
+			boxes.emplace_back(min, min + (i % 10 == 0 ? glm::vec2 {large(gen), large(gen)} : glm::vec2 {size(gen), size(gen)}));
+		}
+
+		return boxes;
+	}
+
+	///
+	/// Hash with no skin, so stored boxes match the input exactly.
+	///
+	void fill(galaxy::physics::SpatialHash<int>& hash, const std::vector<galaxy::math::AABB>& boxes)
+	{
+		hash.set_thickness_factor(std::nullopt);
+
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			hash.insert(i, boxes[i].min(), boxes[i].max());
+		}
+	}
+} // namespace
+
+TEST(SpatialHash, QueryAABBMatchesBruteForce)
+{
+	const auto boxes   = make_boxes(500, 1000.0f, 1);
+	const auto queries = make_boxes(50, 1000.0f, 2);
+
+	galaxy::physics::SpatialHash<int> hash {{32.0f, 32.0f}};
+	fill(hash, boxes);
+
+	EXPECT_GT(hash.large_count(), 0);
+
+	for (const auto& query : queries)
+	{
+		std::vector<int> result;
+		hash.query(query, std::back_inserter(result));
+		std::sort(result.begin(), result.end());
+
+		std::vector<int> expected;
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			if (query.overlaps(boxes[i], true))
+			{
+				expected.push_back(i);
+			}
+		}
+
+		EXPECT_EQ(result, expected);
+	}
+
+	// Larger than every used cell, so the used cells are walked instead.
+	std::vector<int> all;
+	hash.query(galaxy::math::AABB {{-1e6f, -1e6f}, {1e6f, 1e6f}}, std::back_inserter(all));
+	EXPECT_EQ(all.size(), boxes.size());
+}
+
+TEST(SpatialHash, QueryKeyMatchesBruteForce)
+{
+	const auto boxes = make_boxes(300, 800.0f, 3);
+
+	galaxy::physics::SpatialHash<int> hash {{16.0f, 24.0f}};
+	fill(hash, boxes);
+
+	for (int key = 0; key < static_cast<int>(boxes.size()); key++)
+	{
+		std::vector<int> result;
+		hash.query(key, std::back_inserter(result));
+		std::sort(result.begin(), result.end());
+
+		std::vector<int> expected;
+		for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+		{
+			if (i != key && boxes[key].overlaps(boxes[i], true))
+			{
+				expected.push_back(i);
+			}
+		}
+
+		ASSERT_EQ(result, expected) << "key " << key;
+	}
+}
+
+TEST(SpatialHash, QueryPairsMatchesBruteForce)
+{
+	const auto boxes = make_boxes(400, 800.0f, 4);
+
+	galaxy::physics::SpatialHash<int> hash;
+	fill(hash, boxes);
+
+	std::vector<std::pair<int, int>> pairs;
+	hash.query_pairs(std::back_inserter(pairs));
+	for (auto& [a, b] : pairs)
+	{
+		if (a > b)
+		{
+			std::swap(a, b);
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+
+	std::vector<std::pair<int, int>> expected;
+	for (int a = 0; a < static_cast<int>(boxes.size()); a++)
+	{
+		for (int b = a + 1; b < static_cast<int>(boxes.size()); b++)
+		{
+			if (boxes[a].overlaps(boxes[b], true))
+			{
+				expected.emplace_back(a, b);
+			}
+		}
+	}
+
+	EXPECT_EQ(pairs, expected);
+}
+
+TEST(SpatialHash, RayCastAndSweepMatchTree)
+{
+	const auto boxes   = make_boxes(400, 1000.0f, 5);
+	const auto queries = make_boxes(40, 1000.0f, 6);
+
+	galaxy::physics::SpatialHash<int> hash;
+	fill(hash, boxes);
+
+	galaxy::physics::DynamicTree<int> tree;
+	tree.set_thickness_factor(std::nullopt);
+	for (int i = 0; i < static_cast<int>(boxes.size()); i++)
+	{
+		tree.insert(i, boxes[i].min(), boxes[i].max());
+	}
+
+	const auto sorted = [](std::vector<int>& keys) {
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	};
+
+	for (const auto& query : queries)
+	{
+		const glm::vec2 to = query.min() + glm::vec2 {-200.0f, 350.0f};
+
+		std::vector<int> from_hash;
+		std::vector<int> from_tree;
+		hash.ray_cast(query.min(), to, std::back_inserter(from_hash));
+		tree.ray_cast(query.min(), to, std::back_inserter(from_tree));
+		EXPECT_EQ(sorted(from_hash), sorted(from_tree));
+
+		from_hash.clear();
+		from_tree.clear();
+		hash.sweep(query, {300.0f, -120.0f}, std::back_inserter(from_hash));
+		tree.sweep(query, {300.0f, -120.0f}, std::back_inserter(from_tree));
+		EXPECT_EQ(sorted(from_hash), sorted(from_tree));
+	}
+}
+
+TEST(SpatialHash, UpdateEraseAndResize)
+{
+	galaxy::physics::SpatialHash<int> hash {{10.0f, 10.0f}};
+
+	hash.insert(1, {0.0f, 0.0f}, {10.0f, 10.0f});
+	hash.insert(2, {5.0f, 5.0f}, {15.0f, 15.0f});
+	hash.insert(3, {100.0f, 100.0f}, {110.0f, 110.0f});
+
+	// Within the fattened AABB, so nothing changes.
+	EXPECT_FALSE(hash.update(1, {{0.1f, 0.1f}, {10.1f, 10.1f}}));
+	EXPECT_TRUE(hash.update(3, {{8.0f, 8.0f}, {18.0f, 18.0f}}));
+	EXPECT_FALSE(hash.update(4, {{0.0f, 0.0f}, {1.0f, 1.0f}}));
+
+	std::vector<int> result;
+	hash.query(2, std::back_inserter(result));
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(result, (std::vector<int> {1, 3}));
+
+	hash.erase(1);
+	EXPECT_EQ(hash.size(), 2);
+
+	// Freed slots are reused by the next insert.
+	hash.insert(4, {200.0f, 200.0f}, {300.0f, 300.0f});
+	EXPECT_EQ(hash.large_count(), 1);
+
+	// Boxes 2 and 3 share the first cell. Box 4 now fits in cells 1 to 3 on each axis.
+	hash.set_cell_size({100.0f, 100.0f});
+	EXPECT_EQ(hash.large_count(), 0);
+	EXPECT_EQ(hash.cell_count(), 10);
+
+	result.clear();
+	hash.query(galaxy::math::AABB {{0.0f, 0.0f}, {300.0f, 300.0f}}, std::back_inserter(result));
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(result, (std::vector<int> {2, 3, 4}));
+
+	hash.erase(2);
+	hash.erase(3);
+	hash.erase(4);
+	EXPECT_TRUE(hash.is_empty());
+	EXPECT_EQ(hash.cell_count(), 0);
+}
\ No newline at end of file
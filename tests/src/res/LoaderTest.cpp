@@ -0,0 +1,195 @@
+///
+/// LoaderTest.cpp
+/// tests
+///
+/// Refer to LICENSE.txt for more details.
+///
+
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <stb/stb_image_write.h>
+
+#include <galaxy/resource/Loader.hpp>
+
+namespace
+{
+	///
+	/// Encodes a 2x2 png with a distinct colour in each corner.
+	///
+	std::vector<char> make_png()
+	{
+		// clang-format off
+		const unsigned char pixels[] = {
+			255, 0, 0, 255,   0, 255, 0, 255,
+			0, 0, 255, 255,   255, 255, 255, 255
+		};
+		// clang-format on
+
+		std::vector<char> png;
+		stbi_write_png_to_func(
+			[](void* context, void* data, int size) {
+				auto* out = static_cast<std::vector<char>*>(context);
+				out->insert(out->end(), static_cast<char*>(data), static_cast<char*>(data) + size);
+			},
+			&png,
+			2,
+			2,
+			4,
+			pixels,
+			2 * 4);
+
+		return png;
+	}
+
+	///
+	/// Pool and vfs over a temp folder holding a png and a file that is not an image.
+	///
+	class LoaderTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_root = std::filesystem::temp_directory_path() / "galaxy_loader_test";
+			std::filesystem::remove_all(m_root);
+			std::filesystem::create_directories(m_root);
+
+			const auto png = make_png();
+			write(m_root / "tile.png", {png.data(), png.size()});
+			write(m_root / "notes.txt", "not an image");
+
+			ASSERT_TRUE(m_vfs.mount(m_root.string()));
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_root);
+		}
+
+		void write(const std::filesystem::path& path, std::string_view data)
+		{
+			std::ofstream ofs {path, std::ofstream::binary};
+			ofs << data;
+		}
+
+		std::filesystem::path m_root;
+		galaxy::async::ThreadPool m_pool {2};
+		galaxy::fs::Virtual m_vfs;
+	};
+} // namespace
+
+TEST(Decode, ImageRoundTrip)
+{
+	const auto png = make_png();
+
+	const auto image = galaxy::graphics::decode_image({png.data(), png.size()}, false);
+	ASSERT_TRUE(image.has_value());
+	EXPECT_EQ(image->m_width, 2);
+	EXPECT_EQ(image->m_height, 2);
+	ASSERT_EQ(image->m_pixels.size(), 16);
+	EXPECT_EQ(image->m_pixels[0], 255);
+	EXPECT_EQ(image->m_pixels[10], 255);
+
+	// Flipped, the blue pixel comes first.
+	const auto flipped = galaxy::graphics::decode_image({png.data(), png.size()});
+	ASSERT_TRUE(flipped.has_value());
+	EXPECT_EQ(flipped->m_pixels[0], 0);
+	EXPECT_EQ(flipped->m_pixels[2], 255);
+}
+
+TEST(Decode, RejectsGarbage)
+{
+	const std::string garbage = "definitely not encoded";
+
+	EXPECT_FALSE(galaxy::graphics::decode_image({garbage.data(), garbage.size()}).has_value());
+	EXPECT_FALSE(galaxy::audio::decode_vorbis({garbage.data(), garbage.size()}).has_value());
+}
+
+TEST_F(LoaderTest, UploadsOnOwningThread)
+{
+	galaxy::res::Loader loader {&m_pool, &m_vfs};
+
+	const auto owner = std::this_thread::get_id();
+	std::thread::id uploaded_on;
+	int width = 0;
+
+	const auto future = loader.image("tile.png", [&](galaxy::graphics::Image& image) {
+		uploaded_on = std::this_thread::get_id();
+		width       = image.m_width;
+
+		return true;
+	});
+
+	EXPECT_TRUE(loader.wait(future));
+	EXPECT_EQ(uploaded_on, owner);
+	EXPECT_EQ(width, 2);
+	EXPECT_EQ(loader.pending(), 0);
+}
+
+TEST_F(LoaderTest, FailuresResolveFalse)
+{
+	galaxy::res::Loader loader {&m_pool, &m_vfs};
+
+	bool uploaded = false;
+	auto upload   = [&](galaxy::graphics::Image&) {
+		uploaded = true;
+		return true;
+	};
+
+	const auto missing = loader.image("missing.png", upload);
+	const auto invalid = loader.image("notes.txt", upload);
+	const auto rejects = loader.bytes("notes.txt", [](std::vector<char>&) {
+		return false;
+	});
+	const auto throws = loader.submit(
+		[]() -> std::optional<int> {
+			throw std::runtime_error {"decode failed"};
+		},
+		[](int) {
+			return true;
+		});
+
+	loader.wait_all();
+
+	EXPECT_FALSE(missing.get());
+	EXPECT_FALSE(invalid.get());
+	EXPECT_FALSE(rejects.get());
+	EXPECT_FALSE(throws.get());
+	EXPECT_FALSE(uploaded);
+	EXPECT_EQ(loader.pending(), 0);
+}
+
+TEST_F(LoaderTest, PollLimitsUploads)
+{
+	constexpr const int COUNT = 8;
+
+	galaxy::res::Loader loader {&m_pool, &m_vfs};
+
+	int uploads = 0;
+	std::vector<std::shared_future<bool>> futures;
+	for (int i = 0; i < COUNT; i++)
+	{
+		futures.push_back(loader.bytes("tile.png", [&](std::vector<char>& data) {
+			uploads++;
+			return !data.empty();
+		}));
+	}
+
+	// Decoding is done once the pool drains, but nothing is uploaded until polled.
+	m_pool.finish();
+	EXPECT_EQ(uploads, 0);
+
+	EXPECT_EQ(loader.poll(3), 3);
+	EXPECT_EQ(uploads, 3);
+	EXPECT_EQ(loader.pending(), COUNT - 3);
+
+	loader.wait_all();
+	EXPECT_EQ(uploads, COUNT);
+	EXPECT_EQ(loader.pending(), 0);
+
+	for (const auto& future : futures)
+	{
+		EXPECT_TRUE(future.get());
+	}
+}
\ No newline at end of file